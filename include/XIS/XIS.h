@@ -1,15 +1,148 @@
 #pragma once
 
+#include <memory>
 #include "XISConfig.h"
 #include "XISIntegration.h"
 
 namespace XIS {
 
+// Implémentation interne d'une session
+class XISCore;
+
+/**
+ * @brief Session XIS indépendante
+ * 
+ * Une session possède son propre pipeline, ses ressources et ses statistiques.
+ * Plusieurs sessions peuvent traiter des frames simultanément sur des threads
+ * différents. Sur une même session, ProcessFrame doit être appelé depuis un
+ * seul thread à la fois ; les méthodes Enable* et Configure* peuvent être
+ * appelées depuis n'importe quel thread et prennent effet à la frame suivante.
+ * Les sessions sont créées par CPU::CreateSession (ou DX11::CreateSession /
+ * DX12::CreateSession lorsque ces backends sont compilés) et détruites par
+ * DestroySession.
+ */
+class XIS_API XISSession {
+public:
+    explicit XISSession(std::unique_ptr<XISCore> core);
+    ~XISSession();
+
+    /**
+     * @brief Traite une frame source avec upscaling et interpolation optionnelle
+     * 
+     * @param parameters Paramètres pour le traitement de cette frame
+     * @return true si le traitement a réussi, false sinon
+     */
+    bool ProcessFrame(const XISParameters& parameters);
+
+    /**
+     * @brief Active ou désactive l'upscaling bicubique
+     */
+    void EnableBicubicUpscaling(bool enabled);
+
+    /**
+     * @brief Active ou désactive la génération de frames
+     */
+    void EnableFrameGeneration(bool enabled);
+
+    /**
+     * @brief Configure les paramètres d'upscaling
+     */
+    void ConfigureUpscaling(const UpscalingParameters& params);
+
+    /**
+     * @brief Configure les paramètres de génération de frames
+     */
+    void ConfigureFrameGeneration(const FrameGenParameters& params);
+
+    /**
+     * @brief Obtient les statistiques de performance de la session
+     */
+    XISPerformanceStats GetPerformanceStats() const;
+
+    /**
+     * @brief Capture une trace Chrome/Perfetto des prochaines frames
+     *
+     * @param outputPath Fichier JSON de sortie (chrome://tracing, ui.perfetto.dev)
+     * @param frameCount Nombre de frames à capturer
+     * @return true si la capture a démarré, false si une capture est déjà en cours
+     */
+    bool StartTraceCapture(const char* outputPath, uint32_t frameCount);
+
+    /**
+     * @brief Indique si une capture de trace est en cours
+     */
+    bool IsTraceCaptureActive() const;
+
+    /**
+     * @brief Enregistre les prochaines frames pour les rejouer hors ligne
+     *
+     * @param outputPath Fichier de capture (lu par tools/Replay)
+     * @param frameCount Nombre de frames à enregistrer
+     * @return true si la capture a démarré, false si une capture est déjà en cours
+     */
+    bool StartFrameCapture(const char* outputPath, uint32_t frameCount);
+
+    /**
+     * @brief Indique si une capture de frames est en cours
+     */
+    bool IsFrameCaptureActive() const;
+
+    /**
+     * @brief Obtient les centiles de latence de la session sur la fenêtre glissante
+     */
+    XISLatencyReport GetLatencyReport() const;
+
+    /**
+     * @brief Vide les histogrammes de latence de la session
+     */
+    void ResetLatencyStats();
+
+    /**
+     * @brief Obtient le trafic mémoire par étape et le compare au débit crête
+     */
+    XISBandwidthReport GetBandwidthReport() const;
+
+    /**
+     * @brief Remet à zéro les compteurs de trafic mémoire de la session
+     */
+    void ResetBandwidthStats();
+
+    /**
+     * @brief Obtient l'occupation mémoire des ressources de la session
+     */
+    XISMemoryReport GetMemoryReport() const;
+
+    /**
+     * @brief Écrit l'occupation mémoire détaillée de la session
+     *
+     * @param outputPath Fichier texte de sortie, nullptr pour la sortie standard
+     * @return true si l'écriture réussit
+     */
+    bool DumpMemoryReport(const char* outputPath) const;
+
+    /**
+     * @brief Obtient les appels de liaison avant et après filtrage des redondances
+     */
+    XISCommandStats GetCommandStats() const;
+
+private:
+    // Accès de la couche d'intégration à l'implémentation (défini dans XISSession.cpp)
+    friend class XISSessionAccess;
+
+    // Empêcher la copie
+    XISSession(const XISSession&) = delete;
+    XISSession& operator=(const XISSession&) = delete;
+
+    std::unique_ptr<XISCore> m_core;
+};
+
 /**
  * @brief Classe principale pour le système XIS d'upscaling et génération de frames
  * 
  * Cette classe expose l'API publique pour l'intégration du système dans une application.
  * Elle coordonne l'upscaling bicubique et la génération/interpolation de frames.
+ * Elle opère sur la session globale de l'application ; les applications
+ * traitant plusieurs flux utilisent plutôt une XISSession par flux.
  */
 class XISAPI {
 public:
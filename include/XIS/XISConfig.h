@@ -68,6 +68,28 @@ struct FrameGenParameters {
     float motionSensitivity = 0.5f;       // Sensibilité à la détection de mouvement [0.0 - 1.0]
     float artifactReduction = 0.6f;       // Réduction des artefacts [0.0 - 1.0]
     bool enableSceneChangeDetection = true; // Détection des changements de scène
+    uint32_t historyLength = 2;           // Frames d'entrée conservées par l'historique [2 - 16]
+    bool zeroCopyHistory = false;         // Référencer les entrées sans les copier (voir CPU::ImportTexture)
+};
+
+/**
+ * @brief Configuration de la résolution dynamique
+ * 
+ * Lorsque la résolution dynamique est active, XIS ajuste lui-même son point de
+ * fonctionnement (rayon de recherche de mouvement, qualité d'AA, échelle
+ * d'entrée) pour tenir le budget de temps par frame.
+ */
+struct DynamicResolutionParameters {
+    bool enabled = false;                 // Activer le contrôle par budget de temps
+    float frameTimeBudgetMs = 16.6f;      // Budget de traitement par frame en ms
+    float hysteresisPercent = 5.0f;       // Bande morte autour du budget, en % du budget
+    float minInputScale = 0.5f;           // Échelle d'entrée minimale [0.1 - 1.0]
+    float maxInputScale = 1.0f;           // Échelle d'entrée maximale [0.1 - 1.0]
+    uint32_t minSearchRadius = 8;         // Rayon de recherche de mouvement minimal (pixels)
+    uint32_t maxSearchRadius = 32;        // Rayon de recherche de mouvement maximal (pixels)
+    float proportionalGain = 0.4f;        // Gain proportionnel du régulateur
+    float integralGain = 0.1f;            // Gain intégral du régulateur
+    float derivativeGain = 0.05f;         // Gain dérivé du régulateur
 };
 
 /**
@@ -82,9 +104,12 @@ struct XISConfig {
     
     UpscalingParameters upscalingParams;  // Paramètres d'upscaling
     FrameGenParameters frameGenParams;    // Paramètres de génération de frames
+    DynamicResolutionParameters dynamicResolution; // Paramètres de résolution dynamique
     
     bool enableLogging = true;            // Activer la journalisation
     bool enablePerfMonitoring = true;     // Activer la surveillance des performances
+    float latencyWindowSeconds = 10.0f;   // Fenêtre glissante des histogrammes de latence
+    float stageReleaseDelaySeconds = 30.0f; // Délai avant libération d'une étape désactivée (0 = à la frame suivante)
     
     const char* shaderPath = nullptr;     // Chemin vers les shaders (nullptr = utiliser chemin par défaut)
 };
@@ -95,18 +120,30 @@ struct XISConfig {
 struct XISParameters {
     void* inputTexture = nullptr;         // Texture d'entrée
     void* outputTexture = nullptr;        // Texture de sortie
+    void* generatedFrameTexture = nullptr; // Reçoit la frame intermédiaire générée, de la taille de la sortie (nullptr = non copiée)
     
     // Paramètres de timing pour la génération de frames
     float frameDeltaTime = 0.0f;          // Temps écoulé depuis la dernière frame
     
     // Facteurs de qualité dynamiques
-    float qualityFactor = 1.0f;           // Facteur de qualité dynamique [0.0 - 1.0]
+    float qualityFactor = 1.0f;           // Plafond de qualité [0.0 - 1.0], pris en compte à la frame suivante, régulateur actif ou non
     
     // Paramètres spécifiques à DirectX
     bool isDX11 = true;                   // true pour DX11, false pour DX12
     void* deviceContext = nullptr;        // Contexte de périphérique (ID3D11DeviceContext* ou ID3D12GraphicsCommandList*)
 };
 
+/**
+ * @brief Point de fonctionnement choisi par la résolution dynamique
+ */
+struct XISOperatingPoint {
+    float qualityLevel = 1.0f;            // Niveau de qualité du régulateur [0.0 - 1.0]
+    float inputScale = 1.0f;              // Échelle appliquée à l'entrée avant upscaling
+    AAQuality aaQuality = AAQuality::Medium; // Qualité d'antialiasing appliquée
+    uint32_t motionSearchRadius = 32;     // Rayon de recherche de mouvement appliqué
+    float frameTimeBudgetMs = 0.0f;       // Budget visé (0 = résolution dynamique inactive)
+};
+
 /**
  * @brief Statistiques de performance
  */
@@ -118,6 +155,181 @@ struct XISPerformanceStats {
     uint32_t inputResolution[2] = {0, 0}; // Résolution d'entrée [largeur, hauteur]
     uint32_t outputResolution[2] = {0, 0}; // Résolution de sortie [largeur, hauteur]
     float outputFps = 0.0f;               // FPS estimés en sortie
+    uint32_t constantBufferUploads = 0;   // Envois de tampons constants pendant la dernière frame
+    XISOperatingPoint operatingPoint;     // Point de fonctionnement de la dernière frame
+};
+
+/**
+ * @brief Distribution de latences sur la fenêtre glissante
+ *
+ * Centiles issus d'un histogramme à précision relative constante (erreur
+ * inférieure à 2 %) ; le maximum et la moyenne sont exacts.
+ */
+struct XISLatencyStats {
+    uint64_t sampleCount = 0;             // Nombre d'échantillons dans la fenêtre
+    float p50Ms = 0.0f;                   // Médiane
+    float p90Ms = 0.0f;                   // 90e centile
+    float p99Ms = 0.0f;                   // 99e centile
+    float p999Ms = 0.0f;                  // 99,9e centile
+    float maxMs = 0.0f;                   // Maximum
+    float meanMs = 0.0f;                  // Moyenne
+};
+
+/**
+ * @brief Latence d'une étape (durée cumulée par frame)
+ */
+struct XISStageLatency {
+    char stageName[32] = {};              // Nom de l'étape (ex: "Upscaling", "DispatchCompute")
+    XISLatencyStats latency;
+};
+
+/**
+ * @brief Rapport de latences d'une ou plusieurs sessions
+ */
+struct XISLatencyReport {
+    static const uint32_t kMaxStages = 32;
+
+    float windowSeconds = 0.0f;           // Durée de la fenêtre glissante
+    XISLatencyStats frame;                // Durée totale des frames
+    uint32_t stageCount = 0;              // Nombre d'entrées valides dans stages
+    XISStageLatency stages[kMaxStages];   // Étapes ayant au moins un échantillon
+};
+
+/**
+ * @brief Trafic mémoire d'une étape, moyenné par frame
+ *
+ * Les octets sont estimés à partir des ressources liées à chaque appel
+ * (taille complète de chaque ressource, selon ses dimensions et son format).
+ */
+struct XISStageBandwidth {
+    char stageName[32] = {};              // Nom de l'étape (ex: "Upscaling", "DispatchCompute")
+    float callsPerFrame = 0.0f;           // Exécutions par frame où l'étape a tourné
+    float timeMsPerFrame = 0.0f;          // Temps par frame où l'étape a tourné
+    uint64_t bytesReadPerFrame = 0;       // Octets lus par frame
+    uint64_t bytesWrittenPerFrame = 0;    // Octets écrits par frame
+    float achievedGBps = 0.0f;            // (lus + écrits) / temps
+    float peakFraction = 0.0f;            // achievedGBps / peakGBps
+    bool bandwidthBound = false;          // Limitée par la mémoire (peakFraction >= 0,6)
+};
+
+/**
+ * @brief Rapport de débit mémoire d'une session
+ *
+ * Synthèse de type roofline : le débit atteint par chaque étape est comparé
+ * au débit crête mesuré de la machine. Une étape proche du crête est limitée
+ * par la mémoire ; réduire ses accès (formats, résolution) est alors plus
+ * efficace qu'alléger ses calculs.
+ */
+struct XISBandwidthReport {
+    static const uint32_t kMaxStages = 32;
+
+    float peakGBps = 0.0f;                // Débit crête mesuré (lecture + écriture)
+    uint64_t frameCount = 0;              // Frames comptabilisées depuis la remise à zéro
+    XISStageBandwidth frame;              // Frame complète
+    uint32_t stageCount = 0;              // Nombre d'entrées valides dans stages
+    XISStageBandwidth stages[kMaxStages]; // Étapes ayant transféré au moins un octet
+};
+
+/**
+ * @brief Mémoire occupée par les ressources d'un même nom de débogage
+ */
+struct XISMemoryEntry {
+    char name[48] = {};                   // Nom de débogage ("<unnamed>" si absent)
+    char category[24] = {};               // "Texture", "StructuredBuffer", "ConstantBuffer", "Intermediate"
+    uint32_t liveCount = 0;               // Ressources vivantes
+    uint64_t liveBytes = 0;               // Octets vivants
+    uint64_t peakBytes = 0;               // Maximum atteint par liveBytes
+    uint64_t allocationCount = 0;         // Créations depuis le début de la session
+};
+
+/**
+ * @brief Occupation mémoire des ressources d'une session
+ *
+ * Couvre toutes les ressources créées via le renderer de la session (les
+ * textures fournies par l'application ne sont pas comptées).
+ */
+struct XISMemoryReport {
+    static const uint32_t kMaxEntries = 64;
+
+    uint64_t liveBytes = 0;               // Ensemble de travail actuel
+    uint32_t liveCount = 0;               // Ressources vivantes
+    uint64_t peakBytes = 0;               // Maximum de l'ensemble de travail
+    uint64_t hugePageBytes = 0;           // Octets vivants servis par des pages larges (backend CPU)
+    uint64_t allocationCount = 0;         // Créations depuis le début de la session
+    uint32_t allocationsLastFrame = 0;    // Créations pendant la dernière frame
+    uint32_t releasesLastFrame = 0;       // Libérations pendant la dernière frame
+    uint32_t maxAllocationsPerFrame = 0;  // Maximum de créations sur une frame
+    uint32_t entryCount = 0;              // Nombre d'entrées valides dans entries
+    XISMemoryEntry entries[kMaxEntries];  // Par octets vivants décroissants
+};
+
+/**
+ * @brief Appels de liaison d'une session avant et après filtrage
+ *
+ * Les liaisons (shaders, tampons constants, ressources, root constants)
+ * identiques à l'état déjà en place sont supprimées et les barrières
+ * consécutives fusionnées avant d'atteindre le backend. Compteurs cumulés
+ * depuis la création de la session.
+ */
+struct XISCommandStats {
+    uint64_t workCalls = 0;               // Dispatchs et exécutions de shaders
+    uint64_t stateCallsIn = 0;            // Appels de liaison émis par les étapes
+    uint64_t stateCallsOut = 0;           // Appels de liaison transmis au backend
+    float stateCallsPerDispatchIn = 0.0f; // stateCallsIn / workCalls
+    float stateCallsPerDispatchOut = 0.0f; // stateCallsOut / workCalls
+    uint64_t barriersIn = 0;              // Barrières émises par les étapes
+    uint64_t barriersOut = 0;             // Barrières transmises au backend
+    uint64_t batches = 0;                 // Lots de commandes soumis
+    float commandsPerBatch = 0.0f;        // Commandes par lot en moyenne
+};
+
+/**
+ * @brief Placement et accès mémoire d'un nœud NUMA (backend CPU)
+ */
+struct XISNumaNodeStats {
+    uint32_t cpuCount = 0;                // Processeurs logiques du nœud
+    uint32_t sessionCount = 0;            // Sessions CPU affectées au nœud
+    uint64_t localBytes = 0;              // Octets des textures du nœud traités par ses threads
+    uint64_t remoteBytes = 0;             // Octets des textures d'un autre nœud traités par ses threads
+};
+
+/**
+ * @brief Répartition NUMA des sessions CPU du processus
+ *
+ * Les accès sont estimés par kernel : chaque texture liée compte pour sa
+ * taille, comme accès local ou distant selon le nœud de ses pages.
+ */
+struct XISNumaReport {
+    static const uint32_t kMaxNodes = 16;
+
+    uint32_t nodeCount = 0;               // 0 ou 1 sur une machine non NUMA
+    XISNumaNodeStats nodes[kMaxNodes];    // Par numéro de nœud
+};
+
+/**
+ * @brief Configuration de l'ordonnanceur multi-flux
+ */
+struct XISSchedulerConfig {
+    uint32_t workerThreadCount = 0;       // Nombre de threads de traitement (0 = nombre de cœurs)
+    uint32_t maxQueueDepth = 8;           // Nombre maximal de frames en attente par flux
+    float shedMarginMs = 1.0f;            // Marge de sécurité avant l'échéance déclenchant le délestage
+};
+
+/**
+ * @brief Statistiques d'un flux géré par l'ordonnanceur
+ */
+struct XISStreamStats {
+    uint32_t queueDepth = 0;              // Frames en attente
+    uint64_t framesSubmitted = 0;         // Frames soumises
+    uint64_t framesCompleted = 0;         // Frames traitées
+    uint64_t framesRejected = 0;          // Frames refusées (file pleine ou flux retiré)
+    uint64_t framesLate = 0;              // Frames terminées après leur échéance
+    uint64_t frameGenShed = 0;            // Frames traitées sans génération de frames (délestage)
+    uint64_t antiAliasingShed = 0;        // Frames traitées avec une qualité d'AA réduite (délestage)
+    float totalLatenessMs = 0.0f;         // Retard cumulé des frames en retard
+    float maxLatenessMs = 0.0f;           // Retard maximal observé
+    float averageQueueWaitMs = 0.0f;      // Attente moyenne en file (moyenne glissante)
+    float averageProcessingMs = 0.0f;     // Temps de traitement moyen (moyenne glissante)
 };
 
 } // namespace XIS
\ No newline at end of file
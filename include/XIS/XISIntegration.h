@@ -14,6 +14,10 @@ namespace XIS {
 /**
  * @brief Initialise le système XIS avec la configuration spécifiée
  * 
+ * Sans périphérique graphique, la session globale s'exécute sur le CPU
+ * (équivalent à CPU::Initialize) ; utiliser DX11::Initialize ou
+ * DX12::Initialize pour un rendu GPU.
+ * 
  * @param config Configuration du système
  * @return true si l'initialisation a réussi, false sinon
  */
@@ -27,6 +31,9 @@ XIS_API void Shutdown();
 /**
  * @brief Traite une frame en appliquant l'upscaling et/ou la génération de frames
  * 
+ * Comme pour une session explicite, les appels doivent être sérialisés ; les
+ * autres fonctions de la session globale n'attendent pas la fin de la frame.
+ * 
  * @param params Paramètres de traitement de la frame
  * @return true si le traitement a réussi, false sinon
  */
@@ -53,6 +60,300 @@ XIS_API void SetFrameGenParameters(const FrameGenParameters& params);
  */
 XIS_API void GetPerformanceStats(XISPerformanceStats& stats);
 
+/**
+ * @brief Capture une trace des prochaines frames de la session globale
+ *
+ * Voir StartTraceCapture(XISSessionHandle, const char*, uint32_t).
+ */
+XIS_API bool StartTraceCapture(const char* outputPath, uint32_t frameCount);
+
+/**
+ * @brief Enregistre les prochaines frames de la session globale
+ *
+ * Voir StartFrameCapture(XISSessionHandle, const char*, uint32_t).
+ */
+XIS_API bool StartFrameCapture(const char* outputPath, uint32_t frameCount);
+
+/**
+ * @brief Obtient les centiles de latence de la session globale
+ */
+XIS_API void GetLatencyReport(XISLatencyReport& report);
+
+/**
+ * @brief Vide les histogrammes de latence de la session globale
+ */
+XIS_API void ResetLatencyStats();
+
+/**
+ * @brief Obtient le trafic mémoire par étape de la session globale
+ */
+XIS_API void GetBandwidthReport(XISBandwidthReport& report);
+
+/**
+ * @brief Remet à zéro les compteurs de trafic mémoire de la session globale
+ */
+XIS_API void ResetBandwidthStats();
+
+/**
+ * @brief Obtient l'occupation mémoire des ressources de la session globale
+ */
+XIS_API void GetMemoryReport(XISMemoryReport& report);
+
+/**
+ * @brief Écrit l'occupation mémoire détaillée de la session globale
+ */
+XIS_API bool DumpMemoryReport(const char* outputPath);
+
+/**
+ * @brief Obtient les appels de liaison avant et après filtrage de la session globale
+ */
+XIS_API void GetCommandStats(XISCommandStats& stats);
+
+/**
+ * @brief Charge le profil d'autotuning de la machine
+ *
+ * Le profil (produit par tests/PerformanceTests/Autotuner) fixe, pour
+ * chaque paire de résolutions mesurée, la taille des blocs et le rayon de
+ * l'estimation de mouvement, les noyaux d'antialiasing et le parallélisme
+ * du backend CPU. Il s'applique aux sessions initialisées ensuite. À
+ * défaut, le profil désigné par la variable d'environnement
+ * XIS_TUNING_PROFILE est chargé à la première initialisation.
+ *
+ * @return false si le fichier est illisible ; le profil courant est alors conservé
+ */
+XIS_API bool LoadTuningProfile(const char* path);
+
+/**
+ * @brief Applique un fichier de configuration et le surveille
+ *
+ * Chaque modification valide du fichier est appliquée, sans redémarrage, à
+ * toutes les sessions (globale comprise) au début de leur frame suivante,
+ * ainsi qu'aux sessions créées ensuite. Seules les clés présentes dans le
+ * fichier sont modifiées ; une version invalide est rejetée en entier et
+ * journalisée. Un seul fichier est surveillé à la fois.
+ *
+ * @param path Fichier « clé = valeur » par sections (voir ConfigManager)
+ * @return false si le fichier est illisible ou invalide
+ */
+XIS_API bool WatchConfigFile(const char* path);
+
+/**
+ * @brief Arrête la surveillance du fichier de configuration
+ *
+ * Les réglages déjà appliqués sont conservés.
+ */
+XIS_API void StopWatchingConfigFile();
+
+/**
+ * @brief Sessions XIS indépendantes
+ *
+ * Les fonctions ci-dessus opèrent sur une session globale unique. Une
+ * application traitant plusieurs flux crée une session par flux : chaque
+ * session possède son propre pipeline, ses ressources et ses statistiques,
+ * et plusieurs sessions peuvent traiter des frames en parallèle sur des
+ * threads différents. ProcessFrame doit être sérialisé pour une même
+ * session ; les fonctions Set* peuvent être appelées depuis n'importe quel
+ * thread et prennent effet à la frame suivante.
+ */
+class XISSession;
+typedef XISSession* XISSessionHandle;
+
+/**
+ * @brief Détruit une session et libère ses ressources
+ *
+ * @param session Session à détruire (nullptr accepté)
+ */
+XIS_API void DestroySession(XISSessionHandle session);
+
+/**
+ * @brief Traite une frame dans une session
+ *
+ * @param session Session cible
+ * @param params Paramètres de traitement de la frame
+ * @return true si le traitement a réussi, false sinon
+ */
+XIS_API bool ProcessFrame(XISSessionHandle session, const XISParameters& params);
+
+/**
+ * @brief Met à jour les paramètres d'upscaling d'une session
+ */
+XIS_API void SetUpscalingParameters(XISSessionHandle session, const UpscalingParameters& params);
+
+/**
+ * @brief Met à jour les paramètres de génération de frames d'une session
+ */
+XIS_API void SetFrameGenParameters(XISSessionHandle session, const FrameGenParameters& params);
+
+/**
+ * @brief Obtient les statistiques de performance d'une session
+ */
+XIS_API void GetPerformanceStats(XISSessionHandle session, XISPerformanceStats& stats);
+
+/**
+ * @brief Capture une trace Chrome/Perfetto des prochaines frames d'une session
+ *
+ * La trace contient un intervalle par frame (Pipeline::Execute), par étape
+ * et par appel GPU (DispatchCompute, ExecuteShader, CopyResource,
+ * SyncCompute), une piste par thread (thread appelant ou thread de
+ * l'ordonnanceur), et l'attente en file des frames soumises via SubmitFrame.
+ * Le fichier est écrit en arrière-plan après la dernière frame capturée.
+ *
+ * @param session Session cible
+ * @param outputPath Fichier JSON de sortie (chrome://tracing, ui.perfetto.dev)
+ * @param frameCount Nombre de frames à capturer (1000 au plus)
+ * @return true si la capture a démarré, false si une capture est déjà en cours
+ */
+XIS_API bool StartTraceCapture(XISSessionHandle session, const char* outputPath, uint32_t frameCount);
+
+/**
+ * @brief Indique si une capture de trace est en cours pour une session
+ */
+XIS_API bool IsTraceCaptureActive(XISSessionHandle session);
+
+/**
+ * @brief Enregistre les prochaines frames d'une session pour un rejeu déterministe
+ *
+ * La capture contient la configuration et ses changements, les paramètres
+ * et le délestage de chaque frame, le point de fonctionnement de la
+ * résolution dynamique et le contenu de la texture d'entrée, compressé sans
+ * perte. tools/Replay la rejoue à travers le pipeline. Nécessite un backend
+ * capable de relire ses textures (backend CPU).
+ *
+ * @param session Session cible
+ * @param outputPath Fichier de capture
+ * @param frameCount Nombre de frames à enregistrer
+ * @return true si la capture a démarré, false si une capture est déjà en cours
+ */
+XIS_API bool StartFrameCapture(XISSessionHandle session, const char* outputPath, uint32_t frameCount);
+
+/**
+ * @brief Indique si une capture de frames est en cours pour une session
+ */
+XIS_API bool IsFrameCaptureActive(XISSessionHandle session);
+
+/**
+ * @brief Obtient les centiles de latence d'une session
+ *
+ * Les latences sont mesurées sur la fenêtre glissante configurée par
+ * XISConfig::latencyWindowSeconds, pour la frame complète et pour chaque
+ * étape (durée cumulée par frame).
+ */
+XIS_API void GetLatencyReport(XISSessionHandle session, XISLatencyReport& report);
+
+/**
+ * @brief Obtient les centiles de latence de plusieurs sessions réunies
+ *
+ * Les histogrammes des sessions sont fusionnés avant le calcul des centiles :
+ * le résultat est celui d'une session unique ayant traité toutes les frames.
+ *
+ * @param sessions Sessions à réunir (les handles nuls sont ignorés)
+ * @param sessionCount Nombre de sessions
+ * @param report Rapport à remplir
+ */
+XIS_API void GetLatencyReport(const XISSessionHandle* sessions, uint32_t sessionCount, XISLatencyReport& report);
+
+/**
+ * @brief Vide les histogrammes de latence d'une session
+ */
+XIS_API void ResetLatencyStats(XISSessionHandle session);
+
+/**
+ * @brief Obtient le trafic mémoire par étape d'une session
+ *
+ * Octets lus et écrits par frame, débit atteint et fraction du débit crête
+ * de la machine, cumulés depuis la création de la session ou la dernière
+ * remise à zéro. Le débit crête est mesuré au premier appel.
+ */
+XIS_API void GetBandwidthReport(XISSessionHandle session, XISBandwidthReport& report);
+
+/**
+ * @brief Remet à zéro les compteurs de trafic mémoire d'une session
+ */
+XIS_API void ResetBandwidthStats(XISSessionHandle session);
+
+/**
+ * @brief Obtient l'occupation mémoire des ressources d'une session
+ *
+ * Octets vivants et maximum atteint par nom de débogage et catégorie, au
+ * total, et nombre de créations de ressources par frame. Seules les
+ * kMaxEntries entrées les plus lourdes sont rapportées ; DumpMemoryReport
+ * les écrit toutes.
+ */
+XIS_API void GetMemoryReport(XISSessionHandle session, XISMemoryReport& report);
+
+/**
+ * @brief Écrit l'occupation mémoire détaillée d'une session
+ *
+ * @param session Session à décrire
+ * @param outputPath Fichier texte de sortie, nullptr pour la sortie standard
+ * @return true si l'écriture réussit
+ */
+XIS_API bool DumpMemoryReport(XISSessionHandle session, const char* outputPath);
+
+/**
+ * @brief Obtient les appels de liaison d'une session avant et après filtrage
+ *
+ * Nombre d'appels de liaison par dispatch émis par les étapes et transmis
+ * au backend, barrières fusionnées et lots de commandes soumis.
+ */
+XIS_API void GetCommandStats(XISSessionHandle session, XISCommandStats& stats);
+
+/**
+ * @brief Ordonnancement de plusieurs flux
+ *
+ * L'ordonnanceur répartit les frames de toutes les sessions sur un groupe de
+ * threads. Les frames sont traitées par ordre d'échéance de présentation,
+ * une seule frame par session à la fois, et le temps de traitement est
+ * partagé équitablement entre sessions. Un flux sur le point de manquer son
+ * échéance est délesté : la génération de frames est d'abord sautée, puis la
+ * qualité d'antialiasing est réduite.
+ */
+
+/**
+ * @brief Fonction appelée à la fin du traitement d'une frame soumise
+ *
+ * Appelée depuis un thread de l'ordonnanceur.
+ */
+typedef void (*XISFrameCompletionCallback)(XISSessionHandle session, const XISParameters& params, bool success, void* userData);
+
+/**
+ * @brief Démarre l'ordonnanceur multi-flux
+ *
+ * @param config Configuration de l'ordonnanceur
+ * @return true si l'ordonnanceur a démarré, false sinon
+ */
+XIS_API bool StartScheduler(const XISSchedulerConfig& config);
+
+/**
+ * @brief Arrête l'ordonnanceur ; les frames en attente sont abandonnées
+ */
+XIS_API void StopScheduler();
+
+/**
+ * @brief Horloge de l'ordonnanceur en microsecondes (monotone)
+ *
+ * Les échéances passées à SubmitFrame sont exprimées dans cette horloge.
+ */
+XIS_API uint64_t GetSchedulerTimeUs();
+
+/**
+ * @brief Soumet une frame à l'ordonnanceur
+ *
+ * @param session Session cible
+ * @param params Paramètres de la frame (les textures doivent rester valides jusqu'au rappel)
+ * @param presentationDeadlineUs Échéance de présentation (horloge GetSchedulerTimeUs)
+ * @param onComplete Rappel de fin de traitement (optionnel)
+ * @param userData Donnée transmise au rappel
+ * @return true si la frame a été mise en file, false si elle a été refusée
+ */
+XIS_API bool SubmitFrame(XISSessionHandle session, const XISParameters& params, uint64_t presentationDeadlineUs,
+                         XISFrameCompletionCallback onComplete = nullptr, void* userData = nullptr);
+
+/**
+ * @brief Obtient les statistiques d'ordonnancement d'une session
+ */
+XIS_API void GetStreamStats(XISSessionHandle session, XISStreamStats& stats);
+
 /**
  * @brief Fonctions d'intégration spécifiques à DirectX 11
  */
@@ -77,6 +378,17 @@ namespace DX11 {
      * @return true si le traitement a réussi, false sinon
      */
     XIS_API bool ProcessFrame(void* sourceTexture, void* outputTexture, void* deviceContext, const XISParameters* params = nullptr);
+
+    /**
+     * @brief Crée une session indépendante sur un périphérique DirectX 11
+     * 
+     * @param device Pointeur vers le périphérique ID3D11Device
+     * @param deviceContext Contexte utilisé par la session (ID3D11DeviceContext*, idéalement différé)
+     * @param config Configuration de la session
+     * @return La session créée, nullptr en cas d'échec ou si la bibliothèque
+     *         est compilée sans XIS_ENABLE_DX11
+     */
+    XIS_API XISSessionHandle CreateSession(void* device, void* deviceContext, const XISConfig& config);
 }
 
 /**
@@ -103,6 +415,136 @@ namespace DX12 {
      * @return true si le traitement a réussi, false sinon
      */
     XIS_API bool ProcessFrame(void* sourceTexture, void* outputTexture, void* commandList, const XISParameters* params = nullptr);
+
+    /**
+     * @brief Crée une session indépendante sur un périphérique DirectX 12
+     * 
+     * @param device Pointeur vers le périphérique ID3D12Device
+     * @param commandQueue File d'attente de commandes utilisée par la session (ID3D12CommandQueue*)
+     * @param config Configuration de la session
+     * @return La session créée, nullptr en cas d'échec ou si la bibliothèque
+     *         est compilée sans XIS_ENABLE_DX12
+     */
+    XIS_API XISSessionHandle CreateSession(void* device, void* commandQueue, const XISConfig& config);
+}
+
+/**
+ * @brief Fonctions d'intégration du backend CPU
+ *
+ * Le pipeline s'exécute sur le CPU, sans périphérique graphique : les
+ * textures d'entrée et de sortie sont créées par CreateTexture (RGBA 8 bits)
+ * et leur contenu est lu et écrit via MapTexture, ou bien importées sans
+ * copie depuis la mémoire de l'application par ImportTexture.
+ */
+namespace CPU {
+    /**
+     * @brief Format des pixels d'une image importée
+     *
+     * L'entrée et la sortie d'une frame sont en RGBA8 ; les autres formats
+     * servent aux données annexes.
+     */
+    enum class PixelFormat {
+        RGBA8 = 0,
+        R32F = 1,
+        RG32F = 2,
+        RGBA32F = 3
+    };
+
+    /**
+     * @brief Image en mémoire appartenant à l'application (sortie d'un décodeur...)
+     */
+    struct ExternalImage {
+        void* data = nullptr;             // Première ligne, ignoré si fd >= 0 ; aligné sur 4 octets
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t rowPitch = 0;            // Octets entre deux lignes, multiple de 4 (0 = lignes jointives)
+        PixelFormat format = PixelFormat::RGBA8;
+        int fd = -1;                      // dmabuf ou memfd contenant l'image (Linux), -1 si absent
+        uint64_t offset = 0;              // Position de la première ligne dans fd
+        void (*release)(void* userData) = nullptr; // Appelée par ReleaseTexture, quand la mémoire n'est plus utilisée
+        void* userData = nullptr;
+    };
+
+    /**
+     * @brief Crée une session indépendante exécutée sur le CPU
+     * 
+     * Sur une machine NUMA, la session est affectée à un nœud : ses threads
+     * de calcul y sont épinglés et ses textures placées dans sa mémoire.
+     * Le thread qui appelle ProcessFrame ne participe au calcul que s'il
+     * s'exécute sur ce nœud.
+     * 
+     * @param config Configuration de la session
+     * @param workerThreadCount Threads de calcul de la session, thread appelant compris
+     *        (0 = nombre de cœurs, du nœud sur une machine NUMA)
+     * @param numaNode Nœud de la session (-1 = le nœud qui a le moins de sessions)
+     * @return La session créée, nullptr en cas d'échec
+     */
+    XIS_API XISSessionHandle CreateSession(const XISConfig& config, uint32_t workerThreadCount = 0, int numaNode = -1);
+
+    /**
+     * @brief Obtient la répartition NUMA des sessions CPU et leurs accès locaux et distants
+     */
+    XIS_API void GetNumaReport(XISNumaReport& report);
+
+    /**
+     * @brief Initialise la session globale sur le CPU
+     * 
+     * @param config Configuration du système
+     * @param workerThreadCount Threads de calcul, thread appelant compris (0 = nombre de cœurs)
+     * @return true si l'initialisation a réussi, false sinon
+     */
+    XIS_API bool Initialize(const XISConfig& config, uint32_t workerThreadCount = 0);
+
+    /**
+     * @brief Crée une texture RGBA 8 bits utilisable comme entrée ou sortie
+     * 
+     * @return Handle de la texture (à passer dans XISParameters), nullptr en cas d'échec
+     */
+    XIS_API void* CreateTexture(uint32_t width, uint32_t height);
+
+    /**
+     * @brief Crée une texture sur une image de l'application, sans copie
+     *
+     * Le handle s'utilise comme celui de CreateTexture (entrée ou sortie
+     * d'une frame, MapTexture) et lit ou écrit directement dans l'image, en
+     * respectant son pas. L'image doit rester valide jusqu'à ReleaseTexture,
+     * qui appelle image.release : la durée de vie de la mémoire empruntée
+     * est celle du handle.
+     *
+     * La génération de frames copie chaque entrée dans son historique :
+     * l'image d'entrée peut être réécrite ou libérée dès le retour de
+     * ProcessFrame. Avec FrameGenParameters::zeroCopyHistory, l'historique
+     * référence l'entrée sans la copier : elle doit alors rester valide et
+     * inchangée pendant les FrameGenParameters::historyLength frames
+     * suivantes.
+     *
+     * Un descripteur fd est projeté en mémoire partagée et peut être fermé
+     * après l'import ; pour un dmabuf, la synchronisation des accès CPU
+     * (DMA_BUF_IOCTL_SYNC) reste à la charge de l'application.
+     *
+     * @return Handle de la texture, nullptr si l'image est invalide (release n'est alors pas appelée)
+     */
+    XIS_API void* ImportTexture(const ExternalImage& image);
+
+    /**
+     * @brief Libère une texture créée par CreateTexture ou ImportTexture
+     */
+    XIS_API void ReleaseTexture(void* texture);
+
+    /**
+     * @brief Accès direct aux pixels d'une texture
+     * 
+     * Le contenu ne doit pas être modifié pendant le traitement d'une frame
+     * qui utilise la texture.
+     * 
+     * Les lignes sont alignées sur 64 octets et peuvent être suivies d'un
+     * remplissage : le pas entre deux lignes dépasse souvent width * 4.
+     * 
+     * @param texture Texture créée par CreateTexture ou ImportTexture
+     * @param rowPitch Reçoit le nombre d'octets entre deux lignes (optionnel)
+     * @return Pointeur sur la première ligne, nullptr si la texture est invalide
+     */
+    XIS_API uint8_t* MapTexture(void* texture, uint32_t* rowPitch = nullptr);
 }
 
 } // namespace XIS
\ No newline at end of file
@@ -2,12 +2,16 @@
 #include "../Utils/Logger.h"
 #include "../Renderer/IRenderer.h"
 #include "../Shaders/ShaderManager.h"
+#include "../Renderer/ConstantBlock.h"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 namespace XIS {
 
 struct BicubicUpscaler::BicubicUpscalerData {
     bool initialized;
+    IRenderer* renderer;  // Renderer the buffers below were created with
     
     // Shader resources
     void* bicubicShader;
@@ -22,19 +26,24 @@ struct BicubicUpscaler::BicubicUpscalerData {
         float padding[3];
     };
     
-    void* constantBuffer;
+    // Uploaded only when the resolutions or sharpness change
+    ConstantBlock<BicubicConstants> constants;
     
     // Weight buffer for precomputed bicubic weights
     void* weightBuffer;
+    
+    // Sharpness the weight buffer was computed for
+    float weightsSharpness;
 };
 
 BicubicUpscaler::BicubicUpscaler() 
     : m_data(std::make_unique<BicubicUpscalerData>())
 {
     m_data->initialized = false;
+    m_data->renderer = nullptr;
     m_data->bicubicShader = nullptr;
-    m_data->constantBuffer = nullptr;
     m_data->weightBuffer = nullptr;
+    m_data->weightsSharpness = 0.0f;
 }
 
 BicubicUpscaler::~BicubicUpscaler() {
@@ -65,24 +74,23 @@ bool BicubicUpscaler::Initialize(const XISContext* context) {
 }
 
 void BicubicUpscaler::Shutdown() {
-    if (!m_data->initialized) {
+    // Resources created by a failed Initialize are released as well
+    if (!m_data->initialized && !m_data->renderer) {
         return;
     }
     
-    // Release shader resources
-    if (m_data->bicubicShader) {
-        m_data->bicubicShader = nullptr;
-    }
+    // The shader is owned by the context's shader manager
+    m_data->bicubicShader = nullptr;
     
     // Release constant buffer
-    if (m_data->constantBuffer) {
-        m_data->constantBuffer = nullptr;
-    }
+    m_data->constants.Release();
     
     // Release weight buffer
     if (m_data->weightBuffer) {
+        m_data->renderer->ReleaseBuffer(m_data->weightBuffer);
         m_data->weightBuffer = nullptr;
     }
+    m_data->renderer = nullptr;
     
     m_data->initialized = false;
     Logger::Info("BicubicUpscaler: Successfully shut down");
@@ -110,29 +118,32 @@ bool BicubicUpscaler::Upscale(
     
     IRenderer* renderer = context->GetRenderer();
     
-    // Update constant buffer with upscaling parameters
-    BicubicUpscalerData::BicubicConstants constants;
-    constants.inputWidth = inputWidth;
-    constants.inputHeight = inputHeight;
-    constants.outputWidth = outputWidth;
-    constants.outputHeight = outputHeight;
-    
     // Clamp sharpness factor to valid range (-1.0 to -0.5)
     // -0.5 is smoother (Mitchell), -1.0 is sharper (Spline)
     sharpnessFactor = std::max(-1.0f, std::min(-0.5f, sharpnessFactor));
-    constants.sharpnessFactor = sharpnessFactor;
     
-    if (!renderer->UpdateConstantBuffer(m_data->constantBuffer, &constants, sizeof(constants))) {
+    // Update constant buffer with upscaling parameters (uploaded only if changed)
+    m_data->constants.Modify([&](BicubicUpscalerData::BicubicConstants& constants) {
+        constants.inputWidth = inputWidth;
+        constants.inputHeight = inputHeight;
+        constants.outputWidth = outputWidth;
+        constants.outputHeight = outputHeight;
+        constants.sharpnessFactor = sharpnessFactor;
+    });
+    
+    if (!m_data->constants.Flush()) {
         Logger::Error("BicubicUpscaler: Failed to update constant buffer");
         return false;
     }
     
-    // Calculate and update bicubic filter weights
-    CalculateWeights(sharpnessFactor);
+    // Recalculate bicubic filter weights only when the sharpness changes
+    if (sharpnessFactor != m_data->weightsSharpness) {
+        CalculateWeights(context, sharpnessFactor);
+    }
     
     // Set shader resources
     renderer->SetComputeShader(m_data->bicubicShader);
-    renderer->SetComputeConstantBuffer(0, m_data->constantBuffer);
+    renderer->SetComputeConstantBuffer(0, m_data->constants.GetBuffer());
     renderer->SetComputeShaderResource(0, inputTexture);
     renderer->SetComputeShaderResource(1, m_data->weightBuffer);
     renderer->SetComputeUnorderedAccessView(0, outputTexture);
@@ -179,22 +190,18 @@ bool BicubicUpscaler::CreateResources(const XISContext* context) {
         Logger::Error("BicubicUpscaler: Failed to get renderer");
         return false;
     }
+    m_data->renderer = renderer;
     
     // Create constant buffer
-    BicubicUpscalerData::BicubicConstants constants;
-    constants.inputWidth = 0;   // Will be updated in Upscale()
-    constants.inputHeight = 0;
-    constants.outputWidth = 0;
-    constants.outputHeight = 0;
-    constants.sharpnessFactor = -0.5f; // Default: Mitchell filter (balanced)
-    
-    m_data->constantBuffer = renderer->CreateConstantBuffer(
-        sizeof(BicubicUpscalerData::BicubicConstants),
-        &constants,
-        "BicubicConstantBuffer"
-    );
-    
-    if (!m_data->constantBuffer) {
+    m_data->constants.Modify([](BicubicUpscalerData::BicubicConstants& constants) {
+        constants.inputWidth = 0;   // Will be updated in Upscale()
+        constants.inputHeight = 0;
+        constants.outputWidth = 0;
+        constants.outputHeight = 0;
+        constants.sharpnessFactor = -0.5f; // Default: Mitchell filter (balanced)
+    });
+    
+    if (!m_data->constants.Create(renderer, "BicubicConstantBuffer")) {
         Logger::Error("BicubicUpscaler: Failed to create constant buffer");
         return false;
     }
@@ -216,12 +223,12 @@ bool BicubicUpscaler::CreateResources(const XISContext* context) {
     }
     
     // Initialize weights with default value
-    CalculateWeights(-0.5f); // Mitchell filter by default
+    CalculateWeights(context, -0.5f); // Mitchell filter by default
     
     return true;
 }
 
-void BicubicUpscaler::CalculateWeights(float a) {
+void BicubicUpscaler::CalculateWeights(const XISContext* context, float a) {
     // Bicubic weight function with parameter 'a'
     // Common values: -0.5 for Mitchell filter, -0.75 for Catmull-Rom, -1.0 for B-Spline
     auto bicubicWeight = [a](float x) -> float {
@@ -240,7 +247,14 @@ void BicubicUpscaler::CalculateWeights(float a) {
     const int PRECISION = 256;
     const int WEIGHT_COUNT = PRECISION * 4; // 4 weights per position
     
-    std::vector<float> weights(WEIGHT_COUNT);
+    // Staged in the frame arena: UpdateBuffer copies the weights before returning
+    FrameArena& arena = context->GetFrameArena();
+    FrameArena::Scope scratch(arena);
+    float* weights = arena.AllocateArray<float>(WEIGHT_COUNT);
+    if (!weights) {
+        Logger::Error("BicubicUpscaler: Failed to allocate weight staging memory");
+        return;
+    }
     
     for (int i = 0; i < PRECISION; ++i) {
         float frac = static_cast<float>(i) / PRECISION;
@@ -260,8 +274,9 @@ void BicubicUpscaler::CalculateWeights(float a) {
     }
     
     // Update weight buffer with calculated values
-    IRenderer* renderer = XISContext::GetCurrentContext()->GetRenderer();
-    renderer->UpdateBuffer(m_data->weightBuffer, weights.data(), weights.size() * sizeof(float));
+    IRenderer* renderer = context->GetRenderer();
+    renderer->UpdateBuffer(m_data->weightBuffer, weights, WEIGHT_COUNT * sizeof(float));
+    m_data->weightsSharpness = a;
 }
 
 } // namespace XIS
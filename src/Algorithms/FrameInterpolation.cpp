@@ -3,6 +3,8 @@
 #include "../Renderer/IRenderer.h"
 #include "../Core/XISDevice.h"
 #include "../Shaders/ShaderManager.h"
+#include "../Renderer/ConstantBlock.h"
+#include <algorithm>
 
 namespace XIS {
 
@@ -14,9 +16,10 @@ struct FrameInterpolation::FrameInterpolationData {
     void* motionRefinementShader;
     void* frameInterpolationShader;
     
-    // Compute resources
+    // Compute resources, released through the renderer they were created with
+    IRenderer* renderer;
     void* blockMotionBuffer;
-    void* occlusionBuffer;
+    void* occlusionBuffer;  // Created on the first frame that uses occlusion
     
     // Shader constants
     struct MotionShaderConstants {
@@ -32,18 +35,26 @@ struct FrameInterpolation::FrameInterpolationData {
     struct InterpolationShaderConstants {
         int frameWidth;
         int frameHeight;
-        float timePosition;
         float qualityFactor;
         int useOcclusion;
-        int padding[3];
     };
     
-    void* motionConstantBuffer;
-    void* interpolationConstantBuffer;
+    // Per-dispatch values, passed as root constants
+    struct InterpolationRootConstants {
+        float timePosition;
+        float padding[3];
+    };
+    
+    // Uploaded only when their contents change
+    ConstantBlock<MotionShaderConstants> motionConstants;
+    ConstantBlock<InterpolationShaderConstants> interpolationConstants;
     
     // Settings
     int blockSize;
     int searchRadius;
+    
+    // Block size the block motion buffer was sized for
+    int allocatedBlockSize;
 };
 
 FrameInterpolation::FrameInterpolation() 
@@ -53,14 +64,14 @@ FrameInterpolation::FrameInterpolation()
     m_data->motionEstimationShader = nullptr;
     m_data->motionRefinementShader = nullptr;
     m_data->frameInterpolationShader = nullptr;
+    m_data->renderer = nullptr;
     m_data->blockMotionBuffer = nullptr;
     m_data->occlusionBuffer = nullptr;
-    m_data->motionConstantBuffer = nullptr;
-    m_data->interpolationConstantBuffer = nullptr;
     
     // Default settings
     m_data->blockSize = 16;    // 16x16 pixel blocks for motion estimation
     m_data->searchRadius = 32; // 32 pixel search radius
+    m_data->allocatedBlockSize = 0;
 }
 
 FrameInterpolation::~FrameInterpolation() {
@@ -91,7 +102,8 @@ bool FrameInterpolation::Initialize(const XISContext* context) {
 }
 
 void FrameInterpolation::Shutdown() {
-    if (!m_data->initialized) {
+    // Resources created by a failed Initialize are released as well
+    if (!m_data->initialized && !m_data->renderer) {
         return;
     }
     
@@ -110,21 +122,24 @@ void FrameInterpolation::Shutdown() {
     
     // Release compute resources
     if (m_data->blockMotionBuffer) {
+        if (m_data->renderer) {
+            m_data->renderer->ReleaseBuffer(m_data->blockMotionBuffer);
+        }
         m_data->blockMotionBuffer = nullptr;
     }
     
     if (m_data->occlusionBuffer) {
+        if (m_data->renderer) {
+            m_data->renderer->ReleaseResource(m_data->occlusionBuffer);
+        }
         m_data->occlusionBuffer = nullptr;
     }
+    m_data->allocatedBlockSize = 0;
+    m_data->renderer = nullptr;
     
     // Release constant buffers
-    if (m_data->motionConstantBuffer) {
-        m_data->motionConstantBuffer = nullptr;
-    }
-    
-    if (m_data->interpolationConstantBuffer) {
-        m_data->interpolationConstantBuffer = nullptr;
-    }
+    m_data->motionConstants.Release();
+    m_data->interpolationConstants.Release();
     
     m_data->initialized = false;
     Logger::Info("FrameInterpolation: Successfully shut down");
@@ -146,6 +161,15 @@ bool FrameInterpolation::CalculateMotionVectors(
         return false;
     }
     
+    // A new block size changes the block grid; resize its buffer first
+    if (m_data->allocatedBlockSize != m_data->blockSize) {
+        IRenderer* renderer = context->GetRenderer();
+        if (!renderer || !CreateBlockMotionBuffer(renderer, context->GetBackBufferWidth(), context->GetBackBufferHeight())) {
+            Logger::Error("FrameInterpolation: Failed to resize block motion buffer");
+            return false;
+        }
+    }
+    
     // Step 1: Block-based motion estimation
     if (!CalculateBlockMotion(context, previousFrame, currentFrame, m_data->blockMotionBuffer)) {
         Logger::Error("FrameInterpolation: Failed to calculate block motion");
@@ -161,6 +185,17 @@ bool FrameInterpolation::CalculateMotionVectors(
     return true;
 }
 
+void FrameInterpolation::SetSearchRadius(int radius) {
+    // Keep at least one block step so the search window is never empty;
+    // the motion constant block only re-uploads when the value changes
+    m_data->searchRadius = std::max(1, radius);
+}
+
+void FrameInterpolation::SetBlockSize(int blockSize) {
+    // The block motion buffer is resized on the next frame if the grid changes
+    m_data->blockSize = std::max(1, blockSize);
+}
+
 bool FrameInterpolation::GenerateFrames(
     const XISContext* context,
     void* previousFrame,
@@ -271,15 +306,61 @@ bool FrameInterpolation::CreateComputeBuffers(const XISContext* context) {
         return false;
     }
     
+    m_data->renderer = renderer;
+    
     // Get frame dimensions
     int frameWidth = context->GetBackBufferWidth();
     int frameHeight = context->GetBackBufferHeight();
     
+    // Create block motion buffer
+    if (!CreateBlockMotionBuffer(renderer, frameWidth, frameHeight)) {
+        return false;
+    }
+    
+    // The full-resolution occlusion buffer is only needed by high quality
+    // interpolation; it is created by the first frame that uses it
+    
+    // Create motion constant buffer
+    m_data->motionConstants.Modify([&](FrameInterpolationData::MotionShaderConstants& constants) {
+        constants.frameWidth = frameWidth;
+        constants.frameHeight = frameHeight;
+        constants.blockSize = m_data->blockSize;
+        constants.searchRadius = m_data->searchRadius;
+        constants.temporalWeight = 0.7f;  // Weight for temporal coherence
+        constants.spatialWeight = 0.3f;   // Weight for spatial coherence
+    });
+    
+    if (!m_data->motionConstants.Create(renderer, "MotionConstantBuffer")) {
+        Logger::Error("FrameInterpolation: Failed to create motion constant buffer");
+        return false;
+    }
+    
+    // Create interpolation constant buffer
+    m_data->interpolationConstants.Modify([&](FrameInterpolationData::InterpolationShaderConstants& constants) {
+        constants.frameWidth = frameWidth;
+        constants.frameHeight = frameHeight;
+        constants.qualityFactor = 0.8f;    // Default high quality
+        constants.useOcclusion = 1;        // Enable occlusion handling by default
+    });
+    
+    if (!m_data->interpolationConstants.Create(renderer, "InterpolationConstantBuffer")) {
+        Logger::Error("FrameInterpolation: Failed to create interpolation constant buffer");
+        return false;
+    }
+    
+    return true;
+}
+
+bool FrameInterpolation::CreateBlockMotionBuffer(IRenderer* renderer, int frameWidth, int frameHeight) {
+    if (m_data->blockMotionBuffer) {
+        renderer->ReleaseBuffer(m_data->blockMotionBuffer);
+        m_data->blockMotionBuffer = nullptr;
+    }
+    
     // Calculate block grid dimensions
     int blockGridWidth = (frameWidth + m_data->blockSize - 1) / m_data->blockSize;
     int blockGridHeight = (frameHeight + m_data->blockSize - 1) / m_data->blockSize;
     
-    // Create block motion buffer
     m_data->blockMotionBuffer = renderer->CreateStructuredBuffer(
         blockGridWidth * blockGridHeight, // Number of blocks
         sizeof(float) * 4,                // Vector4: x, y motion vectors + confidence + occlusion
@@ -289,10 +370,15 @@ bool FrameInterpolation::CreateComputeBuffers(const XISContext* context) {
     
     if (!m_data->blockMotionBuffer) {
         Logger::Error("FrameInterpolation: Failed to create block motion buffer");
+        m_data->allocatedBlockSize = 0;
         return false;
     }
     
-    // Create occlusion buffer
+    m_data->allocatedBlockSize = m_data->blockSize;
+    return true;
+}
+
+bool FrameInterpolation::CreateOcclusionBuffer(IRenderer* renderer, int frameWidth, int frameHeight) {
     m_data->occlusionBuffer = renderer->CreateTexture2D(
         frameWidth,
         frameHeight,
@@ -306,45 +392,6 @@ bool FrameInterpolation::CreateComputeBuffers(const XISContext* context) {
         return false;
     }
     
-    // Create motion constant buffer
-    FrameInterpolationData::MotionShaderConstants motionConstants;
-    motionConstants.frameWidth = frameWidth;
-    motionConstants.frameHeight = frameHeight;
-    motionConstants.blockSize = m_data->blockSize;
-    motionConstants.searchRadius = m_data->searchRadius;
-    motionConstants.temporalWeight = 0.7f;  // Weight for temporal coherence
-    motionConstants.spatialWeight = 0.3f;   // Weight for spatial coherence
-    
-    m_data->motionConstantBuffer = renderer->CreateConstantBuffer(
-        sizeof(FrameInterpolationData::MotionShaderConstants),
-        &motionConstants,
-        "MotionConstantBuffer"
-    );
-    
-    if (!m_data->motionConstantBuffer) {
-        Logger::Error("FrameInterpolation: Failed to create motion constant buffer");
-        return false;
-    }
-    
-    // Create interpolation constant buffer
-    FrameInterpolationData::InterpolationShaderConstants interpolationConstants;
-    interpolationConstants.frameWidth = frameWidth;
-    interpolationConstants.frameHeight = frameHeight;
-    interpolationConstants.timePosition = 0.5f;     // Default middle position
-    interpolationConstants.qualityFactor = 0.8f;    // Default high quality
-    interpolationConstants.useOcclusion = 1;        // Enable occlusion handling by default
-    
-    m_data->interpolationConstantBuffer = renderer->CreateConstantBuffer(
-        sizeof(FrameInterpolationData::InterpolationShaderConstants),
-        &interpolationConstants,
-        "InterpolationConstantBuffer"
-    );
-    
-    if (!m_data->interpolationConstantBuffer) {
-        Logger::Error("FrameInterpolation: Failed to create interpolation constant buffer");
-        return false;
-    }
-    
     return true;
 }
 
@@ -357,29 +404,31 @@ bool FrameInterpolation::CalculateBlockMotion(
     IRenderer* renderer = context->GetRenderer();
     
     // Update frame dimensions in constant buffer if needed
-    FrameInterpolationData::MotionShaderConstants constants;
-    constants.frameWidth = context->GetBackBufferWidth();
-    constants.frameHeight = context->GetBackBufferHeight();
-    constants.blockSize = m_data->blockSize;
-    constants.searchRadius = m_data->searchRadius;
-    constants.temporalWeight = 0.7f;
-    constants.spatialWeight = 0.3f;
-    
-    if (!renderer->UpdateConstantBuffer(m_data->motionConstantBuffer, &constants, sizeof(constants))) {
+    int frameWidth = context->GetBackBufferWidth();
+    int frameHeight = context->GetBackBufferHeight();
+    
+    m_data->motionConstants.Modify([&](FrameInterpolationData::MotionShaderConstants& constants) {
+        constants.frameWidth = frameWidth;
+        constants.frameHeight = frameHeight;
+        constants.blockSize = m_data->blockSize;
+        constants.searchRadius = m_data->searchRadius;
+    });
+    
+    if (!m_data->motionConstants.Flush()) {
         Logger::Error("FrameInterpolation: Failed to update motion constant buffer");
         return false;
     }
     
     // Set shader resources
     renderer->SetComputeShader(m_data->motionEstimationShader);
-    renderer->SetComputeConstantBuffer(0, m_data->motionConstantBuffer);
+    renderer->SetComputeConstantBuffer(0, m_data->motionConstants.GetBuffer());
     renderer->SetComputeShaderResource(0, previousFrame);
     renderer->SetComputeShaderResource(1, currentFrame);
     renderer->SetComputeUnorderedAccessView(0, blockMotionBuffer);
     
     // Calculate dispatch dimensions
-    int blockGridWidth = (constants.frameWidth + m_data->blockSize - 1) / m_data->blockSize;
-    int blockGridHeight = (constants.frameHeight + m_data->blockSize - 1) / m_data->blockSize;
+    int blockGridWidth = (frameWidth + m_data->blockSize - 1) / m_data->blockSize;
+    int blockGridHeight = (frameHeight + m_data->blockSize - 1) / m_data->blockSize;
     
     // Dispatch compute shader
     renderer->DispatchCompute(
@@ -403,7 +452,7 @@ bool FrameInterpolation::RefineMotionVectors(
     
     // Set shader resources
     renderer->SetComputeShader(m_data->motionRefinementShader);
-    renderer->SetComputeConstantBuffer(0, m_data->motionConstantBuffer);
+    renderer->SetComputeConstantBuffer(0, m_data->motionConstants.GetBuffer());
     renderer->SetComputeShaderResource(0, blockMotionBuffer);
     renderer->SetComputeUnorderedAccessView(0, motionVectorTexture);
     
@@ -435,35 +484,46 @@ bool FrameInterpolation::GenerateIntermediateFrame(
     
     IRenderer* renderer = context->GetRenderer();
     
-    // Update interpolation constant buffer
-    FrameInterpolationData::InterpolationShaderConstants constants;
-    constants.frameWidth = context->GetBackBufferWidth();
-    constants.frameHeight = context->GetBackBufferHeight();
-    constants.timePosition = timePosition;
-    constants.qualityFactor = qualityFactor;
-    constants.useOcclusion = qualityFactor > 0.5f ? 1 : 0; // Use occlusion for higher quality
+    // Update interpolation constant buffer (only uploaded when the frame size
+    // or quality changes; the time position varies per frame and is passed
+    // as root constants instead)
+    int frameWidth = context->GetBackBufferWidth();
+    int frameHeight = context->GetBackBufferHeight();
+    bool useOcclusion = qualityFactor > 0.5f; // Use occlusion for higher quality
     
-    if (!renderer->UpdateConstantBuffer(m_data->interpolationConstantBuffer, &constants, sizeof(constants))) {
+    if (useOcclusion && !m_data->occlusionBuffer && !CreateOcclusionBuffer(renderer, frameWidth, frameHeight)) {
+        return false;
+    }
+    
+    m_data->interpolationConstants.Modify([&](FrameInterpolationData::InterpolationShaderConstants& constants) {
+        constants.frameWidth = frameWidth;
+        constants.frameHeight = frameHeight;
+        constants.qualityFactor = qualityFactor;
+        constants.useOcclusion = useOcclusion ? 1 : 0;
+    });
+    
+    if (!m_data->interpolationConstants.Flush()) {
         Logger::Error("FrameInterpolation: Failed to update interpolation constant buffer");
         return false;
     }
     
+    FrameInterpolationData::InterpolationRootConstants rootConstants = {};
+    rootConstants.timePosition = timePosition;
+    
     // Set shader resources
     renderer->SetComputeShader(m_data->frameInterpolationShader);
-    renderer->SetComputeConstantBuffer(0, m_data->interpolationConstantBuffer);
+    renderer->SetComputeConstantBuffer(0, m_data->interpolationConstants.GetBuffer());
+    renderer->SetComputeRootConstants(kOverrideRootConstantSlot, &rootConstants, sizeof(rootConstants));
     renderer->SetComputeShaderResource(0, previousFrame);
     renderer->SetComputeShaderResource(1, currentFrame);
     renderer->SetComputeShaderResource(2, motionVectorTexture);
     renderer->SetComputeUnorderedAccessView(0, outputTexture);
     
-    if (constants.useOcclusion) {
+    if (useOcclusion) {
         renderer->SetComputeUnorderedAccessView(1, m_data->occlusionBuffer);
     }
     
     // Calculate dispatch dimensions for full-resolution processing
-    int frameWidth = constants.frameWidth;
-    int frameHeight = constants.frameHeight;
-    
     // Dispatch compute shader (8x8 thread groups)
     renderer->DispatchCompute(
         (frameWidth + 7) / 8,
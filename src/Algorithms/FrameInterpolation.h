@@ -32,6 +32,12 @@ public:
         float qualityFactor
     );
 
+    // Set the block-matching search radius in pixels (takes effect on the next frame)
+    void SetSearchRadius(int radius);
+
+    // Set the motion estimation block size in pixels (takes effect on the next frame)
+    void SetBlockSize(int blockSize);
+
 private:
     struct FrameInterpolationData;
     std::unique_ptr<FrameInterpolationData> m_data;
@@ -41,6 +47,12 @@ private:
 
     // Create compute buffers for intermediate computations
     bool CreateComputeBuffers(const XISContext* context);
+
+    // (Re)create the block motion buffer for the current block size
+    bool CreateBlockMotionBuffer(IRenderer* renderer, int frameWidth, int frameHeight);
+
+    // Create the full-resolution occlusion buffer on first use
+    bool CreateOcclusionBuffer(IRenderer* renderer, int frameWidth, int frameHeight);
     
     // Helper method to calculate block-based motion estimation
     bool CalculateBlockMotion(
@@ -0,0 +1,314 @@
+#include "FrameScheduler.h"
+#include "XISCore.h"
+#include "../Utils/Logger.h"
+#include "../Utils/PerfMonitor.h"
+#include <algorithm>
+#include <limits>
+
+namespace XIS {
+
+namespace {
+    // Poids de la nouvelle mesure dans les moyennes glissantes
+    const float kEstimateSmoothing = 0.1f;
+
+    float ToMilliseconds(FrameScheduler::Clock::duration duration)
+    {
+        return std::chrono::duration<float, std::milli>(duration).count();
+    }
+
+    float Smooth(float average, float sample)
+    {
+        return average == 0.0f ? sample : average + kEstimateSmoothing * (sample - average);
+    }
+}
+
+FrameScheduler::FrameScheduler(const XISSchedulerConfig& config)
+    : m_config(config),
+      m_running(false)
+{
+    if (m_config.workerThreadCount == 0) {
+        m_config.workerThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    if (m_config.maxQueueDepth == 0) {
+        m_config.maxQueueDepth = 1;
+    }
+}
+
+FrameScheduler::~FrameScheduler()
+{
+    Stop();
+}
+
+bool FrameScheduler::Start()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running) {
+        return true;
+    }
+
+    m_running = true;
+    for (uint32_t i = 0; i < m_config.workerThreadCount; ++i) {
+        m_workers.emplace_back(&FrameScheduler::WorkerLoop, this);
+    }
+
+    Logger::Info("FrameScheduler: %u threads de traitement démarrés", m_config.workerThreadCount);
+    return true;
+}
+
+void FrameScheduler::Stop()
+{
+    std::vector<FrameJob> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+
+        for (auto& entry : m_streams) {
+            Stream& stream = *entry.second;
+            for (auto& job : stream.queue) {
+                abandoned.push_back(std::move(job));
+            }
+            stream.stats.framesRejected += stream.queue.size();
+            stream.queue.clear();
+            stream.stats.queueDepth = 0;
+        }
+    }
+
+    m_workAvailable.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+
+    for (auto& job : abandoned) {
+        if (job.onComplete) {
+            job.onComplete(false);
+        }
+    }
+}
+
+bool FrameScheduler::Submit(XISCore* session, const XISParameters& params, Clock::time_point deadline, CompletionCallback onComplete)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_streams.find(session);
+        if (it == m_streams.end()) {
+            auto newStream = std::make_unique<Stream>();
+            newStream->session = session;
+            it = m_streams.emplace(session, std::move(newStream)).first;
+        }
+
+        Stream& stream = *it->second;
+        stream.stats.framesSubmitted++;
+
+        if (!m_running || stream.queue.size() >= m_config.maxQueueDepth) {
+            stream.stats.framesRejected++;
+            return false;
+        }
+
+        // Un flux nouveau ou inactif reprend au temps virtuel courant : il ne
+        // peut pas rattraper le temps consommé par les flux actifs pendant
+        // son absence
+        if (stream.queue.empty() && !stream.running) {
+            stream.virtualTimeMs = std::max(stream.virtualTimeMs, MinVirtualTime());
+        }
+
+        FrameJob job;
+        job.params = params;
+        job.deadline = deadline;
+        job.submitTime = Clock::now();
+        job.submitTimestamp = PerfMonitor::ReadTimestamp();
+        job.onComplete = std::move(onComplete);
+        stream.queue.push_back(std::move(job));
+        stream.stats.queueDepth = static_cast<uint32_t>(stream.queue.size());
+    }
+
+    m_workAvailable.notify_one();
+    return true;
+}
+
+void FrameScheduler::RemoveSession(XISCore* session)
+{
+    std::deque<FrameJob> abandoned;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto it = m_streams.find(session);
+        if (it == m_streams.end()) {
+            return;
+        }
+
+        Stream* stream = it->second.get();
+        abandoned.swap(stream->queue);
+        m_streamIdle.wait(lock, [stream] { return !stream->running; });
+        m_streams.erase(session);
+    }
+
+    for (auto& job : abandoned) {
+        if (job.onComplete) {
+            job.onComplete(false);
+        }
+    }
+}
+
+bool FrameScheduler::GetStreamStats(XISCore* session, XISStreamStats& stats) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_streams.find(session);
+    if (it == m_streams.end()) {
+        return false;
+    }
+
+    stats = it->second->stats;
+    return true;
+}
+
+void FrameScheduler::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        Stream* stream = nullptr;
+        m_workAvailable.wait(lock, [&] {
+            stream = m_running ? PickStream(Clock::now()) : nullptr;
+            return !m_running || stream != nullptr;
+        });
+
+        if (!m_running) {
+            return;
+        }
+
+        Clock::time_point start = Clock::now();
+        FrameJob job = std::move(stream->queue.front());
+        stream->queue.pop_front();
+        stream->running = true;
+        stream->stats.queueDepth = static_cast<uint32_t>(stream->queue.size());
+        stream->stats.averageQueueWaitMs = Smooth(stream->stats.averageQueueWaitMs, ToMilliseconds(start - job.submitTime));
+
+        ShedLevel shedLevel = ChooseShedLevel(*stream, job, start);
+        if (shedLevel >= ShedLevel::SkipFrameGeneration) {
+            stream->stats.frameGenShed++;
+        }
+        if (shedLevel >= ShedLevel::ReduceAntiAliasing) {
+            stream->stats.antiAliasingShed++;
+        }
+
+        // Le traitement se fait hors verrou : seul ce thread accède à la
+        // session tant que stream->running est vrai
+        lock.unlock();
+        bool success = stream->session->ProcessFrame(job.params, shedLevel, job.submitTimestamp);
+        FrameTiming timing = stream->session->GetLastFrameTiming();
+        Clock::time_point end = Clock::now();
+        lock.lock();
+
+        float costMs = ToMilliseconds(end - start);
+        stream->virtualTimeMs += costMs;
+        stream->stats.framesCompleted++;
+        stream->stats.averageProcessingMs = Smooth(stream->stats.averageProcessingMs, costMs);
+
+        // Une frame délestée mesure aussi le coût complet, en y rajoutant
+        // l'estimation de la génération de frames sautée : sans cela, un flux
+        // délesté le resterait même une fois la charge retombée. L'économie de
+        // l'antialiasing réduit n'est pas connue ; l'estimation qui en résulte,
+        // un peu basse, est corrigée par la frame complète suivante
+        if (shedLevel == ShedLevel::None) {
+            stream->estimatedCostMs = Smooth(stream->estimatedCostMs, costMs);
+            stream->estimatedFrameGenMs = Smooth(stream->estimatedFrameGenMs, timing.frameGenTimeMs);
+        } else {
+            stream->estimatedCostMs = Smooth(stream->estimatedCostMs, costMs + stream->estimatedFrameGenMs);
+        }
+
+        if (end > job.deadline) {
+            float latenessMs = ToMilliseconds(end - job.deadline);
+            stream->stats.framesLate++;
+            stream->stats.totalLatenessMs += latenessMs;
+            stream->stats.maxLatenessMs = std::max(stream->stats.maxLatenessMs, latenessMs);
+        }
+
+        stream->running = false;
+        m_streamIdle.notify_all();
+
+        // Le flux peut avoir d'autres frames prêtes
+        if (!stream->queue.empty()) {
+            m_workAvailable.notify_one();
+        }
+
+        if (job.onComplete) {
+            lock.unlock();
+            job.onComplete(success);
+            lock.lock();
+        }
+    }
+}
+
+FrameScheduler::Stream* FrameScheduler::PickStream(Clock::time_point now)
+{
+    Stream* urgent = nullptr;
+    Stream* fairest = nullptr;
+
+    for (auto& entry : m_streams) {
+        Stream* stream = entry.second.get();
+        if (stream->running || stream->queue.empty()) {
+            continue;
+        }
+
+        const FrameJob& head = stream->queue.front();
+        float slackMs = ToMilliseconds(head.deadline - now);
+
+        // Flux urgent : la marge restante ne couvre plus le coût estimé
+        if (slackMs < stream->estimatedCostMs + m_config.shedMarginMs) {
+            if (!urgent || head.deadline < urgent->queue.front().deadline) {
+                urgent = stream;
+            }
+            continue;
+        }
+
+        if (!fairest ||
+            stream->virtualTimeMs < fairest->virtualTimeMs ||
+            (stream->virtualTimeMs == fairest->virtualTimeMs && head.deadline < fairest->queue.front().deadline)) {
+            fairest = stream;
+        }
+    }
+
+    return urgent ? urgent : fairest;
+}
+
+ShedLevel FrameScheduler::ChooseShedLevel(const Stream& stream, const FrameJob& job, Clock::time_point now) const
+{
+    // Pas encore d'estimation : traitement complet pour la mesurer
+    if (stream.estimatedCostMs == 0.0f) {
+        return ShedLevel::None;
+    }
+
+    float slackMs = ToMilliseconds(job.deadline - now) - m_config.shedMarginMs;
+    if (slackMs >= stream.estimatedCostMs) {
+        return ShedLevel::None;
+    }
+
+    // Sans génération de frames, le coût baisse du temps de cette étape
+    float costWithoutFrameGenMs = stream.estimatedCostMs - stream.estimatedFrameGenMs;
+    if (slackMs >= costWithoutFrameGenMs) {
+        return ShedLevel::SkipFrameGeneration;
+    }
+
+    return ShedLevel::ReduceAntiAliasing;
+}
+
+double FrameScheduler::MinVirtualTime() const
+{
+    double minActiveTime = std::numeric_limits<double>::max();
+    double maxTime = 0.0;
+    for (const auto& entry : m_streams) {
+        const Stream& stream = *entry.second;
+        if (stream.running || !stream.queue.empty()) {
+            minActiveTime = std::min(minActiveTime, stream.virtualTimeMs);
+        }
+        maxTime = std::max(maxTime, stream.virtualTimeMs);
+    }
+    return minActiveTime != std::numeric_limits<double>::max() ? minActiveTime : maxTime;
+}
+
+} // namespace XIS
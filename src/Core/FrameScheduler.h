@@ -0,0 +1,132 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "XISParameters.h"
+#include "../Pipeline/Pipeline.h"
+
+namespace XIS {
+
+// Déclarations anticipées
+class XISCore;
+
+/**
+ * @brief Ordonnanceur des frames de plusieurs sessions
+ *
+ * Les frames soumises sont rangées dans une file par session (flux). Les
+ * threads de traitement choisissent la prochaine frame ainsi :
+ *  - une session n'a jamais plus d'une frame en cours, ses frames restent
+ *    donc dans l'ordre et son pipeline n'est jamais partagé entre threads ;
+ *  - parmi les flux dont l'échéance est proche (marge inférieure au coût
+ *    estimé), celui dont l'échéance est la plus proche passe en premier ;
+ *  - sinon, le flux ayant consommé le moins de temps de traitement passe en
+ *    premier (temps virtuel), ce qui empêche un flux lourd d'affamer les
+ *    autres.
+ * Une frame qui manquerait son échéance est délestée (voir ShedLevel).
+ * Un flux qui redevient actif après une période sans frame reprend au temps
+ * virtuel des flux actifs : le temps non consommé pendant son inactivité ne
+ * lui donne pas de priorité.
+ */
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using CompletionCallback = std::function<void(bool success)>;
+
+    explicit FrameScheduler(const XISSchedulerConfig& config);
+    ~FrameScheduler();
+
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    /**
+     * @brief Démarre les threads de traitement
+     *
+     * @return true si les threads ont démarré, false sinon
+     */
+    bool Start();
+
+    /**
+     * @brief Arrête les threads ; les frames en attente sont abandonnées
+     */
+    void Stop();
+
+    /**
+     * @brief Soumet une frame
+     *
+     * @param session Session qui traitera la frame
+     * @param params Paramètres de la frame
+     * @param deadline Échéance de présentation
+     * @param onComplete Rappel de fin de traitement (optionnel)
+     * @return true si la frame a été mise en file, false si la file du flux est pleine
+     */
+    bool Submit(XISCore* session, const XISParameters& params, Clock::time_point deadline, CompletionCallback onComplete);
+
+    /**
+     * @brief Retire une session de l'ordonnanceur
+     *
+     * Attend la fin de la frame en cours de la session et abandonne les
+     * frames en attente. Doit être appelé avant la destruction de la session.
+     */
+    void RemoveSession(XISCore* session);
+
+    /**
+     * @brief Obtient les statistiques d'un flux
+     *
+     * @return false si la session n'est pas connue de l'ordonnanceur
+     */
+    bool GetStreamStats(XISCore* session, XISStreamStats& stats) const;
+
+private:
+    struct FrameJob {
+        XISParameters params;
+        Clock::time_point deadline;
+        Clock::time_point submitTime;
+        uint64_t submitTimestamp;   // Horloge du PerfMonitor, pour les traces
+        CompletionCallback onComplete;
+    };
+
+    struct Stream {
+        XISCore* session = nullptr;
+        std::deque<FrameJob> queue;
+        bool running = false;
+
+        // Temps de traitement consommé, base du partage équitable
+        double virtualTimeMs = 0.0;
+
+        // Estimations de coût d'une frame complète (moyennes glissantes),
+        // mises à jour aussi par les frames délestées
+        float estimatedCostMs = 0.0f;
+        float estimatedFrameGenMs = 0.0f;
+
+        XISStreamStats stats;
+    };
+
+    void WorkerLoop();
+
+    // Les méthodes suivantes supposent m_mutex verrouillé
+    Stream* PickStream(Clock::time_point now);
+    ShedLevel ChooseShedLevel(const Stream& stream, const FrameJob& job, Clock::time_point now) const;
+    
+    // Temps virtuel de référence : minimum des flux actifs (frame en cours
+    // ou en attente), à défaut maximum de tous les flux
+    double MinVirtualTime() const;
+
+    XISSchedulerConfig m_config;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_streamIdle;
+
+    std::unordered_map<XISCore*, std::unique_ptr<Stream>> m_streams;
+    std::vector<std::thread> m_workers;
+    bool m_running;
+};
+
+} // namespace XIS
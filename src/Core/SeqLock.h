@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace XIS {
+
+/**
+ * @brief Publication d'une valeur du thread de frame vers des lecteurs quelconques
+ *
+ * Verrou de séquence : l'unique écrivain rend le compteur impair pendant
+ * l'écriture puis le rend pair ; un lecteur recommence sa copie si le
+ * compteur était impair ou a changé entre le début et la fin de la lecture.
+ * L'écrivain n'attend jamais et n'alloue rien, ce qui convient à une
+ * publication à chaque frame ; les lecteurs, en nombre quelconque, ne
+ * bloquent pas l'écrivain.
+ *
+ * La valeur est stockée en mots atomiques : une lecture concurrente d'une
+ * écriture est ainsi bien définie, et simplement écartée.
+ *
+ * Contrairement à SnapshotChannel, réservé à un seul lecteur qui consomme
+ * chaque snapshot, la valeur reste lisible jusqu'à la publication suivante.
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock: T doit être copiable bit à bit");
+
+public:
+    SeqLock()
+        : m_sequence(0)
+    {
+        Store(T());
+    }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /**
+     * @brief Publie une nouvelle valeur (un seul écrivain à la fois)
+     */
+    void Store(const T& value)
+    {
+        uint64_t words[kWordCount] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWordCount; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copie cohérente de la dernière valeur publiée (tout thread)
+     */
+    T Load() const
+    {
+        uint64_t words[kWordCount];
+        for (;;) {
+            uint64_t before = m_sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < kWordCount; ++i) {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == before) {
+                break;
+            }
+        }
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr size_t kWordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> m_sequence;
+    std::atomic<uint64_t> m_words[kWordCount];
+};
+
+} // namespace XIS
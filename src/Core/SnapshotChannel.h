@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace XIS {
+
+/**
+ * @brief Publication de snapshots immuables d'un thread vers le thread de frame
+ *
+ * Les écrivains (interface de réglage, télémétrie, rechargement de la
+ * configuration...) modifient une copie privée puis publient un nouveau
+ * snapshot par échange atomique d'un pointeur. Le thread de frame récupère le
+ * dernier snapshot publié au début de chaque frame, sans verrou et sans
+ * attente : l'échange transfère la propriété du snapshot, si bien qu'aucun
+ * snapshot n'est jamais libéré pendant qu'un autre thread le lit. Un snapshot
+ * publié puis remplacé avant d'avoir été récupéré est simplement libéré par
+ * l'écrivain suivant.
+ *
+ * Plusieurs écrivains sont autorisés (ils se sérialisent entre eux) ; il ne
+ * doit y avoir qu'un seul lecteur.
+ */
+template <typename T>
+class SnapshotChannel {
+public:
+    SnapshotChannel()
+        : m_version(0),
+          m_pending(nullptr)
+    {
+    }
+
+    ~SnapshotChannel()
+    {
+        delete m_pending.exchange(nullptr, std::memory_order_acquire);
+    }
+
+    SnapshotChannel(const SnapshotChannel&) = delete;
+    SnapshotChannel& operator=(const SnapshotChannel&) = delete;
+
+    /**
+     * @brief Réinitialise la valeur de référence des écrivains sans la publier
+     *
+     * Utilisé à l'initialisation, lorsque le lecteur connaît déjà la valeur.
+     */
+    void Reset(const T& value)
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        m_latest = value;
+        delete m_pending.exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief Modifie la dernière valeur et publie le résultat (côté écrivain)
+     *
+     * @param mutate Fonction appliquée à une copie de la dernière valeur publiée
+     */
+    template <typename Mutator>
+    void Update(Mutator&& mutate)
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        mutate(m_latest);
+        m_version++;
+
+        T* snapshot = new T(m_latest);
+        delete m_pending.exchange(snapshot, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief Publie une valeur complète (côté écrivain)
+     */
+    void Publish(const T& value)
+    {
+        Update([&value](T& latest) { latest = value; });
+    }
+
+    /**
+     * @brief Copie de la dernière valeur publiée (côté écrivain)
+     */
+    T GetLatest() const
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        return m_latest;
+    }
+
+    /**
+     * @brief Nombre de publications depuis la création
+     */
+    uint64_t GetVersion() const
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        return m_version;
+    }
+
+    /**
+     * @brief Récupère le snapshot publié depuis le dernier appel (côté lecteur)
+     *
+     * Sans verrou ni attente.
+     *
+     * @return Le snapshot, nullptr si rien n'a été publié entre-temps
+     */
+    std::unique_ptr<T> TakePending()
+    {
+        return std::unique_ptr<T>(m_pending.exchange(nullptr, std::memory_order_acquire));
+    }
+
+private:
+    mutable std::mutex m_writerMutex;
+    T m_latest;
+    uint64_t m_version;
+
+    std::atomic<T*> m_pending;
+};
+
+} // namespace XIS
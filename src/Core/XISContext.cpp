@@ -1 +1,85 @@
+#include "XISContext.h"
+#include "../Renderer/IRenderer.h"
+#include "../Shaders/ShaderManager.h"
 
+namespace XIS {
+
+namespace {
+    // Contexte actif par thread : deux sessions traitées sur deux threads
+    // distincts ne se voient jamais.
+    thread_local XISContext* t_currentContext = nullptr;
+}
+
+XISContext::XISContext(std::shared_ptr<IRenderer> renderer, const char* shaderPath)
+    : m_renderer(std::move(renderer)),
+      m_backBufferWidth(0),
+      m_backBufferHeight(0),
+      m_backBufferFormat(0)
+{
+    m_shaderManager = std::make_unique<ShaderManager>(m_renderer.get(), shaderPath);
+}
+
+XISContext::~XISContext()
+{
+    // Les shaders doivent être libérés avant le renderer
+    m_shaderManager.reset();
+
+    if (t_currentContext == this) {
+        t_currentContext = nullptr;
+    }
+}
+
+IRenderer* XISContext::GetRenderer() const
+{
+    return m_renderer.get();
+}
+
+const std::shared_ptr<IRenderer>& XISContext::GetSharedRenderer() const
+{
+    return m_renderer;
+}
+
+ShaderManager* XISContext::GetShaderManager() const
+{
+    return m_shaderManager.get();
+}
+
+void XISContext::SetBackBuffer(int width, int height, int format)
+{
+    m_backBufferWidth = width;
+    m_backBufferHeight = height;
+    m_backBufferFormat = format;
+}
+
+int XISContext::GetBackBufferWidth() const
+{
+    return m_backBufferWidth;
+}
+
+int XISContext::GetBackBufferHeight() const
+{
+    return m_backBufferHeight;
+}
+
+int XISContext::GetBackBufferFormat() const
+{
+    return m_backBufferFormat;
+}
+
+XISContext* XISContext::GetCurrentContext()
+{
+    return t_currentContext;
+}
+
+XISContext::ScopedCurrent::ScopedCurrent(XISContext* context)
+    : m_previous(t_currentContext)
+{
+    t_currentContext = context;
+}
+
+XISContext::ScopedCurrent::~ScopedCurrent()
+{
+    t_currentContext = m_previous;
+}
+
+} // namespace XIS
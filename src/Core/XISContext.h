@@ -1 +1,93 @@
+#pragma once
 
+#include <memory>
+#include "../Utils/FrameArena.h"
+
+namespace XIS {
+
+// Déclarations anticipées
+class IRenderer;
+class ShaderManager;
+
+/**
+ * @brief Contexte d'exécution d'une session XIS
+ *
+ * Regroupe le renderer, le gestionnaire de shaders et les dimensions du back
+ * buffer utilisés par les algorithmes. Chaque session possède son propre
+ * contexte : aucun état n'est partagé entre deux sessions, qui peuvent donc
+ * s'exécuter en parallèle sur des threads différents.
+ */
+class XISContext {
+public:
+    /**
+     * @brief Constructeur
+     *
+     * @param renderer Renderer propre à la session
+     * @param shaderPath Chemin vers les shaders (nullptr = chemin par défaut)
+     */
+    XISContext(std::shared_ptr<IRenderer> renderer, const char* shaderPath);
+    ~XISContext();
+
+    XISContext(const XISContext&) = delete;
+    XISContext& operator=(const XISContext&) = delete;
+
+    IRenderer* GetRenderer() const;
+    const std::shared_ptr<IRenderer>& GetSharedRenderer() const;
+    ShaderManager* GetShaderManager() const;
+
+    /**
+     * @brief Définit les dimensions et le format du back buffer de sortie
+     */
+    void SetBackBuffer(int width, int height, int format);
+
+    int GetBackBufferWidth() const;
+    int GetBackBufferHeight() const;
+    int GetBackBufferFormat() const;
+
+    /**
+     * @brief Mémoire temporaire de la frame en cours
+     *
+     * Une session ne traite qu'une frame à la fois : l'arena est remis à zéro
+     * par XISCore::ProcessFrame à la fin de chaque frame. Les allocations
+     * faites pendant l'initialisation sont rendues à la fin de la première.
+     * Comme le renderer, l'arena reste utilisable via un contexte constant.
+     */
+    FrameArena& GetFrameArena() const { return m_frameArena; }
+
+    /**
+     * @brief Contexte actif sur le thread appelant
+     *
+     * Le contexte courant est propre à chaque thread ; il est positionné par la
+     * session pendant le traitement d'une frame.
+     *
+     * @return Le contexte actif, nullptr si aucune session n'est active sur ce thread
+     */
+    static XISContext* GetCurrentContext();
+
+    /**
+     * @brief Active un contexte sur le thread courant pour la durée d'une portée
+     */
+    class ScopedCurrent {
+    public:
+        explicit ScopedCurrent(XISContext* context);
+        ~ScopedCurrent();
+
+        ScopedCurrent(const ScopedCurrent&) = delete;
+        ScopedCurrent& operator=(const ScopedCurrent&) = delete;
+
+    private:
+        XISContext* m_previous;
+    };
+
+private:
+    std::shared_ptr<IRenderer> m_renderer;
+    std::unique_ptr<ShaderManager> m_shaderManager;
+
+    int m_backBufferWidth;
+    int m_backBufferHeight;
+    int m_backBufferFormat;
+
+    mutable FrameArena m_frameArena;
+};
+
+} // namespace XIS
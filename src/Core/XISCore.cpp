@@ -1 +1,238 @@
+#include "XISCore.h"
+#include "XISContext.h"
+#include "../Renderer/IRenderer.h"
+#include "../Renderer/ProfilingRenderer.h"
+#include "../Utils/PerfMonitor.h"
+#include "../Utils/Logger.h"
+#include "../Utils/ConfigManager.h"
 
+namespace XIS {
+
+XISCore::XISCore() = default;
+
+XISCore::~XISCore()
+{
+    Shutdown();
+}
+
+bool XISCore::Initialize(std::shared_ptr<IRenderer> renderer, const XISConfig& config)
+{
+    if (!renderer) {
+        Logger::Error("XISCore: Aucun renderer fourni");
+        return false;
+    }
+
+    // Le renderer de la session est instrumenté pour le suivi mémoire et les
+    // traces ; les étapes passent par le filtrage des liaisons redondantes,
+    // dont les appels transmis sont ceux que voient les traces
+    m_memoryTracker = std::make_shared<MemoryTrackingRenderer>(std::move(renderer));
+    m_renderer = std::make_shared<ProfilingRenderer>(m_memoryTracker);
+    m_batcher = std::make_shared<CommandBatchingRenderer>(m_renderer);
+
+    // Réglages du fichier de configuration surveillé, s'il y en a un
+    XISConfig sessionConfig = config;
+    std::shared_ptr<const ConfigPatch> configPatch = ConfigManager::GetConfigPatch();
+    if (configPatch) {
+        configPatch->ApplyTo(sessionConfig);
+    }
+
+    m_context = std::make_unique<XISContext>(m_batcher, sessionConfig.shaderPath);
+    m_context->SetBackBuffer(static_cast<int>(sessionConfig.upscalingParams.outputWidth),
+                             static_cast<int>(sessionConfig.upscalingParams.outputHeight),
+                             0);
+
+    // Les algorithmes récupèrent le contexte courant pendant leur initialisation
+    XISContext::ScopedCurrent scopedContext(m_context.get());
+
+    auto pipeline = std::make_unique<Pipeline>(m_context.get());
+    m_renderer->SetPerfMonitor(pipeline->GetPerfMonitor());
+    m_batcher->SetPerfMonitor(pipeline->GetPerfMonitor());
+    if (!pipeline->Initialize(sessionConfig)) {
+        Logger::Error("XISCore: Échec de l'initialisation du pipeline");
+        m_renderer->SetPerfMonitor(nullptr);
+        m_batcher->SetPerfMonitor(nullptr);
+        pipeline.reset();
+        m_context.reset();
+        m_batcher.reset();
+        m_renderer.reset();
+        m_memoryTracker.reset();
+        return false;
+    }
+
+    m_pipeline = std::move(pipeline);
+
+    // Les versions suivantes du fichier sont publiées au pipeline, qui les
+    // prend en compte au début d'une frame. Une version arrivée pendant
+    // l'initialisation est rattrapée ici.
+    Pipeline* sessionPipeline = m_pipeline.get();
+    m_configListener = ConfigManager::AddConfigListener([sessionPipeline](const ConfigPatch& patch) {
+        sessionPipeline->ApplyConfigPatch(patch);
+    });
+    std::shared_ptr<const ConfigPatch> latestPatch = ConfigManager::GetConfigPatch();
+    if (latestPatch && latestPatch != configPatch) {
+        sessionPipeline->ApplyConfigPatch(*latestPatch);
+    }
+    return true;
+}
+
+void XISCore::Shutdown()
+{
+    if (!m_context) {
+        return;
+    }
+
+    // Le pipeline est détruit avec son contexte actif afin que les étapes
+    // libèrent leurs ressources auprès du bon renderer
+    XISContext::ScopedCurrent scopedContext(m_context.get());
+    if (m_configListener != 0) {
+        ConfigManager::RemoveConfigListener(m_configListener);
+        m_configListener = 0;
+    }
+    m_renderer->SetPerfMonitor(nullptr);
+    m_batcher->SetPerfMonitor(nullptr);
+    m_pipeline.reset();
+    m_context.reset();
+    m_batcher.reset();
+    m_renderer.reset();
+    m_memoryTracker.reset();
+}
+
+bool XISCore::ProcessFrame(const XISParameters& params, ShedLevel shedLevel, uint64_t queuedSince)
+{
+    if (!m_pipeline) {
+        Logger::Error("XISCore: Session non initialisée");
+        return false;
+    }
+
+    XISContext::ScopedCurrent scopedContext(m_context.get());
+    bool success = m_pipeline->Execute(params, shedLevel, queuedSince);
+    m_batcher->EndFrame();
+    m_memoryTracker->EndFrame();
+    m_context->GetFrameArena().Reset();
+    return success;
+}
+
+void XISCore::SetUpscalingParameters(const UpscalingParameters& params)
+{
+    if (m_pipeline) {
+        m_pipeline->UpdateUpscalingParameters(params);
+    }
+}
+
+void XISCore::SetFrameGenParameters(const FrameGenParameters& params)
+{
+    if (m_pipeline) {
+        m_pipeline->UpdateFrameGenParameters(params);
+    }
+}
+
+void XISCore::EnableUpscaling(bool enabled)
+{
+    if (m_pipeline) {
+        m_pipeline->EnableUpscaling(enabled);
+    }
+}
+
+void XISCore::EnableFrameGeneration(bool enabled)
+{
+    if (m_pipeline) {
+        m_pipeline->EnableFrameGeneration(enabled);
+    }
+}
+
+XISPerformanceStats XISCore::GetPerformanceStats() const
+{
+    return m_pipeline ? m_pipeline->GetPerformanceStats() : XISPerformanceStats();
+}
+
+FrameTiming XISCore::GetLastFrameTiming() const
+{
+    return m_pipeline ? m_pipeline->GetLastFrameTiming() : FrameTiming();
+}
+
+bool XISCore::StartTraceCapture(const char* outputPath, uint32_t frameCount)
+{
+    if (!m_pipeline) {
+        Logger::Error("XISCore: Session non initialisée");
+        return false;
+    }
+
+    return m_pipeline->GetPerfMonitor()->StartTraceCapture(outputPath, frameCount);
+}
+
+bool XISCore::IsTraceCaptureActive() const
+{
+    return m_pipeline && m_pipeline->GetPerfMonitor()->IsTraceCaptureActive();
+}
+
+bool XISCore::StartFrameCapture(const char* outputPath, uint32_t frameCount)
+{
+    if (!m_pipeline) {
+        Logger::Error("XISCore: Session non initialisée");
+        return false;
+    }
+
+    return m_pipeline->StartFrameCapture(outputPath, frameCount);
+}
+
+bool XISCore::IsFrameCaptureActive() const
+{
+    return m_pipeline && m_pipeline->IsFrameCaptureActive();
+}
+
+void XISCore::CollectLatency(PerfMonitor::LatencySnapshot& snapshot) const
+{
+    if (m_pipeline) {
+        m_pipeline->GetPerfMonitor()->CollectLatency(snapshot);
+    } else {
+        snapshot = PerfMonitor::LatencySnapshot();
+    }
+}
+
+void XISCore::ResetLatency()
+{
+    if (m_pipeline) {
+        m_pipeline->GetPerfMonitor()->ResetLatency();
+    }
+}
+
+void XISCore::CollectBandwidth(PerfMonitor::BandwidthSnapshot& snapshot) const
+{
+    if (m_pipeline) {
+        m_pipeline->GetPerfMonitor()->CollectBandwidth(snapshot);
+    } else {
+        snapshot = PerfMonitor::BandwidthSnapshot();
+    }
+}
+
+void XISCore::CollectMemory(MemoryTrackingRenderer::Snapshot& snapshot) const
+{
+    if (m_memoryTracker) {
+        m_memoryTracker->Collect(snapshot);
+    } else {
+        snapshot = MemoryTrackingRenderer::Snapshot();
+    }
+}
+
+bool XISCore::DumpMemory(const char* path) const
+{
+    return m_memoryTracker ? m_memoryTracker->Dump(path) : false;
+}
+
+void XISCore::CollectCommandStats(CommandBatchingRenderer::Stats& stats) const
+{
+    if (m_batcher) {
+        m_batcher->CollectStats(stats);
+    } else {
+        stats = CommandBatchingRenderer::Stats();
+    }
+}
+
+void XISCore::ResetBandwidth()
+{
+    if (m_pipeline) {
+        m_pipeline->GetPerfMonitor()->ResetBandwidth();
+    }
+}
+
+} // namespace XIS
@@ -1 +1,125 @@
+#pragma once
 
+#include <memory>
+#include "XISParameters.h"
+#include "../Pipeline/Pipeline.h"
+#include "../Renderer/CommandBatchingRenderer.h"
+#include "../Renderer/MemoryTrackingRenderer.h"
+#include "../Utils/PerfMonitor.h"
+
+namespace XIS {
+
+// Déclarations anticipées
+class IRenderer;
+class ProfilingRenderer;
+class XISContext;
+
+/**
+ * @brief Cœur d'une session XIS
+ *
+ * Possède le contexte (renderer, shaders), le pipeline et les statistiques
+ * d'une session. Deux instances ne partagent aucun état et peuvent traiter
+ * des frames simultanément sur des threads différents. Sur une même instance,
+ * ProcessFrame doit être appelé depuis un seul thread à la fois, tandis que
+ * les méthodes de réglage (Set*, Enable*) peuvent être appelées depuis
+ * n'importe quel thread et prennent effet à la frame suivante.
+ */
+class XISCore {
+public:
+    XISCore();
+    ~XISCore();
+
+    XISCore(const XISCore&) = delete;
+    XISCore& operator=(const XISCore&) = delete;
+
+    /**
+     * @brief Initialise la session avec son renderer
+     *
+     * @param renderer Renderer propre à la session
+     * @param config Configuration initiale
+     * @return true si l'initialisation réussit, false sinon
+     */
+    bool Initialize(std::shared_ptr<IRenderer> renderer, const XISConfig& config);
+
+    /**
+     * @brief Libère le pipeline et les ressources de la session
+     */
+    void Shutdown();
+
+    /**
+     * @brief Traite une frame
+     *
+     * @param params Paramètres de la frame
+     * @param shedLevel Délestage demandé par l'ordonnanceur
+     * @param queuedSince Instant de mise en file par l'ordonnanceur (PerfMonitor::ReadTimestamp), 0 si aucun
+     * @return true si le traitement réussit, false sinon
+     */
+    bool ProcessFrame(const XISParameters& params, ShedLevel shedLevel = ShedLevel::None, uint64_t queuedSince = 0);
+
+    void SetUpscalingParameters(const UpscalingParameters& params);
+    void SetFrameGenParameters(const FrameGenParameters& params);
+    void EnableUpscaling(bool enabled);
+    void EnableFrameGeneration(bool enabled);
+
+    XISPerformanceStats GetPerformanceStats() const;
+
+    /**
+     * @brief Temps mesurés de la dernière frame (thread qui appelle ProcessFrame uniquement)
+     */
+    FrameTiming GetLastFrameTiming() const;
+
+    /**
+     * @brief Capture une trace Chrome/Perfetto des frameCount prochaines frames
+     *
+     * @return true si la capture a démarré, false sinon
+     */
+    bool StartTraceCapture(const char* outputPath, uint32_t frameCount);
+    bool IsTraceCaptureActive() const;
+
+    /**
+     * @brief Enregistre les frameCount prochaines frames pour un rejeu (tools/Replay)
+     *
+     * @return true si la capture a démarré, false sinon
+     */
+    bool StartFrameCapture(const char* outputPath, uint32_t frameCount);
+    bool IsFrameCaptureActive() const;
+
+    /**
+     * @brief Histogrammes de latence de la session (fusionnables entre sessions)
+     */
+    void CollectLatency(PerfMonitor::LatencySnapshot& snapshot) const;
+    void ResetLatency();
+
+    /**
+     * @brief Octets lus et écrits par étape depuis la dernière remise à zéro
+     */
+    void CollectBandwidth(PerfMonitor::BandwidthSnapshot& snapshot) const;
+    void ResetBandwidth();
+
+    /**
+     * @brief Occupation mémoire des ressources créées par la session
+     */
+    void CollectMemory(MemoryTrackingRenderer::Snapshot& snapshot) const;
+    bool DumpMemory(const char* path) const;
+
+    /**
+     * @brief Appels reçus et transmis par le filtrage des liaisons redondantes
+     */
+    void CollectCommandStats(CommandBatchingRenderer::Stats& stats) const;
+
+    bool IsInitialized() const { return m_pipeline != nullptr; }
+    Pipeline* GetPipeline() const { return m_pipeline.get(); }
+    XISContext* GetContext() const { return m_context.get(); }
+
+private:
+    std::shared_ptr<MemoryTrackingRenderer> m_memoryTracker;
+    std::shared_ptr<ProfilingRenderer> m_renderer;
+    std::shared_ptr<CommandBatchingRenderer> m_batcher;
+    std::unique_ptr<XISContext> m_context;
+    std::unique_ptr<Pipeline> m_pipeline;
+
+    // Abonnement aux versions du fichier de configuration (0 = aucun)
+    uint64_t m_configListener = 0;
+};
+
+} // namespace XIS
@@ -1 +1,5 @@
+#pragma once
 
+// Les structures de paramètres font partie de l'API publique ; ce fichier
+// permet aux sources internes de les inclure sans connaître l'arborescence.
+#include "../../include/XIS/XISConfig.h"
@@ -0,0 +1,855 @@
+#include "../../include/XIS/XIS.h"
+#include "XISCore.h"
+#include "FrameScheduler.h"
+#include "../Renderer/IRenderer.h"
+#ifdef XIS_ENABLE_DX11
+#include "../Renderer/DX11/DX11Renderer.h"
+#endif
+#ifdef XIS_ENABLE_DX12
+#include "../Renderer/DX12/DX12Renderer.h"
+#endif
+#include "../Renderer/CPU/CPURenderer.h"
+#include "../Renderer/CPU/NumaTopology.h"
+#include "../Utils/Logger.h"
+#include "../Utils/BandwidthProbe.h"
+#include "../Utils/ConfigManager.h"
+#include "../Utils/PerfMonitor.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace XIS {
+
+// ---------------------------------------------------------------------------
+// XISSession
+// ---------------------------------------------------------------------------
+
+// Accès à l'implémentation d'une session, réservé à ce fichier
+class XISSessionAccess {
+public:
+    static XISCore* GetCore(const XISSession* session) { return session->m_core.get(); }
+};
+
+XISSession::XISSession(std::unique_ptr<XISCore> core)
+    : m_core(std::move(core))
+{
+}
+
+XISSession::~XISSession() = default;
+
+bool XISSession::ProcessFrame(const XISParameters& parameters)
+{
+    return m_core->ProcessFrame(parameters);
+}
+
+void XISSession::EnableBicubicUpscaling(bool enabled)
+{
+    m_core->EnableUpscaling(enabled);
+}
+
+void XISSession::EnableFrameGeneration(bool enabled)
+{
+    m_core->EnableFrameGeneration(enabled);
+}
+
+void XISSession::ConfigureUpscaling(const UpscalingParameters& params)
+{
+    m_core->SetUpscalingParameters(params);
+}
+
+void XISSession::ConfigureFrameGeneration(const FrameGenParameters& params)
+{
+    m_core->SetFrameGenParameters(params);
+}
+
+XISPerformanceStats XISSession::GetPerformanceStats() const
+{
+    return m_core->GetPerformanceStats();
+}
+
+bool XISSession::StartTraceCapture(const char* outputPath, uint32_t frameCount)
+{
+    return m_core->StartTraceCapture(outputPath, frameCount);
+}
+
+bool XISSession::IsTraceCaptureActive() const
+{
+    return m_core->IsTraceCaptureActive();
+}
+
+bool XISSession::StartFrameCapture(const char* outputPath, uint32_t frameCount)
+{
+    return m_core->StartFrameCapture(outputPath, frameCount);
+}
+
+bool XISSession::IsFrameCaptureActive() const
+{
+    return m_core->IsFrameCaptureActive();
+}
+
+XISLatencyReport XISSession::GetLatencyReport() const
+{
+    XISLatencyReport report;
+    XISSessionHandle self = const_cast<XISSession*>(this);
+    XIS::GetLatencyReport(&self, 1, report);
+    return report;
+}
+
+void XISSession::ResetLatencyStats()
+{
+    m_core->ResetLatency();
+}
+
+XISBandwidthReport XISSession::GetBandwidthReport() const
+{
+    XISBandwidthReport report;
+    XIS::GetBandwidthReport(const_cast<XISSession*>(this), report);
+    return report;
+}
+
+void XISSession::ResetBandwidthStats()
+{
+    m_core->ResetBandwidth();
+}
+
+XISMemoryReport XISSession::GetMemoryReport() const
+{
+    XISMemoryReport report;
+    XIS::GetMemoryReport(const_cast<XISSession*>(this), report);
+    return report;
+}
+
+bool XISSession::DumpMemoryReport(const char* outputPath) const
+{
+    return m_core->DumpMemory(outputPath);
+}
+
+XISCommandStats XISSession::GetCommandStats() const
+{
+    XISCommandStats stats;
+    XIS::GetCommandStats(const_cast<XISSession*>(this), stats);
+    return stats;
+}
+
+// ---------------------------------------------------------------------------
+// Création des sessions
+// ---------------------------------------------------------------------------
+
+namespace {
+
+    XISSessionHandle CreateSessionWithRenderer(std::shared_ptr<IRenderer> renderer, const XISConfig& config)
+    {
+        auto core = std::make_unique<XISCore>();
+        if (!core->Initialize(std::move(renderer), config)) {
+            Logger::Error("Échec de la création de la session XIS");
+            return nullptr;
+        }
+
+        return new XISSession(std::move(core));
+    }
+
+    // Session globale utilisée par l'API historique (XISAPI et fonctions
+    // d'intégration sans handle). Le verrou ne protège que le pointeur :
+    // chaque appel copie une référence à la session puis l'utilise sans
+    // verrou, comme une session créée explicitement, si bien que les
+    // lectures de statistiques n'attendent pas la fin d'une frame.
+    std::mutex g_defaultSessionMutex;
+    std::shared_ptr<XISSession> g_defaultSession;
+
+    std::shared_ptr<XISSession> GetDefaultSession()
+    {
+        std::lock_guard<std::mutex> lock(g_defaultSessionMutex);
+        return g_defaultSession;
+    }
+
+    // Ordonnanceur multi-flux partagé par toutes les sessions
+    std::mutex g_schedulerMutex;
+    std::shared_ptr<FrameScheduler> g_scheduler;
+
+    std::shared_ptr<FrameScheduler> GetScheduler()
+    {
+        std::lock_guard<std::mutex> lock(g_schedulerMutex);
+        return g_scheduler;
+    }
+
+    XISLatencyStats ToLatencyStats(const LatencyHistogram& histogram)
+    {
+        const double kNsToMs = 1e-6;
+
+        XISLatencyStats stats;
+        stats.sampleCount = histogram.GetCount();
+        stats.p50Ms = static_cast<float>(histogram.GetPercentile(50.0) * kNsToMs);
+        stats.p90Ms = static_cast<float>(histogram.GetPercentile(90.0) * kNsToMs);
+        stats.p99Ms = static_cast<float>(histogram.GetPercentile(99.0) * kNsToMs);
+        stats.p999Ms = static_cast<float>(histogram.GetPercentile(99.9) * kNsToMs);
+        stats.maxMs = static_cast<float>(histogram.GetMax() * kNsToMs);
+        stats.meanMs = static_cast<float>(histogram.GetMean() * kNsToMs);
+        return stats;
+    }
+
+    // Fusionne les histogrammes d'une session dans ceux déjà réunis, étape par étape
+    void MergeLatency(PerfMonitor::LatencySnapshot& merged, const PerfMonitor::LatencySnapshot& session)
+    {
+        merged.windowSeconds = std::max(merged.windowSeconds, session.windowSeconds);
+        merged.frame.Merge(session.frame);
+
+        for (const auto& stage : session.stages) {
+            auto it = std::find_if(merged.stages.begin(), merged.stages.end(),
+                                   [&stage](const std::pair<std::string, LatencyHistogram>& entry) {
+                                       return entry.first == stage.first;
+                                   });
+            if (it != merged.stages.end()) {
+                it->second.Merge(stage.second);
+            } else {
+                merged.stages.push_back(stage);
+            }
+        }
+    }
+
+    // Au-delà de cette fraction du débit crête, une étape est limitée par la mémoire
+    const float kBandwidthBoundFraction = 0.6f;
+
+    XISStageBandwidth ToStageBandwidth(uint64_t frames, uint64_t calls, double timeMs,
+                                       uint64_t bytesRead, uint64_t bytesWritten, double peakGBps)
+    {
+        XISStageBandwidth stats;
+        if (frames == 0) {
+            return stats;
+        }
+
+        stats.callsPerFrame = static_cast<float>(static_cast<double>(calls) / frames);
+        stats.timeMsPerFrame = static_cast<float>(timeMs / frames);
+        stats.bytesReadPerFrame = bytesRead / frames;
+        stats.bytesWrittenPerFrame = bytesWritten / frames;
+
+        if (timeMs > 0.0) {
+            // Octets par milliseconde -> Go/s
+            stats.achievedGBps = static_cast<float>((bytesRead + bytesWritten) / timeMs * 1e-6);
+        }
+        if (peakGBps > 0.0) {
+            stats.peakFraction = static_cast<float>(stats.achievedGBps / peakGBps);
+            stats.bandwidthBound = stats.peakFraction >= kBandwidthBoundFraction;
+        }
+        return stats;
+    }
+
+    bool SetDefaultSession(XISSessionHandle session)
+    {
+        if (!session) {
+            return false;
+        }
+
+        // L'ancienne session est détruite hors du verrou, au retour de ses
+        // frames en cours
+        std::shared_ptr<XISSession> previous(session);
+        {
+            std::lock_guard<std::mutex> lock(g_defaultSessionMutex);
+            previous.swap(g_defaultSession);
+        }
+        return true;
+    }
+
+} // namespace
+
+void DestroySession(XISSessionHandle session)
+{
+    if (!session) {
+        return;
+    }
+
+    if (auto scheduler = GetScheduler()) {
+        scheduler->RemoveSession(XISSessionAccess::GetCore(session));
+    }
+    delete session;
+}
+
+bool ProcessFrame(XISSessionHandle session, const XISParameters& params)
+{
+    return session ? session->ProcessFrame(params) : false;
+}
+
+void SetUpscalingParameters(XISSessionHandle session, const UpscalingParameters& params)
+{
+    if (session) {
+        session->ConfigureUpscaling(params);
+    }
+}
+
+void SetFrameGenParameters(XISSessionHandle session, const FrameGenParameters& params)
+{
+    if (session) {
+        session->ConfigureFrameGeneration(params);
+    }
+}
+
+void GetPerformanceStats(XISSessionHandle session, XISPerformanceStats& stats)
+{
+    stats = session ? session->GetPerformanceStats() : XISPerformanceStats();
+}
+
+bool StartTraceCapture(XISSessionHandle session, const char* outputPath, uint32_t frameCount)
+{
+    return session ? session->StartTraceCapture(outputPath, frameCount) : false;
+}
+
+bool IsTraceCaptureActive(XISSessionHandle session)
+{
+    return session ? session->IsTraceCaptureActive() : false;
+}
+
+bool StartFrameCapture(XISSessionHandle session, const char* outputPath, uint32_t frameCount)
+{
+    return session ? session->StartFrameCapture(outputPath, frameCount) : false;
+}
+
+bool IsFrameCaptureActive(XISSessionHandle session)
+{
+    return session ? session->IsFrameCaptureActive() : false;
+}
+
+void GetLatencyReport(XISSessionHandle session, XISLatencyReport& report)
+{
+    GetLatencyReport(&session, 1, report);
+}
+
+void GetLatencyReport(const XISSessionHandle* sessions, uint32_t sessionCount, XISLatencyReport& report)
+{
+    report = XISLatencyReport();
+    if (!sessions) {
+        return;
+    }
+
+    PerfMonitor::LatencySnapshot merged;
+    PerfMonitor::LatencySnapshot snapshot;
+    for (uint32_t i = 0; i < sessionCount; i++) {
+        if (sessions[i]) {
+            XISSessionAccess::GetCore(sessions[i])->CollectLatency(snapshot);
+            MergeLatency(merged, snapshot);
+        }
+    }
+
+    report.windowSeconds = merged.windowSeconds;
+    report.frame = ToLatencyStats(merged.frame);
+
+    for (const auto& stage : merged.stages) {
+        if (report.stageCount >= XISLatencyReport::kMaxStages) {
+            break;
+        }
+
+        XISStageLatency& entry = report.stages[report.stageCount++];
+        std::strncpy(entry.stageName, stage.first.c_str(), sizeof(entry.stageName) - 1);
+        entry.latency = ToLatencyStats(stage.second);
+    }
+}
+
+void ResetLatencyStats(XISSessionHandle session)
+{
+    if (session) {
+        session->ResetLatencyStats();
+    }
+}
+
+void GetBandwidthReport(XISSessionHandle session, XISBandwidthReport& report)
+{
+    report = XISBandwidthReport();
+    if (!session) {
+        return;
+    }
+
+    PerfMonitor::BandwidthSnapshot snapshot;
+    XISSessionAccess::GetCore(session)->CollectBandwidth(snapshot);
+
+    double peakGBps = BandwidthProbe::GetPeakGBps();
+    report.peakGBps = static_cast<float>(peakGBps);
+    report.frameCount = snapshot.frames;
+    report.frame = ToStageBandwidth(snapshot.frames, snapshot.frames, snapshot.frameTimeMs,
+                                    snapshot.bytesRead, snapshot.bytesWritten, peakGBps);
+    std::strncpy(report.frame.stageName, "Frame", sizeof(report.frame.stageName) - 1);
+
+    for (const auto& stage : snapshot.stages) {
+        if (report.stageCount >= XISBandwidthReport::kMaxStages) {
+            break;
+        }
+
+        XISStageBandwidth& entry = report.stages[report.stageCount++];
+        entry = ToStageBandwidth(stage.frames, stage.calls, stage.timeMs,
+                                 stage.bytesRead, stage.bytesWritten, peakGBps);
+        std::strncpy(entry.stageName, stage.name.c_str(), sizeof(entry.stageName) - 1);
+    }
+}
+
+void ResetBandwidthStats(XISSessionHandle session)
+{
+    if (session) {
+        session->ResetBandwidthStats();
+    }
+}
+
+void GetMemoryReport(XISSessionHandle session, XISMemoryReport& report)
+{
+    report = XISMemoryReport();
+    if (!session) {
+        return;
+    }
+
+    MemoryTrackingRenderer::Snapshot snapshot;
+    XISSessionAccess::GetCore(session)->CollectMemory(snapshot);
+
+    report.liveBytes = snapshot.liveBytes;
+    report.liveCount = snapshot.liveCount;
+    report.peakBytes = snapshot.peakBytes;
+    report.hugePageBytes = snapshot.hugePageBytes;
+    report.allocationCount = snapshot.allocationCount;
+    report.allocationsLastFrame = snapshot.allocationsLastFrame;
+    report.releasesLastFrame = snapshot.releasesLastFrame;
+    report.maxAllocationsPerFrame = snapshot.maxAllocationsPerFrame;
+
+    for (const auto& source : snapshot.entries) {
+        if (report.entryCount >= XISMemoryReport::kMaxEntries) {
+            break;
+        }
+
+        XISMemoryEntry& entry = report.entries[report.entryCount++];
+        std::strncpy(entry.name, source.name.c_str(), sizeof(entry.name) - 1);
+        std::strncpy(entry.category, source.category, sizeof(entry.category) - 1);
+        entry.liveCount = source.liveCount;
+        entry.liveBytes = source.liveBytes;
+        entry.peakBytes = source.peakBytes;
+        entry.allocationCount = source.allocationCount;
+    }
+}
+
+bool DumpMemoryReport(XISSessionHandle session, const char* outputPath)
+{
+    return session ? session->DumpMemoryReport(outputPath) : false;
+}
+
+void GetCommandStats(XISSessionHandle session, XISCommandStats& stats)
+{
+    stats = XISCommandStats();
+    if (!session) {
+        return;
+    }
+
+    CommandBatchingRenderer::Stats source;
+    XISSessionAccess::GetCore(session)->CollectCommandStats(source);
+
+    stats.workCalls = source.workCalls;
+    stats.stateCallsIn = source.stateCallsIn;
+    stats.stateCallsOut = source.stateCallsOut;
+    stats.barriersIn = source.barriersIn;
+    stats.barriersOut = source.barriersOut;
+    stats.batches = source.batches;
+    if (source.workCalls > 0) {
+        stats.stateCallsPerDispatchIn = static_cast<float>(static_cast<double>(source.stateCallsIn) / source.workCalls);
+        stats.stateCallsPerDispatchOut = static_cast<float>(static_cast<double>(source.stateCallsOut) / source.workCalls);
+    }
+    if (source.batches > 0) {
+        stats.commandsPerBatch = static_cast<float>(static_cast<double>(source.batchedCommands) / source.batches);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Ordonnancement multi-flux
+// ---------------------------------------------------------------------------
+
+bool StartScheduler(const XISSchedulerConfig& config)
+{
+    std::lock_guard<std::mutex> lock(g_schedulerMutex);
+    if (g_scheduler) {
+        Logger::Warning("StartScheduler: l'ordonnanceur est déjà démarré");
+        return true;
+    }
+
+    auto scheduler = std::make_shared<FrameScheduler>(config);
+    if (!scheduler->Start()) {
+        return false;
+    }
+
+    g_scheduler = std::move(scheduler);
+    return true;
+}
+
+void StopScheduler()
+{
+    std::shared_ptr<FrameScheduler> scheduler;
+    {
+        std::lock_guard<std::mutex> lock(g_schedulerMutex);
+        scheduler.swap(g_scheduler);
+    }
+
+    if (scheduler) {
+        scheduler->Stop();
+    }
+}
+
+uint64_t GetSchedulerTimeUs()
+{
+    auto sinceEpoch = FrameScheduler::Clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count());
+}
+
+bool SubmitFrame(XISSessionHandle session, const XISParameters& params, uint64_t presentationDeadlineUs,
+                 XISFrameCompletionCallback onComplete, void* userData)
+{
+    auto scheduler = GetScheduler();
+    if (!session || !scheduler) {
+        Logger::Error("SubmitFrame: session invalide ou ordonnanceur non démarré");
+        return false;
+    }
+
+    FrameScheduler::Clock::time_point deadline{std::chrono::microseconds(presentationDeadlineUs)};
+
+    FrameScheduler::CompletionCallback callback;
+    if (onComplete) {
+        callback = [session, params, onComplete, userData](bool success) {
+            onComplete(session, params, success, userData);
+        };
+    }
+
+    return scheduler->Submit(XISSessionAccess::GetCore(session), params, deadline, std::move(callback));
+}
+
+void GetStreamStats(XISSessionHandle session, XISStreamStats& stats)
+{
+    stats = XISStreamStats();
+
+    auto scheduler = GetScheduler();
+    if (session && scheduler) {
+        scheduler->GetStreamStats(XISSessionAccess::GetCore(session), stats);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// API historique : session globale
+// ---------------------------------------------------------------------------
+
+bool Initialize(const XISConfig& config)
+{
+    // Sans périphérique, la session globale s'exécute sur le CPU
+    return CPU::Initialize(config, 0);
+}
+
+void Shutdown()
+{
+    // Une frame en cours garde sa référence : la session est détruite à son retour
+    std::shared_ptr<XISSession> session;
+    {
+        std::lock_guard<std::mutex> lock(g_defaultSessionMutex);
+        session.swap(g_defaultSession);
+    }
+}
+
+bool ProcessFrame(const XISParameters& params)
+{
+    std::shared_ptr<XISSession> session = GetDefaultSession();
+    return session ? session->ProcessFrame(params) : false;
+}
+
+void SetUpscalingParameters(const UpscalingParameters& params)
+{
+    SetUpscalingParameters(GetDefaultSession().get(), params);
+}
+
+void SetFrameGenParameters(const FrameGenParameters& params)
+{
+    SetFrameGenParameters(GetDefaultSession().get(), params);
+}
+
+void GetPerformanceStats(XISPerformanceStats& stats)
+{
+    GetPerformanceStats(GetDefaultSession().get(), stats);
+}
+
+bool StartTraceCapture(const char* outputPath, uint32_t frameCount)
+{
+    return StartTraceCapture(GetDefaultSession().get(), outputPath, frameCount);
+}
+
+bool StartFrameCapture(const char* outputPath, uint32_t frameCount)
+{
+    return StartFrameCapture(GetDefaultSession().get(), outputPath, frameCount);
+}
+
+void GetLatencyReport(XISLatencyReport& report)
+{
+    GetLatencyReport(GetDefaultSession().get(), report);
+}
+
+void ResetLatencyStats()
+{
+    ResetLatencyStats(GetDefaultSession().get());
+}
+
+void GetBandwidthReport(XISBandwidthReport& report)
+{
+    GetBandwidthReport(GetDefaultSession().get(), report);
+}
+
+void ResetBandwidthStats()
+{
+    ResetBandwidthStats(GetDefaultSession().get());
+}
+
+void GetMemoryReport(XISMemoryReport& report)
+{
+    GetMemoryReport(GetDefaultSession().get(), report);
+}
+
+bool DumpMemoryReport(const char* outputPath)
+{
+    return DumpMemoryReport(GetDefaultSession().get(), outputPath);
+}
+
+void GetCommandStats(XISCommandStats& stats)
+{
+    GetCommandStats(GetDefaultSession().get(), stats);
+}
+
+bool LoadTuningProfile(const char* path)
+{
+    return ConfigManager::LoadTuningProfile(path);
+}
+
+bool WatchConfigFile(const char* path)
+{
+    return ConfigManager::WatchConfigFile(path);
+}
+
+void StopWatchingConfigFile()
+{
+    ConfigManager::StopWatchingConfigFile();
+}
+
+namespace DX11 {
+
+    XISSessionHandle CreateSession(void* device, void* deviceContext, const XISConfig& config)
+    {
+#ifdef XIS_ENABLE_DX11
+        return CreateSessionWithRenderer(std::make_shared<DX11Renderer>(device, deviceContext), config);
+#else
+        (void)device;
+        (void)deviceContext;
+        (void)config;
+        Logger::Error("Backend DX11 non compilé (XIS_ENABLE_DX11)");
+        return nullptr;
+#endif
+    }
+
+    bool Initialize(void* device, void* deviceContext, const XISConfig& config)
+    {
+        return SetDefaultSession(CreateSession(device, deviceContext, config));
+    }
+
+    bool ProcessFrame(void* sourceTexture, void* outputTexture, void* deviceContext, const XISParameters* params)
+    {
+        XISParameters frameParams = params ? *params : XISParameters();
+        frameParams.inputTexture = sourceTexture;
+        frameParams.outputTexture = outputTexture;
+        frameParams.deviceContext = deviceContext;
+        frameParams.isDX11 = true;
+
+        return XIS::ProcessFrame(frameParams);
+    }
+
+} // namespace DX11
+
+namespace DX12 {
+
+    XISSessionHandle CreateSession(void* device, void* commandQueue, const XISConfig& config)
+    {
+#ifdef XIS_ENABLE_DX12
+        return CreateSessionWithRenderer(std::make_shared<DX12Renderer>(device, commandQueue), config);
+#else
+        (void)device;
+        (void)commandQueue;
+        (void)config;
+        Logger::Error("Backend DX12 non compilé (XIS_ENABLE_DX12)");
+        return nullptr;
+#endif
+    }
+
+    bool Initialize(void* device, void* commandQueue, const XISConfig& config)
+    {
+        return SetDefaultSession(CreateSession(device, commandQueue, config));
+    }
+
+    bool ProcessFrame(void* sourceTexture, void* outputTexture, void* commandList, const XISParameters* params)
+    {
+        XISParameters frameParams = params ? *params : XISParameters();
+        frameParams.inputTexture = sourceTexture;
+        frameParams.outputTexture = outputTexture;
+        frameParams.deviceContext = commandList;
+        frameParams.isDX11 = false;
+
+        return XIS::ProcessFrame(frameParams);
+    }
+
+} // namespace DX12
+
+namespace CPU {
+
+    XISSessionHandle CreateSession(const XISConfig& config, uint32_t workerThreadCount, int numaNode)
+    {
+        return CreateSessionWithRenderer(std::make_shared<CPURenderer>(workerThreadCount, numaNode), config);
+    }
+
+    void GetNumaReport(XISNumaReport& report)
+    {
+        report = XISNumaReport();
+
+        std::vector<NumaTopology::NodeStats> nodes;
+        NumaTopology::Get().Collect(nodes);
+        report.nodeCount = static_cast<uint32_t>(std::min<size_t>(nodes.size(), XISNumaReport::kMaxNodes));
+        for (uint32_t i = 0; i < report.nodeCount; ++i) {
+            report.nodes[i].cpuCount = nodes[i].cpuCount;
+            report.nodes[i].sessionCount = nodes[i].sessionCount;
+            report.nodes[i].localBytes = nodes[i].localBytes;
+            report.nodes[i].remoteBytes = nodes[i].remoteBytes;
+        }
+    }
+
+    bool Initialize(const XISConfig& config, uint32_t workerThreadCount)
+    {
+        return SetDefaultSession(CreateSession(config, workerThreadCount));
+    }
+
+    void* CreateTexture(uint32_t width, uint32_t height)
+    {
+        CPUTexture* texture = CreateCPUTexture(static_cast<int>(width), static_cast<int>(height), CPUTextureFormat::RGBA8);
+        if (!texture) {
+            Logger::Error("CPU::CreateTexture: échec de la création d'une texture %ux%u", width, height);
+        }
+        return texture;
+    }
+
+    void* ImportTexture(const ExternalImage& image)
+    {
+        CPUExternalImage external;
+        external.data = static_cast<uint8_t*>(image.data);
+        external.width = static_cast<int>(image.width);
+        external.height = static_cast<int>(image.height);
+        external.pitch = image.rowPitch;
+        external.format = static_cast<CPUTextureFormat>(image.format);
+        external.fd = image.fd;
+        external.offset = image.offset;
+        external.releaseCallback = image.release;
+        external.releaseUserData = image.userData;
+
+        CPUTexture* texture = ImportCPUTexture(external);
+        if (!texture) {
+            Logger::Error("CPU::ImportTexture: échec de l'import d'une image %ux%u", image.width, image.height);
+        }
+        return texture;
+    }
+
+    void ReleaseTexture(void* texture)
+    {
+        // Pas de AsCPUTexture : le handle a pu être libéré, son en-tête n'est pas relu
+        ReleaseCPUResource(static_cast<CPUResource*>(texture));
+    }
+
+    uint8_t* MapTexture(void* texture, uint32_t* rowPitch)
+    {
+        CPUTexture* cpuTexture = AsCPUTexture(texture);
+        if (!cpuTexture) {
+            return nullptr;
+        }
+
+        if (rowPitch) {
+            *rowPitch = static_cast<uint32_t>(cpuTexture->pitch);
+        }
+        return cpuTexture->data;
+    }
+
+} // namespace CPU
+
+// ---------------------------------------------------------------------------
+// XISAPI : façade singleton sur la session globale
+// ---------------------------------------------------------------------------
+
+class XISAPI::Impl {
+};
+
+XISAPI* XISAPI::s_pInstance = nullptr;
+
+XISAPI::XISAPI()
+    : m_pImpl(std::make_unique<Impl>())
+{
+}
+
+XISAPI::~XISAPI() = default;
+
+bool XISAPI::Initialize(const XISConfig& config)
+{
+    if (!XIS::Initialize(config)) {
+        return false;
+    }
+
+    if (!s_pInstance) {
+        s_pInstance = new XISAPI();
+    }
+    return true;
+}
+
+void XISAPI::Shutdown()
+{
+    XIS::Shutdown();
+
+    delete s_pInstance;
+    s_pInstance = nullptr;
+}
+
+XISAPI& XISAPI::GetInstance()
+{
+    if (!s_pInstance) {
+        s_pInstance = new XISAPI();
+    }
+    return *s_pInstance;
+}
+
+bool XISAPI::ProcessFrame(void* sourceTexture, void* outputTexture, const XISParameters& parameters)
+{
+    XISParameters frameParams = parameters;
+    frameParams.inputTexture = sourceTexture;
+    frameParams.outputTexture = outputTexture;
+
+    return XIS::ProcessFrame(frameParams);
+}
+
+void XISAPI::EnableBicubicUpscaling(bool enabled)
+{
+    std::shared_ptr<XISSession> session = GetDefaultSession();
+    if (session) {
+        session->EnableBicubicUpscaling(enabled);
+    }
+}
+
+void XISAPI::EnableFrameGeneration(bool enabled)
+{
+    std::shared_ptr<XISSession> session = GetDefaultSession();
+    if (session) {
+        session->EnableFrameGeneration(enabled);
+    }
+}
+
+void XISAPI::ConfigureUpscaling(const UpscalingParameters& params)
+{
+    XIS::SetUpscalingParameters(params);
+}
+
+void XISAPI::ConfigureFrameGeneration(const FrameGenParameters& params)
+{
+    XIS::SetFrameGenParameters(params);
+}
+
+XISPerformanceStats XISAPI::GetPerformanceStats() const
+{
+    XISPerformanceStats stats;
+    XIS::GetPerformanceStats(stats);
+    return stats;
+}
+
+} // namespace XIS
@@ -9,13 +9,12 @@ AntiAliasingStage::AntiAliasingStage(std::shared_ptr<IRenderer> renderer)
     : m_renderer(renderer),
       m_quality(AAQuality::Medium),
       m_aaShader(nullptr),
-      m_aaConstantBuffer(nullptr)
+      m_kernelSizes{ 1, 3, 5 }
 {
     // Initialiser les paramètres par défaut
-    m_aaParams.threshold = 0.1f;
-    m_aaParams.blendFactor = 0.5f;
-    m_aaParams.kernelSize = 3;
-    m_aaParams.reserved = 0.0f;
+    m_constants.Modify([this](AAParams& params) {
+        params = GetParamsForQuality(AAQuality::Medium);
+    });
 }
 
 AntiAliasingStage::~AntiAliasingStage()
@@ -25,46 +24,52 @@ AntiAliasingStage::~AntiAliasingStage()
         m_renderer->ReleaseShaderResource(m_aaShader);
         m_aaShader = nullptr;
     }
-    
-    if (m_aaConstantBuffer) {
-        m_renderer->ReleaseBuffer(m_aaConstantBuffer);
-        m_aaConstantBuffer = nullptr;
-    }
+
+    m_constants.Release();
 }
 
-bool AntiAliasingStage::Initialize(AAQuality quality)
+AntiAliasingStage::AAParams AntiAliasingStage::GetParamsForQuality(AAQuality quality) const
 {
-    m_quality = quality;
-    
-    // Si l'antialiasing est désactivé, pas besoin de créer des ressources
-    if (quality == AAQuality::Off) {
-        return true;
-    }
-    
-    // Configurer les paramètres en fonction de la qualité
+    AAParams params = {};
+
     switch (quality) {
         case AAQuality::Low:
-            m_aaParams.threshold = 0.15f;
-            m_aaParams.blendFactor = 0.3f;
-            m_aaParams.kernelSize = 1;
-            break;
-            
-        case AAQuality::Medium:
-            m_aaParams.threshold = 0.1f;
-            m_aaParams.blendFactor = 0.5f;
-            m_aaParams.kernelSize = 3;
+            params.threshold = 0.15f;
+            params.blendFactor = 0.3f;
+            params.kernelSize = m_kernelSizes[0];
             break;
-            
+
         case AAQuality::High:
-            m_aaParams.threshold = 0.05f;
-            m_aaParams.blendFactor = 0.7f;
-            m_aaParams.kernelSize = 5;
+            params.threshold = 0.05f;
+            params.blendFactor = 0.7f;
+            params.kernelSize = m_kernelSizes[2];
             break;
-            
+
+        case AAQuality::Medium:
         default:
+            params.threshold = 0.1f;
+            params.blendFactor = 0.5f;
+            params.kernelSize = m_kernelSizes[1];
             break;
     }
-    
+
+    return params;
+}
+
+bool AntiAliasingStage::Initialize(AAQuality quality)
+{
+    m_quality = quality;
+
+    // Si l'antialiasing est désactivé, pas besoin de créer des ressources
+    if (quality == AAQuality::Off) {
+        return true;
+    }
+
+    // Configurer les paramètres en fonction de la qualité
+    m_constants.Modify([this, quality](AAParams& params) {
+        params = GetParamsForQuality(quality);
+    });
+
     // Créer les ressources des shaders
     return CreateShaderResources();
 }
@@ -77,46 +82,57 @@ bool AntiAliasingStage::CreateShaderResources()
         Logger::Error("Échec du chargement du shader d'antialiasing");
         return false;
     }
-    
-    // Créer le tampon constant pour les paramètres
-    m_aaConstantBuffer = m_renderer->CreateConstantBuffer(sizeof(AAParams));
-    if (!m_aaConstantBuffer) {
+
+    // Créer le tampon constant avec les paramètres initiaux
+    if (!m_constants.Create(m_renderer.get(), "AAConstantBuffer")) {
         Logger::Error("Échec de la création du tampon constant pour l'antialiasing");
         return false;
     }
-    
-    // Mettre à jour le tampon constant avec les paramètres initiaux
-    UpdateConstantBuffer();
-    
+
     return true;
 }
 
-void AntiAliasingStage::UpdateConstantBuffer()
+bool AntiAliasingStage::Process(void* inputTexture, void* outputTexture)
 {
-    if (m_aaConstantBuffer) {
-        m_renderer->UpdateBuffer(m_aaConstantBuffer, &m_aaParams, sizeof(AAParams));
-    }
+    return Process(inputTexture, outputTexture, m_quality);
 }
 
-bool AntiAliasingStage::Process(void* inputTexture, void* outputTexture)
+bool AntiAliasingStage::Process(void* inputTexture, void* outputTexture, AAQuality quality)
 {
     // Si l'antialiasing est désactivé, copier simplement l'entrée vers la sortie
-    if (m_quality == AAQuality::Off) {
+    if (quality == AAQuality::Off || m_quality == AAQuality::Off) {
         m_renderer->CopyResource(inputTexture, outputTexture);
         return true;
     }
-    
+
+    // N'envoyer le tampon constant que si les paramètres ont changé
+    if (!m_constants.Flush()) {
+        Logger::Error("Échec de la mise à jour du tampon constant pour l'antialiasing");
+        return false;
+    }
+
+    // Une qualité différente de la qualité configurée est passée en root
+    // constants, sans toucher au tampon constant
+    AAOverride override = {};
+    if (quality != m_quality) {
+        AAParams params = GetParamsForQuality(quality);
+        override.threshold = params.threshold;
+        override.blendFactor = params.blendFactor;
+        override.kernelSize = params.kernelSize;
+        override.enabled = 1;
+    }
+
     // Appliquer l'antialiasing en fonction de la qualité
-    switch (m_quality) {
+    switch (quality) {
         case AAQuality::Low:
-            return ApplyLowQualityAA(inputTexture, outputTexture);
-            
+            return ApplyLowQualityAA(inputTexture, outputTexture, override);
+
         case AAQuality::Medium:
-            return ApplyMediumQualityAA(inputTexture, outputTexture);
-            
+            return ApplyMediumQualityAA(inputTexture, outputTexture, override);
+
         case AAQuality::High:
-            return ApplyHighQualityAA(inputTexture, outputTexture);
-            
+            return ApplyHighQualityAA(inputTexture, outputTexture, override);
+
         default:
             // Ne devrait jamais arriver si nous avons vérifié correctement
             m_renderer->CopyResource(inputTexture, outputTexture);
@@ -128,85 +144,88 @@ void AntiAliasingStage::SetQuality(AAQuality quality)
 {
     if (m_quality != quality) {
         m_quality = quality;
-        
-        // Mettre à jour les paramètres en fonction de la nouvelle qualité
-        switch (quality) {
-            case AAQuality::Low:
-                m_aaParams.threshold = 0.15f;
-                m_aaParams.blendFactor = 0.3f;
-                m_aaParams.kernelSize = 1;
-                break;
-                
-            case AAQuality::Medium:
-                m_aaParams.threshold = 0.1f;
-                m_aaParams.blendFactor = 0.5f;
-                m_aaParams.kernelSize = 3;
-                break;
-                
-            case AAQuality::High:
-                m_aaParams.threshold = 0.05f;
-                m_aaParams.blendFactor = 0.7f;
-                m_aaParams.kernelSize = 5;
-                break;
-                
-            default:
-                break;
+
+        // Mettre à jour les paramètres en fonction de la nouvelle qualité ;
+        // l'envoi est différé au prochain Process
+        if (quality != AAQuality::Off) {
+            m_constants.Modify([this, quality](AAParams& params) {
+                params = GetParamsForQuality(quality);
+            });
         }
-        
-        // Mettre à jour le tampon constant
-        UpdateConstantBuffer();
     }
 }
 
-bool AntiAliasingStage::ApplyLowQualityAA(void* input, void* output)
+void AntiAliasingStage::SetKernelSize(AAQuality quality, int kernelSize)
+{
+    if (quality == AAQuality::Off) {
+        return;
+    }
+
+    int index = static_cast<int>(quality) - static_cast<int>(AAQuality::Low);
+    kernelSize = kernelSize < 1 ? 1 : kernelSize;
+    if (m_kernelSizes[index] == kernelSize) {
+        return;
+    }
+    m_kernelSizes[index] = kernelSize;
+
+    // Les autres qualités sont passées en root constants à chaque appel ;
+    // seule la qualité configurée est dans le tampon constant
+    if (quality == m_quality) {
+        m_constants.Modify([kernelSize](AAParams& params) {
+            params.kernelSize = kernelSize;
+        });
+    }
+}
+
+void AntiAliasingStage::BindResources(void* input, void* output, const AAOverride& override)
 {
-    // Configuration pour qualité faible (FXAA simplifié)
     m_renderer->SetShader(m_aaShader);
-    m_renderer->SetConstantBuffer(m_aaConstantBuffer, 0);
+    m_renderer->SetConstantBuffer(m_constants.GetBuffer(), 0);
+    m_renderer->SetRootConstants(kOverrideRootConstantSlot, &override, sizeof(override));
     m_renderer->SetTexture(input, 0);
     m_renderer->SetRenderTarget(output);
-    
+}
+
+bool AntiAliasingStage::ApplyLowQualityAA(void* input, void* output, const AAOverride& override)
+{
+    // Configuration pour qualité faible (FXAA simplifié)
+    BindResources(input, output, override);
+
     // Exécuter le shader avec le tampon constant actuel
     bool success = m_renderer->ExecuteShader();
     if (!success) {
         Logger::Error("Échec de l'exécution du shader d'antialiasing (qualité faible)");
     }
-    
+
     return success;
 }
 
-bool AntiAliasingStage::ApplyMediumQualityAA(void* input, void* output)
+bool AntiAliasingStage::ApplyMediumQualityAA(void* input, void* output, const AAOverride& override)
 {
     // Configuration pour qualité moyenne (FXAA standard)
-    m_renderer->SetShader(m_aaShader);
-    m_renderer->SetConstantBuffer(m_aaConstantBuffer, 0);
-    m_renderer->SetTexture(input, 0);
-    m_renderer->SetRenderTarget(output);
-    
+    BindResources(input, output, override);
+
     // Exécuter le shader avec le tampon constant actuel
     bool success = m_renderer->ExecuteShader();
     if (!success) {
         Logger::Error("Échec de l'exécution du shader d'antialiasing (qualité moyenne)");
     }
-    
+
     return success;
 }
 
-bool AntiAliasingStage::ApplyHighQualityAA(void* input, void* output)
+bool AntiAliasingStage::ApplyHighQualityAA(void* input, void* output, const AAOverride& override)
 {
     // Configuration pour qualité élevée (FXAA avancé ou SMAA)
-    m_renderer->SetShader(m_aaShader);
-    m_renderer->SetConstantBuffer(m_aaConstantBuffer, 0);
-    m_renderer->SetTexture(input, 0);
-    m_renderer->SetRenderTarget(output);
-    
+    BindResources(input, output, override);
+
     // Exécuter le shader avec le tampon constant actuel
     bool success = m_renderer->ExecuteShader();
     if (!success) {
         Logger::Error("Échec de l'exécution du shader d'antialiasing (qualité élevée)");
     }
-    
+
     return success;
 }
 
-} // namespace XIS
\ No newline at end of file
+} // namespace XIS
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include "../Core/XISParameters.h"
+#include "../Renderer/ConstantBlock.h"
 
 namespace XIS {
 
@@ -41,6 +42,19 @@ public:
      */
     bool Process(void* inputTexture, void* outputTexture);
 
+    /**
+     * @brief Traite une frame avec une qualité propre à cet appel
+     * 
+     * La qualité configurée n'est pas modifiée : les paramètres correspondants
+     * sont passés en root constants (utilisé pour le délestage).
+     * 
+     * @param inputTexture Texture d'entrée
+     * @param outputTexture Texture de sortie
+     * @param quality Qualité pour cet appel uniquement
+     * @return true si le traitement réussit, false sinon
+     */
+    bool Process(void* inputTexture, void* outputTexture, AAQuality quality);
+
     /**
      * @brief Change la qualité de l'antialiasing
      * 
@@ -48,13 +62,23 @@ public:
      */
     void SetQuality(AAQuality quality);
 
+    /**
+     * @brief Change la taille du noyau de convolution d'une qualité
+     * 
+     * Utilisé par le profil d'autotuning ; par défaut 1, 3 et 5 pour les
+     * qualités Low, Medium et High.
+     * 
+     * @param quality Qualité concernée (Low, Medium ou High)
+     * @param kernelSize Taille du noyau en pixels
+     */
+    void SetKernelSize(AAQuality quality, int kernelSize);
+
 private:
     std::shared_ptr<IRenderer> m_renderer;
     AAQuality m_quality;
     
     // Ressources des shaders
     void* m_aaShader;
-    void* m_aaConstantBuffer;
     
     // Paramètres internes
     struct AAParams {
@@ -64,16 +88,30 @@ private:
         float reserved;      // Pour alignement
     };
     
-    AAParams m_aaParams;
+    // Surcharge par appel, passée en root constants
+    struct AAOverride {
+        float threshold;     // Seuil de détection des contours
+        float blendFactor;   // Facteur de mélange pour lissage adaptatif
+        int kernelSize;      // Taille du noyau de convolution
+        int enabled;         // 0 = utiliser le tampon constant
+    };
+    
+    ConstantBlock<AAParams> m_constants;
+    
+    // Taille du noyau des qualités Low, Medium et High
+    int m_kernelSizes[3];
+    
+    // Paramètres associés à une qualité
+    AAParams GetParamsForQuality(AAQuality quality) const;
     
     // Méthodes d'initialisation des ressources
     bool CreateShaderResources();
-    void UpdateConstantBuffer();
     
     // Méthodes d'application des différentes qualités d'AA
-    bool ApplyLowQualityAA(void* input, void* output);
-    bool ApplyMediumQualityAA(void* input, void* output);
-    bool ApplyHighQualityAA(void* input, void* output);
+    bool ApplyLowQualityAA(void* input, void* output, const AAOverride& override);
+    bool ApplyMediumQualityAA(void* input, void* output, const AAOverride& override);
+    bool ApplyHighQualityAA(void* input, void* output, const AAOverride& override);
+    void BindResources(void* input, void* output, const AAOverride& override);
 };
 
 } // namespace XIS
\ No newline at end of file
@@ -1,19 +1,21 @@
 #include "DownsampleStage.h"
 #include "../Renderer/IRenderer.h"
 #include "../Utils/Logger.h"
+#include <algorithm>
 
 namespace XIS {
 
 DownsampleStage::DownsampleStage(std::shared_ptr<IRenderer> renderer)
     : m_renderer(renderer),
-      m_downsampleShader(nullptr),
-      m_constantBuffer(nullptr)
+      m_downsampleShader(nullptr)
 {
     // Initialiser les paramètres par défaut
-    m_params.downsampleFactor = 0.5f;  // Par défaut, réduire à 50%
-    m_params.preserveDetail = 0.75f;   // Conserver 75% des détails
-    m_params.threshold = 0.1f;         // Seuil pour la détection des contours
-    m_params.reserved = 0.0f;
+    m_constants.Modify([](DownsampleParams& params) {
+        params.downsampleFactor = 0.5f;  // Par défaut, réduire à 50%
+        params.preserveDetail = 0.75f;   // Conserver 75% des détails
+        params.threshold = 0.1f;         // Seuil pour la détection des contours
+        params.reserved = 0.0f;
+    });
 }
 
 DownsampleStage::~DownsampleStage()
@@ -24,10 +26,7 @@ DownsampleStage::~DownsampleStage()
         m_downsampleShader = nullptr;
     }
     
-    if (m_constantBuffer) {
-        m_renderer->ReleaseBuffer(m_constantBuffer);
-        m_constantBuffer = nullptr;
-    }
+    m_constants.Release();
 }
 
 bool DownsampleStage::Initialize()
@@ -44,47 +43,32 @@ bool DownsampleStage::CreateShaderResources()
         return false;
     }
     
-    // Créer le tampon constant pour les paramètres
-    m_constantBuffer = m_renderer->CreateConstantBuffer(sizeof(DownsampleParams));
-    if (!m_constantBuffer) {
+    // Créer le tampon constant avec les paramètres initiaux
+    if (!m_constants.Create(m_renderer.get(), "DownsampleConstantBuffer")) {
         Logger::Error("Échec de la création du tampon constant pour le downsampling");
         return false;
     }
     
-    // Mettre à jour le tampon constant avec les paramètres initiaux
-    UpdateConstantBuffer();
-    
     return true;
 }
 
-void DownsampleStage::UpdateConstantBuffer()
-{
-    if (m_constantBuffer) {
-        m_renderer->UpdateBuffer(m_constantBuffer, &m_params, sizeof(DownsampleParams));
-    }
-}
-
 bool DownsampleStage::Process(void* inputTexture, void* outputTexture, float factor)
 {
-    // Si un facteur spécifique est fourni, l'utiliser temporairement
-    if (factor > 0.0f) {
-        float oldFactor = m_params.downsampleFactor;
-        m_params.downsampleFactor = factor;
-        UpdateConstantBuffer();
-        
-        // Exécuter le shader
-        bool result = Process(inputTexture, outputTexture);
-        
-        // Restaurer l'ancien facteur
-        m_params.downsampleFactor = oldFactor;
-        UpdateConstantBuffer();
-        
-        return result;
+    // N'envoyer le tampon constant que si les paramètres ont changé
+    if (!m_constants.Flush()) {
+        Logger::Error("Échec de la mise à jour du tampon constant pour le downsampling");
+        return false;
     }
     
+    // Un facteur spécifique à cet appel est passé en root constants :
+    // le tampon constant reste inchangé
+    DownsampleOverride override = {};
+    override.downsampleFactor = factor > 0.0f ? factor : 0.0f;
+    
     // Configuration standard pour le downsampling
     m_renderer->SetShader(m_downsampleShader);
-    m_renderer->SetConstantBuffer(m_constantBuffer, 0);
+    m_renderer->SetConstantBuffer(m_constants.GetBuffer(), 0);
+    m_renderer->SetRootConstants(kOverrideRootConstantSlot, &override, sizeof(override));
     m_renderer->SetTexture(inputTexture, 0);
     m_renderer->SetRenderTarget(outputTexture);
     
@@ -102,10 +86,10 @@ void DownsampleStage::SetDownsampleFactor(float factor)
     // Limiter le facteur entre 0.1 et 1.0
     factor = std::max(0.1f, std::min(1.0f, factor));
     
-    if (m_params.downsampleFactor != factor) {
-        m_params.downsampleFactor = factor;
-        UpdateConstantBuffer();
-    }
+    // L'envoi est différé au prochain Process
+    m_constants.Modify([factor](DownsampleParams& params) {
+        params.downsampleFactor = factor;
+    });
 }
 
 } // namespace XIS
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include "../Renderer/ConstantBlock.h"
 
 namespace XIS {
 
@@ -53,7 +54,6 @@ private:
     
     // Ressources des shaders
     void* m_downsampleShader;
-    void* m_constantBuffer;
     
     // Paramètres
     struct DownsampleParams {
@@ -63,11 +63,16 @@ private:
         float reserved;          // Pour alignement
     };
     
-    DownsampleParams m_params;
+    // Surcharge par appel, passée en root constants
+    struct DownsampleOverride {
+        float downsampleFactor;  // Facteur de réduction (0 = utiliser le tampon constant)
+        float reserved[3];       // Pour alignement
+    };
+    
+    ConstantBlock<DownsampleParams> m_constants;
     
     // Méthodes d'initialisation des ressources
     bool CreateShaderResources();
-    void UpdateConstantBuffer();
 };
 
 } // namespace XIS
\ No newline at end of file
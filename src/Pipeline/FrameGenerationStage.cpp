@@ -2,12 +2,14 @@
 #include "../Algorithms/FrameInterpolation.h"
 #include "../Utils/Logger.h"
 #include "../Renderer/IRenderer.h"
+#include <algorithm>
 
 namespace XIS {
 
 struct FrameGenerationStage::FrameGenerationStageData {
     bool initialized;
     FrameInterpolation frameInterpolator;
+    IRenderer* renderer;  // Renderer the textures below were created with
     void* motionVectorTexture;
     int frameWidth;
     int frameHeight;
@@ -18,15 +20,15 @@ FrameGenerationStage::FrameGenerationStage()
     : m_data(std::make_unique<FrameGenerationStageData>())
     , m_generatedFrameBuffer(nullptr)
     , m_generationFactor(1) // Default to 1 intermediate frame (doubles framerate)
+    , m_historyLength(2) // Current and previous frame
+    , m_zeroCopyHistory(false)
 {
     m_data->initialized = false;
+    m_data->renderer = nullptr;
     m_data->motionVectorTexture = nullptr;
     m_data->frameWidth = 0;
     m_data->frameHeight = 0;
     m_data->format = 0;
-
-    // Reserve space for previous frames (keeping last 2 frames)
-    m_previousFrames.resize(2, nullptr);
 }
 
 FrameGenerationStage::~FrameGenerationStage() {
@@ -62,30 +64,29 @@ bool FrameGenerationStage::Initialize(const XISContext* context) {
 }
 
 void FrameGenerationStage::Shutdown() {
-    if (!m_data->initialized) {
+    // Resources created by a failed Initialize are released as well
+    if (!m_data->initialized && !m_data->renderer) {
         return;
     }
 
     // Clean up frame interpolator
     m_data->frameInterpolator.Shutdown();
 
-    // Release previous frames
-    for (auto& frame : m_previousFrames) {
-        if (frame) {
-            // Release resource based on renderer type
-            frame = nullptr;
-        }
-    }
+    // Release the history textures
+    m_history.reset();
 
     // Release motion vector texture
     if (m_data->motionVectorTexture) {
+        m_data->renderer->ReleaseResource(m_data->motionVectorTexture);
         m_data->motionVectorTexture = nullptr;
     }
 
     // Release generated frame buffer
     if (m_generatedFrameBuffer) {
+        m_data->renderer->ReleaseResource(m_generatedFrameBuffer);
         m_generatedFrameBuffer = nullptr;
     }
+    m_data->renderer = nullptr;
 
     m_data->initialized = false;
     Logger::Info("FrameGenerationStage: Successfully shut down");
@@ -105,33 +106,37 @@ bool FrameGenerationStage::Process(const XISContext* context,
         return false;
     }
 
-    // Update motion vectors between current frame and previous frame
-    if (!UpdateMotionVectors(context, inputTexture)) {
-        Logger::Warning("FrameGenerationStage: Failed to update motion vectors");
-        // Continue processing even if motion vector update fails
+    // Capture the input once; every consumer below reads the history copy,
+    // so the caller may recycle its texture as soon as the frame returns.
+    // Only the application's own texture may be referenced: an earlier stage
+    // hands over a pipeline intermediate that the next frame overwrites
+    bool importInput = m_zeroCopyHistory && inputTexture == params.inputTexture;
+    FrameHistory::FrameRef currentFrame = importInput ? m_history->Import(inputTexture)
+                                                      : m_history->Capture(inputTexture);
+    if (!currentFrame) {
+        Logger::Error("FrameGenerationStage: Failed to add the input frame to the history");
+        return false;
     }
 
-    // Get previous frame
-    void* previousFrame = m_previousFrames[0];
-    
+    FrameHistory::FrameRef previousFrame = m_history->Get(1);
+
     // Generate intermediate frames if we have a previous frame
     if (previousFrame) {
-        if (!GenerateIntermediateFrames(context, previousFrame, inputTexture, params)) {
+        // Update motion vectors between previous frame and current frame
+        if (!UpdateMotionVectors(context, previousFrame.GetTexture(), currentFrame.GetTexture())) {
+            Logger::Warning("FrameGenerationStage: Failed to update motion vectors");
+            // Continue processing even if motion vector update fails
+        }
+
+        if (!GenerateIntermediateFrames(context, previousFrame.GetTexture(), currentFrame.GetTexture(), params)) {
             Logger::Error("FrameGenerationStage: Failed to generate intermediate frames");
             return false;
         }
     }
 
-    // Update frame history:
-    // Shift frames: previousFrames[1] -> previousFrames[0]
-    m_previousFrames[0] = m_previousFrames[1];
-    
-    // Store current frame as the most recent frame in history
-    m_previousFrames[1] = inputTexture;
-
     // Copy current frame to output texture
     IRenderer* renderer = context->GetRenderer();
-    if (!renderer->CopyResource(outputTexture, inputTexture)) {
+    if (!renderer->CopyResource(inputTexture, outputTexture)) {
         Logger::Error("FrameGenerationStage: Failed to copy resource");
         return false;
     }
@@ -150,17 +155,51 @@ void FrameGenerationStage::SetGenerationFactor(int factor) {
     Logger::Info("FrameGenerationStage: Generation factor set to %d", m_generationFactor);
 }
 
+void FrameGenerationStage::SetMotionSearchRadius(int radius) {
+    m_data->frameInterpolator.SetSearchRadius(radius);
+}
+
+void FrameGenerationStage::SetMotionBlockSize(int blockSize) {
+    m_data->frameInterpolator.SetBlockSize(blockSize);
+}
+
+void FrameGenerationStage::SetHistoryLength(int frames) {
+    int length = frames < 2 ? 2 : frames;
+    if (length == m_historyLength) {
+        return;
+    }
+    m_historyLength = length;
+
+    if (m_history && !ResizeHistory()) {
+        Logger::Warning("FrameGenerationStage: Keeping the %d-frame history", m_history->GetCapacity());
+        m_historyLength = m_history->GetCapacity();
+    }
+}
+
+void FrameGenerationStage::SetZeroCopyHistory(bool enabled) {
+    if (m_zeroCopyHistory != enabled && m_history) {
+        // Imported entries are only valid under the previous guarantee
+        m_history->Clear();
+    }
+    m_zeroCopyHistory = enabled;
+}
+
+const FrameHistory* FrameGenerationStage::GetFrameHistory() const {
+    return m_history.get();
+}
+
 void* FrameGenerationStage::GetGeneratedFrameBuffer() const {
     return m_generatedFrameBuffer;
 }
 
 bool FrameGenerationStage::IsReady() const {
     // We need at least two frames in history to generate intermediate frames
-    return m_data->initialized && m_previousFrames[0] != nullptr;
+    return m_data->initialized && m_history && m_history->GetCount() >= 2;
 }
 
 bool FrameGenerationStage::InitializeResources(const XISContext* context) {
     IRenderer* renderer = context->GetRenderer();
+    m_data->renderer = renderer;
     
     // Create motion vector texture
     m_data->motionVectorTexture = renderer->CreateTexture2D(
@@ -189,17 +228,48 @@ bool FrameGenerationStage::InitializeResources(const XISContext* context) {
         Logger::Error("FrameGenerationStage: Failed to create generated frame buffer");
         return false;
     }
+
+    // Create the history ring at the frame size
+    m_history = std::make_unique<FrameHistory>(m_historyLength);
+    if (!m_history->Initialize(renderer, m_data->frameWidth, m_data->frameHeight, m_data->format)) {
+        Logger::Error("FrameGenerationStage: Failed to create the frame history");
+        m_history.reset();
+        return false;
+    }
     
     return true;
 }
 
-bool FrameGenerationStage::UpdateMotionVectors(const XISContext* context, void* currentFrame) {
-    // Get previous frame - if none, return success (nothing to do yet)
-    void* previousFrame = m_previousFrames[0];
-    if (!previousFrame) {
-        return true;
+bool FrameGenerationStage::ResizeHistory() {
+    auto history = std::make_unique<FrameHistory>(m_historyLength);
+    if (!history->Initialize(m_data->renderer, m_data->frameWidth, m_data->frameHeight, m_data->format)) {
+        Logger::Error("FrameGenerationStage: Failed to create a %d-frame history", m_historyLength);
+        return false;
     }
-    
+
+    // Carry over the most recent consecutive frames, oldest first so that
+    // their ages are unchanged in the new ring
+    int kept = 0;
+    while (kept < history->GetCapacity() && m_history->Get(kept)) {
+        kept++;
+    }
+    for (int age = kept - 1; age >= 0; age--) {
+        void* texture = m_history->Get(age).GetTexture();
+        FrameHistory::FrameRef frame = m_zeroCopyHistory ? history->Import(texture)
+                                                         : history->Capture(texture);
+        if (!frame) {
+            // A gap would shift the ages: restart from an empty history
+            history->Clear();
+            break;
+        }
+    }
+
+    m_history = std::move(history);
+    Logger::Info("FrameGenerationStage: History resized to %d frames", m_historyLength);
+    return true;
+}
+
+bool FrameGenerationStage::UpdateMotionVectors(const XISContext* context, void* previousFrame, void* currentFrame) {
     // Calculate motion vectors between previous and current frame
     return m_data->frameInterpolator.CalculateMotionVectors(
         context,
@@ -223,7 +293,7 @@ bool FrameGenerationStage::GenerateIntermediateFrames(
         m_data->motionVectorTexture,
         m_generatedFrameBuffer,
         m_generationFactor,
-        params.frameGenerationQuality
+        params.qualityFactor
     );
 }
 
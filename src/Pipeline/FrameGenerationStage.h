@@ -1,72 +1,86 @@
 #pragma once
 
 #include "../Core/XISContext.h"
+#include "../Core/XISParameters.h"
+#include "FrameHistory.h"
 #include <memory>
 
 namespace XIS {
 
-class FrameInterpolation {
+class FrameGenerationStage {
 public:
-    FrameInterpolation();
-    ~FrameInterpolation();
+    FrameGenerationStage();
+    ~FrameGenerationStage();
 
     bool Initialize(const XISContext* context);
     void Shutdown();
 
-    // Calculate motion vectors between two frames
-    bool CalculateMotionVectors(
+    // Generate intermediate frames from the input and write the current frame to the output
+    bool Process(
         const XISContext* context,
-        void* previousFrame,
-        void* currentFrame,
-        void* motionVectorTexture
+        void* inputTexture,
+        void* outputTexture,
+        const XISParameters& params
     );
 
-    // Generate intermediate frames between two input frames
-    bool GenerateFrames(
-        const XISContext* context,
-        void* previousFrame,
-        void* currentFrame,
-        void* motionVectorTexture,
-        void* outputFrameBuffer,
-        int generationFactor,
-        float qualityFactor
-    );
+    // Number of intermediate frames generated between two input frames
+    void SetGenerationFactor(int factor);
+
+    // Block-matching search radius used for motion estimation, in pixels
+    void SetMotionSearchRadius(int radius);
+
+    // Block size used for motion estimation, in pixels
+    void SetMotionBlockSize(int blockSize);
+
+    // Number of input frames kept in the history ring (at least 2).
+    // An initialized stage resizes its ring and keeps the most recent frames.
+    // Must not be called while Process is running.
+    void SetHistoryLength(int frames);
+
+    // Reference input textures in the history instead of copying them.
+    // The caller guarantees each input stays valid and unmodified for the
+    // next history length frames. When disabled (the default), or when the
+    // stage input is a pipeline intermediate rather than params.inputTexture,
+    // the input is copied once and may be recycled as soon as Process returns.
+    void SetZeroCopyHistory(bool enabled);
+
+    // Input frame history, shared by motion estimation, interpolation and
+    // temporal features
+    const FrameHistory* GetFrameHistory() const;
+
+    void* GetGeneratedFrameBuffer() const;
+
+    // True once enough history is available to generate intermediate frames
+    bool IsReady() const;
 
 private:
-    struct FrameInterpolationData;
-    std::unique_ptr<FrameInterpolationData> m_data;
+    struct FrameGenerationStageData;
+    std::unique_ptr<FrameGenerationStageData> m_data;
 
-    // Initialize shader resources
-    bool InitializeShaders(const XISContext* context);
+    void* m_generatedFrameBuffer;
+    int m_generationFactor;
 
-    // Create compute buffers for intermediate computations
-    bool CreateComputeBuffers(const XISContext* context);
-    
-    // Helper method to calculate block-based motion estimation
-    bool CalculateBlockMotion(
-        const XISContext* context,
-        void* previousFrame,
-        void* currentFrame,
-        void* blockMotionBuffer
-    );
-    
-    // Refine motion vectors using optical flow techniques
-    bool RefineMotionVectors(
-        const XISContext* context,
-        void* blockMotionBuffer,
-        void* motionVectorTexture
-    );
-    
-    // Generate a single intermediate frame at the specified time position
-    bool GenerateIntermediateFrame(
+    // Frames captured once per Process, newest first
+    std::unique_ptr<FrameHistory> m_history;
+    int m_historyLength;
+    bool m_zeroCopyHistory;
+
+    // Create the motion vector texture and the generated frame buffer
+    bool InitializeResources(const XISContext* context);
+
+    // Replace the history ring with one of m_historyLength frames
+    bool ResizeHistory();
+
+    // Estimate motion between the previous frame and the current frame
+    bool UpdateMotionVectors(const XISContext* context, void* previousFrame, void* currentFrame);
+
+    // Generate the intermediate frames between the two input frames
+    bool GenerateIntermediateFrames(
         const XISContext* context,
         void* previousFrame,
         void* currentFrame,
-        void* motionVectorTexture,
-        void* outputTexture,
-        float timePosition, // 0.0 = previous frame, 1.0 = current frame
-        float qualityFactor
+        const XISParameters& params
     );
 };
 
-} // namespace XIS
\ No newline at end of file
+} // namespace XIS
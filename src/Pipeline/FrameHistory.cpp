@@ -0,0 +1,224 @@
+#include "FrameHistory.h"
+#include "../Renderer/IRenderer.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace XIS {
+
+struct FrameHistory::Slot {
+    void* texture = nullptr;              // Texture appartenant à l'historique
+    void* imported = nullptr;             // Texture de l'application (Import), prioritaire
+    uint64_t frameIndex = 0;
+    bool valid = false;
+    int refCount = 0;                     // FrameRef en cours, hors historique
+};
+
+// ---------------------------------------------------------------------------
+// FrameRef
+// ---------------------------------------------------------------------------
+
+FrameHistory::FrameRef::FrameRef(Slot* slot)
+    : m_slot(slot)
+{
+    if (m_slot) {
+        m_slot->refCount++;
+    }
+}
+
+FrameHistory::FrameRef::FrameRef(const FrameRef& other)
+    : FrameRef(other.m_slot)
+{
+}
+
+FrameHistory::FrameRef::FrameRef(FrameRef&& other) noexcept
+    : m_slot(other.m_slot)
+{
+    other.m_slot = nullptr;
+}
+
+FrameHistory::FrameRef& FrameHistory::FrameRef::operator=(FrameRef other) noexcept
+{
+    std::swap(m_slot, other.m_slot);
+    return *this;
+}
+
+FrameHistory::FrameRef::~FrameRef()
+{
+    if (m_slot) {
+        m_slot->refCount--;
+    }
+}
+
+void* FrameHistory::FrameRef::GetTexture() const
+{
+    if (!m_slot) {
+        return nullptr;
+    }
+    return m_slot->imported ? m_slot->imported : m_slot->texture;
+}
+
+uint64_t FrameHistory::FrameRef::GetFrameIndex() const
+{
+    return m_slot ? m_slot->frameIndex : 0;
+}
+
+// ---------------------------------------------------------------------------
+// FrameHistory
+// ---------------------------------------------------------------------------
+
+FrameHistory::FrameHistory(int capacity)
+    : m_renderer(nullptr),
+      m_capacity(std::max(capacity, 2)),
+      m_slots(new Slot[std::max(capacity, 2)]),
+      m_nextFrameIndex(0),
+      m_captureCount(0)
+{
+}
+
+FrameHistory::~FrameHistory()
+{
+    Shutdown();
+}
+
+bool FrameHistory::Initialize(IRenderer* renderer, int width, int height, int format)
+{
+    Shutdown();
+    if (!renderer) {
+        Logger::Error("FrameHistory: renderer invalide");
+        return false;
+    }
+    m_renderer = renderer;
+
+    for (int i = 0; i < m_capacity; i++) {
+        m_slots[i].texture = renderer->CreateTexture2D(width, height, format, true, "FrameHistory");
+        if (!m_slots[i].texture) {
+            Logger::Error("FrameHistory: échec de la création de la texture %d (%dx%d)", i, width, height);
+            Shutdown();
+            return false;
+        }
+    }
+    return true;
+}
+
+void FrameHistory::Shutdown()
+{
+    Clear();
+    for (int i = 0; i < m_capacity; i++) {
+        Slot& slot = m_slots[i];
+        // Une FrameRef qui survit à l'historique désignerait une texture libérée
+        if (slot.refCount > 0) {
+            Logger::Error("FrameHistory: texture %d libérée alors qu'elle est encore référencée (%d FrameRef)",
+                          i, slot.refCount);
+        }
+        assert(slot.refCount == 0 && "FrameHistory: FrameRef encore en cours à la libération");
+        if (slot.texture && m_renderer) {
+            m_renderer->ReleaseResource(slot.texture);
+        }
+        slot.texture = nullptr;
+    }
+    m_renderer = nullptr;
+}
+
+FrameHistory::Slot* FrameHistory::AcquireSlot()
+{
+    Slot* oldest = nullptr;
+    for (int i = 0; i < m_capacity; i++) {
+        Slot& slot = m_slots[i];
+        if (slot.refCount > 0) {
+            continue;
+        }
+        if (!slot.valid) {
+            return &slot;
+        }
+        if (!oldest || slot.frameIndex < oldest->frameIndex) {
+            oldest = &slot;
+        }
+    }
+
+    if (!oldest) {
+        Logger::Error("FrameHistory: les %d frames conservées sont toutes référencées", m_capacity);
+    }
+    return oldest;
+}
+
+FrameHistory::FrameRef FrameHistory::Capture(void* inputTexture)
+{
+    if (!inputTexture) {
+        return FrameRef();
+    }
+
+    Slot* slot = AcquireSlot();
+    if (!slot || !slot->texture) {
+        return FrameRef();
+    }
+
+    // L'emplacement est invalidé avant la copie pour qu'un échec ne laisse
+    // pas une frame ancienne passer pour la plus récente
+    slot->valid = false;
+    slot->imported = nullptr;
+    if (!m_renderer->CopyResource(inputTexture, slot->texture)) {
+        Logger::Error("FrameHistory: échec de la copie de la frame d'entrée");
+        return FrameRef();
+    }
+
+    slot->frameIndex = m_nextFrameIndex++;
+    slot->valid = true;
+    m_captureCount++;
+    return FrameRef(slot);
+}
+
+FrameHistory::FrameRef FrameHistory::Import(void* inputTexture)
+{
+    if (!inputTexture) {
+        return FrameRef();
+    }
+
+    Slot* slot = AcquireSlot();
+    if (!slot) {
+        return FrameRef();
+    }
+
+    slot->imported = inputTexture;
+    slot->frameIndex = m_nextFrameIndex++;
+    slot->valid = true;
+    return FrameRef(slot);
+}
+
+FrameHistory::FrameRef FrameHistory::Get(int age) const
+{
+    if (age < 0 || static_cast<uint64_t>(age) >= m_nextFrameIndex) {
+        return FrameRef();
+    }
+
+    uint64_t frameIndex = m_nextFrameIndex - 1 - static_cast<uint64_t>(age);
+    for (int i = 0; i < m_capacity; i++) {
+        Slot& slot = m_slots[i];
+        if (slot.valid && slot.frameIndex == frameIndex) {
+            return FrameRef(&slot);
+        }
+    }
+    return FrameRef();
+}
+
+void FrameHistory::Clear()
+{
+    for (int i = 0; i < m_capacity; i++) {
+        m_slots[i].valid = false;
+        m_slots[i].imported = nullptr;
+    }
+}
+
+int FrameHistory::GetCount() const
+{
+    int count = 0;
+    for (int i = 0; i < m_capacity; i++) {
+        if (m_slots[i].valid) {
+            count++;
+        }
+    }
+    return count;
+}
+
+} // namespace XIS
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace XIS {
+
+// Déclarations anticipées
+class IRenderer;
+
+/**
+ * @brief Historique circulaire des frames d'entrée
+ *
+ * Conserve les dernières frames d'entrée dans des textures appartenant à
+ * l'historique : chaque entrée est copiée une seule fois (Capture), puis
+ * partagée par l'estimation de mouvement, l'interpolation et les effets
+ * temporels, sans dépendre des textures de l'application qui peuvent être
+ * recyclées dès la fin de la frame. Une application qui garantit la durée
+ * de vie de ses entrées peut les faire référencer sans copie (Import).
+ *
+ * Les frames sont tenues par des FrameRef à compteur de références : un
+ * emplacement n'est réutilisé pour une nouvelle frame que lorsque plus
+ * aucune FrameRef ne le désigne. Les FrameRef ne doivent pas survivre à
+ * l'historique. Une instance n'est utilisée que par le thread de sa session.
+ */
+class FrameHistory {
+    struct Slot;
+
+public:
+    /**
+     * @brief Référence comptée sur une frame de l'historique
+     */
+    class FrameRef {
+    public:
+        FrameRef() = default;
+        FrameRef(const FrameRef& other);
+        FrameRef(FrameRef&& other) noexcept;
+        FrameRef& operator=(FrameRef other) noexcept;
+        ~FrameRef();
+
+        /**
+         * @brief Texture de la frame (texture de l'historique, ou de l'application si importée)
+         */
+        void* GetTexture() const;
+
+        /**
+         * @brief Numéro de la frame, croissant depuis la création de l'historique
+         */
+        uint64_t GetFrameIndex() const;
+
+        explicit operator bool() const { return m_slot != nullptr; }
+
+    private:
+        friend class FrameHistory;
+        explicit FrameRef(Slot* slot);
+
+        Slot* m_slot = nullptr;
+    };
+
+    /**
+     * @param capacity Nombre de frames conservées (2 au minimum : courante et précédente)
+     */
+    explicit FrameHistory(int capacity = 2);
+    ~FrameHistory();
+
+    FrameHistory(const FrameHistory&) = delete;
+    FrameHistory& operator=(const FrameHistory&) = delete;
+
+    /**
+     * @brief Crée les textures de l'historique ; les frames conservées sont oubliées
+     *
+     * @return true si toutes les textures ont été créées
+     */
+    bool Initialize(IRenderer* renderer, int width, int height, int format);
+
+    /**
+     * @brief Libère les textures de l'historique
+     *
+     * Aucune FrameRef ne doit être en cours (assertion en debug, erreur
+     * journalisée sinon).
+     */
+    void Shutdown();
+
+    /**
+     * @brief Copie une frame d'entrée dans l'historique
+     *
+     * La frame devient la plus récente ; l'emplacement libre le plus ancien
+     * est réutilisé.
+     *
+     * @return La frame copiée, vide si la copie échoue ou si tous les emplacements sont référencés
+     */
+    FrameRef Capture(void* inputTexture);
+
+    /**
+     * @brief Ajoute une frame d'entrée sans la copier
+     *
+     * L'application garantit que la texture reste valide et inchangée tant
+     * qu'elle est dans l'historique (capacity frames) ou référencée.
+     *
+     * @return La frame importée, vide si tous les emplacements sont référencés
+     */
+    FrameRef Import(void* inputTexture);
+
+    /**
+     * @brief Frame conservée
+     *
+     * @param age 0 pour la plus récente, 1 pour la précédente...
+     * @return La frame, vide si l'historique n'en contient pas autant
+     */
+    FrameRef Get(int age) const;
+
+    /**
+     * @brief Oublie les frames conservées (changement de scène), sans libérer les textures
+     */
+    void Clear();
+
+    int GetCapacity() const { return m_capacity; }
+    int GetCount() const;
+
+    /**
+     * @brief Frames copiées depuis la création (les imports ne sont pas comptés)
+     */
+    uint64_t GetCaptureCount() const { return m_captureCount; }
+
+private:
+    // Emplacement le plus ancien sans référence, nullptr si tous sont référencés
+    Slot* AcquireSlot();
+
+    IRenderer* m_renderer;
+    int m_capacity;
+    std::unique_ptr<Slot[]> m_slots;
+    uint64_t m_nextFrameIndex;
+    uint64_t m_captureCount;
+};
+
+} // namespace XIS
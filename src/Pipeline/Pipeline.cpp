@@ -6,21 +6,56 @@
 #include "AntiAliasingStage.h"
 #include "UpscalingStage.h"
 #include "SharpnessStage.h"
-#include "FrameGenStage.h"
+#include "FrameGenerationStage.h"
 #include "../Algorithms/BicubicUpscaler.h"
-#include "../Algorithms/FrameInterpolator.h"
 #include "../Utils/Logger.h"
 #include "../Utils/PerfMonitor.h"
+#include "../Utils/FrameCapture.h"
+#include "../Utils/ConfigManager.h"
+#include "../Renderer/ConstantBlock.h"
+#include <algorithm>
+#include <iterator>
 
 namespace XIS {
 
-Pipeline::Pipeline(std::shared_ptr<IRenderer> renderer)
-    : m_renderer(renderer),
-      m_upscalingEnabled(true),
-      m_frameGenEnabled(true),
-      m_antiAliasingEnabled(true),
-      m_sharpnessEnabled(true)
+namespace {
+
+    bool SameUpscalingParameters(const UpscalingParameters& a, const UpscalingParameters& b)
+    {
+        return a.mode == b.mode &&
+               a.sharpnessStrength == b.sharpnessStrength &&
+               a.edgePreservation == b.edgePreservation &&
+               a.outputWidth == b.outputWidth &&
+               a.outputHeight == b.outputHeight &&
+               a.preserveFilmGrain == b.preserveFilmGrain;
+    }
+
+    bool SameDynamicResolutionParameters(const DynamicResolutionParameters& a, const DynamicResolutionParameters& b)
+    {
+        return a.enabled == b.enabled &&
+               a.frameTimeBudgetMs == b.frameTimeBudgetMs &&
+               a.hysteresisPercent == b.hysteresisPercent &&
+               a.minInputScale == b.minInputScale &&
+               a.maxInputScale == b.maxInputScale &&
+               a.minSearchRadius == b.minSearchRadius &&
+               a.maxSearchRadius == b.maxSearchRadius &&
+               a.proportionalGain == b.proportionalGain &&
+               a.integralGain == b.integralGain &&
+               a.derivativeGain == b.derivativeGain;
+    }
+
+} // namespace
+
+Pipeline::Pipeline(XISContext* context)
+    : m_context(context),
+      m_renderer(context->GetSharedRenderer()),
+      m_perfMonitor(std::make_unique<PerfMonitor>())
 {
+    m_stageIds.downsample = m_perfMonitor->RegisterStage("Downsample");
+    m_stageIds.antiAliasing = m_perfMonitor->RegisterStage("AntiAliasing");
+    m_stageIds.upscaling = m_perfMonitor->RegisterStage("Upscaling");
+    m_stageIds.frameGen = m_perfMonitor->RegisterStage("FrameGen");
+    m_stageIds.sharpness = m_perfMonitor->RegisterStage("Sharpness");
 }
 
 Pipeline::~Pipeline() = default;
@@ -28,72 +63,252 @@ Pipeline::~Pipeline() = default;
 bool Pipeline::Initialize(const XISConfig& config)
 {
     m_config = config;
+    m_configChannel.Reset(config);
+    m_shaderPath = config.shaderPath ? config.shaderPath : "";
+    m_resolutionController.Configure(config.dynamicResolution, config.aaQuality, config.dynamicResolution.maxSearchRadius);
+    m_perfMonitor->SetLatencyWindow(config.latencyWindowSeconds);
+    m_tuningProfile = ConfigManager::GetTuningProfile();
     
-    // Initialiser les états d'activation en fonction de la configuration
-    m_upscalingEnabled = config.enableBicubicUpscaling;
-    m_frameGenEnabled = config.enableFrameGeneration;
-    m_antiAliasingEnabled = config.enableAntiAliasing;
-    m_sharpnessEnabled = config.enableSharpness;
-    
-    // Initialiser les algorithmes partagés
-    m_bicubicUpscaler = std::make_shared<BicubicUpscaler>();
-    if (!m_bicubicUpscaler->Initialize(m_renderer)) {
-        Logger::Error("Échec de l'initialisation de BicubicUpscaler");
+    // Seules les étapes activées sont créées ; les autres le seront à leur
+    // première activation
+    if (!UpdateStageResidency()) {
         return false;
     }
     
-    m_frameInterpolator = std::make_shared<FrameInterpolator>();
-    if (!m_frameInterpolator->Initialize(m_renderer)) {
-        Logger::Error("Échec de l'initialisation de FrameInterpolator");
+    Logger::Info("Pipeline: étapes activées initialisées avec succès");
+    return true;
+}
+
+bool Pipeline::IsStageWanted(StageSlot slot) const
+{
+    switch (slot) {
+    case kDownsampleSlot:
+        // La résolution dynamique peut réduire l'entrée à toute frame, et un
+        // plafond de qualité bas la réduit même sans régulateur
+        return m_config.upscalingParams.mode == UpscalingMode::BicubicAdaptive || m_config.dynamicResolution.enabled ||
+               m_resolutionController.GetOperatingPoint().inputScale < 1.0f;
+    case kAntiAliasingSlot:
+        return m_config.enableAntiAliasing && m_config.aaQuality != AAQuality::Off;
+    case kUpscalingSlot:
+        return m_config.enableBicubicUpscaling;
+    case kFrameGenSlot:
+        // Les tampons de l'étape sont à la taille du back buffer : tant
+        // qu'elle est inconnue, l'étape attend la première frame
+        return m_config.enableFrameGeneration && m_context->GetBackBufferWidth() > 0;
+    case kSharpnessSlot:
+        return m_config.enableSharpness;
+    default:
         return false;
     }
-    
-    // Initialiser les étapes du pipeline
-    return InitializeStages();
 }
 
-bool Pipeline::InitializeStages()
+bool Pipeline::IsStageCreated(StageSlot slot) const
 {
-    // Créer et initialiser les étapes du pipeline
-    m_downsampleStage = std::make_unique<DownsampleStage>(m_renderer);
-    if (!m_downsampleStage->Initialize()) {
-        Logger::Error("Échec de l'initialisation de DownsampleStage");
+    switch (slot) {
+    case kDownsampleSlot:
+        return m_downsampleStage != nullptr;
+    case kAntiAliasingSlot:
+        return m_antiAliasingStage != nullptr;
+    case kUpscalingSlot:
+        return m_upscalingStage != nullptr;
+    case kFrameGenSlot:
+        return m_frameGenStage != nullptr;
+    case kSharpnessSlot:
+        return m_sharpnessStage != nullptr;
+    default:
         return false;
     }
+}
+
+bool Pipeline::CreateStage(StageSlot slot)
+{
+    // Les étapes sont initialisées avec la configuration active ; les
+    // réglages d'autotuning seront réappliqués à la frame suivante
+    std::fill(std::begin(m_tunedResolution), std::end(m_tunedResolution), 0);
     
-    m_antiAliasingStage = std::make_unique<AntiAliasingStage>(m_renderer);
-    if (!m_antiAliasingStage->Initialize(m_config.aaQuality)) {
-        Logger::Error("Échec de l'initialisation de AntiAliasingStage");
-        return false;
+    switch (slot) {
+    case kDownsampleSlot: {
+        auto stage = std::make_unique<DownsampleStage>(m_renderer);
+        if (!stage->Initialize()) {
+            Logger::Error("Échec de l'initialisation de DownsampleStage");
+            return false;
+        }
+        m_downsampleStage = std::move(stage);
+        return true;
     }
-    
-    m_upscalingStage = std::make_unique<UpscalingStage>(m_renderer, m_bicubicUpscaler);
-    if (!m_upscalingStage->Initialize(m_config.upscalingParams)) {
-        Logger::Error("Échec de l'initialisation de UpscalingStage");
+    case kAntiAliasingSlot: {
+        auto stage = std::make_unique<AntiAliasingStage>(m_renderer);
+        if (!stage->Initialize(m_config.aaQuality)) {
+            Logger::Error("Échec de l'initialisation de AntiAliasingStage");
+            return false;
+        }
+        m_antiAliasingStage = std::move(stage);
+        return true;
+    }
+    case kUpscalingSlot: {
+        auto upscaler = std::make_shared<BicubicUpscaler>();
+        if (!upscaler->Initialize(m_context)) {
+            Logger::Error("Échec de l'initialisation de BicubicUpscaler");
+            return false;
+        }
+        auto stage = std::make_unique<UpscalingStage>(m_context, upscaler);
+        if (!stage->Initialize(m_config.upscalingParams)) {
+            Logger::Error("Échec de l'initialisation de UpscalingStage");
+            return false;
+        }
+        m_bicubicUpscaler = std::move(upscaler);
+        m_upscalingStage = std::move(stage);
+        return true;
+    }
+    case kFrameGenSlot: {
+        auto stage = std::make_unique<FrameGenerationStage>();
+        stage->SetHistoryLength(static_cast<int>(m_config.frameGenParams.historyLength));
+        stage->SetZeroCopyHistory(m_config.frameGenParams.zeroCopyHistory);
+        if (!stage->Initialize(m_context)) {
+            Logger::Error("Échec de l'initialisation de FrameGenerationStage");
+            return false;
+        }
+        m_frameGenStage = std::move(stage);
+        return true;
+    }
+    case kSharpnessSlot: {
+        auto stage = std::make_unique<SharpnessStage>(m_renderer);
+        if (!stage->Initialize(m_config.upscalingParams.sharpnessStrength)) {
+            Logger::Error("Échec de l'initialisation de SharpnessStage");
+            return false;
+        }
+        m_sharpnessStage = std::move(stage);
+        return true;
+    }
+    default:
         return false;
     }
+}
+
+void Pipeline::ReleaseStage(StageSlot slot)
+{
+    // Les étapes libèrent leurs shaders, tampons et textures à leur destruction
+    switch (slot) {
+    case kDownsampleSlot:
+        m_downsampleStage.reset();
+        break;
+    case kAntiAliasingSlot:
+        m_antiAliasingStage.reset();
+        break;
+    case kUpscalingSlot:
+        m_upscalingStage.reset();
+        m_bicubicUpscaler.reset();
+        break;
+    case kFrameGenSlot:
+        m_frameGenStage.reset();
+        break;
+    case kSharpnessSlot:
+        m_sharpnessStage.reset();
+        break;
+    default:
+        break;
+    }
+}
+
+bool Pipeline::UpdateStageResidency()
+{
+    static const char* const kStageNames[kStageSlotCount] = {
+        "Downsample", "AntiAliasing", "Upscaling", "FrameGen", "Sharpness"
+    };
     
-    m_sharpnessStage = std::make_unique<SharpnessStage>(m_renderer);
-    if (!m_sharpnessStage->Initialize(m_config.upscalingParams.sharpnessStrength)) {
-        Logger::Error("Échec de l'initialisation de SharpnessStage");
-        return false;
+    auto now = std::chrono::steady_clock::now();
+    auto releaseDelay = std::chrono::duration<float>(m_config.stageReleaseDelaySeconds);
+    
+    bool success = true;
+    for (int i = 0; i < kStageSlotCount; i++) {
+        StageSlot slot = static_cast<StageSlot>(i);
+        bool created = IsStageCreated(slot);
+        
+        if (IsStageWanted(slot)) {
+            m_stageLastWanted[i] = now;
+            if (!created) {
+                if (!CreateStage(slot)) {
+                    success = false;
+                    continue;
+                }
+                Logger::Info("Pipeline: étape %s créée", kStageNames[i]);
+            }
+        } else if (created && now - m_stageLastWanted[i] >= releaseDelay) {
+            ReleaseStage(slot);
+            Logger::Info("Pipeline: étape %s libérée après %.1f s sans utilisation",
+                         kStageNames[i], m_config.stageReleaseDelaySeconds);
+        }
     }
+    return success;
+}
+
+bool Pipeline::Execute(const XISParameters& params, ShedLevel shedLevel, uint64_t queuedSince)
+{
+    // Démarrer le monitoring de performance
+    PerfMonitor* perfMonitor = m_perfMonitor.get();
+    perfMonitor->StartFrame(queuedSince);
+    uint64_t constantUploadsAtStart = ConstantUploadCounter::GetThreadCount();
+    m_lastFrameTiming.frameGenTimeMs = 0.0f;
     
-    m_frameGenStage = std::make_unique<FrameGenStage>(m_renderer, m_frameInterpolator);
-    if (!m_frameGenStage->Initialize(m_config.frameGenParams)) {
-        Logger::Error("Échec de l'initialisation de FrameGenStage");
-        return false;
+    bool success = ExecuteStages(params, shedLevel);
+    
+    // Terminer le monitoring de performance, y compris pour une frame
+    // ignorée ou simplement copiée.
+    // Les statistiques agrégées arrivent de manière asynchrone ; le temps de
+    // frame mesuré directement sert au réglage de la résolution dynamique
+    float frameTimeMs = perfMonitor->EndFrame();
+    m_lastFrameTiming.frameTimeMs = frameTimeMs;
+    XISPerformanceStats perfStats = perfMonitor->GetStats();
+    perfStats.constantBufferUploads = static_cast<uint32_t>(ConstantUploadCounter::GetThreadCount() - constantUploadsAtStart);
+    
+    // Rapporter le point de fonctionnement utilisé, puis choisir celui de la
+    // frame suivante. qualityFactor plafonne la qualité, que la résolution
+    // dynamique soit active ou non.
+    perfStats.operatingPoint = m_resolutionController.GetOperatingPoint();
+    m_perfStats.Store(perfStats);
+    if (success) {
+        m_resolutionController.Update(frameTimeMs, params.qualityFactor);
     }
     
-    Logger::Info("Toutes les étapes du pipeline ont été initialisées avec succès");
-    return true;
+    // Nettoyer les ressources intermédiaires
+    m_renderer->ReleaseIntermediateResources();
+    
+    return success;
 }
 
-bool Pipeline::Execute(const XISParameters& params)
+bool Pipeline::ExecuteStages(const XISParameters& params, ShedLevel shedLevel)
 {
-    // Démarrer le monitoring de performance
-    auto perfMonitor = PerfMonitor::GetInstance();
-    perfMonitor->StartFrame();
+    PerfMonitor* perfMonitor = m_perfMonitor.get();
+    
+    // Prendre en compte les réglages publiés depuis la frame précédente
+    bool configChanged = ApplyPendingConfig();
+    
+    // Taille de sortie non configurée : déduite de la première frame
+    if (m_context->GetBackBufferWidth() <= 0) {
+        int width = 0;
+        int height = 0;
+        int format = 0;
+        if (m_renderer->ReadTexture(params.outputTexture, width, height, format, nullptr)) {
+            m_context->SetBackBuffer(width, height, format);
+        }
+    }
+    
+    // Rejeu : point de fonctionnement enregistré plutôt que celui du régulateur.
+    // Appliqué avant la résidence des étapes, dont le downsampling dépend
+    if (m_hasForcedOperatingPoint) {
+        m_resolutionController.Override(m_forcedOperatingPoint);
+        m_hasForcedOperatingPoint = false;
+    }
+    
+    // Créer les étapes nouvellement activées, libérer celles qui ne servent plus
+    if (!UpdateStageResidency()) {
+        Logger::Error("Pipeline: étapes requises indisponibles, frame ignorée");
+        return false;
+    }
+    
+    if (m_captureActive.load(std::memory_order_acquire)) {
+        RecordFrame(params, shedLevel, configChanged);
+    }
     
     // Préparer les ressources pour le pipeline
     void* currentInput = params.inputTexture;
@@ -101,8 +316,8 @@ bool Pipeline::Execute(const XISParameters& params)
     void* finalOutput = params.outputTexture;
     
     // Vérifier si nous avons des étapes activées
-    bool anyStageEnabled = m_upscalingEnabled || m_frameGenEnabled || 
-                          m_antiAliasingEnabled || m_sharpnessEnabled;
+    bool anyStageEnabled = m_config.enableBicubicUpscaling || m_config.enableFrameGeneration || 
+                          m_config.enableAntiAliasing || m_config.enableSharpness;
     
     if (!anyStageEnabled) {
         // Aucune étape activée, copier directement l'entrée vers la sortie
@@ -113,107 +328,321 @@ bool Pipeline::Execute(const XISParameters& params)
     // Créer des textures intermédiaires selon les besoins
     m_renderer->CreateIntermediateResources(params);
     
-    // 1. Étape optionnelle de downsampling (pour réduire le bruit avant upscaling)
-    if (m_config.upscalingParams.mode == UpscalingMode::BicubicAdaptive) {
-        perfMonitor->StartStage("Downsample");
+    // Réglages du profil d'autotuning pour cette paire de résolutions
+    if (m_tuningProfile) {
+        ApplyTuning(params);
+    }
+    
+    // Point de fonctionnement choisi à la fin de la frame précédente par la
+    // résolution dynamique ou le plafond de qualité de l'application
+    const XISOperatingPoint& operatingPoint = m_resolutionController.GetOperatingPoint();
+    bool adjusted = m_resolutionController.IsActive();
+    
+    // 1. Étape optionnelle de downsampling (pour réduire le bruit avant upscaling,
+    //    ou réduire l'échelle d'entrée lorsque le budget de temps l'exige)
+    // Une étape absente est sautée plutôt que déréférencée : sa résidence ne
+    // suit pas forcément les conditions d'exécution ci-dessous
+    bool reduceInput = adjusted && operatingPoint.inputScale < 1.0f;
+    if (m_downsampleStage && (m_config.upscalingParams.mode == UpscalingMode::BicubicAdaptive || reduceInput)) {
+        perfMonitor->StartStage(m_stageIds.downsample);
         intermediateOutput = m_renderer->GetIntermediateResource(0);
-        m_downsampleStage->Process(currentInput, intermediateOutput);
+        m_downsampleStage->Process(currentInput, intermediateOutput, reduceInput ? operatingPoint.inputScale : 0.0f);
         currentInput = intermediateOutput;
-        perfMonitor->EndStage("Downsample");
+        m_renderer->Flush();
+        perfMonitor->EndStage(m_stageIds.downsample);
     }
     
     // 2. Étape d'antialiasing
-    if (m_antiAliasingEnabled && m_config.aaQuality != AAQuality::Off) {
-        perfMonitor->StartStage("AntiAliasing");
+    if (m_antiAliasingStage && m_config.enableAntiAliasing && m_config.aaQuality != AAQuality::Off) {
+        perfMonitor->StartStage(m_stageIds.antiAliasing);
         intermediateOutput = m_renderer->GetIntermediateResource(1);
-        m_antiAliasingStage->Process(currentInput, intermediateOutput);
+        
+        // Délestage : qualité immédiatement inférieure pour cette frame seulement
+        AAQuality quality = m_config.aaQuality;
+        if (adjusted && operatingPoint.aaQuality < quality) {
+            quality = operatingPoint.aaQuality;
+        }
+        if (shedLevel >= ShedLevel::ReduceAntiAliasing && quality != AAQuality::Low) {
+            quality = static_cast<AAQuality>(static_cast<int>(quality) - 1);
+        }
+        
+        m_antiAliasingStage->Process(currentInput, intermediateOutput, quality);
+        
         currentInput = intermediateOutput;
-        perfMonitor->EndStage("AntiAliasing");
+        m_renderer->Flush();
+        perfMonitor->EndStage(m_stageIds.antiAliasing);
     }
     
     // 3. Étape d'upscaling bicubique
-    if (m_upscalingEnabled) {
-        perfMonitor->StartStage("Upscaling");
+    if (m_upscalingStage && m_config.enableBicubicUpscaling) {
+        perfMonitor->StartStage(m_stageIds.upscaling);
         intermediateOutput = m_renderer->GetIntermediateResource(2);
         m_upscalingStage->Process(currentInput, intermediateOutput);
         currentInput = intermediateOutput;
-        perfMonitor->EndStage("Upscaling");
+        m_renderer->Flush();
+        perfMonitor->EndStage(m_stageIds.upscaling);
     }
     
     // 4. Étape de génération/interpolation de frames
-    if (m_frameGenEnabled) {
-        perfMonitor->StartStage("FrameGen");
+    if (m_frameGenStage && m_config.enableFrameGeneration && shedLevel < ShedLevel::SkipFrameGeneration) {
+        perfMonitor->StartStage(m_stageIds.frameGen);
+        auto frameGenStart = std::chrono::steady_clock::now();
         intermediateOutput = m_renderer->GetIntermediateResource(3);
-        m_frameGenStage->Process(currentInput, intermediateOutput, params.frameDeltaTime);
+        // Rayon du point de fonctionnement, sinon celui du profil d'autotuning
+        // ou de la configuration
+        uint32_t searchRadius = adjusted ? operatingPoint.motionSearchRadius
+                              : m_tunedSearchRadius > 0 ? static_cast<uint32_t>(m_tunedSearchRadius)
+                              : m_config.dynamicResolution.maxSearchRadius;
+        m_frameGenStage->SetMotionSearchRadius(static_cast<int>(searchRadius));
+        m_frameGenStage->Process(m_context, currentInput, intermediateOutput, params);
+        if (params.generatedFrameTexture && m_frameGenStage->IsReady()) {
+            m_renderer->CopyResource(m_frameGenStage->GetGeneratedFrameBuffer(), params.generatedFrameTexture);
+        }
         currentInput = intermediateOutput;
-        perfMonitor->EndStage("FrameGen");
+        m_renderer->Flush();
+        m_lastFrameTiming.frameGenTimeMs =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameGenStart).count();
+        perfMonitor->EndStage(m_stageIds.frameGen);
     }
     
     // 5. Étape d'amélioration de la netteté
-    if (m_sharpnessEnabled) {
-        perfMonitor->StartStage("Sharpness");
+    if (m_sharpnessStage && m_config.enableSharpness) {
+        perfMonitor->StartStage(m_stageIds.sharpness);
         m_sharpnessStage->Process(currentInput, finalOutput);
-        perfMonitor->EndStage("Sharpness");
+        m_renderer->Flush();
+        perfMonitor->EndStage(m_stageIds.sharpness);
     } else {
-        // Copier le résultat final si l'étape de netteté est désactivée
+        // Copier le résultat final si l'étape de netteté est désactivée ou absente
         m_renderer->CopyResource(currentInput, finalOutput);
     }
     
-    // Terminer le monitoring de performance
-    perfMonitor->EndFrame();
-    m_perfStats = perfMonitor->GetStats();
+    return true;
+}
+
+void Pipeline::ApplyTuning(const XISParameters& params)
+{
+    int resolution[4];
+    int format;
+    if (!m_renderer->ReadTexture(params.inputTexture, resolution[0], resolution[1], format, nullptr) ||
+        !m_renderer->ReadTexture(params.outputTexture, resolution[2], resolution[3], format, nullptr)) {
+        // Backend incapable de décrire ses textures : réglages par défaut
+        return;
+    }
     
-    // Nettoyer les ressources intermédiaires
-    m_renderer->ReleaseIntermediateResources();
+    if (std::equal(resolution, resolution + 4, m_tunedResolution)) {
+        return;
+    }
+    std::copy(resolution, resolution + 4, m_tunedResolution);
+    
+    bool exactMatch = false;
+    TuningParameters tuning = m_tuningProfile->Find(resolution[0], resolution[1], resolution[2], resolution[3], &exactMatch);
+    
+    // Les étapes non créées recevront ces réglages à leur création
+    if (m_frameGenStage) {
+        m_frameGenStage->SetMotionBlockSize(tuning.motionBlockSize);
+    }
+    // Appliqué à chaque frame tant que le point de fonctionnement ne l'impose pas
+    m_tunedSearchRadius = tuning.motionSearchRadius;
+    if (m_antiAliasingStage) {
+        m_antiAliasingStage->SetKernelSize(AAQuality::Low, tuning.aaKernelSize[0]);
+        m_antiAliasingStage->SetKernelSize(AAQuality::Medium, tuning.aaKernelSize[1]);
+        m_antiAliasingStage->SetKernelSize(AAQuality::High, tuning.aaKernelSize[2]);
+    }
+    m_renderer->SetParallelism(tuning.workerThreads, tuning.rowsPerTask);
+    
+    Logger::Info("Pipeline: réglages d'autotuning %dx%d -> %dx%d%s : blocs %d, rayon %d, %u threads",
+                 resolution[0], resolution[1], resolution[2], resolution[3],
+                 exactMatch ? "" : " (résolution voisine)",
+                 tuning.motionBlockSize, tuning.motionSearchRadius, tuning.workerThreads);
+}
+
+bool Pipeline::ApplyPendingConfig()
+{
+    std::unique_ptr<XISConfig> pending = m_configChannel.TakePending();
+    if (!pending) {
+        return false;
+    }
+    
+    const XISConfig& next = *pending;
     
+    if (!SameUpscalingParameters(next.upscalingParams, m_config.upscalingParams)) {
+        if (m_upscalingStage) {
+            m_upscalingStage->UpdateParameters(next.upscalingParams);
+        }
+        
+        if (m_sharpnessStage && next.upscalingParams.sharpnessStrength != m_config.upscalingParams.sharpnessStrength) {
+            m_sharpnessStage->UpdateSharpnessStrength(next.upscalingParams.sharpnessStrength);
+        }
+    }
+    
+    if (m_frameGenStage) {
+        m_frameGenStage->SetHistoryLength(static_cast<int>(next.frameGenParams.historyLength));
+        m_frameGenStage->SetZeroCopyHistory(next.frameGenParams.zeroCopyHistory);
+    }
+    
+    if (m_antiAliasingStage && next.aaQuality != m_config.aaQuality) {
+        m_antiAliasingStage->SetQuality(next.aaQuality);
+    }
+    
+    if (next.aaQuality != m_config.aaQuality ||
+        !SameDynamicResolutionParameters(next.dynamicResolution, m_config.dynamicResolution)) {
+        m_resolutionController.Configure(next.dynamicResolution, next.aaQuality, next.dynamicResolution.maxSearchRadius);
+    }
+    
+    if (next.latencyWindowSeconds != m_config.latencyWindowSeconds) {
+        m_perfMonitor->SetLatencyWindow(next.latencyWindowSeconds);
+    }
+    
+    m_config = next;
     return true;
 }
 
-void Pipeline::UpdateUpscalingParameters(const UpscalingParameters& params)
+void Pipeline::RecordFrame(const XISParameters& params, ShedLevel shedLevel, bool configChanged)
 {
-    if (m_upscalingStage) {
-        m_upscalingStage->UpdateParameters(params);
+    // Configuration écrite au début de la capture puis à chaque changement
+    if (!m_capture) {
+        std::lock_guard<std::mutex> lock(m_captureMutex);
+        m_capture = std::move(m_pendingCapture);
+        configChanged = m_capture != nullptr;
     }
+    if (!m_capture) {
+        return;
+    }
+    
+    bool failed = false;
+    if (configChanged) {
+        XISConfig config = m_config;
+        config.shaderPath = m_shaderPath.empty() ? nullptr : m_shaderPath.c_str();
+        failed = !m_capture->WriteConfig(config);
+    }
+    
+    CapturedFrame frame;
+    frame.index = m_capture->GetFramesWritten();
+    frame.frameDeltaTime = params.frameDeltaTime;
+    frame.qualityFactor = params.qualityFactor;
+    frame.shedLevel = static_cast<int>(shedLevel);
+    frame.operatingPoint = m_resolutionController.GetOperatingPoint();
     
-    if (m_sharpnessStage) {
-        m_sharpnessStage->UpdateSharpnessStrength(params.sharpnessStrength);
+    if (!failed) {
+        failed = !m_renderer->ReadTexture(params.inputTexture, frame.inputWidth, frame.inputHeight,
+                                          frame.inputFormat, &m_capturePixels) ||
+                 !m_renderer->ReadTexture(params.outputTexture, frame.outputWidth, frame.outputHeight,
+                                          frame.outputFormat, nullptr);
+        if (failed) {
+            Logger::Error("Pipeline: le renderer ne permet pas de relire les textures, capture abandonnée");
+        }
     }
     
-    m_config.upscalingParams = params;
+    if (!failed) {
+        frame.pixels = m_capturePixels.data();
+        frame.pixelBytes = m_capturePixels.size();
+        failed = !m_capture->WriteFrame(frame);
+    }
+    
+    if (failed || m_capture->IsComplete()) {
+        uint32_t frames = m_capture->GetFramesWritten();
+        uint64_t rawBytes = m_capture->GetRawBytes();
+        uint64_t encodedBytes = m_capture->GetEncodedBytes();
+        std::string path = m_capture->GetPath();
+        if (m_capture->Close() && !failed) {
+            double ratio = encodedBytes > 0 ? static_cast<double>(rawBytes) / static_cast<double>(encodedBytes) : 0.0;
+            Logger::Info("Capture de %u frames écrite dans %s (compression %.1fx)", frames, path.c_str(), ratio);
+        }
+        m_capture.reset();
+        m_capturePixels.clear();
+        m_capturePixels.shrink_to_fit();
+        m_captureActive.store(false, std::memory_order_release);
+    }
 }
 
-void Pipeline::UpdateFrameGenParameters(const FrameGenParameters& params)
+bool Pipeline::StartFrameCapture(const char* outputPath, uint32_t frameCount)
 {
-    if (m_frameGenStage) {
-        m_frameGenStage->UpdateParameters(params);
+    if (!outputPath || frameCount == 0) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_captureMutex);
+    
+    if (m_captureActive.load(std::memory_order_acquire)) {
+        Logger::Warning("Pipeline: une capture de frames est déjà en cours");
+        return false;
+    }
+    
+    auto writer = std::make_unique<FrameCaptureWriter>();
+    if (!writer->Open(outputPath, frameCount)) {
+        return false;
     }
     
-    m_config.frameGenParams = params;
+    m_pendingCapture = std::move(writer);
+    m_captureActive.store(true, std::memory_order_release);
+    return true;
+}
+
+void Pipeline::PublishConfig(const XISConfig& config)
+{
+    m_configChannel.Publish(config);
+}
+
+bool Pipeline::ApplyConfigPatch(const ConfigPatch& patch)
+{
+    bool applied = false;
+    m_configChannel.Update([&patch, &applied](XISConfig& latest) {
+        applied = patch.ApplyTo(latest);
+    });
+    return applied;
+}
+
+void Pipeline::ForceNextOperatingPoint(const XISOperatingPoint& point)
+{
+    m_forcedOperatingPoint = point;
+    m_hasForcedOperatingPoint = true;
+}
+
+void Pipeline::UpdateUpscalingParameters(const UpscalingParameters& params)
+{
+    m_configChannel.Update([&params](XISConfig& config) {
+        config.upscalingParams = params;
+    });
+}
+
+void Pipeline::UpdateFrameGenParameters(const FrameGenParameters& params)
+{
+    m_configChannel.Update([&params](XISConfig& config) {
+        config.frameGenParams = params;
+    });
 }
 
 void Pipeline::EnableUpscaling(bool enabled)
 {
-    m_upscalingEnabled = enabled;
+    m_configChannel.Update([enabled](XISConfig& config) {
+        config.enableBicubicUpscaling = enabled;
+    });
 }
 
 void Pipeline::EnableFrameGeneration(bool enabled)
 {
-    m_frameGenEnabled = enabled;
+    m_configChannel.Update([enabled](XISConfig& config) {
+        config.enableFrameGeneration = enabled;
+    });
 }
 
 void Pipeline::EnableAntiAliasing(bool enabled)
 {
-    m_antiAliasingEnabled = enabled;
+    m_configChannel.Update([enabled](XISConfig& config) {
+        config.enableAntiAliasing = enabled;
+    });
 }
 
 void Pipeline::EnableSharpening(bool enabled)
 {
-    m_sharpnessEnabled = enabled;
+    m_configChannel.Update([enabled](XISConfig& config) {
+        config.enableSharpness = enabled;
+    });
 }
 
 XISPerformanceStats Pipeline::GetPerformanceStats() const
 {
-    return m_perfStats;
+    return m_perfStats.Load();
 }
 
 } // namespace XIS
\ No newline at end of file
@@ -1,20 +1,54 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 #include "../Core/XISParameters.h"
+#include "../Core/SeqLock.h"
+#include "../Core/SnapshotChannel.h"
+#include "ResolutionController.h"
 
 namespace XIS {
 
 // Déclarations anticipées
 class IRenderer;
+class XISContext;
 class DownsampleStage;
 class AntiAliasingStage;
 class UpscalingStage;
 class SharpnessStage;
-class FrameGenStage;
+class FrameGenerationStage;
 class BicubicUpscaler;
-class FrameInterpolator;
+class PerfMonitor;
+class FrameCaptureWriter;
+class TuningProfile;
+class ConfigPatch;
+
+/**
+ * @brief Niveau de délestage appliqué à une frame
+ *
+ * Utilisé par l'ordonnanceur pour alléger une frame qui risque de manquer son
+ * échéance. Chaque niveau inclut les précédents.
+ */
+enum class ShedLevel {
+    None,                 // Traitement complet
+    SkipFrameGeneration,  // Pas de génération de frames
+    ReduceAntiAliasing    // Pas de génération de frames et antialiasing de qualité inférieure
+};
+
+/**
+ * @brief Temps de la dernière frame, mesurés directement par le thread de frame
+ *
+ * Contrairement aux statistiques agrégées (GetPerformanceStats), disponibles
+ * dès le retour d'Execute.
+ */
+struct FrameTiming {
+    float frameTimeMs = 0.0f;             // Durée totale de la frame
+    float frameGenTimeMs = 0.0f;          // Génération de frames, 0 si l'étape n'a pas été exécutée
+};
 
 /**
  * @brief Classe définissant le pipeline de traitement XIS
@@ -22,15 +56,21 @@ class FrameInterpolator;
  * Cette classe gère l'exécution et la coordination des différentes étapes
  * du pipeline de traitement: downsampling optionnel, antialiasing,
  * upscaling bicubique, génération de frame et sharpness.
+ *
+ * Execute doit être appelé depuis un seul thread à la fois. Les méthodes de
+ * mise à jour (Update*, Enable*) peuvent être appelées depuis n'importe quel
+ * thread : elles publient un nouveau snapshot de configuration, pris en
+ * compte au début de la frame suivante sans verrou sur le chemin de frame.
  */
 class Pipeline {
 public:
     /**
      * @brief Constructeur
      * 
-     * @param renderer Renderer à utiliser
+     * @param context Contexte de la session (renderer, shaders, back buffer),
+     *        qui doit survivre au pipeline
      */
-    explicit Pipeline(std::shared_ptr<IRenderer> renderer);
+    explicit Pipeline(XISContext* context);
     ~Pipeline();
 
     /**
@@ -45,9 +85,11 @@ public:
      * @brief Exécute le pipeline complet sur une frame
      * 
      * @param params Paramètres de traitement
+     * @param shedLevel Délestage à appliquer à cette frame uniquement
+     * @param queuedSince Instant de mise en file de la frame (PerfMonitor::ReadTimestamp), 0 si aucun
      * @return true si le traitement réussit, false sinon
      */
-    bool Execute(const XISParameters& params);
+    bool Execute(const XISParameters& params, ShedLevel shedLevel = ShedLevel::None, uint64_t queuedSince = 0);
 
     /**
      * @brief Met à jour les paramètres d'upscaling
@@ -94,40 +136,169 @@ public:
     /**
      * @brief Obtient les statistiques de performance actuelles
      * 
+     * Appelable depuis n'importe quel thread, y compris pendant Execute.
+     * 
      * @return Statistiques de performance
      */
     XISPerformanceStats GetPerformanceStats() const;
 
+    /**
+     * @brief Temps mesurés de la dernière frame exécutée (thread de frame uniquement)
+     */
+    const FrameTiming& GetLastFrameTiming() const { return m_lastFrameTiming; }
+
+    /**
+     * @brief Moniteur de performance du pipeline (captures de trace, instrumentation du renderer)
+     */
+    PerfMonitor* GetPerfMonitor() const { return m_perfMonitor.get(); }
+
+    /**
+     * @brief Démarre l'enregistrement des prochaines frames (appelable depuis n'importe quel thread)
+     *
+     * La capture contient la configuration, les paramètres de chaque frame,
+     * le délestage, le point de fonctionnement et le contenu de la texture
+     * d'entrée ; tools/Replay la rejoue à l'identique. Le renderer doit
+     * savoir relire ses textures (IRenderer::ReadTexture).
+     *
+     * @param outputPath Fichier de capture
+     * @param frameCount Nombre de frames à enregistrer
+     * @return true si la capture commencera à la frame suivante
+     */
+    bool StartFrameCapture(const char* outputPath, uint32_t frameCount);
+
+    /**
+     * @brief Indique si une capture de frames est demandée ou en cours
+     */
+    bool IsFrameCaptureActive() const { return m_captureActive.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Publie une configuration complète, prise en compte à la frame suivante
+     */
+    void PublishConfig(const XISConfig& config);
+
+    /**
+     * @brief Applique les réglages d'un fichier de configuration (appelable depuis n'importe quel thread)
+     *
+     * Les réglages sont appliqués à la dernière configuration publiée puis
+     * pris en compte à la frame suivante. Ils sont ignorés s'ils rendent
+     * cette configuration incohérente.
+     *
+     * @return true si les réglages ont été publiés
+     */
+    bool ApplyConfigPatch(const ConfigPatch& patch);
+
+    /**
+     * @brief Impose le point de fonctionnement de la prochaine frame (thread de frame uniquement)
+     *
+     * Utilisé par le rejeu d'une capture.
+     */
+    void ForceNextOperatingPoint(const XISOperatingPoint& point);
+
 private:
-    // Renderer
+    // Contexte de la session et son renderer
+    XISContext* m_context;
     std::shared_ptr<IRenderer> m_renderer;
 
-    // Étapes du pipeline
+    // Étapes du pipeline, créées à leur première activation (voir
+    // UpdateStageResidency) ; nullptr tant qu'une étape n'est pas utilisée
     std::unique_ptr<DownsampleStage> m_downsampleStage;
     std::unique_ptr<AntiAliasingStage> m_antiAliasingStage;
     std::unique_ptr<UpscalingStage> m_upscalingStage;
     std::unique_ptr<SharpnessStage> m_sharpnessStage;
-    std::unique_ptr<FrameGenStage> m_frameGenStage;
+    std::unique_ptr<FrameGenerationStage> m_frameGenStage;
 
-    // Algorithmes
+    // Upscaler bicubique, créé et libéré avec l'étape d'upscaling
     std::shared_ptr<BicubicUpscaler> m_bicubicUpscaler;
-    std::shared_ptr<FrameInterpolator> m_frameInterpolator;
+    
+    enum StageSlot {
+        kDownsampleSlot,
+        kAntiAliasingSlot,
+        kUpscalingSlot,
+        kFrameGenSlot,
+        kSharpnessSlot,
+        kStageSlotCount
+    };
+    
+    // Dernière frame où chaque étape était requise par la configuration
+    std::chrono::steady_clock::time_point m_stageLastWanted[kStageSlotCount];
 
-    // Configuration
+    // Configuration active, lue et modifiée uniquement par le thread de frame
     XISConfig m_config;
     
-    // États d'activation
-    bool m_upscalingEnabled;
-    bool m_frameGenEnabled;
-    bool m_antiAliasingEnabled;
-    bool m_sharpnessEnabled;
-
-    // Statistiques de performance
-    XISPerformanceStats m_perfStats;
+    // Configurations publiées par les autres threads
+    SnapshotChannel<XISConfig> m_configChannel;
+
+    // Statistiques de performance (propres à ce pipeline), publiées à la
+    // fin de chaque frame pour les lecteurs des autres threads
+    std::unique_ptr<PerfMonitor> m_perfMonitor;
+    SeqLock<XISPerformanceStats> m_perfStats;
+    FrameTiming m_lastFrameTiming;
+    
+    // Identifiants des étapes, enregistrés une fois à la construction
+    struct StageIds {
+        uint16_t downsample;
+        uint16_t antiAliasing;
+        uint16_t upscaling;
+        uint16_t frameGen;
+        uint16_t sharpness;
+    } m_stageIds;
+    
+    // Résolution dynamique : point de fonctionnement appliqué à la frame suivante
+    ResolutionController m_resolutionController;
+    bool m_hasForcedOperatingPoint = false;
+    XISOperatingPoint m_forcedOperatingPoint;
+    
+    // Capture de frames : demandée par n'importe quel thread sous
+    // m_captureMutex, reprise par le thread de frame au début d'une frame
+    std::mutex m_captureMutex;
+    std::unique_ptr<FrameCaptureWriter> m_pendingCapture;
+    std::atomic<bool> m_captureActive{false};
+    std::unique_ptr<FrameCaptureWriter> m_capture;
+    std::vector<uint8_t> m_capturePixels;
+    std::string m_shaderPath;             // Copie de config.shaderPath pour la capture
+    
+    // Profil d'autotuning lu à l'initialisation, appliqué lorsque la paire
+    // de résolutions (entrée, sortie) change
+    std::shared_ptr<const TuningProfile> m_tuningProfile;
+    int m_tunedResolution[4] = {};        // Entrée puis sortie (largeur, hauteur)
+    int m_tunedSearchRadius = 0;          // Rayon du profil, 0 si aucun
     
     // Méthodes internes
-    bool InitializeStages();
-    void UpdatePipelineStages();
+    void RecordFrame(const XISParameters& params, ShedLevel shedLevel, bool configChanged);
+    
+    /**
+     * @brief Corps de Execute entre StartFrame et EndFrame
+     *
+     * Execute termine la frame quel que soit le chemin de sortie.
+     *
+     * @return false si la frame n'a pas pu être traitée
+     */
+    bool ExecuteStages(const XISParameters& params, ShedLevel shedLevel);
+    void ApplyTuning(const XISParameters& params);
+    
+    /**
+     * @brief Crée les étapes requises par la configuration active et libère
+     *        celles qui ne le sont plus depuis stageReleaseDelaySeconds
+     *
+     * Appelé à l'initialisation puis au début de chaque frame.
+     *
+     * @return false si une étape requise n'a pas pu être créée
+     */
+    bool UpdateStageResidency();
+    bool IsStageWanted(StageSlot slot) const;
+    bool IsStageCreated(StageSlot slot) const;
+    bool CreateStage(StageSlot slot);
+    void ReleaseStage(StageSlot slot);
+    
+    /**
+     * @brief Applique le dernier snapshot de configuration publié
+     * 
+     * Appelé au début de chaque frame ; seules les étapes dont les paramètres
+     * ont changé sont mises à jour.
+     *
+     * @return true si un snapshot a été appliqué
+     */
+    bool ApplyPendingConfig();
 };
 
 } // namespace XIS
\ No newline at end of file
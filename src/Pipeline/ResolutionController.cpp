@@ -0,0 +1,166 @@
+#include "ResolutionController.h"
+#include <algorithm>
+#include <cmath>
+
+namespace XIS {
+
+namespace {
+    // Lissage du temps de frame mesuré
+    const float kFrameTimeSmoothing = 0.2f;
+
+    // Hystérésis des paliers d'AA, en unités de niveau
+    const float kAAHysteresis = 0.05f;
+
+    // Pas de quantification de l'échelle d'entrée
+    const float kInputScaleStep = 0.05f;
+
+    // Les rayons de recherche sont des multiples de cette valeur
+    const uint32_t kSearchRadiusStep = 4;
+
+    float Clamp01(float value)
+    {
+        return std::max(0.0f, std::min(1.0f, value));
+    }
+
+    float Remap01(float value, float low, float high)
+    {
+        return Clamp01((value - low) / (high - low));
+    }
+}
+
+ResolutionController::ResolutionController()
+    : m_maxAAQuality(AAQuality::Medium),
+      m_configuredSearchRadius(32),
+      m_level(1.0f),
+      m_smoothedFrameTimeMs(0.0f),
+      m_previousError(0.0f),
+      m_previousDelta(0.0f)
+{
+}
+
+void ResolutionController::Configure(const DynamicResolutionParameters& params, AAQuality maxAAQuality, uint32_t maxSearchRadius)
+{
+    m_params = params;
+    m_params.minInputScale = std::max(0.1f, std::min(1.0f, m_params.minInputScale));
+    m_params.maxInputScale = std::max(m_params.minInputScale, std::min(1.0f, m_params.maxInputScale));
+    m_params.maxSearchRadius = std::max(m_params.minSearchRadius, m_params.maxSearchRadius);
+    m_maxAAQuality = maxAAQuality;
+    m_configuredSearchRadius = maxSearchRadius;
+
+    if (!m_params.enabled) {
+        SetConfiguredOperatingPoint();
+        return;
+    }
+
+    UpdateOperatingPoint(m_level);
+}
+
+void ResolutionController::SetConfiguredOperatingPoint()
+{
+    // Régulateur inactif : le point de fonctionnement reflète la configuration
+    m_operatingPoint = XISOperatingPoint();
+    m_operatingPoint.aaQuality = m_maxAAQuality;
+    m_operatingPoint.motionSearchRadius = m_configuredSearchRadius;
+}
+
+void ResolutionController::Reset()
+{
+    m_level = 1.0f;
+    m_smoothedFrameTimeMs = 0.0f;
+    m_previousError = 0.0f;
+    m_previousDelta = 0.0f;
+
+    if (m_params.enabled) {
+        UpdateOperatingPoint(m_level);
+    }
+}
+
+const XISOperatingPoint& ResolutionController::Update(float frameTimeMs, float qualityCap)
+{
+    if (!m_params.enabled || m_params.frameTimeBudgetMs <= 0.0f) {
+        // Sans régulation, le plafond de l'application fixe seul le niveau
+        float level = Clamp01(qualityCap);
+        if (level < 1.0f) {
+            UpdateOperatingPoint(level);
+            m_operatingPoint.frameTimeBudgetMs = 0.0f;
+        } else if (m_operatingPoint.qualityLevel < 1.0f) {
+            SetConfiguredOperatingPoint();
+        }
+        return m_operatingPoint;
+    }
+
+    m_smoothedFrameTimeMs = m_smoothedFrameTimeMs == 0.0f
+        ? frameTimeMs
+        : m_smoothedFrameTimeMs + kFrameTimeSmoothing * (frameTimeMs - m_smoothedFrameTimeMs);
+
+    // Erreur normalisée : positive lorsqu'il reste de la marge
+    float error = (m_params.frameTimeBudgetMs - m_smoothedFrameTimeMs) / m_params.frameTimeBudgetMs;
+
+    // Bande morte : pas de correction tant que l'on reste proche du budget
+    if (std::fabs(error) * 100.0f < m_params.hysteresisPercent) {
+        error = 0.0f;
+    }
+
+    // PID incrémental : l'intégrale est portée par le niveau lui-même, ce qui
+    // évite l'emballement de l'intégrateur lorsque le niveau est saturé
+    float delta = error - m_previousError;
+    float deltaRate = delta - m_previousDelta;
+    float adjustment = m_params.integralGain * error +
+                       m_params.proportionalGain * delta +
+                       m_params.derivativeGain * deltaRate;
+
+    m_previousDelta = delta;
+    m_previousError = error;
+    m_level = Clamp01(m_level + adjustment);
+
+    // L'application peut imposer une qualité maximale
+    UpdateOperatingPoint(std::min(m_level, Clamp01(qualityCap)));
+    return m_operatingPoint;
+}
+
+void ResolutionController::UpdateOperatingPoint(float level)
+{
+    m_operatingPoint.qualityLevel = level;
+    m_operatingPoint.frameTimeBudgetMs = m_params.frameTimeBudgetMs;
+
+    // Rayon de recherche : premier réglage sacrifié
+    float radiusLevel = Remap01(level, 2.0f / 3.0f, 1.0f);
+    float radius = m_params.minSearchRadius + radiusLevel * (m_params.maxSearchRadius - m_params.minSearchRadius);
+    uint32_t steppedRadius = static_cast<uint32_t>(std::lround(radius / kSearchRadiusStep)) * kSearchRadiusStep;
+    m_operatingPoint.motionSearchRadius = std::max(m_params.minSearchRadius, std::min(m_params.maxSearchRadius, steppedRadius));
+
+    // Qualité d'antialiasing
+    m_operatingPoint.aaQuality = SelectAAQuality(Remap01(level, 1.0f / 3.0f, 2.0f / 3.0f));
+
+    // Échelle d'entrée : dernier réglage sacrifié
+    float scaleLevel = Remap01(level, 0.0f, 1.0f / 3.0f);
+    float scale = m_params.minInputScale + scaleLevel * (m_params.maxInputScale - m_params.minInputScale);
+    m_operatingPoint.inputScale = std::max(m_params.minInputScale,
+                                           std::min(m_params.maxInputScale, std::round(scale / kInputScaleStep) * kInputScaleStep));
+}
+
+AAQuality ResolutionController::SelectAAQuality(float aaLevel) const
+{
+    if (m_maxAAQuality == AAQuality::Off) {
+        return AAQuality::Off;
+    }
+
+    // Le niveau [0, 1] est découpé en autant de paliers que de qualités
+    // disponibles jusqu'à la qualité configurée
+    int maxStep = static_cast<int>(m_maxAAQuality);
+    int currentStep = std::max(1, std::min(maxStep, static_cast<int>(m_operatingPoint.aaQuality)));
+    float stepWidth = 1.0f / maxStep;
+
+    // Monter d'un palier seulement au-delà du seuil plus l'hystérésis,
+    // descendre seulement en deçà du seuil moins l'hystérésis
+    while (currentStep < maxStep && aaLevel > currentStep * stepWidth + kAAHysteresis) {
+        currentStep++;
+    }
+    while (currentStep > 1 && aaLevel < (currentStep - 1) * stepWidth - kAAHysteresis) {
+        currentStep--;
+    }
+
+    return static_cast<AAQuality>(currentStep);
+}
+
+} // namespace XIS
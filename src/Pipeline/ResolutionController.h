@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../Core/XISParameters.h"
+
+namespace XIS {
+
+/**
+ * @brief Régulateur de résolution dynamique piloté par un budget de temps
+ *
+ * Un régulateur PID (forme incrémentale) compare le temps de traitement
+ * lissé au budget et fait évoluer un niveau de qualité continu dans [0, 1].
+ * Une bande morte autour du budget évite les oscillations. Le niveau est
+ * ensuite converti en point de fonctionnement, les réglages les moins
+ * visibles étant sacrifiés en premier lorsque le niveau baisse :
+ *  - [2/3, 1] : le rayon de recherche de mouvement varie ;
+ *  - [1/3, 2/3] : la qualité d'antialiasing baisse par paliers ;
+ *  - [0, 1/3] : l'échelle d'entrée baisse.
+ * Les paliers d'AA ont leur propre hystérésis pour ne pas basculer à chaque
+ * frame au voisinage d'un seuil.
+ *
+ * Régulateur inactif, le niveau est directement le plafond de qualité de
+ * l'application (XISParameters::qualityFactor) : à 1, le point de
+ * fonctionnement reflète la configuration.
+ */
+class ResolutionController {
+public:
+    ResolutionController();
+
+    /**
+     * @brief Configure le régulateur
+     *
+     * @param params Paramètres de résolution dynamique
+     * @param maxAAQuality Qualité d'AA configurée, jamais dépassée
+     * @param maxSearchRadius Rayon de recherche configuré, utilisé lorsque le régulateur est inactif
+     */
+    void Configure(const DynamicResolutionParameters& params, AAQuality maxAAQuality, uint32_t maxSearchRadius);
+
+    /**
+     * @brief Remet le régulateur à la qualité maximale
+     */
+    void Reset();
+
+    /**
+     * @brief Met à jour le point de fonctionnement après une frame
+     *
+     * @param frameTimeMs Temps de traitement mesuré de la frame (ignoré si le régulateur est inactif)
+     * @param qualityCap Qualité maximale autorisée par l'application (XISParameters::qualityFactor)
+     * @return Le point de fonctionnement à appliquer à la frame suivante
+     */
+    const XISOperatingPoint& Update(float frameTimeMs, float qualityCap);
+
+    /**
+     * @brief Impose le point de fonctionnement de la prochaine frame
+     *
+     * Utilisé par le rejeu d'une capture, qui reproduit les décisions du
+     * régulateur au lieu de les recalculer à partir de temps différents.
+     */
+    void Override(const XISOperatingPoint& point) { m_operatingPoint = point; }
+
+    const XISOperatingPoint& GetOperatingPoint() const { return m_operatingPoint; }
+    bool IsEnabled() const { return m_params.enabled; }
+
+    /**
+     * @brief Indique si le point de fonctionnement s'écarte de la configuration
+     *
+     * Vrai lorsque le régulateur est actif ou que l'application plafonne la qualité.
+     */
+    bool IsActive() const { return m_params.enabled || m_operatingPoint.qualityLevel < 1.0f; }
+
+private:
+    void UpdateOperatingPoint(float level);
+    void SetConfiguredOperatingPoint();
+    AAQuality SelectAAQuality(float aaLevel) const;
+
+    DynamicResolutionParameters m_params;
+    AAQuality m_maxAAQuality;
+    uint32_t m_configuredSearchRadius;
+
+    // État du régulateur
+    float m_level;
+    float m_smoothedFrameTimeMs;
+    float m_previousError;
+    float m_previousDelta;
+
+    XISOperatingPoint m_operatingPoint;
+};
+
+} // namespace XIS
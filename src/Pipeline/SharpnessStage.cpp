@@ -1 +1,86 @@
+#include "SharpnessStage.h"
+#include "../Renderer/IRenderer.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
 
+namespace XIS {
+
+SharpnessStage::SharpnessStage(std::shared_ptr<IRenderer> renderer)
+    : m_renderer(renderer),
+      m_sharpnessShader(nullptr)
+{
+    m_constants.Modify([](SharpnessParams& params) {
+        params.strength = 0.5f;
+        params.reserved[0] = 0.0f;
+        params.reserved[1] = 0.0f;
+        params.reserved[2] = 0.0f;
+    });
+}
+
+SharpnessStage::~SharpnessStage()
+{
+    // Libérer les ressources
+    if (m_sharpnessShader) {
+        m_renderer->ReleaseShaderResource(m_sharpnessShader);
+        m_sharpnessShader = nullptr;
+    }
+    
+    m_constants.Release();
+}
+
+bool SharpnessStage::Initialize(float strength)
+{
+    UpdateSharpnessStrength(strength);
+    return CreateShaderResources();
+}
+
+bool SharpnessStage::CreateShaderResources()
+{
+    // Charger le shader de netteté depuis le fichier
+    m_sharpnessShader = m_renderer->LoadShader("Sharpness.hlsl", "PSSharpness");
+    if (!m_sharpnessShader) {
+        Logger::Error("Échec du chargement du shader de netteté");
+        return false;
+    }
+    
+    // Créer le tampon constant avec les paramètres initiaux
+    if (!m_constants.Create(m_renderer.get(), "SharpnessConstantBuffer")) {
+        Logger::Error("Échec de la création du tampon constant pour la netteté");
+        return false;
+    }
+    
+    return true;
+}
+
+bool SharpnessStage::Process(void* inputTexture, void* outputTexture)
+{
+    // N'envoyer le tampon constant que si la force a changé
+    if (!m_constants.Flush()) {
+        Logger::Error("Échec de la mise à jour du tampon constant pour la netteté");
+        return false;
+    }
+    
+    m_renderer->SetShader(m_sharpnessShader);
+    m_renderer->SetConstantBuffer(m_constants.GetBuffer(), 0);
+    m_renderer->SetTexture(inputTexture, 0);
+    m_renderer->SetRenderTarget(outputTexture);
+    
+    bool success = m_renderer->ExecuteShader();
+    if (!success) {
+        Logger::Error("Échec de l'exécution du shader de netteté");
+    }
+    
+    return success;
+}
+
+void SharpnessStage::UpdateSharpnessStrength(float strength)
+{
+    strength = std::max(0.0f, std::min(1.0f, strength));
+    
+    // L'envoi est différé au prochain Process
+    m_constants.Modify([strength](SharpnessParams& params) {
+        params.strength = strength;
+    });
+}
+
+} // namespace XIS
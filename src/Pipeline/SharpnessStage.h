@@ -1 +1,69 @@
+#pragma once
 
+#include <memory>
+#include "../Renderer/ConstantBlock.h"
+
+namespace XIS {
+
+// Déclarations anticipées
+class IRenderer;
+
+/**
+ * @brief Étape d'amélioration de la netteté dans le pipeline
+ * 
+ * Cette classe implémente la dernière étape du pipeline, qui renforce les
+ * détails atténués par l'upscaling et la génération de frames.
+ */
+class SharpnessStage {
+public:
+    /**
+     * @brief Constructeur
+     * 
+     * @param renderer Renderer à utiliser
+     */
+    explicit SharpnessStage(std::shared_ptr<IRenderer> renderer);
+    ~SharpnessStage();
+
+    /**
+     * @brief Initialise l'étape de netteté
+     * 
+     * @param strength Force de la netteté [0.0 - 1.0]
+     * @return true si l'initialisation réussit, false sinon
+     */
+    bool Initialize(float strength);
+
+    /**
+     * @brief Traite une frame en renforçant sa netteté
+     * 
+     * @param inputTexture Texture d'entrée
+     * @param outputTexture Texture de sortie
+     * @return true si le traitement réussit, false sinon
+     */
+    bool Process(void* inputTexture, void* outputTexture);
+
+    /**
+     * @brief Change la force de la netteté
+     * 
+     * @param strength Nouvelle force [0.0 - 1.0]
+     */
+    void UpdateSharpnessStrength(float strength);
+
+private:
+    std::shared_ptr<IRenderer> m_renderer;
+    
+    // Ressources des shaders
+    void* m_sharpnessShader;
+    
+    // Paramètres
+    struct SharpnessParams {
+        float strength;          // Force de la netteté
+        float reserved[3];       // Pour alignement
+    };
+    
+    ConstantBlock<SharpnessParams> m_constants;
+    
+    // Méthodes d'initialisation des ressources
+    bool CreateShaderResources();
+};
+
+} // namespace XIS
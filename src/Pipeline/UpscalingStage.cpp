@@ -1 +1,84 @@
+#include "UpscalingStage.h"
+#include "../Core/XISContext.h"
+#include "../Algorithms/BicubicUpscaler.h"
+#include "../Renderer/IRenderer.h"
+#include "../Utils/Logger.h"
+#include <algorithm>
 
+namespace XIS {
+
+namespace {
+
+    // Paramètre 'a' du filtre : -0.5 (doux) à -1.0 (net)
+    float ComputeSharpnessFactor(const UpscalingParameters& params)
+    {
+        float strength = std::max(0.0f, std::min(1.0f, params.sharpnessStrength));
+        switch (params.mode) {
+        case UpscalingMode::BicubicSharp:
+            return -0.5f - 0.5f * strength;
+        case UpscalingMode::BicubicAdaptive:
+            // Netteté modérée par la conservation des contours
+            return -0.5f - 0.5f * strength * std::max(0.0f, std::min(1.0f, params.edgePreservation));
+        case UpscalingMode::Bicubic:
+        default:
+            return -0.5f;
+        }
+    }
+
+} // namespace
+
+UpscalingStage::UpscalingStage(const XISContext* context, std::shared_ptr<BicubicUpscaler> upscaler)
+    : m_context(context),
+      m_upscaler(std::move(upscaler)),
+      m_sharpnessFactor(-0.5f)
+{
+}
+
+UpscalingStage::~UpscalingStage() = default;
+
+bool UpscalingStage::Initialize(const UpscalingParameters& params)
+{
+    if (!m_context || !m_upscaler) {
+        Logger::Error("UpscalingStage: contexte ou upscaler manquant");
+        return false;
+    }
+    
+    UpdateParameters(params);
+    return true;
+}
+
+bool UpscalingStage::Process(void* inputTexture, void* outputTexture)
+{
+    IRenderer* renderer = m_context->GetRenderer();
+    
+    // Tailles effectives des textures ; une taille de sortie configurée
+    // remplace celle de la texture
+    int inputWidth = 0;
+    int inputHeight = 0;
+    int outputWidth = 0;
+    int outputHeight = 0;
+    int format = 0;
+    renderer->ReadTexture(inputTexture, inputWidth, inputHeight, format, nullptr);
+    renderer->ReadTexture(outputTexture, outputWidth, outputHeight, format, nullptr);
+    if (m_params.outputWidth > 0 && m_params.outputHeight > 0) {
+        outputWidth = static_cast<int>(m_params.outputWidth);
+        outputHeight = static_cast<int>(m_params.outputHeight);
+    }
+    
+    bool success = m_upscaler->Upscale(m_context, inputTexture, outputTexture,
+                                       inputWidth, inputHeight, outputWidth, outputHeight,
+                                       m_sharpnessFactor);
+    if (!success) {
+        Logger::Error("Échec de l'upscaling bicubique");
+    }
+    
+    return success;
+}
+
+void UpscalingStage::UpdateParameters(const UpscalingParameters& params)
+{
+    m_params = params;
+    m_sharpnessFactor = ComputeSharpnessFactor(params);
+}
+
+} // namespace XIS
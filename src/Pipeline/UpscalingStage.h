@@ -1 +1,63 @@
+#pragma once
 
+#include <memory>
+#include "../Core/XISParameters.h"
+
+namespace XIS {
+
+// Déclarations anticipées
+class XISContext;
+class BicubicUpscaler;
+
+/**
+ * @brief Étape d'upscaling bicubique dans le pipeline
+ * 
+ * Cette classe adapte BicubicUpscaler au pipeline : elle traduit les
+ * paramètres d'upscaling de la configuration (mode, netteté, taille de
+ * sortie) en paramètres du filtre bicubique.
+ */
+class UpscalingStage {
+public:
+    /**
+     * @brief Constructeur
+     * 
+     * @param context Contexte de la session
+     * @param upscaler Upscaler bicubique initialisé
+     */
+    UpscalingStage(const XISContext* context, std::shared_ptr<BicubicUpscaler> upscaler);
+    ~UpscalingStage();
+
+    /**
+     * @brief Initialise l'étape d'upscaling
+     * 
+     * @param params Paramètres d'upscaling
+     * @return true si l'initialisation réussit, false sinon
+     */
+    bool Initialize(const UpscalingParameters& params);
+
+    /**
+     * @brief Agrandit une frame à la taille de sortie
+     * 
+     * @param inputTexture Texture d'entrée
+     * @param outputTexture Texture de sortie (taille cible)
+     * @return true si le traitement réussit, false sinon
+     */
+    bool Process(void* inputTexture, void* outputTexture);
+
+    /**
+     * @brief Met à jour les paramètres d'upscaling
+     * 
+     * @param params Nouveaux paramètres d'upscaling
+     */
+    void UpdateParameters(const UpscalingParameters& params);
+
+private:
+    const XISContext* m_context;
+    std::shared_ptr<BicubicUpscaler> m_upscaler;
+    UpscalingParameters m_params;
+    
+    // Paramètre 'a' du filtre bicubique déduit de m_params
+    float m_sharpnessFactor;
+};
+
+} // namespace XIS
@@ -0,0 +1,860 @@
+#include "CPUKernels.h"
+#include "../ConstantBlock.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define XIS_CPU_SSE2 1
+#endif
+
+namespace XIS {
+
+namespace {
+
+    struct Float4 {
+        float x, y, z, w;
+    };
+
+    // Dispositions des tampons constants, identiques aux structures déclarées
+    // par les étapes et algorithmes qui lient ces kernels
+    struct DownsampleConstants {
+        float downsampleFactor;
+        float preserveDetail;
+        float threshold;
+        float reserved;
+    };
+
+    struct DownsampleOverride {
+        float downsampleFactor;
+        float reserved[3];
+    };
+
+    struct AAConstants {
+        float threshold;
+        float blendFactor;
+        int kernelSize;
+        float reserved;
+    };
+
+    struct AAOverride {
+        float threshold;
+        float blendFactor;
+        int kernelSize;
+        int enabled;
+    };
+
+    struct SharpnessConstants {
+        float strength;
+        float reserved[3];
+    };
+
+    struct BicubicConstants {
+        int inputWidth;
+        int inputHeight;
+        int outputWidth;
+        int outputHeight;
+        float sharpnessFactor;
+        float padding[3];
+    };
+
+    struct MotionConstants {
+        int frameWidth;
+        int frameHeight;
+        int blockSize;
+        int searchRadius;
+        float temporalWeight;
+        float spatialWeight;
+        int padding[2];
+    };
+
+    struct InterpolationConstants {
+        int frameWidth;
+        int frameHeight;
+        float qualityFactor;
+        int useOcclusion;
+    };
+
+    struct InterpolationRootConstants {
+        float timePosition;
+        float padding[3];
+    };
+
+    // Positions fractionnaires du buffer de poids bicubiques (4 poids chacune)
+    const int kBicubicPrecision = 256;
+
+    // Amplitude (en pixels) des vecteurs de mouvement stockés en RGBA8
+    const float kMotionRange = 64.0f;
+
+    // Écart de luminance au-delà duquel un pixel interpolé est considéré occulté
+    const float kOcclusionThreshold = 0.2f;
+
+    // --- Accès aux ressources ---
+
+    CPUTexture* TextureAt(CPUResource* const* resources, int slot)
+    {
+        return AsCPUTexture(resources[slot]);
+    }
+
+    CPUBuffer* BufferAt(CPUResource* const* resources, int slot)
+    {
+        return AsCPUBuffer(resources[slot]);
+    }
+
+    /**
+     * Root constants du registre si présentes, tampon constant lié sinon
+     */
+    template <typename T>
+    const T* GetConstants(const CPUKernelBindings& bindings, int slot)
+    {
+        if (bindings.rootConstantSizes[slot] >= sizeof(T)) {
+            return reinterpret_cast<const T*>(bindings.rootConstants[slot]);
+        }
+
+        const CPUBuffer* buffer = bindings.constantBuffers[slot];
+        if (buffer && buffer->size >= sizeof(T)) {
+            return reinterpret_cast<const T*>(buffer->data);
+        }
+
+        return nullptr;
+    }
+
+    // Fixe la zone valide d'une sortie, bornée par son allocation
+    void SetExtent(CPUTexture& texture, int width, int height)
+    {
+        texture.width = std::max(1, std::min(width, texture.allocWidth));
+        texture.height = std::max(1, std::min(height, texture.allocHeight));
+    }
+
+    // --- Texels ---
+
+    inline Float4 Add(const Float4& a, const Float4& b) { return { a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w }; }
+    inline Float4 Sub(const Float4& a, const Float4& b) { return { a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w }; }
+    inline Float4 Scale(const Float4& a, float s) { return { a.x * s, a.y * s, a.z * s, a.w * s }; }
+    inline Float4 Lerp(const Float4& a, const Float4& b, float t) { return Add(a, Scale(Sub(b, a), t)); }
+    inline float Luma(const Float4& c) { return 0.299f * c.x + 0.587f * c.y + 0.114f * c.z; }
+
+    inline uint8_t ToUnorm8(float value)
+    {
+        value = std::min(1.0f, std::max(0.0f, value));
+        return static_cast<uint8_t>(value * 255.0f + 0.5f);
+    }
+
+    /**
+     * Lit un texel ; les coordonnées sont bornées à la zone valide
+     */
+    inline Float4 LoadTexel(const CPUTexture& texture, int x, int y)
+    {
+        x = std::min(std::max(x, 0), texture.width - 1);
+        y = std::min(std::max(y, 0), texture.height - 1);
+        const uint8_t* row = texture.GetRow(y);
+
+        switch (texture.format) {
+        case CPUTextureFormat::RGBA8: {
+            const uint8_t* p = row + static_cast<size_t>(x) * 4;
+            const float s = 1.0f / 255.0f;
+            return { p[0] * s, p[1] * s, p[2] * s, p[3] * s };
+        }
+        case CPUTextureFormat::R32F: {
+            const float* p = reinterpret_cast<const float*>(row) + x;
+            return { p[0], 0.0f, 0.0f, 1.0f };
+        }
+        case CPUTextureFormat::RG32F: {
+            const float* p = reinterpret_cast<const float*>(row) + static_cast<size_t>(x) * 2;
+            return { p[0], p[1], 0.0f, 1.0f };
+        }
+        case CPUTextureFormat::RGBA32F: {
+            const float* p = reinterpret_cast<const float*>(row) + static_cast<size_t>(x) * 4;
+            return { p[0], p[1], p[2], p[3] };
+        }
+        }
+        return { 0.0f, 0.0f, 0.0f, 0.0f };
+    }
+
+    /**
+     * Écrit un texel ; les coordonnées doivent être dans l'allocation
+     */
+    inline void StoreTexel(CPUTexture& texture, int x, int y, const Float4& value)
+    {
+        uint8_t* row = texture.GetRow(y);
+
+        switch (texture.format) {
+        case CPUTextureFormat::RGBA8: {
+            uint8_t* p = row + static_cast<size_t>(x) * 4;
+            p[0] = ToUnorm8(value.x);
+            p[1] = ToUnorm8(value.y);
+            p[2] = ToUnorm8(value.z);
+            p[3] = ToUnorm8(value.w);
+            break;
+        }
+        case CPUTextureFormat::R32F:
+            reinterpret_cast<float*>(row)[x] = value.x;
+            break;
+        case CPUTextureFormat::RG32F: {
+            float* p = reinterpret_cast<float*>(row) + static_cast<size_t>(x) * 2;
+            p[0] = value.x;
+            p[1] = value.y;
+            break;
+        }
+        case CPUTextureFormat::RGBA32F: {
+            float* p = reinterpret_cast<float*>(row) + static_cast<size_t>(x) * 4;
+            p[0] = value.x;
+            p[1] = value.y;
+            p[2] = value.z;
+            p[3] = value.w;
+            break;
+        }
+        }
+    }
+
+    /**
+     * Échantillonnage bilinéaire, coordonnées en pixels (centre du texel à +0.5)
+     */
+    inline Float4 SampleBilinear(const CPUTexture& texture, float x, float y)
+    {
+        x -= 0.5f;
+        y -= 0.5f;
+        float floorX = std::floor(x);
+        float floorY = std::floor(y);
+        int x0 = static_cast<int>(floorX);
+        int y0 = static_cast<int>(floorY);
+        float fx = x - floorX;
+        float fy = y - floorY;
+
+        Float4 top = Lerp(LoadTexel(texture, x0, y0), LoadTexel(texture, x0 + 1, y0), fx);
+        Float4 bottom = Lerp(LoadTexel(texture, x0, y0 + 1), LoadTexel(texture, x0 + 1, y0 + 1), fx);
+        return Lerp(top, bottom, fy);
+    }
+
+    // Les vecteurs de mouvement sont écrits dans une texture au format du back
+    // buffer : en RGBA8, R et G codent ±kMotionRange pixels et B la confiance
+    inline void StoreMotion(CPUTexture& texture, int x, int y, float mvx, float mvy, float confidence)
+    {
+        if (texture.format == CPUTextureFormat::RGBA8) {
+            StoreTexel(texture, x, y, {
+                mvx / kMotionRange * 0.5f + 0.5f,
+                mvy / kMotionRange * 0.5f + 0.5f,
+                confidence,
+                1.0f });
+        } else {
+            StoreTexel(texture, x, y, { mvx, mvy, confidence, 1.0f });
+        }
+    }
+
+    inline void LoadMotion(const CPUTexture& texture, int x, int y, float& mvx, float& mvy)
+    {
+        Float4 value = LoadTexel(texture, x, y);
+        if (texture.format == CPUTextureFormat::RGBA8) {
+            mvx = (value.x - 0.5f) * 2.0f * kMotionRange;
+            mvy = (value.y - 0.5f) * 2.0f * kMotionRange;
+        } else {
+            mvx = value.x;
+            mvy = value.y;
+        }
+    }
+
+    // --- Copie (points d'entrée inconnus) ---
+
+    int PrepareCopy(CPUKernelBindings& bindings)
+    {
+        CPUTexture* source = TextureAt(bindings.shaderResources, 0);
+        CPUTexture* destination = TextureAt(bindings.unorderedAccess, 0);
+        if (!source || !destination) {
+            return -1;
+        }
+
+        SetExtent(*destination, source->width, source->height);
+        return destination->height;
+    }
+
+    void RunCopy(const CPUKernelBindings& bindings, int rowBegin, int rowEnd, FrameArena&)
+    {
+        CopyCPUTextureRows(*TextureAt(bindings.shaderResources, 0), *TextureAt(bindings.unorderedAccess, 0), rowBegin, rowEnd);
+    }
+
+    // --- PSDownsample : moyenne des texels couverts par chaque pixel de sortie ---
+
+    int PrepareDownsample(CPUKernelBindings& bindings)
+    {
+        CPUTexture* input = TextureAt(bindings.shaderResources, 0);
+        CPUTexture* output = TextureAt(bindings.unorderedAccess, 0);
+        if (!input || !output) {
+            return -1;
+        }
+
+        const DownsampleConstants* constants = GetConstants<DownsampleConstants>(bindings, 0);
+        const DownsampleOverride* override = GetConstants<DownsampleOverride>(bindings, kOverrideRootConstantSlot);
+
+        float factor = constants ? constants->downsampleFactor : 0.5f;
+        if (override && override->downsampleFactor > 0.0f) {
+            factor = override->downsampleFactor;
+        }
+        factor = std::max(0.1f, std::min(1.0f, factor));
+
+        SetExtent(*output,
+                  static_cast<int>(std::lround(input->width * factor)),
+                  static_cast<int>(std::lround(input->height * factor)));
+        return output->height;
+    }
+
+    void RunDownsample(const CPUKernelBindings& bindings, int rowBegin, int rowEnd, FrameArena&)
+    {
+        const CPUTexture& input = *TextureAt(bindings.shaderResources, 0);
+        CPUTexture& output = *TextureAt(bindings.unorderedAccess, 0);
+
+        const int64_t inWidth = input.width;
+        const int64_t inHeight = input.height;
+
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            int sy0 = static_cast<int>(y * inHeight / output.height);
+            int sy1 = std::max(sy0 + 1, static_cast<int>((y + 1) * inHeight / output.height));
+
+            for (int x = 0; x < output.width; ++x) {
+                int sx0 = static_cast<int>(x * inWidth / output.width);
+                int sx1 = std::max(sx0 + 1, static_cast<int>((x + 1) * inWidth / output.width));
+
+                Float4 sum = { 0.0f, 0.0f, 0.0f, 0.0f };
+                for (int sy = sy0; sy < sy1; ++sy) {
+                    for (int sx = sx0; sx < sx1; ++sx) {
+                        sum = Add(sum, LoadTexel(input, sx, sy));
+                    }
+                }
+
+                StoreTexel(output, x, y, Scale(sum, 1.0f / static_cast<float>((sy1 - sy0) * (sx1 - sx0))));
+            }
+        }
+    }
+
+    // --- PSAntiAliasing : lissage des pixels à fort contraste local ---
+
+    int PrepareSameExtent(CPUKernelBindings& bindings)
+    {
+        CPUTexture* input = TextureAt(bindings.shaderResources, 0);
+        CPUTexture* output = TextureAt(bindings.unorderedAccess, 0);
+        if (!input || !output) {
+            return -1;
+        }
+
+        SetExtent(*output, input->width, input->height);
+        return output->height;
+    }
+
+    void RunAntiAliasing(const CPUKernelBindings& bindings, int rowBegin, int rowEnd, FrameArena&)
+    {
+        const CPUTexture& input = *TextureAt(bindings.shaderResources, 0);
+        CPUTexture& output = *TextureAt(bindings.unorderedAccess, 0);
+
+        AAConstants params = { 0.1f, 0.5f, 3, 0.0f };
+        if (const AAConstants* constants = GetConstants<AAConstants>(bindings, 0)) {
+            params = *constants;
+        }
+        const AAOverride* override = GetConstants<AAOverride>(bindings, kOverrideRootConstantSlot);
+        if (override && override->enabled) {
+            params.threshold = override->threshold;
+            params.blendFactor = override->blendFactor;
+            params.kernelSize = override->kernelSize;
+        }
+
+        const int radius = std::max(1, params.kernelSize / 2);
+        const float weight = 1.0f / static_cast<float>((2 * radius + 1) * (2 * radius + 1));
+
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            for (int x = 0; x < output.width; ++x) {
+                Float4 center = LoadTexel(input, x, y);
+                float lumaCenter = Luma(center);
+                float lumaN = Luma(LoadTexel(input, x, y - 1));
+                float lumaS = Luma(LoadTexel(input, x, y + 1));
+                float lumaW = Luma(LoadTexel(input, x - 1, y));
+                float lumaE = Luma(LoadTexel(input, x + 1, y));
+
+                float lumaMin = std::min(lumaCenter, std::min(std::min(lumaN, lumaS), std::min(lumaW, lumaE)));
+                float lumaMax = std::max(lumaCenter, std::max(std::max(lumaN, lumaS), std::max(lumaW, lumaE)));
+
+                if (lumaMax - lumaMin < params.threshold) {
+                    StoreTexel(output, x, y, center);
+                    continue;
+                }
+
+                Float4 sum = { 0.0f, 0.0f, 0.0f, 0.0f };
+                for (int dy = -radius; dy <= radius; ++dy) {
+                    for (int dx = -radius; dx <= radius; ++dx) {
+                        sum = Add(sum, LoadTexel(input, x + dx, y + dy));
+                    }
+                }
+
+                StoreTexel(output, x, y, Lerp(center, Scale(sum, weight), params.blendFactor));
+            }
+        }
+    }
+
+    // --- PSSharpness : masque flou (unsharp mask) sur le voisinage en croix ---
+
+    void RunSharpness(const CPUKernelBindings& bindings, int rowBegin, int rowEnd, FrameArena&)
+    {
+        const CPUTexture& input = *TextureAt(bindings.shaderResources, 0);
+        CPUTexture& output = *TextureAt(bindings.unorderedAccess, 0);
+
+        const SharpnessConstants* constants = GetConstants<SharpnessConstants>(bindings, 0);
+        const float strength = constants ? constants->strength : 0.5f;
+
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            for (int x = 0; x < output.width; ++x) {
+                Float4 center = LoadTexel(input, x, y);
+                Float4 neighbours = Add(Add(LoadTexel(input, x, y - 1), LoadTexel(input, x, y + 1)),
+                                        Add(LoadTexel(input, x - 1, y), LoadTexel(input, x + 1, y)));
+                Float4 detail = Sub(center, Scale(neighbours, 0.25f));
+                Float4 result = Add(center, Scale(detail, strength));
+                result.w = center.w;
+                StoreTexel(output, x, y, result);
+            }
+        }
+    }
+
+    // --- BicubicUpscaleCS : filtre 4x4 avec les poids précalculés ---
+
+    int PrepareBicubic(CPUKernelBindings& bindings)
+    {
+        CPUTexture* input = TextureAt(bindings.shaderResources, 0);
+        CPUBuffer* weights = BufferAt(bindings.shaderResources, 1);
+        CPUTexture* output = TextureAt(bindings.unorderedAccess, 0);
+        if (!input || !weights || !output || weights->size < sizeof(float) * kBicubicPrecision * 4) {
+            return -1;
+        }
+
+        // La taille de sortie vient du tampon constant ; l'entrée est lue sur
+        // sa zone valide, éventuellement réduite par une étape précédente
+        const BicubicConstants* constants = GetConstants<BicubicConstants>(bindings, 0);
+        int width = constants && constants->outputWidth > 0 ? constants->outputWidth : output->allocWidth;
+        int height = constants && constants->outputHeight > 0 ? constants->outputHeight : output->allocHeight;
+
+        SetExtent(*output, width, height);
+        return output->height;
+    }
+
+    inline int WeightIndex(float position, int& base)
+    {
+        float floorPosition = std::floor(position);
+        base = static_cast<int>(floorPosition);
+        int index = static_cast<int>((position - floorPosition) * kBicubicPrecision);
+        return std::min(index, kBicubicPrecision - 1) * 4;
+    }
+
+    // Colonne source et poids horizontaux d'une colonne de sortie
+    struct BicubicColumn {
+        int base;
+        int weightIndex;
+    };
+
+    inline BicubicColumn GetBicubicColumn(int x, float scaleX)
+    {
+        BicubicColumn column;
+        column.weightIndex = WeightIndex((x + 0.5f) * scaleX - 0.5f, column.base);
+        return column;
+    }
+
+    void RunBicubic(const CPUKernelBindings& bindings, int rowBegin, int rowEnd, FrameArena& scratch)
+    {
+        const CPUTexture& input = *TextureAt(bindings.shaderResources, 0);
+        const float* weights = reinterpret_cast<const float*>(BufferAt(bindings.shaderResources, 1)->data);
+        CPUTexture& output = *TextureAt(bindings.unorderedAccess, 0);
+
+        const float scaleX = static_cast<float>(input.width) / output.width;
+        const float scaleY = static_cast<float>(input.height) / output.height;
+
+        // Les colonnes sont les mêmes pour toutes les lignes du bloc : calculées
+        // une fois dans l'arena du thread (calcul par pixel si elle est épuisée)
+        BicubicColumn* columns = scratch.AllocateArray<BicubicColumn>(static_cast<size_t>(output.width));
+        if (columns) {
+            for (int x = 0; x < output.width; ++x) {
+                columns[x] = GetBicubicColumn(x, scaleX);
+            }
+        }
+
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            int baseY;
+            const float* weightsY = weights + WeightIndex((y + 0.5f) * scaleY - 0.5f, baseY);
+
+            for (int x = 0; x < output.width; ++x) {
+                const BicubicColumn column = columns ? columns[x] : GetBicubicColumn(x, scaleX);
+                const int baseX = column.base;
+                const float* weightsX = weights + column.weightIndex;
+
+                Float4 sum = { 0.0f, 0.0f, 0.0f, 0.0f };
+                for (int j = 0; j < 4; ++j) {
+                    Float4 row = { 0.0f, 0.0f, 0.0f, 0.0f };
+                    for (int i = 0; i < 4; ++i) {
+                        row = Add(row, Scale(LoadTexel(input, baseX - 1 + i, baseY - 1 + j), weightsX[i]));
+                    }
+                    sum = Add(sum, Scale(row, weightsY[j]));
+                }
+
+                StoreTexel(output, x, y, sum);
+            }
+        }
+    }
+
+    // --- MotionEstimationCS : recherche en trois pas par bloc (SAD sur G) ---
+
+    uint32_t BlockSADScalar(const uint8_t* a, size_t pitchA, const uint8_t* b, size_t pitchB, int width, int height)
+    {
+        uint32_t sum = 0;
+        for (int y = 0; y < height; ++y, a += pitchA, b += pitchB) {
+            for (int i = 1; i < width * 4; i += 4) {
+                sum += static_cast<uint32_t>(std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])));
+            }
+        }
+        return sum;
+    }
+
+#if XIS_CPU_SSE2
+    // Quatre pixels par registre : les octets autres que G sont masqués à
+    // zéro des deux côtés, psadbw ne compte donc que G
+    uint32_t BlockSADSSE2(const uint8_t* a, size_t pitchA, const uint8_t* b, size_t pitchB, int width, int height)
+    {
+        const __m128i mask = _mm_set1_epi32(0x0000FF00);
+        const int vectorWidth = width & ~3;
+
+        __m128i total = _mm_setzero_si128();
+        uint32_t tail = 0;
+        for (int y = 0; y < height; ++y, a += pitchA, b += pitchB) {
+            for (int x = 0; x < vectorWidth; x += 4) {
+                __m128i va = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x * 4)), mask);
+                __m128i vb = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x * 4)), mask);
+                total = _mm_add_epi64(total, _mm_sad_epu8(va, vb));
+            }
+            for (int x = vectorWidth; x < width; ++x) {
+                tail += static_cast<uint32_t>(std::abs(static_cast<int>(a[x * 4 + 1]) - static_cast<int>(b[x * 4 + 1])));
+            }
+        }
+
+        return static_cast<uint32_t>(_mm_cvtsi128_si32(total) + _mm_cvtsi128_si32(_mm_srli_si128(total, 8))) + tail;
+    }
+
+    const CPUBlockSADFn kBlockSAD = BlockSADSSE2;
+#else
+    const CPUBlockSADFn kBlockSAD = BlockSADScalar;
+#endif
+
+    struct BlockGrid {
+        int width;
+        int height;
+        int blockSize;
+        int gridWidth;
+        int gridHeight;
+    };
+
+    bool GetBlockGrid(const CPUKernelBindings& bindings, int frameWidth, int frameHeight, BlockGrid& grid)
+    {
+        const MotionConstants* constants = GetConstants<MotionConstants>(bindings, 0);
+        if (!constants) {
+            return false;
+        }
+
+        grid.width = std::min(constants->frameWidth, frameWidth);
+        grid.height = std::min(constants->frameHeight, frameHeight);
+        grid.blockSize = std::max(1, constants->blockSize);
+        grid.gridWidth = (grid.width + grid.blockSize - 1) / grid.blockSize;
+        grid.gridHeight = (grid.height + grid.blockSize - 1) / grid.blockSize;
+        return grid.width > 0 && grid.height > 0;
+    }
+
+    int PrepareMotionEstimation(CPUKernelBindings& bindings)
+    {
+        CPUTexture* previous = TextureAt(bindings.shaderResources, 0);
+        CPUTexture* current = TextureAt(bindings.shaderResources, 1);
+        CPUBuffer* blockMotion = BufferAt(bindings.unorderedAccess, 0);
+        if (!previous || !current || !blockMotion) {
+            return -1;
+        }
+
+        BlockGrid grid;
+        if (!GetBlockGrid(bindings, std::min(previous->width, current->width),
+                          std::min(previous->height, current->height), grid)) {
+            return -1;
+        }
+
+        size_t required = static_cast<size_t>(grid.gridWidth) * grid.gridHeight * sizeof(float) * 4;
+        return blockMotion->size >= required ? grid.gridHeight : -1;
+    }
+
+    void RunMotionEstimation(const CPUKernelBindings& bindings, int rowBegin, int rowEnd, FrameArena&)
+    {
+        const CPUTexture& previous = *TextureAt(bindings.shaderResources, 0);
+        const CPUTexture& current = *TextureAt(bindings.shaderResources, 1);
+        float* blockMotion = reinterpret_cast<float*>(BufferAt(bindings.unorderedAccess, 0)->data);
+
+        BlockGrid grid;
+        GetBlockGrid(bindings, std::min(previous.width, current.width), std::min(previous.height, current.height), grid);
+        const int radius = std::max(1, GetConstants<MotionConstants>(bindings, 0)->searchRadius);
+        const bool bytesG = previous.format == CPUTextureFormat::RGBA8 && current.format == CPUTextureFormat::RGBA8;
+
+        for (int by = rowBegin; by < rowEnd; ++by) {
+            int y0 = by * grid.blockSize;
+            int y1 = std::min(y0 + grid.blockSize, grid.height);
+
+            for (int bx = 0; bx < grid.gridWidth; ++bx) {
+                int x0 = bx * grid.blockSize;
+                int x1 = std::min(x0 + grid.blockSize, grid.width);
+
+                // Le contenu en p dans la frame précédente se retrouve en
+                // p + mv dans la frame courante
+                auto blockCost = [&](int dx, int dy) {
+                    // Bloc déplacé entièrement dans l'image : SAD entière sur
+                    // les octets G, sans bornage des coordonnées
+                    if (bytesG && x0 + dx >= 0 && y0 + dy >= 0 && x1 + dx <= current.width && y1 + dy <= current.height) {
+                        uint32_t sum = kBlockSAD(previous.GetRow(y0) + static_cast<size_t>(x0) * 4, previous.pitch,
+                                                 current.GetRow(y0 + dy) + static_cast<size_t>(x0 + dx) * 4, current.pitch,
+                                                 x1 - x0, y1 - y0);
+                        return static_cast<float>(sum) * (1.0f / 255.0f);
+                    }
+
+                    float cost = 0.0f;
+                    for (int y = y0; y < y1; ++y) {
+                        for (int x = x0; x < x1; ++x) {
+                            cost += std::fabs(LoadTexel(previous, x, y).y - LoadTexel(current, x + dx, y + dy).y);
+                        }
+                    }
+                    return cost;
+                };
+
+                int bestX = 0;
+                int bestY = 0;
+                float bestCost = blockCost(0, 0);
+
+                for (int step = std::max(1, radius / 2); step >= 1; step /= 2) {
+                    int centerX = bestX;
+                    int centerY = bestY;
+                    for (int sy = -1; sy <= 1; ++sy) {
+                        for (int sx = -1; sx <= 1; ++sx) {
+                            int dx = centerX + sx * step;
+                            int dy = centerY + sy * step;
+                            if ((sx == 0 && sy == 0) || std::abs(dx) > radius || std::abs(dy) > radius) {
+                                continue;
+                            }
+                            float cost = blockCost(dx, dy);
+                            if (cost < bestCost) {
+                                bestCost = cost;
+                                bestX = dx;
+                                bestY = dy;
+                            }
+                        }
+                    }
+                }
+
+                float meanDifference = bestCost / static_cast<float>((y1 - y0) * (x1 - x0));
+                float* block = blockMotion + (static_cast<size_t>(by) * grid.gridWidth + bx) * 4;
+                block[0] = static_cast<float>(bestX);
+                block[1] = static_cast<float>(bestY);
+                block[2] = 1.0f / (1.0f + 16.0f * meanDifference);
+                block[3] = 0.0f;
+            }
+        }
+    }
+
+    // --- MotionRefinementCS : interpolation des vecteurs de blocs par pixel ---
+
+    int PrepareMotionRefinement(CPUKernelBindings& bindings)
+    {
+        CPUBuffer* blockMotion = BufferAt(bindings.shaderResources, 0);
+        CPUTexture* motionVectors = TextureAt(bindings.unorderedAccess, 0);
+        if (!blockMotion || !motionVectors) {
+            return -1;
+        }
+
+        BlockGrid grid;
+        if (!GetBlockGrid(bindings, motionVectors->allocWidth, motionVectors->allocHeight, grid)) {
+            return -1;
+        }
+
+        size_t required = static_cast<size_t>(grid.gridWidth) * grid.gridHeight * sizeof(float) * 4;
+        if (blockMotion->size < required) {
+            return -1;
+        }
+
+        SetExtent(*motionVectors, grid.width, grid.height);
+        return motionVectors->height;
+    }
+
+    void RunMotionRefinement(const CPUKernelBindings& bindings, int rowBegin, int rowEnd, FrameArena&)
+    {
+        const float* blockMotion = reinterpret_cast<const float*>(BufferAt(bindings.shaderResources, 0)->data);
+        CPUTexture& motionVectors = *TextureAt(bindings.unorderedAccess, 0);
+
+        BlockGrid grid;
+        GetBlockGrid(bindings, motionVectors.allocWidth, motionVectors.allocHeight, grid);
+        const float inverseBlockSize = 1.0f / grid.blockSize;
+
+        auto blockAt = [&](int bx, int by) {
+            return blockMotion + (static_cast<size_t>(by) * grid.gridWidth + bx) * 4;
+        };
+
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            float fy = std::min(std::max((y + 0.5f) * inverseBlockSize - 0.5f, 0.0f), static_cast<float>(grid.gridHeight - 1));
+            int by0 = static_cast<int>(fy);
+            int by1 = std::min(by0 + 1, grid.gridHeight - 1);
+            float ty = fy - by0;
+
+            for (int x = 0; x < motionVectors.width; ++x) {
+                float fx = std::min(std::max((x + 0.5f) * inverseBlockSize - 0.5f, 0.0f), static_cast<float>(grid.gridWidth - 1));
+                int bx0 = static_cast<int>(fx);
+                int bx1 = std::min(bx0 + 1, grid.gridWidth - 1);
+                float tx = fx - bx0;
+
+                // Pondération bilinéaire par la confiance de chaque bloc
+                const float* blocks[4] = { blockAt(bx0, by0), blockAt(bx1, by0), blockAt(bx0, by1), blockAt(bx1, by1) };
+                const float spatial[4] = { (1 - tx) * (1 - ty), tx * (1 - ty), (1 - tx) * ty, tx * ty };
+
+                float mvx = 0.0f;
+                float mvy = 0.0f;
+                float confidence = 0.0f;
+                float totalWeight = 0.0f;
+                for (int i = 0; i < 4; ++i) {
+                    float weight = spatial[i] * (blocks[i][2] + 1e-3f);
+                    mvx += blocks[i][0] * weight;
+                    mvy += blocks[i][1] * weight;
+                    confidence += blocks[i][2] * spatial[i];
+                    totalWeight += weight;
+                }
+
+                StoreMotion(motionVectors, x, y, mvx / totalWeight, mvy / totalWeight, confidence);
+            }
+        }
+    }
+
+    // --- FrameInterpolationCS : mélange compensé en mouvement ---
+
+    int PrepareFrameInterpolation(CPUKernelBindings& bindings)
+    {
+        CPUTexture* previous = TextureAt(bindings.shaderResources, 0);
+        CPUTexture* current = TextureAt(bindings.shaderResources, 1);
+        CPUTexture* motionVectors = TextureAt(bindings.shaderResources, 2);
+        CPUTexture* output = TextureAt(bindings.unorderedAccess, 0);
+        const InterpolationConstants* constants = GetConstants<InterpolationConstants>(bindings, 0);
+        if (!previous || !current || !motionVectors || !output || !constants) {
+            return -1;
+        }
+
+        int width = std::min(constants->frameWidth, std::min(previous->width, current->width));
+        int height = std::min(constants->frameHeight, std::min(previous->height, current->height));
+        SetExtent(*output, width, height);
+
+        if (CPUTexture* occlusion = TextureAt(bindings.unorderedAccess, 1)) {
+            SetExtent(*occlusion, width, height);
+        }
+
+        return output->height;
+    }
+
+    void RunFrameInterpolation(const CPUKernelBindings& bindings, int rowBegin, int rowEnd, FrameArena&)
+    {
+        const CPUTexture& previous = *TextureAt(bindings.shaderResources, 0);
+        const CPUTexture& current = *TextureAt(bindings.shaderResources, 1);
+        const CPUTexture& motionVectors = *TextureAt(bindings.shaderResources, 2);
+        CPUTexture& output = *TextureAt(bindings.unorderedAccess, 0);
+
+        const InterpolationConstants* constants = GetConstants<InterpolationConstants>(bindings, 0);
+        CPUTexture* occlusion = constants->useOcclusion ? TextureAt(bindings.unorderedAccess, 1) : nullptr;
+
+        const InterpolationRootConstants* rootConstants = GetConstants<InterpolationRootConstants>(bindings, kOverrideRootConstantSlot);
+        const float t = rootConstants ? std::min(1.0f, std::max(0.0f, rootConstants->timePosition)) : 0.5f;
+
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            for (int x = 0; x < output.width; ++x) {
+                float mvx;
+                float mvy;
+                LoadMotion(motionVectors, x, y, mvx, mvy);
+
+                float px = x + 0.5f;
+                float py = y + 0.5f;
+                Float4 fromPrevious = SampleBilinear(previous, px - t * mvx, py - t * mvy);
+                Float4 fromCurrent = SampleBilinear(current, px + (1.0f - t) * mvx, py + (1.0f - t) * mvy);
+                Float4 result = Lerp(fromPrevious, fromCurrent, t);
+
+                if (occlusion) {
+                    // Les deux projections divergent : garder la frame la
+                    // plus proche dans le temps plutôt qu'un mélange fantôme
+                    float difference = std::fabs(Luma(fromPrevious) - Luma(fromCurrent));
+                    if (difference > kOcclusionThreshold) {
+                        result = t < 0.5f ? fromPrevious : fromCurrent;
+                    }
+                    if (x < occlusion->width && y < occlusion->height) {
+                        StoreTexel(*occlusion, x, y, { difference, 0.0f, 0.0f, 1.0f });
+                    }
+                }
+
+                StoreTexel(output, x, y, result);
+            }
+        }
+    }
+
+    const CPUKernel kCopyKernel = { "Copy", 1, 1, 0, PrepareCopy, RunCopy };
+
+    const CPUKernel kKernels[] = {
+        { "PSDownsample", 1, 1, 1, PrepareDownsample, RunDownsample },
+        { "PSAntiAliasing", 1, 1, 1, PrepareSameExtent, RunAntiAliasing },
+        { "PSSharpness", 1, 1, 1, PrepareSameExtent, RunSharpness },
+        { "BicubicUpscaleCS", 2, 1, 1, PrepareBicubic, RunBicubic },
+        { "MotionEstimationCS", 2, 1, 1, PrepareMotionEstimation, RunMotionEstimation },
+        { "MotionRefinementCS", 1, 1, 1, PrepareMotionRefinement, RunMotionRefinement },
+        { "FrameInterpolationCS", 3, 2, 1, PrepareFrameInterpolation, RunFrameInterpolation },
+    };
+
+} // namespace
+
+const CPUKernel* FindCPUKernel(const char* entryPoint)
+{
+    if (!entryPoint) {
+        return nullptr;
+    }
+
+    for (const CPUKernel& kernel : kKernels) {
+        if (std::strcmp(kernel.entryPoint, entryPoint) == 0) {
+            return &kernel;
+        }
+    }
+
+    return nullptr;
+}
+
+const CPUKernel* GetCPUCopyKernel()
+{
+    return &kCopyKernel;
+}
+
+CPUBlockSADFn GetCPUBlockSAD(CPUBlockSADVariant variant)
+{
+    switch (variant) {
+    case CPUBlockSADVariant::Scalar:
+        return BlockSADScalar;
+    case CPUBlockSADVariant::SSE2:
+#if XIS_CPU_SSE2
+        return BlockSADSSE2;
+#else
+        return nullptr;
+#endif
+    }
+    return nullptr;
+}
+
+void CopyCPUTextureRows(const CPUTexture& source, CPUTexture& destination, int rowBegin, int rowEnd)
+{
+    const int width = std::min(source.width, destination.width);
+    rowEnd = std::min(rowEnd, std::min(source.height, destination.height));
+
+    if (source.format == destination.format) {
+        const size_t rowSize = static_cast<size_t>(width) * GetCPUFormatSize(source.format);
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            std::memcpy(destination.GetRow(y), source.GetRow(y), rowSize);
+        }
+        return;
+    }
+
+    for (int y = rowBegin; y < rowEnd; ++y) {
+        for (int x = 0; x < width; ++x) {
+            StoreTexel(destination, x, y, LoadTexel(source, x, y));
+        }
+    }
+}
+
+} // namespace XIS
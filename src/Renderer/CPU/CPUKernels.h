@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CPUResources.h"
+#include "../../Utils/FrameArena.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace XIS {
+
+/**
+ * @brief Ressources liées à un appel de kernel CPU
+ *
+ * Reprend les registres HLSL : t# (shaderResources), u# (unorderedAccess,
+ * la cible de rendu occupant u0 pour les pixel shaders) et b#
+ * (constantBuffers). Les root constants d'un registre b# remplacent le
+ * tampon constant lié à ce registre.
+ */
+struct CPUKernelBindings {
+    static const int kMaxShaderResources = 8;
+    static const int kMaxUnorderedAccess = 4;
+    static const int kMaxConstantBuffers = 4;
+    static const size_t kMaxRootConstantSize = 64;
+
+    CPUResource* shaderResources[kMaxShaderResources] = {};
+    CPUResource* unorderedAccess[kMaxUnorderedAccess] = {};
+    CPUBuffer* constantBuffers[kMaxConstantBuffers] = {};
+
+    alignas(16) uint8_t rootConstants[kMaxConstantBuffers][kMaxRootConstantSize] = {};
+    size_t rootConstantSizes[kMaxConstantBuffers] = {};
+};
+
+/**
+ * @brief Implémentation CPU d'un point d'entrée HLSL
+ *
+ * prepare valide les liaisons, fixe la zone valide des sorties et renvoie le
+ * nombre de lignes à traiter (-1 si les liaisons sont invalides) ; run
+ * traite ensuite les lignes [rowBegin, rowEnd), éventuellement en parallèle.
+ * run prend ses tuiles de travail dans scratch, l'arena du thread qui
+ * l'exécute, plutôt que sur le tas. Les kernels sont des implémentations de référence des shaders : mêmes
+ * entrées, mêmes sorties, sans recherche de performance particulière.
+ *
+ * shaderResourceCount, unorderedAccessCount et constantBufferCount sont les
+ * registres t#, u# et b# déclarés par le shader : les registres suivants
+ * peuvent garder des liaisons d'un appel précédent et ne sont jamais lus
+ * (les root constants du registre de surcharge ne sont pas des liaisons).
+ */
+struct CPUKernel {
+    const char* entryPoint;
+    int shaderResourceCount;
+    int unorderedAccessCount;
+    int constantBufferCount;
+    int (*prepare)(CPUKernelBindings& bindings);
+    void (*run)(const CPUKernelBindings& bindings, int rowBegin, int rowEnd, FrameArena& scratch);
+};
+
+/**
+ * @brief Kernel correspondant à un point d'entrée, nullptr s'il est inconnu
+ */
+const CPUKernel* FindCPUKernel(const char* entryPoint);
+
+/**
+ * @brief Kernel de copie t0 → u0, utilisé pour les points d'entrée inconnus
+ */
+const CPUKernel* GetCPUCopyKernel();
+
+/**
+ * @brief Variantes de la fonction de coût de MotionEstimationCS
+ */
+enum class CPUBlockSADVariant {
+    Scalar,
+    SSE2
+};
+
+/**
+ * @brief Somme des écarts absolus entre les octets G de deux blocs RGBA8
+ *
+ * a et b pointent sur le premier pixel de chaque bloc ; width et height
+ * sont en pixels.
+ */
+using CPUBlockSADFn = uint32_t (*)(const uint8_t* a, size_t pitchA, const uint8_t* b, size_t pitchB, int width, int height);
+
+/**
+ * @brief Implémentation d'une variante, nullptr si elle n'est pas disponible
+ *        pour l'architecture cible
+ *
+ * MotionEstimationCS utilise la meilleure variante disponible ; les autres
+ * servent aux microbenchmarks et à la validation.
+ */
+CPUBlockSADFn GetCPUBlockSAD(CPUBlockSADVariant variant);
+
+/**
+ * @brief Copie les lignes [rowBegin, rowEnd) d'une texture, avec conversion
+ *        de format si nécessaire
+ *
+ * La zone valide de la destination doit déjà être fixée.
+ */
+void CopyCPUTextureRows(const CPUTexture& source, CPUTexture& destination, int rowBegin, int rowEnd);
+
+} // namespace XIS
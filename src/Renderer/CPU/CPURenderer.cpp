@@ -0,0 +1,512 @@
+#include "CPURenderer.h"
+#include "CPUWorkerPool.h"
+#include "NumaTopology.h"
+#include "../../Utils/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace XIS {
+
+CPURenderer::CPURenderer(uint32_t workerThreadCount, int numaNode)
+    : m_numaNode(NumaTopology::Get().AcquireSessionNode(numaNode)),
+      m_workerPool(std::make_unique<CPUWorkerPool>(workerThreadCount, m_numaNode))
+{
+    if (m_numaNode >= 0) {
+        Logger::Info("CPURenderer: session affectée au nœud NUMA %d (%u threads)",
+                     m_numaNode, m_workerPool->GetThreadCount());
+    }
+}
+
+CPURenderer::~CPURenderer()
+{
+    ReleaseIntermediates();
+    NumaTopology::Get().ReleaseSessionNode(m_numaNode);
+}
+
+uint32_t CPURenderer::GetWorkerThreadCount() const
+{
+    return m_workerPool->GetThreadCount();
+}
+
+// --- Shaders ---
+
+void* CPURenderer::LoadKernel(const char* entryPoint)
+{
+    const CPUKernel* kernel = FindCPUKernel(entryPoint);
+    if (!kernel) {
+        // Le pipeline reste exécutable : l'étape se réduit à une copie
+        Logger::Warning("CPURenderer: aucun kernel CPU pour %s, copie de l'entrée utilisée", entryPoint ? entryPoint : "(null)");
+        kernel = GetCPUCopyKernel();
+    }
+    return const_cast<CPUKernel*>(kernel);
+}
+
+void* CPURenderer::LoadShader(const char* fileName, const char* entryPoint)
+{
+    (void)fileName;
+    return LoadKernel(entryPoint);
+}
+
+void* CPURenderer::LoadComputeShader(const char* fileName, const char* entryPoint, const char* profile)
+{
+    (void)fileName;
+    (void)profile;
+    return LoadKernel(entryPoint);
+}
+
+void CPURenderer::ReleaseShaderResource(void* shader)
+{
+    // Les kernels sont statiques
+    (void)shader;
+}
+
+bool CPURenderer::GetShaderSlotCounts(void* shader, int& shaderResources, int& unorderedAccessViews,
+                                      int& constantBuffers) const
+{
+    const CPUKernel* kernel = static_cast<const CPUKernel*>(shader);
+    if (!kernel) {
+        return false;
+    }
+    shaderResources = kernel->shaderResourceCount;
+    unorderedAccessViews = kernel->unorderedAccessCount;
+    constantBuffers = kernel->constantBufferCount;
+    return true;
+}
+
+// --- Ressources ---
+
+void* CPURenderer::CreateTexture2D(int width, int height, int format, bool allowUAV, const char* debugName)
+{
+    (void)allowUAV;
+
+    CPUTexture* texture = CreateTexture(width, height, static_cast<CPUTextureFormat>(format));
+    if (!texture) {
+        Logger::Error("CPURenderer: échec de la création de la texture %s (%dx%d, format %d)",
+                      debugName ? debugName : "", width, height, format);
+    }
+    return texture;
+}
+
+void* CPURenderer::CreateStructuredBuffer(int elementCount, int elementStride, bool allowUAV, const char* debugName)
+{
+    (void)allowUAV;
+
+    if (elementCount <= 0 || elementStride <= 0) {
+        Logger::Error("CPURenderer: dimensions invalides pour le buffer %s", debugName ? debugName : "");
+        return nullptr;
+    }
+
+    CPUBuffer* buffer = CreateCPUBuffer(static_cast<size_t>(elementCount) * elementStride, elementStride);
+    if (!buffer) {
+        Logger::Error("CPURenderer: échec de la création du buffer %s", debugName ? debugName : "");
+    }
+    return buffer;
+}
+
+void* CPURenderer::CreateConstantBuffer(size_t size, const void* initialData, const char* debugName)
+{
+    CPUBuffer* buffer = CreateCPUBuffer(size, 0);
+    if (!buffer) {
+        Logger::Error("CPURenderer: échec de la création du tampon constant %s", debugName ? debugName : "");
+        return nullptr;
+    }
+
+    if (initialData) {
+        std::memcpy(buffer->data, initialData, size);
+    }
+    return buffer;
+}
+
+void CPURenderer::ReleaseResource(void* resource)
+{
+    ReleaseBound(static_cast<CPUResource*>(resource));
+}
+
+void CPURenderer::ReleaseBuffer(void* buffer)
+{
+    ReleaseBound(static_cast<CPUResource*>(buffer));
+}
+
+void CPURenderer::ReleaseBound(CPUResource* resource)
+{
+    if (!resource) {
+        return;
+    }
+    UnbindResource(resource);
+    ReleaseCPUResource(resource);
+}
+
+void CPURenderer::UnbindResource(const CPUResource* resource)
+{
+    for (CPUKernelBindings* bindings : { &m_graphicsBindings, &m_computeBindings }) {
+        for (CPUResource*& bound : bindings->shaderResources) {
+            if (bound == resource) {
+                bound = nullptr;
+            }
+        }
+        for (CPUResource*& bound : bindings->unorderedAccess) {
+            if (bound == resource) {
+                bound = nullptr;
+            }
+        }
+        for (CPUBuffer*& bound : bindings->constantBuffers) {
+            if (bound == resource) {
+                bound = nullptr;
+            }
+        }
+    }
+}
+
+void CPURenderer::UpdateBuffer(void* buffer, const void* data, size_t size)
+{
+    CPUBuffer* target = AsCPUBuffer(buffer);
+    if (!target || !data) {
+        return;
+    }
+    std::memcpy(target->data, data, std::min(size, target->size));
+}
+
+bool CPURenderer::UpdateConstantBuffer(void* buffer, const void* data, size_t size)
+{
+    CPUBuffer* target = AsCPUBuffer(buffer);
+    if (!target || !data || size > target->size) {
+        return false;
+    }
+    std::memcpy(target->data, data, size);
+    return true;
+}
+
+bool CPURenderer::CopyResource(void* source, void* destination)
+{
+    if (source == destination) {
+        return source != nullptr;
+    }
+
+    CPUTexture* sourceTexture = AsCPUTexture(source);
+    CPUTexture* destinationTexture = AsCPUTexture(destination);
+    if (sourceTexture && destinationTexture) {
+        // La destination prend la zone valide de la source
+        destinationTexture->width = std::min(sourceTexture->width, destinationTexture->allocWidth);
+        destinationTexture->height = std::min(sourceTexture->height, destinationTexture->allocHeight);
+
+        int rows = destinationTexture->height;
+        m_workerPool->ParallelFor(rows, GetGrain(rows),
+            [sourceTexture, destinationTexture](int rowBegin, int rowEnd) {
+                CopyCPUTextureRows(*sourceTexture, *destinationTexture, rowBegin, rowEnd);
+            });
+        return true;
+    }
+
+    CPUBuffer* sourceBuffer = AsCPUBuffer(source);
+    CPUBuffer* destinationBuffer = AsCPUBuffer(destination);
+    if (sourceBuffer && destinationBuffer) {
+        std::memcpy(destinationBuffer->data, sourceBuffer->data, std::min(sourceBuffer->size, destinationBuffer->size));
+        return true;
+    }
+
+    Logger::Error("CPURenderer: copie entre ressources incompatibles");
+    return false;
+}
+
+size_t CPURenderer::GetResourceSize(void* resource) const
+{
+    if (const CPUTexture* texture = AsCPUTexture(resource)) {
+        return texture->GetAllocationSize();
+    }
+    if (const CPUBuffer* buffer = AsCPUBuffer(resource)) {
+        return buffer->size;
+    }
+    return 0;
+}
+
+size_t CPURenderer::GetResourceHugePageSize(void* resource) const
+{
+    const CPUTexture* texture = AsCPUTexture(resource);
+    return texture ? texture->hugePageBytes : 0;
+}
+
+int CPURenderer::GetFloatTextureFormat() const
+{
+    return static_cast<int>(CPUTextureFormat::R32F);
+}
+
+bool CPURenderer::ReadTexture(void* texture, int& width, int& height, int& format, std::vector<uint8_t>* pixels)
+{
+    const CPUTexture* cpuTexture = AsCPUTexture(texture);
+    if (!cpuTexture) {
+        return false;
+    }
+
+    width = cpuTexture->width;
+    height = cpuTexture->height;
+    format = static_cast<int>(cpuTexture->format);
+    if (pixels) {
+        // Étendue active uniquement, sans le remplissage des lignes
+        size_t rowBytes = static_cast<size_t>(width) * GetCPUFormatSize(cpuTexture->format);
+        pixels->resize(rowBytes * static_cast<size_t>(height));
+        for (int y = 0; y < height; ++y) {
+            std::memcpy(pixels->data() + rowBytes * static_cast<size_t>(y), cpuTexture->GetRow(y), rowBytes);
+        }
+    }
+    return true;
+}
+
+// --- Ressources intermédiaires ---
+
+void CPURenderer::CreateIntermediateResources(const XISParameters& params)
+{
+    const CPUTexture* input = AsCPUTexture(params.inputTexture);
+    const CPUTexture* output = AsCPUTexture(params.outputTexture);
+    if (!input || !output) {
+        Logger::Error("CPURenderer: les textures d'entrée et de sortie doivent être des textures CPU");
+        return;
+    }
+
+    // 0 (réduction) et 1 (antialiasing) à la taille d'entrée,
+    // 2 (upscaling) et 3 (génération de frames) à la taille de sortie
+    for (int i = 0; i < kIntermediateCount; ++i) {
+        const CPUTexture* reference = i < 2 ? input : output;
+        CPUTexture*& intermediate = m_intermediates[i];
+
+        if (intermediate &&
+            intermediate->allocWidth == reference->allocWidth &&
+            intermediate->allocHeight == reference->allocHeight &&
+            intermediate->format == reference->format) {
+            continue;
+        }
+
+        ReleaseBound(intermediate);
+        intermediate = CreateTexture(reference->allocWidth, reference->allocHeight, reference->format);
+        if (!intermediate) {
+            Logger::Error("CPURenderer: échec de la création de la ressource intermédiaire %d", i);
+        }
+    }
+}
+
+void* CPURenderer::GetIntermediateResource(int index)
+{
+    if (index < 0 || index >= kIntermediateCount) {
+        return nullptr;
+    }
+    return m_intermediates[index];
+}
+
+void CPURenderer::ReleaseIntermediateResources()
+{
+    // Les textures sont conservées pour la frame suivante (voir
+    // CreateIntermediateResources) ; seules les tuiles des kernels sont rendues
+    m_workerPool->ResetScratch();
+}
+
+void CPURenderer::ReleaseIntermediates()
+{
+    for (CPUTexture*& intermediate : m_intermediates) {
+        ReleaseBound(intermediate);
+        intermediate = nullptr;
+    }
+}
+
+// --- Pipeline graphique ---
+
+void CPURenderer::SetShader(void* shader)
+{
+    m_graphicsKernel = static_cast<const CPUKernel*>(shader);
+}
+
+void CPURenderer::SetConstantBuffer(void* buffer, int slot)
+{
+    if (slot >= 0 && slot < CPUKernelBindings::kMaxConstantBuffers) {
+        m_graphicsBindings.constantBuffers[slot] = AsCPUBuffer(buffer);
+    }
+}
+
+void CPURenderer::SetTexture(void* texture, int slot)
+{
+    if (slot >= 0 && slot < CPUKernelBindings::kMaxShaderResources) {
+        m_graphicsBindings.shaderResources[slot] = static_cast<CPUResource*>(texture);
+    }
+}
+
+void CPURenderer::SetRenderTarget(void* renderTarget)
+{
+    m_graphicsBindings.unorderedAccess[0] = static_cast<CPUResource*>(renderTarget);
+}
+
+void CPURenderer::SetRootConstants(int slot, const void* data, size_t size)
+{
+    SetRootConstantsIn(m_graphicsBindings, slot, data, size);
+}
+
+bool CPURenderer::ExecuteShader()
+{
+    return Run(m_graphicsKernel, m_graphicsBindings);
+}
+
+// --- Pipeline compute ---
+
+void CPURenderer::SetComputeShader(void* shader)
+{
+    m_computeKernel = static_cast<const CPUKernel*>(shader);
+}
+
+void CPURenderer::SetComputeConstantBuffer(int slot, void* buffer)
+{
+    if (slot >= 0 && slot < CPUKernelBindings::kMaxConstantBuffers) {
+        m_computeBindings.constantBuffers[slot] = AsCPUBuffer(buffer);
+    }
+}
+
+void CPURenderer::SetComputeShaderResource(int slot, void* resource)
+{
+    if (slot >= 0 && slot < CPUKernelBindings::kMaxShaderResources) {
+        m_computeBindings.shaderResources[slot] = static_cast<CPUResource*>(resource);
+    }
+}
+
+void CPURenderer::SetComputeUnorderedAccessView(int slot, void* resource)
+{
+    if (slot >= 0 && slot < CPUKernelBindings::kMaxUnorderedAccess) {
+        m_computeBindings.unorderedAccess[slot] = static_cast<CPUResource*>(resource);
+    }
+}
+
+void CPURenderer::SetComputeRootConstants(int slot, const void* data, size_t size)
+{
+    SetRootConstantsIn(m_computeBindings, slot, data, size);
+}
+
+void CPURenderer::DispatchCompute(int groupsX, int groupsY, int groupsZ)
+{
+    (void)groupsX;
+    (void)groupsY;
+    (void)groupsZ;
+    Run(m_computeKernel, m_computeBindings);
+}
+
+void CPURenderer::SyncCompute()
+{
+    // DispatchCompute est synchrone
+}
+
+// --- Exécution ---
+
+void CPURenderer::SetRootConstantsIn(CPUKernelBindings& bindings, int slot, const void* data, size_t size)
+{
+    if (slot < 0 || slot >= CPUKernelBindings::kMaxConstantBuffers || size > CPUKernelBindings::kMaxRootConstantSize) {
+        Logger::Warning("CPURenderer: root constants ignorées (slot %d, %zu octets)", slot, size);
+        return;
+    }
+
+    std::memcpy(bindings.rootConstants[slot], data, size);
+    bindings.rootConstantSizes[slot] = size;
+}
+
+bool CPURenderer::Run(const CPUKernel* kernel, CPUKernelBindings& bindings)
+{
+    if (!kernel) {
+        Logger::Error("CPURenderer: aucun shader lié");
+        return false;
+    }
+
+    int rows = kernel->prepare(bindings);
+
+    // Les root constants ne valent que pour un appel
+    auto clearRootConstants = [&bindings]() {
+        std::fill(std::begin(bindings.rootConstantSizes), std::end(bindings.rootConstantSizes), 0);
+    };
+
+    if (rows < 0) {
+        Logger::Error("CPURenderer: ressources liées invalides pour %s", kernel->entryPoint);
+        clearRootConstants();
+        return false;
+    }
+
+    const CPUKernelBindings& boundResources = bindings;
+    m_workerPool->ParallelFor(rows, GetGrain(rows), [kernel, &boundResources](int rowBegin, int rowEnd, FrameArena& scratch) {
+        kernel->run(boundResources, rowBegin, rowEnd, scratch);
+    });
+    if (m_numaNode >= 0) {
+        RecordNumaAccesses(kernel, bindings);
+    }
+
+    clearRootConstants();
+    return true;
+}
+
+CPUTexture* CPURenderer::CreateTexture(int width, int height, CPUTextureFormat format)
+{
+    if (m_numaNode < 0) {
+        return CreateCPUTexture(width, height, format);
+    }
+
+    CPUFirstTouch firstTouch = { &CPURenderer::FirstTouch, m_workerPool.get() };
+    CPUTexture* texture = CreateCPUTexture(width, height, format, &firstTouch);
+    if (texture) {
+        texture->numaNode = NumaTopology::Get().GetMemoryNode(texture->data, texture->GetAllocationSize());
+        texture->numaNodeQueried = true;
+    }
+    return texture;
+}
+
+void CPURenderer::FirstTouch(void* context, uint8_t* data, size_t size)
+{
+    // Blocs de 256 Kio répartis entre les threads du nœud
+    const size_t blockSize = 256 * 1024;
+    int blockCount = static_cast<int>((size + blockSize - 1) / blockSize);
+
+    static_cast<CPUWorkerPool*>(context)->ParallelFor(blockCount, 1, [data, size, blockSize](int begin, int end) {
+        size_t first = static_cast<size_t>(begin) * blockSize;
+        size_t last = std::min(size, static_cast<size_t>(end) * blockSize);
+        std::memset(data + first, 0, last - first);
+    });
+}
+
+void CPURenderer::RecordNumaAccesses(const CPUKernel* kernel, const CPUKernelBindings& bindings)
+{
+    NumaTopology& topology = NumaTopology::Get();
+
+    auto record = [&](CPUResource* resource) {
+        CPUTexture* texture = AsCPUTexture(resource);
+        if (!texture) {
+            return;
+        }
+        // Les textures de l'application sont situées à leur première utilisation
+        if (!texture->numaNodeQueried) {
+            texture->numaNode = topology.GetMemoryNode(texture->data, texture->GetAllocationSize());
+            texture->numaNodeQueried = true;
+        }
+        topology.RecordAccess(m_numaNode, texture->numaNode, texture->pitch * static_cast<size_t>(texture->height));
+    };
+
+    // Les registres au-delà de ceux du kernel gardent les liaisons d'appels
+    // précédents, dont les ressources ont pu être libérées depuis
+    for (int slot = 0; slot < kernel->shaderResourceCount; ++slot) {
+        record(bindings.shaderResources[slot]);
+    }
+    for (int slot = 0; slot < kernel->unorderedAccessCount; ++slot) {
+        record(bindings.unorderedAccess[slot]);
+    }
+}
+
+int CPURenderer::GetGrain(int rows) const
+{
+    if (m_rowsPerTask > 0) {
+        return m_rowsPerTask;
+    }
+
+    // Environ quatre blocs par thread pour équilibrer la charge
+    return std::max(1, rows / static_cast<int>(m_workerPool->GetActiveThreadCount() * 4));
+}
+
+void CPURenderer::SetParallelism(uint32_t threadCount, int rowsPerTask)
+{
+    m_workerPool->SetActiveThreadCount(threadCount);
+    m_rowsPerTask = std::max(0, rowsPerTask);
+}
+
+void CPURenderer::Flush()
+{
+    // Chaque appel est exécuté immédiatement
+}
+
+} // namespace XIS
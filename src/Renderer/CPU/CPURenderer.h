@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "../IRenderer.h"
+#include "CPUKernels.h"
+
+namespace XIS {
+
+class CPUWorkerPool;
+
+/**
+ * @brief Backend de rendu exécuté sur le CPU
+ *
+ * Chaque point d'entrée HLSL est associé à un kernel C++ de référence
+ * (CPUKernels) ; les appels ExecuteShader et DispatchCompute répartissent
+ * les lignes de la sortie entre les threads d'un CPUWorkerPool et ne
+ * reviennent qu'une fois le calcul terminé. Ce backend permet d'exécuter le
+ * pipeline sans GPU ni API graphique (benchmarks, tests, serveurs).
+ *
+ * Les textures sont des CPUTexture : format 0 (RGBA8) pour les images, 1
+ * (R32F) pour GetFloatTextureFormat. Les textures de l'application sont
+ * créées par XIS::CPU::CreateTexture.
+ *
+ * Sur une machine NUMA, chaque renderer est affecté à un nœud
+ * (NumaTopology) : ses threads de calcul y sont épinglés, ses textures y
+ * sont écrites en premier par ces threads, et les octets des textures liées
+ * à chaque kernel sont comptés comme accès locaux ou distants.
+ */
+class CPURenderer : public IRenderer {
+public:
+    /**
+     * @brief Constructeur
+     *
+     * @param workerThreadCount Nombre de threads de calcul, thread de la
+     *        session compris (0 = nombre de cœurs logiques du nœud)
+     * @param numaNode Nœud NUMA de la session (-1 = le moins chargé ;
+     *        ignoré sur une machine non NUMA)
+     */
+    explicit CPURenderer(uint32_t workerThreadCount, int numaNode = -1);
+    ~CPURenderer() override;
+
+    CPURenderer(const CPURenderer&) = delete;
+    CPURenderer& operator=(const CPURenderer&) = delete;
+
+    uint32_t GetWorkerThreadCount() const;
+
+    /**
+     * @brief Nœud NUMA de la session, -1 sur une machine non NUMA
+     */
+    int GetNumaNode() const { return m_numaNode; }
+
+    // --- IRenderer ---
+    void* LoadShader(const char* fileName, const char* entryPoint) override;
+    void* LoadComputeShader(const char* fileName, const char* entryPoint, const char* profile) override;
+    void ReleaseShaderResource(void* shader) override;
+    bool GetShaderSlotCounts(void* shader, int& shaderResources, int& unorderedAccessViews,
+                             int& constantBuffers) const override;
+
+    void* CreateTexture2D(int width, int height, int format, bool allowUAV, const char* debugName) override;
+    void* CreateStructuredBuffer(int elementCount, int elementStride, bool allowUAV, const char* debugName) override;
+    void* CreateConstantBuffer(size_t size, const void* initialData = nullptr, const char* debugName = nullptr) override;
+    void ReleaseResource(void* resource) override;
+    void ReleaseBuffer(void* buffer) override;
+    void UpdateBuffer(void* buffer, const void* data, size_t size) override;
+    bool UpdateConstantBuffer(void* buffer, const void* data, size_t size) override;
+    bool CopyResource(void* source, void* destination) override;
+    size_t GetResourceSize(void* resource) const override;
+    size_t GetResourceHugePageSize(void* resource) const override;
+    int GetFloatTextureFormat() const override;
+    bool ReadTexture(void* texture, int& width, int& height, int& format, std::vector<uint8_t>* pixels) override;
+
+    /**
+     * Les ressources intermédiaires sont conservées d'une frame à l'autre et
+     * recréées seulement si la taille ou le format de l'entrée ou de la
+     * sortie change ; ReleaseIntermediateResources, appelé en fin de frame,
+     * ne fait que remettre à zéro les arenas des threads de calcul.
+     */
+    void CreateIntermediateResources(const XISParameters& params) override;
+    void* GetIntermediateResource(int index) override;
+    void ReleaseIntermediateResources() override;
+
+    void SetShader(void* shader) override;
+    void SetConstantBuffer(void* buffer, int slot) override;
+    void SetTexture(void* texture, int slot) override;
+    void SetRenderTarget(void* renderTarget) override;
+    void SetRootConstants(int slot, const void* data, size_t size) override;
+    bool ExecuteShader() override;
+
+    void SetComputeShader(void* shader) override;
+    void SetComputeConstantBuffer(int slot, void* buffer) override;
+    void SetComputeShaderResource(int slot, void* resource) override;
+    void SetComputeUnorderedAccessView(int slot, void* resource) override;
+    void SetComputeRootConstants(int slot, const void* data, size_t size) override;
+
+    /**
+     * La grille de groupes est ignorée : le kernel couvre toute sa sortie.
+     */
+    void DispatchCompute(int groupsX, int groupsY, int groupsZ) override;
+    void SyncCompute() override;
+
+    /**
+     * Limite les threads du pool participant aux appels suivants (le pool
+     * n'est pas recréé) et fixe la taille des blocs de lignes.
+     */
+    void SetParallelism(uint32_t threadCount, int rowsPerTask) override;
+    void Flush() override;
+
+private:
+    static const int kIntermediateCount = 4;
+
+    void* LoadKernel(const char* entryPoint);
+    bool Run(const CPUKernel* kernel, CPUKernelBindings& bindings);
+    static void SetRootConstantsIn(CPUKernelBindings& bindings, int slot, const void* data, size_t size);
+    void ReleaseIntermediates();
+
+    // Retire une ressource libérée des liaisons graphiques et compute, pour
+    // qu'un appel suivant ne lise pas une ressource rendue
+    void UnbindResource(const CPUResource* resource);
+    // Libère une ressource après l'avoir retirée des liaisons
+    void ReleaseBound(CPUResource* resource);
+
+    // Crée une texture écrite en premier par les threads de calcul du nœud
+    CPUTexture* CreateTexture(int width, int height, CPUTextureFormat format);
+    static void FirstTouch(void* context, uint8_t* data, size_t size);
+
+    // Compte les accès d'un kernel aux textures liées à ses registres déclarés
+    void RecordNumaAccesses(const CPUKernel* kernel, const CPUKernelBindings& bindings);
+
+    int m_numaNode;
+    std::unique_ptr<CPUWorkerPool> m_workerPool;
+    int m_rowsPerTask = 0;                // 0 = quatre blocs par thread actif
+
+    // Lignes par bloc pour une sortie de rows lignes
+    int GetGrain(int rows) const;
+
+    const CPUKernel* m_graphicsKernel = nullptr;
+    const CPUKernel* m_computeKernel = nullptr;
+    CPUKernelBindings m_graphicsBindings;
+    CPUKernelBindings m_computeBindings;
+
+    CPUTexture* m_intermediates[kIntermediateCount] = {};
+};
+
+} // namespace XIS
@@ -0,0 +1,390 @@
+#include "CPUResources.h"
+#include "../../Utils/Logger.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace XIS {
+
+namespace {
+    // Lignes et buffers alignés sur une ligne de cache
+    const size_t kAlignment = 64;
+
+    uint8_t* AllocateZeroed(size_t size)
+    {
+        size_t rounded = (size + kAlignment - 1) / kAlignment * kAlignment;
+        void* memory = std::aligned_alloc(kAlignment, rounded > 0 ? rounded : kAlignment);
+        if (memory) {
+            std::memset(memory, 0, rounded);
+        }
+        return static_cast<uint8_t*>(memory);
+    }
+
+    // Ressources vivantes de tous les renderers : une double libération est
+    // détectée sans relire l'en-tête d'une ressource déjà rendue, dont la
+    // mémoire peut avoir été réutilisée par une autre ressource
+    struct LiveResources {
+        std::mutex mutex;
+        std::unordered_set<const CPUResource*> resources;
+    };
+
+    LiveResources& GetLiveResources()
+    {
+        static LiveResources live;
+        return live;
+    }
+
+    template <typename T>
+    T* TrackResource(T* resource)
+    {
+        LiveResources& live = GetLiveResources();
+        std::lock_guard<std::mutex> lock(live.mutex);
+        live.resources.insert(resource);
+        return resource;
+    }
+
+    bool UntrackResource(const CPUResource* resource)
+    {
+        LiveResources& live = GetLiveResources();
+        std::lock_guard<std::mutex> lock(live.mutex);
+        return live.resources.erase(resource) > 0;
+    }
+
+    // Aliasing 4K : deux adresses distantes d'un multiple de 4 Kio partagent
+    // leurs ensembles de cache L1 et leurs bits de désambiguïsation mémoire
+    const size_t kAliasingStride = 4096;
+    const int kAliasingRows = 4;
+
+    // En dessous, une texture tient dans quelques entrées de TLB
+    const size_t kHugePageSize = 2u << 20;
+
+#ifdef __linux__
+    /**
+     * Pages larges transparentes activées (mode always ou madvise), lu une
+     * fois par processus : sinon smaps n'est jamais parcouru
+     */
+    bool TransparentHugePagesEnabled()
+    {
+        static const bool enabled = [] {
+            FILE* file = std::fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+            if (!file) {
+                return false;
+            }
+            char mode[128] = {};
+            bool never = !std::fgets(mode, sizeof(mode), file) || std::strstr(mode, "[never]") != nullptr;
+            std::fclose(file);
+            return !never;
+        }();
+        return enabled;
+    }
+
+    /**
+     * Octets de [address, address + size) servis par des pages larges
+     * transparentes, d'après /proc/self/smaps
+     *
+     * Les projections y sont triées par adresse : la lecture s'arrête à la
+     * première projection située après la zone. Une texture récente, placée
+     * sous les projections existantes, est trouvée parmi les premières.
+     */
+    size_t QueryTransparentHugePageBytes(const void* address, size_t size)
+    {
+        if (!TransparentHugePagesEnabled()) {
+            return 0;
+        }
+
+        FILE* file = std::fopen("/proc/self/smaps", "r");
+        if (!file) {
+            return 0;
+        }
+
+        uintptr_t begin = reinterpret_cast<uintptr_t>(address);
+        uintptr_t end = begin + size;
+        bool inRange = false;
+        size_t bytes = 0;
+
+        char line[256];
+        while (std::fgets(line, sizeof(line), file)) {
+            unsigned long long start = 0;
+            unsigned long long stop = 0;
+            if (std::sscanf(line, "%llx-%llx ", &start, &stop) == 2) {
+                if (start >= end) {
+                    break;
+                }
+                inRange = stop > begin;
+                continue;
+            }
+            unsigned long long kilobytes = 0;
+            if (inRange && std::sscanf(line, "AnonHugePages: %llu kB", &kilobytes) == 1) {
+                bytes += static_cast<size_t>(kilobytes) * 1024;
+            }
+        }
+
+        std::fclose(file);
+
+        // Une zone voisine ayant reçu le même conseil partage la projection
+        return bytes < size ? bytes : size;
+    }
+
+    /**
+     * Projette size octets en pages larges : pages explicites si le système
+     * en réserve, sinon projection alignée sur 2 Mio confiée aux pages larges
+     * transparentes. Le contenu est nul.
+     */
+    bool MapHugePages(CPUTexture* texture, size_t size, const CPUFirstTouch* firstTouch)
+    {
+        size_t mapped = (size + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+
+        void* memory = mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (memory != MAP_FAILED) {
+            texture->data = static_cast<uint8_t*>(memory);
+            texture->backing = CPUPageBacking::HugePages;
+            texture->mappedBytes = mapped;
+            texture->hugePageBytes = mapped;
+            return true;
+        }
+
+        // Marge d'une page large pour aligner le début de la projection
+        size_t reserved = mapped + kHugePageSize;
+        memory = mmap(nullptr, reserved, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            return false;
+        }
+
+        uintptr_t start = reinterpret_cast<uintptr_t>(memory);
+        uintptr_t aligned = (start + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+        if (aligned > start) {
+            munmap(memory, aligned - start);
+        }
+        size_t tail = start + reserved - (aligned + mapped);
+        if (tail > 0) {
+            munmap(reinterpret_cast<void*>(aligned + mapped), tail);
+        }
+
+        uint8_t* data = reinterpret_cast<uint8_t*>(aligned);
+#ifdef MADV_HUGEPAGE
+        madvise(data, mapped, MADV_HUGEPAGE);
+#endif
+        // Les pages sont touchées dès maintenant, pour que le noyau les
+        // attribue à la création plutôt qu'au premier traitement, et pour
+        // savoir ce qui a été obtenu
+        if (firstTouch) {
+            firstTouch->fn(firstTouch->context, data, mapped);
+        } else {
+            for (size_t offset = 0; offset < mapped; offset += kHugePageSize) {
+                data[offset] = 0;
+            }
+        }
+
+        texture->data = data;
+        texture->backing = CPUPageBacking::TransparentHugePages;
+        texture->mappedBytes = mapped;
+        texture->hugePageBytes = QueryTransparentHugePageBytes(data, mapped);
+
+        // Signalé une fois par processus : THP désactivées ou mémoire fragmentée
+        static std::atomic<bool> reported{false};
+        if (texture->hugePageBytes == 0 && !reported.exchange(true)) {
+            Logger::Info("CPUResources: pages larges indisponibles, textures en pages de 4 Kio "
+                         "(voir /sys/kernel/mm/transparent_hugepage/enabled)");
+        }
+        return true;
+    }
+#endif
+}
+
+size_t GetCPUTexturePitch(int width, CPUTextureFormat format)
+{
+    size_t pitch = static_cast<size_t>(width) * GetCPUFormatSize(format);
+    pitch = (pitch + kAlignment - 1) / kAlignment * kAlignment;
+
+    for (;;) {
+        bool aliased = false;
+        for (int rows = 1; rows <= kAliasingRows && !aliased; ++rows) {
+            aliased = pitch * rows % kAliasingStride == 0;
+        }
+        if (!aliased) {
+            return pitch;
+        }
+        pitch += kAlignment;
+    }
+}
+
+CPUTexture* CreateCPUTexture(int width, int height, CPUTextureFormat format, const CPUFirstTouch* firstTouch)
+{
+    int pixelSize = GetCPUFormatSize(format);
+    if (width <= 0 || height <= 0 || pixelSize == 0) {
+        return nullptr;
+    }
+
+    CPUTexture* texture = new (std::nothrow) CPUTexture();
+    if (!texture) {
+        return nullptr;
+    }
+
+    texture->width = width;
+    texture->height = height;
+    texture->allocWidth = width;
+    texture->allocHeight = height;
+    texture->format = format;
+    texture->pitch = GetCPUTexturePitch(width, format);
+
+    size_t size = texture->GetAllocationSize();
+#ifdef __linux__
+    if (size >= kHugePageSize) {
+        MapHugePages(texture, size, firstTouch);
+    }
+#endif
+    if (!texture->data && firstTouch) {
+        size_t rounded = (size + kAlignment - 1) / kAlignment * kAlignment;
+        texture->data = static_cast<uint8_t*>(std::aligned_alloc(kAlignment, rounded));
+        if (texture->data) {
+            firstTouch->fn(firstTouch->context, texture->data, rounded);
+        }
+    } else if (!texture->data) {
+        texture->data = AllocateZeroed(size);
+    }
+    if (!texture->data) {
+        delete texture;
+        return nullptr;
+    }
+
+    return TrackResource(texture);
+}
+
+CPUTexture* ImportCPUTexture(const CPUExternalImage& image)
+{
+    int pixelSize = GetCPUFormatSize(image.format);
+    if (image.width <= 0 || image.height <= 0 || pixelSize == 0) {
+        Logger::Error("ImportCPUTexture: dimensions ou format invalides (%dx%d)", image.width, image.height);
+        return nullptr;
+    }
+
+    size_t rowBytes = static_cast<size_t>(image.width) * pixelSize;
+    size_t pitch = image.pitch > 0 ? image.pitch : rowBytes;
+    if (pitch < rowBytes || pitch % 4 != 0) {
+        Logger::Error("ImportCPUTexture: pas de %zu octets invalide pour %d pixels de %d octets",
+                      pitch, image.width, pixelSize);
+        return nullptr;
+    }
+    // La dernière ligne n'a pas besoin du remplissage
+    size_t size = pitch * static_cast<size_t>(image.height - 1) + rowBytes;
+
+    CPUTexture* texture = new (std::nothrow) CPUTexture();
+    if (!texture) {
+        return nullptr;
+    }
+
+    if (image.fd >= 0) {
+#ifdef __linux__
+        size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        uint64_t mappingStart = image.offset / pageSize * pageSize;
+        size_t mappingOffset = static_cast<size_t>(image.offset - mappingStart);
+        size_t mapped = mappingOffset + size;
+
+        void* memory = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_SHARED, image.fd,
+                            static_cast<off_t>(mappingStart));
+        if (memory == MAP_FAILED) {
+            Logger::Error("ImportCPUTexture: projection du descripteur %d impossible", image.fd);
+            delete texture;
+            return nullptr;
+        }
+        texture->data = static_cast<uint8_t*>(memory) + mappingOffset;
+        texture->mappedBytes = mapped;
+        texture->mappingOffset = mappingOffset;
+#else
+        Logger::Error("ImportCPUTexture: import d'un descripteur non pris en charge sur cette plateforme");
+        delete texture;
+        return nullptr;
+#endif
+    } else {
+        texture->data = image.data;
+    }
+
+    if (!texture->data || reinterpret_cast<uintptr_t>(texture->data) % 4 != 0) {
+        Logger::Error("ImportCPUTexture: adresse de l'image nulle ou non alignée sur 4 octets");
+#ifdef __linux__
+        if (texture->mappedBytes > 0) {
+            munmap(texture->data - texture->mappingOffset, texture->mappedBytes);
+        }
+#endif
+        delete texture;
+        return nullptr;
+    }
+
+    texture->width = image.width;
+    texture->height = image.height;
+    texture->allocWidth = image.width;
+    texture->allocHeight = image.height;
+    texture->format = image.format;
+    texture->pitch = pitch;
+    texture->imported = true;
+    texture->releaseCallback = image.releaseCallback;
+    texture->releaseUserData = image.releaseUserData;
+    return TrackResource(texture);
+}
+
+CPUBuffer* CreateCPUBuffer(size_t size, int stride)
+{
+    CPUBuffer* buffer = new (std::nothrow) CPUBuffer();
+    if (!buffer) {
+        return nullptr;
+    }
+
+    buffer->size = size;
+    buffer->stride = stride;
+    buffer->data = AllocateZeroed(size);
+    if (!buffer->data) {
+        delete buffer;
+        return nullptr;
+    }
+
+    return TrackResource(buffer);
+}
+
+void ReleaseCPUResource(CPUResource* resource)
+{
+    if (!resource) {
+        return;
+    }
+    if (!UntrackResource(resource)) {
+        Logger::Error("ReleaseCPUResource: ressource %p inconnue ou déjà libérée", static_cast<const void*>(resource));
+        return;
+    }
+
+    // Un handle conservé par erreur n'est plus reconnu par AsCPUTexture / AsCPUBuffer
+    resource->signature = 0;
+
+    if (resource->kind == CPUResource::Kind::Texture) {
+        CPUTexture* texture = static_cast<CPUTexture*>(resource);
+#ifdef __linux__
+        if (texture->mappedBytes > 0) {
+            munmap(texture->data - texture->mappingOffset, texture->mappedBytes);
+        } else if (!texture->imported) {
+            std::free(texture->data);
+        }
+#else
+        if (!texture->imported) {
+            std::free(texture->data);
+        }
+#endif
+        if (texture->releaseCallback) {
+            texture->releaseCallback(texture->releaseUserData);
+        }
+        delete texture;
+    } else {
+        CPUBuffer* buffer = static_cast<CPUBuffer*>(resource);
+        std::free(buffer->data);
+        delete buffer;
+    }
+}
+
+} // namespace XIS
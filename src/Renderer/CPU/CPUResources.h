@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace XIS {
+
+/**
+ * @brief Formats de texture du backend CPU
+ *
+ * La valeur 0 (format par défaut du back buffer) correspond aux textures
+ * couleur RGBA 8 bits.
+ */
+enum class CPUTextureFormat : int {
+    RGBA8 = 0,
+    R32F = 1,
+    RG32F = 2,
+    RGBA32F = 3
+};
+
+/**
+ * @brief Taille d'un pixel en octets, 0 si le format est inconnu
+ */
+inline int GetCPUFormatSize(CPUTextureFormat format)
+{
+    switch (format) {
+    case CPUTextureFormat::RGBA8: return 4;
+    case CPUTextureFormat::R32F: return 4;
+    case CPUTextureFormat::RG32F: return 8;
+    case CPUTextureFormat::RGBA32F: return 16;
+    }
+    return 0;
+}
+
+/**
+ * @brief Pages mémoire d'une texture CPU
+ */
+enum class CPUPageBacking : uint8_t {
+    Standard,             // Pages de 4 Kio (petites textures, ou pages larges indisponibles)
+    TransparentHugePages, // Pages larges transparentes demandées (madvise) ; voir hugePageBytes
+    HugePages             // Pages larges explicites (hugetlbfs)
+};
+
+/**
+ * @brief En-tête commun des ressources CPU
+ *
+ * Les handles opaques manipulés par IRenderer pointent sur ces structures ;
+ * la signature permet de rejeter un handle étranger (texture DX passée par
+ * erreur) plutôt que de lire une mémoire arbitraire.
+ */
+struct CPUResource {
+    static const uint32_t kSignature = 0x58495343; // "XISC"
+
+    enum class Kind : uint32_t { Texture, Buffer };
+
+    uint32_t signature = kSignature;
+    Kind kind;
+
+    explicit CPUResource(Kind resourceKind) : kind(resourceKind) {}
+};
+
+/**
+ * @brief Texture 2D en mémoire centrale
+ *
+ * width et height désignent la zone valide, qui peut être plus petite que
+ * l'allocation : une réduction de résolution écrit une image plus petite
+ * dans une cible allouée à la taille d'entrée, et les étapes suivantes
+ * lisent cette zone.
+ *
+ * Les lignes commencent sur une ligne de cache et pitch peut dépasser la
+ * largeur utile (voir GetCPUTexturePitch) : les lignes se parcourent
+ * toujours avec GetRow. Une texture importée (ImportCPUTexture) garde le pas
+ * et l'alignement de la mémoire de l'application.
+ */
+struct CPUTexture : CPUResource {
+    int width = 0;
+    int height = 0;
+    int allocWidth = 0;
+    int allocHeight = 0;
+    CPUTextureFormat format = CPUTextureFormat::RGBA8;
+    size_t pitch = 0;                     // Octets entre deux lignes
+    uint8_t* data = nullptr;
+
+    // Mémoire allouée
+    CPUPageBacking backing = CPUPageBacking::Standard;
+    size_t mappedBytes = 0;               // Taille de la projection (0 = allocation sur le tas)
+    size_t mappingOffset = 0;             // Position de data dans la projection
+    size_t hugePageBytes = 0;             // Octets effectivement servis par des pages larges
+    int numaNode = -1;                    // Nœud NUMA des pages (-1 = inconnu ou machine non NUMA)
+    bool numaNodeQueried = false;         // numaNode a été recherché
+
+    // Mémoire importée : appartient à l'application, rendue à la libération
+    bool imported = false;
+    void (*releaseCallback)(void* userData) = nullptr;
+    void* releaseUserData = nullptr;
+
+    CPUTexture() : CPUResource(Kind::Texture) {}
+
+    uint8_t* GetRow(int y) const { return data + static_cast<size_t>(y) * pitch; }
+    size_t GetAllocationSize() const { return pitch * static_cast<size_t>(allocHeight); }
+};
+
+/**
+ * @brief Buffer (structured buffer ou tampon constant) en mémoire centrale
+ */
+struct CPUBuffer : CPUResource {
+    size_t size = 0;
+    int stride = 0;                       // Taille d'un élément, 0 pour un tampon constant
+    uint8_t* data = nullptr;
+
+    CPUBuffer() : CPUResource(Kind::Buffer) {}
+};
+
+/**
+ * @brief Pas entre deux lignes d'une texture
+ *
+ * Largeur utile arrondie à 64 octets, puis augmentée de 64 octets tant que
+ * deux lignes distantes de une à quatre lignes (les taps verticaux du
+ * filtre bicubique, les lignes d'un bloc de recherche de mouvement) seraient
+ * séparées d'un multiple de 4 Kio : leurs accès tomberaient sinon dans les
+ * mêmes ensembles du cache L1 et se gêneraient (aliasing 4K).
+ */
+size_t GetCPUTexturePitch(int width, CPUTextureFormat format);
+
+/**
+ * @brief Première écriture de la mémoire d'une texture
+ *
+ * Remplace la mise à zéro de la création : fn doit écrire des zéros sur
+ * [data, data + size). Le système place chaque page sur le nœud NUMA du
+ * thread qui l'écrit en premier ; le backend fait écrire les textures par
+ * les threads qui les traiteront.
+ */
+struct CPUFirstTouch {
+    void (*fn)(void* context, uint8_t* data, size_t size);
+    void* context;
+};
+
+/**
+ * @brief Crée une texture ; le contenu initial est nul
+ *
+ * Les textures d'au moins 2 Mio sont projetées en pages larges pour réduire
+ * les défauts de TLB des parcours d'image complets : pages explicites
+ * (hugetlbfs) si le système en réserve, pages larges transparentes sinon.
+ * backing et hugePageBytes indiquent ce qui a été obtenu.
+ *
+ * @param firstTouch Première écriture de la mémoire (nullptr = par le thread appelant)
+ * @return La texture, nullptr si les dimensions ou le format sont invalides
+ */
+CPUTexture* CreateCPUTexture(int width, int height, CPUTextureFormat format,
+                             const CPUFirstTouch* firstTouch = nullptr);
+
+/**
+ * @brief Image en mémoire appartenant à l'application
+ */
+struct CPUExternalImage {
+    uint8_t* data = nullptr;              // Première ligne, ignoré si fd >= 0
+    int width = 0;
+    int height = 0;
+    size_t pitch = 0;                     // Octets entre deux lignes (0 = lignes jointives)
+    CPUTextureFormat format = CPUTextureFormat::RGBA8;
+    int fd = -1;                          // dmabuf ou memfd à projeter (Linux)
+    uint64_t offset = 0;                  // Position de la première ligne dans fd
+    void (*releaseCallback)(void* userData) = nullptr;
+    void* releaseUserData = nullptr;
+};
+
+/**
+ * @brief Crée une texture sur la mémoire d'une image, sans copie
+ *
+ * La texture lit et écrit directement dans la mémoire de l'application,
+ * qui doit rester valide jusqu'à ReleaseCPUResource ; celle-ci appelle
+ * releaseCallback. Un descripteur est projeté en mémoire partagée et peut
+ * être fermé après l'import.
+ *
+ * @return La texture, nullptr si la description est invalide ou la projection impossible
+ */
+CPUTexture* ImportCPUTexture(const CPUExternalImage& image);
+
+/**
+ * @brief Crée un buffer ; le contenu initial est nul
+ */
+CPUBuffer* CreateCPUBuffer(size_t size, int stride);
+
+/**
+ * @brief Libère une texture ou un buffer créé par CreateCPUTexture / CreateCPUBuffer
+ *
+ * Pour une texture importée, seule la description est libérée ; la mémoire
+ * est rendue à l'application par son releaseCallback. Un handle inconnu ou
+ * déjà libéré est ignoré (erreur journalisée) sans que sa mémoire soit lue.
+ */
+void ReleaseCPUResource(CPUResource* resource);
+
+/**
+ * @brief Convertit un handle opaque en texture, nullptr s'il n'en est pas une
+ */
+inline CPUTexture* AsCPUTexture(void* handle)
+{
+    CPUResource* resource = static_cast<CPUResource*>(handle);
+    if (!resource || resource->signature != CPUResource::kSignature || resource->kind != CPUResource::Kind::Texture) {
+        return nullptr;
+    }
+    return static_cast<CPUTexture*>(resource);
+}
+
+/**
+ * @brief Convertit un handle opaque en buffer, nullptr s'il n'en est pas un
+ */
+inline CPUBuffer* AsCPUBuffer(void* handle)
+{
+    CPUResource* resource = static_cast<CPUResource*>(handle);
+    if (!resource || resource->signature != CPUResource::kSignature || resource->kind != CPUResource::Kind::Buffer) {
+        return nullptr;
+    }
+    return static_cast<CPUBuffer*>(resource);
+}
+
+} // namespace XIS
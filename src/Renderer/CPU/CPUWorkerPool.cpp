@@ -0,0 +1,167 @@
+#include "CPUWorkerPool.h"
+#include "NumaTopology.h"
+#include <algorithm>
+
+namespace XIS {
+
+CPUWorkerPool::CPUWorkerPool(uint32_t threadCount, int numaNode)
+    : m_numaNode(NumaTopology::Get().GetNodeCpus(numaNode).empty() ? -1 : numaNode)
+{
+    if (threadCount == 0 && m_numaNode >= 0) {
+        threadCount = static_cast<uint32_t>(NumaTopology::Get().GetNodeCpus(m_numaNode).size());
+    }
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Le thread appelant participe au calcul
+    m_scratch = std::make_unique<FrameArena[]>(threadCount);
+    m_workers.reserve(threadCount - 1);
+    m_activeThreadCount = threadCount;
+    for (uint32_t i = 1; i < threadCount; ++i) {
+        m_workers.emplace_back(&CPUWorkerPool::WorkerLoop, this, i - 1);
+    }
+}
+
+CPUWorkerPool::~CPUWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void CPUWorkerPool::SetActiveThreadCount(uint32_t threadCount)
+{
+    uint32_t available = GetThreadCount();
+    if (threadCount == 0 || threadCount > available) {
+        threadCount = available;
+    }
+
+    // Lu par les workers sous m_mutex, au réveil
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_activeThreadCount = threadCount;
+}
+
+void CPUWorkerPool::Run(int count, int grain, TaskFn task, void* context)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    grain = std::max(1, grain);
+    int chunkCount = (count + grain - 1) / grain;
+
+    // Un thread appelant hors du nœud laisse les blocs aux workers
+    bool callerParticipates = m_numaNode < 0 || m_activeThreadCount == 1 ||
+                              NumaTopology::Get().GetCurrentNode() == m_numaNode;
+
+    // Pas de réveil des workers pour un seul bloc
+    if (m_activeThreadCount == 1 || (chunkCount == 1 && callerParticipates)) {
+        FrameArena::Scope scratchScope(m_scratch[0]);
+        task(context, 0, count, m_scratch[0]);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = task;
+        m_context = context;
+        m_count = count;
+        m_grain = grain;
+        m_chunkCount = chunkCount;
+        m_nextChunk.store(0, std::memory_order_relaxed);
+        m_remainingChunks.store(chunkCount, std::memory_order_relaxed);
+        ++m_generation;
+    }
+    m_wakeCondition.notify_all();
+
+    if (callerParticipates) {
+        ExecuteChunks(m_scratch[0]);
+    }
+
+    // Attendre la fin des blocs et la sortie des workers encore dans
+    // ExecuteChunks, qui liraient sinon le travail suivant
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this] {
+        return m_remainingChunks.load(std::memory_order_acquire) == 0 && m_activeWorkers == 0;
+    });
+    m_task = nullptr;
+    m_context = nullptr;
+}
+
+void CPUWorkerPool::WorkerLoop(uint32_t workerIndex)
+{
+    if (m_numaNode >= 0) {
+        NumaTopology::Get().BindCurrentThread(m_numaNode);
+    }
+
+    uint64_t seenGeneration = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [this, seenGeneration] {
+                return m_stopping || m_generation != seenGeneration;
+            });
+            if (m_stopping) {
+                return;
+            }
+            seenGeneration = m_generation;
+            // Le thread appelant compte parmi les threads actifs
+            if (!m_task || workerIndex + 1 >= m_activeThreadCount) {
+                continue;
+            }
+            ++m_activeWorkers;
+        }
+
+        ExecuteChunks(m_scratch[workerIndex + 1]);
+
+        bool notify;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_activeWorkers;
+            notify = m_activeWorkers == 0;
+        }
+        if (notify) {
+            m_doneCondition.notify_one();
+        }
+    }
+}
+
+void CPUWorkerPool::ResetScratch()
+{
+    for (uint32_t i = 0; i < GetThreadCount(); ++i) {
+        m_scratch[i].Reset();
+    }
+}
+
+void CPUWorkerPool::ExecuteChunks(FrameArena& scratch)
+{
+    for (;;) {
+        int chunk = m_nextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= m_chunkCount) {
+            return;
+        }
+
+        int begin = chunk * m_grain;
+        int end = std::min(m_count, begin + m_grain);
+        {
+            FrameArena::Scope scratchScope(scratch);
+            m_task(m_context, begin, end, scratch);
+        }
+
+        if (m_remainingChunks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // Le mutex ordonne la notification avec l'attente de Run
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_doneCondition.notify_one();
+        }
+    }
+}
+
+} // namespace XIS
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "../../Utils/FrameArena.h"
+
+namespace XIS {
+
+/**
+ * @brief Pool de threads pour l'exécution des kernels CPU
+ *
+ * Un seul travail est exécuté à la fois : ParallelFor découpe l'intervalle
+ * [0, count) en blocs de grain éléments que les workers et le thread
+ * appelant se partagent, puis attend la fin du dernier bloc. Il n'y a ni
+ * file de tâches ni allocation par appel.
+ *
+ * Chaque thread dispose d'un FrameArena pour ses tuiles de travail : la
+ * mémoire prise par un bloc lui est rendue à la fin du bloc, et ResetScratch
+ * ajuste les arenas à la fin de la frame.
+ *
+ * Un pool attaché à un nœud NUMA épingle ses workers sur les processeurs du
+ * nœud ; le thread appelant ne traite alors des blocs que s'il s'exécute
+ * lui-même sur ce nœud, pour que tous les accès partent du nœud.
+ */
+class CPUWorkerPool {
+public:
+    /**
+     * @brief Constructeur
+     *
+     * @param threadCount Nombre total de threads de calcul, thread appelant
+     *        compris (0 = nombre de cœurs logiques, du nœud s'il y en a un)
+     * @param numaNode Nœud NUMA des workers (-1 = aucun épinglage)
+     */
+    explicit CPUWorkerPool(uint32_t threadCount, int numaNode = -1);
+    ~CPUWorkerPool();
+
+    CPUWorkerPool(const CPUWorkerPool&) = delete;
+    CPUWorkerPool& operator=(const CPUWorkerPool&) = delete;
+
+    /**
+     * @brief Nombre de threads de calcul, thread appelant compris
+     */
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_workers.size()) + 1; }
+
+    /**
+     * @brief Limite le nombre de threads participant aux appels suivants
+     *
+     * Les workers au-delà de la limite restent en attente. Ne doit pas être
+     * appelé pendant un ParallelFor.
+     *
+     * @param threadCount Threads utilisés, thread appelant compris (0 = tous)
+     */
+    void SetActiveThreadCount(uint32_t threadCount);
+
+    uint32_t GetActiveThreadCount() const { return m_activeThreadCount; }
+
+    int GetNumaNode() const { return m_numaNode; }
+
+    /**
+     * @brief Appelle fn(begin, end) sur des blocs couvrant [0, count)
+     *
+     * Les blocs peuvent être traités dans n'importe quel ordre et en
+     * parallèle ; fn ne doit pas appeler ParallelFor. fn peut aussi prendre
+     * un troisième paramètre FrameArena& : l'arena du thread qui traite le
+     * bloc, dont la mémoire est rendue à la fin du bloc.
+     */
+    template <typename F>
+    void ParallelFor(int count, int grain, F&& fn)
+    {
+        Run(count, grain, &Thunk<F>, &fn);
+    }
+
+    /**
+     * @brief Remet à zéro les arenas des threads (fin de frame)
+     *
+     * Un arena qui a débordé pendant la frame est agrandi à son pic : en
+     * régime établi, les tuiles ne font plus aucune allocation. Ne doit pas
+     * être appelé pendant un ParallelFor.
+     */
+    void ResetScratch();
+
+private:
+    using TaskFn = void (*)(void* context, int begin, int end, FrameArena& scratch);
+
+    template <typename F>
+    static void Thunk(void* context, int begin, int end, FrameArena& scratch)
+    {
+        using Fn = typename std::remove_reference<F>::type;
+        if constexpr (std::is_invocable<Fn&, int, int, FrameArena&>::value) {
+            (*static_cast<Fn*>(context))(begin, end, scratch);
+        } else {
+            (void)scratch;
+            (*static_cast<Fn*>(context))(begin, end);
+        }
+    }
+
+    void Run(int count, int grain, TaskFn task, void* context);
+    void WorkerLoop(uint32_t workerIndex);
+    void ExecuteChunks(FrameArena& scratch);
+
+    int m_numaNode = -1;
+    std::vector<std::thread> m_workers;
+    std::unique_ptr<FrameArena[]> m_scratch;  // Thread appelant puis workers
+    uint32_t m_activeThreadCount = 1;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+    uint64_t m_generation = 0;
+    bool m_stopping = false;
+
+    // Travail en cours
+    TaskFn m_task = nullptr;
+    void* m_context = nullptr;
+    int m_count = 0;
+    int m_grain = 1;
+    int m_chunkCount = 0;
+    std::atomic<int> m_nextChunk{0};
+    std::atomic<int> m_remainingChunks{0};
+    int m_activeWorkers = 0;
+};
+
+} // namespace XIS
@@ -0,0 +1,269 @@
+#include "NumaTopology.h"
+#include "../../Utils/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace XIS {
+
+namespace {
+    // Pages interrogées pour situer une zone mémoire
+    const size_t kMemoryNodeSamples = 16;
+
+    /**
+     * Lit une liste de processeurs au format du noyau ("0-3,8-11")
+     */
+    std::vector<int> ParseCpuList(const char* text)
+    {
+        std::vector<int> cpus;
+        const char* cursor = text;
+        while (*cursor) {
+            char* end = nullptr;
+            long first = std::strtol(cursor, &end, 10);
+            if (end == cursor) {
+                break;
+            }
+            long last = first;
+            cursor = end;
+            if (*cursor == '-') {
+                last = std::strtol(cursor + 1, &end, 10);
+                cursor = end;
+            }
+            for (long cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(static_cast<int>(cpu));
+            }
+            if (*cursor != ',') {
+                break;
+            }
+            ++cursor;
+        }
+        return cpus;
+    }
+
+    const std::vector<int> kNoCpus;
+}
+
+NumaTopology& NumaTopology::Get()
+{
+    static NumaTopology topology;
+    return topology;
+}
+
+NumaTopology::NumaTopology()
+{
+#ifdef __linux__
+    // Les numéros de nœuds en ligne peuvent être discontinus ("0,2")
+    char text[4096] = {};
+    FILE* file = std::fopen("/sys/devices/system/node/online", "r");
+    if (!file) {
+        return;
+    }
+    bool read = std::fgets(text, sizeof(text), file) != nullptr;
+    std::fclose(file);
+    std::vector<int> nodes = read ? ParseCpuList(text) : std::vector<int>();
+
+    for (int node : nodes) {
+        if (node >= static_cast<int>(m_nodes.size())) {
+            m_nodes.resize(node + 1);
+        }
+    }
+    for (auto& state : m_nodes) {
+        state = std::make_unique<NodeState>();
+    }
+
+    for (int node : nodes) {
+        char path[64];
+        std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        file = std::fopen(path, "r");
+        if (!file) {
+            continue;
+        }
+        text[0] = '\0';
+        read = std::fgets(text, sizeof(text), file) != nullptr;
+        std::fclose(file);
+        if (!read) {
+            continue;
+        }
+
+        m_nodes[node]->cpus = ParseCpuList(text);
+        for (int cpu : m_nodes[node]->cpus) {
+            if (cpu >= static_cast<int>(m_cpuNodes.size())) {
+                m_cpuNodes.resize(cpu + 1, -1);
+            }
+            m_cpuNodes[cpu] = node;
+        }
+    }
+#endif
+
+    int nodesWithCpus = 0;
+    for (const auto& state : m_nodes) {
+        if (!state->cpus.empty()) {
+            nodesWithCpus++;
+        }
+    }
+    m_numa = nodesWithCpus > 1;
+    if (m_numa) {
+        Logger::Info("NumaTopology: %d nœuds NUMA avec processeurs", nodesWithCpus);
+    }
+}
+
+const std::vector<int>& NumaTopology::GetNodeCpus(int node) const
+{
+    if (node < 0 || node >= GetNodeCount()) {
+        return kNoCpus;
+    }
+    return m_nodes[node]->cpus;
+}
+
+bool NumaTopology::BindCurrentThread(int node) const
+{
+    const std::vector<int>& cpus = GetNodeCpus(node);
+    if (cpus.empty()) {
+        return false;
+    }
+
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        Logger::Warning("NumaTopology: impossible d'épingler un thread sur le nœud %d", node);
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+int NumaTopology::GetCurrentNode() const
+{
+#ifdef __linux__
+    int cpu = sched_getcpu();
+    if (cpu >= 0 && cpu < static_cast<int>(m_cpuNodes.size())) {
+        return m_cpuNodes[cpu];
+    }
+#endif
+    return -1;
+}
+
+int NumaTopology::GetMemoryNode(const void* data, size_t size) const
+{
+    if (!m_numa || !data || size == 0) {
+        return -1;
+    }
+
+#if defined(__linux__) && defined(SYS_move_pages)
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t first = reinterpret_cast<uintptr_t>(data) / pageSize * pageSize;
+    size_t pageCount = (reinterpret_cast<uintptr_t>(data) + size - first + pageSize - 1) / pageSize;
+    size_t sampleCount = std::min(pageCount, kMemoryNodeSamples);
+
+    void* pages[kMemoryNodeSamples];
+    int status[kMemoryNodeSamples];
+    for (size_t i = 0; i < sampleCount; ++i) {
+        size_t page = sampleCount > 1 ? i * (pageCount - 1) / (sampleCount - 1) : 0;
+        pages[i] = reinterpret_cast<void*>(first + page * pageSize);
+    }
+
+    // Sans tableau de nœuds cibles, move_pages indique le nœud de chaque page
+    if (syscall(SYS_move_pages, 0, sampleCount, pages, nullptr, status, 0) != 0) {
+        return -1;
+    }
+
+    // Nœud le plus fréquent parmi les pages échantillonnées
+    int best = -1;
+    int bestVotes = 0;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        int votes = 0;
+        for (size_t j = 0; j < sampleCount; ++j) {
+            votes += status[j] == status[i] ? 1 : 0;
+        }
+        if (status[i] >= 0 && votes > bestVotes) {
+            best = status[i];
+            bestVotes = votes;
+        }
+    }
+    return best;
+#else
+    return -1;
+#endif
+}
+
+int NumaTopology::AcquireSessionNode(int node)
+{
+    if (!m_numa) {
+        return -1;
+    }
+
+    if (!GetNodeCpus(node).empty()) {
+        m_nodes[node]->sessionCount.fetch_add(1);
+        return node;
+    }
+
+    // Le moins de sessions par processeur ; les affectations concurrentes
+    // peuvent se croiser, l'équilibre reste approximatif
+    int best = -1;
+    double bestLoad = 0.0;
+    for (int candidate = 0; candidate < GetNodeCount(); ++candidate) {
+        const NodeState& state = *m_nodes[candidate];
+        if (state.cpus.empty()) {
+            continue;
+        }
+        double load = static_cast<double>(state.sessionCount.load()) / state.cpus.size();
+        if (best < 0 || load < bestLoad) {
+            best = candidate;
+            bestLoad = load;
+        }
+    }
+
+    if (best >= 0) {
+        m_nodes[best]->sessionCount.fetch_add(1);
+    }
+    return best;
+}
+
+void NumaTopology::ReleaseSessionNode(int node)
+{
+    if (node >= 0 && node < GetNodeCount()) {
+        m_nodes[node]->sessionCount.fetch_sub(1);
+    }
+}
+
+void NumaTopology::RecordAccess(int threadNode, int memoryNode, uint64_t bytes)
+{
+    if (threadNode < 0 || threadNode >= GetNodeCount() || memoryNode < 0) {
+        return;
+    }
+
+    NodeState& state = *m_nodes[threadNode];
+    if (memoryNode == threadNode) {
+        state.localBytes.fetch_add(bytes, std::memory_order_relaxed);
+    } else {
+        state.remoteBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+void NumaTopology::Collect(std::vector<NodeStats>& stats) const
+{
+    stats.resize(m_nodes.size());
+    for (size_t node = 0; node < m_nodes.size(); ++node) {
+        const NodeState& state = *m_nodes[node];
+        stats[node].cpuCount = static_cast<uint32_t>(state.cpus.size());
+        stats[node].sessionCount = state.sessionCount.load();
+        stats[node].localBytes = state.localBytes.load(std::memory_order_relaxed);
+        stats[node].remoteBytes = state.remoteBytes.load(std::memory_order_relaxed);
+    }
+}
+
+} // namespace XIS
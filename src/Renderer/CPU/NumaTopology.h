@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace XIS {
+
+/**
+ * @brief Nœuds NUMA de la machine et placement des sessions CPU
+ *
+ * La topologie est lue une fois dans /sys/devices/system/node. Sur une
+ * machine à un seul nœud (ou hors Linux), IsNuma renvoie false et le backend
+ * CPU garde son comportement habituel : threads non épinglés, pages placées
+ * par le système.
+ *
+ * Chaque session CPU reçoit un nœud (AcquireSessionNode, le moins chargé) :
+ * ses threads de calcul y sont épinglés et ses textures y sont écrites en
+ * premier, donc placées dans sa mémoire. Les accès des kernels sont
+ * comptés par nœud, locaux ou distants selon le nœud des pages des
+ * textures liées.
+ */
+class NumaTopology {
+public:
+    /**
+     * @brief Compteurs d'un nœud
+     */
+    struct NodeStats {
+        uint32_t cpuCount = 0;
+        uint32_t sessionCount = 0;        // Sessions CPU affectées au nœud
+        uint64_t localBytes = 0;          // Octets lus ou écrits par ses threads dans sa mémoire
+        uint64_t remoteBytes = 0;         // Octets lus ou écrits par ses threads dans la mémoire d'un autre nœud
+    };
+
+    static NumaTopology& Get();
+
+    /**
+     * @brief Nombre de nœuds (plus grand numéro de nœud + 1)
+     */
+    int GetNodeCount() const { return static_cast<int>(m_nodes.size()); }
+
+    /**
+     * @brief true si au moins deux nœuds ont des processeurs
+     */
+    bool IsNuma() const { return m_numa; }
+
+    /**
+     * @brief Processeurs logiques d'un nœud (vide pour un nœud sans processeur)
+     */
+    const std::vector<int>& GetNodeCpus(int node) const;
+
+    /**
+     * @brief Épingle le thread appelant sur les processeurs d'un nœud
+     */
+    bool BindCurrentThread(int node) const;
+
+    /**
+     * @brief Nœud du processeur qui exécute le thread appelant, -1 si inconnu
+     */
+    int GetCurrentNode() const;
+
+    /**
+     * @brief Nœud qui héberge la majorité des pages de [data, data + size)
+     *
+     * Quelques pages réparties sur la zone sont interrogées (move_pages) ;
+     * elles doivent avoir été écrites.
+     *
+     * @return Le nœud, -1 si inconnu ou si la machine n'est pas NUMA
+     */
+    int GetMemoryNode(const void* data, size_t size) const;
+
+    /**
+     * @brief Affecte une session à un nœud
+     *
+     * @param node Nœud demandé ; -1 (ou un nœud sans processeur) pour celui
+     *        qui a le moins de sessions par processeur
+     * @return Le nœud, -1 si la machine n'est pas NUMA
+     */
+    int AcquireSessionNode(int node = -1);
+    void ReleaseSessionNode(int node);
+
+    /**
+     * @brief Compte bytes octets accédés par un thread de threadNode dans la mémoire de memoryNode
+     */
+    void RecordAccess(int threadNode, int memoryNode, uint64_t bytes);
+
+    void Collect(std::vector<NodeStats>& stats) const;
+
+private:
+    NumaTopology();
+
+    struct NodeState {
+        std::vector<int> cpus;
+        std::atomic<uint32_t> sessionCount{0};
+        std::atomic<uint64_t> localBytes{0};
+        std::atomic<uint64_t> remoteBytes{0};
+    };
+
+    std::vector<std::unique_ptr<NodeState>> m_nodes;     // Par numéro de nœud
+    std::vector<int> m_cpuNodes;          // Processeur logique -> nœud
+    bool m_numa = false;
+};
+
+} // namespace XIS
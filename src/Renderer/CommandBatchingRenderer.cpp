@@ -0,0 +1,448 @@
+#include "CommandBatchingRenderer.h"
+#include <cstring>
+#include <initializer_list>
+
+namespace XIS {
+
+namespace {
+    // Valeur d'un slot dont le contenu dans le renderer de la session est
+    // inconnu : aucune liaison ne lui est égale
+    char s_unknownBinding;
+    void* const kUnknownBinding = &s_unknownBinding;
+}
+
+CommandBatchingRenderer::CommandBatchingRenderer(std::shared_ptr<IRenderer> renderer)
+    : m_renderer(std::move(renderer)),
+      m_commandCount(0),
+      m_rootConstantPoolUsed(0),
+      m_workSinceBarrier(false),
+      m_perfMonitor(nullptr)
+{
+    InvalidateAll();
+}
+
+CommandBatchingRenderer::~CommandBatchingRenderer()
+{
+    Flush();
+}
+
+void CommandBatchingRenderer::EndFrame()
+{
+    Flush();
+    PublishStats();
+}
+
+void CommandBatchingRenderer::CollectStats(Stats& stats) const
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    stats = m_publishedStats;
+}
+
+void CommandBatchingRenderer::SetPerfMonitor(PerfMonitor* perfMonitor)
+{
+    Flush();
+    m_perfMonitor = perfMonitor;
+}
+
+PerfMonitor::StageId CommandBatchingRenderer::GetCurrentStage() const
+{
+    return m_perfMonitor ? m_perfMonitor->GetCurrentStage() : PerfMonitor::kInvalidStage;
+}
+
+void CommandBatchingRenderer::PublishStats()
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_publishedStats = m_stats;
+}
+
+void CommandBatchingRenderer::InvalidateAll()
+{
+    for (BindState* state : { &m_graphicsState, &m_computeState }) {
+        state->shader = kUnknownBinding;
+        state->renderTarget = kUnknownBinding;
+        for (int i = 0; i < kMaxBindSlots; i++) {
+            state->constantBuffers[i] = kUnknownBinding;
+            state->shaderResources[i] = kUnknownBinding;
+            state->unorderedAccessViews[i] = kUnknownBinding;
+        }
+    }
+}
+
+void CommandBatchingRenderer::Invalidate(void* object)
+{
+    if (!object) {
+        return;
+    }
+
+    auto invalidate = [object](void*& binding) {
+        if (binding == object) {
+            binding = kUnknownBinding;
+        }
+    };
+
+    for (BindState* state : { &m_graphicsState, &m_computeState }) {
+        invalidate(state->shader);
+        invalidate(state->renderTarget);
+        for (int i = 0; i < kMaxBindSlots; i++) {
+            invalidate(state->constantBuffers[i]);
+            invalidate(state->shaderResources[i]);
+            invalidate(state->unorderedAccessViews[i]);
+        }
+    }
+}
+
+CommandBatchingRenderer::Command* CommandBatchingRenderer::Append(CommandType type)
+{
+    if (m_commandCount == kMaxCommands) {
+        Flush();
+    }
+
+    Command& command = m_commands[m_commandCount++];
+    command.type = type;
+    command.slot = 0;
+    command.object = nullptr;
+    command.dataOffset = 0;
+    command.dataSize = 0;
+    command.stage = PerfMonitor::kInvalidStage;
+    return &command;
+}
+
+void CommandBatchingRenderer::RecordBind(CommandType type, void*& current, int slot, void* object)
+{
+    m_stats.stateCallsIn++;
+    if (current == object) {
+        return;
+    }
+
+    current = object;
+    Command* command = Append(type);
+    command->slot = slot;
+    command->object = object;
+    m_stats.stateCallsOut++;
+}
+
+void CommandBatchingRenderer::RecordSlotBind(CommandType type, void** slots, int slot, void* object)
+{
+    if (slot >= 0 && slot < kMaxBindSlots) {
+        RecordBind(type, slots[slot], slot, object);
+        return;
+    }
+
+    // Slot non suivi : transmis tel quel, le backend le valide
+    m_stats.stateCallsIn++;
+    Command* command = Append(type);
+    command->slot = slot;
+    command->object = object;
+    m_stats.stateCallsOut++;
+}
+
+void CommandBatchingRenderer::RecordRootConstants(CommandType type, int slot, const void* data, size_t size)
+{
+    m_stats.stateCallsIn++;
+    m_stats.stateCallsOut++;
+
+    // Hors limites : transmis directement pour que le backend les rejette
+    if (!data || size > kMaxRootConstantSize) {
+        Flush();
+        if (type == CommandType::SetRootConstants) {
+            m_renderer->SetRootConstants(slot, data, size);
+        } else {
+            m_renderer->SetComputeRootConstants(slot, data, size);
+        }
+        return;
+    }
+
+    if (m_rootConstantPoolUsed + size > kRootConstantPoolSize) {
+        Flush();
+    }
+
+    Command* command = Append(type);
+    command->slot = slot;
+    command->dataOffset = static_cast<uint32_t>(m_rootConstantPoolUsed);
+    command->dataSize = static_cast<uint32_t>(size);
+    std::memcpy(m_rootConstantPool + m_rootConstantPoolUsed, data, size);
+    m_rootConstantPoolUsed += size;
+}
+
+void CommandBatchingRenderer::Replay(const Command& command)
+{
+    // Dispatch ou barrière rejoué hors de l'étape qui l'a émis
+    PerfMonitor::StageId stage = command.stage;
+    if (stage != PerfMonitor::kInvalidStage && stage == GetCurrentStage()) {
+        stage = PerfMonitor::kInvalidStage;
+    }
+    if (stage != PerfMonitor::kInvalidStage) {
+        m_perfMonitor->StartStage(stage);
+    }
+
+    switch (command.type) {
+    case CommandType::SetShader:
+        m_renderer->SetShader(command.object);
+        break;
+    case CommandType::SetConstantBuffer:
+        m_renderer->SetConstantBuffer(command.object, command.slot);
+        break;
+    case CommandType::SetTexture:
+        m_renderer->SetTexture(command.object, command.slot);
+        break;
+    case CommandType::SetRenderTarget:
+        m_renderer->SetRenderTarget(command.object);
+        break;
+    case CommandType::SetRootConstants:
+        m_renderer->SetRootConstants(command.slot, m_rootConstantPool + command.dataOffset, command.dataSize);
+        break;
+    case CommandType::SetComputeShader:
+        m_renderer->SetComputeShader(command.object);
+        break;
+    case CommandType::SetComputeConstantBuffer:
+        m_renderer->SetComputeConstantBuffer(command.slot, command.object);
+        break;
+    case CommandType::SetComputeShaderResource:
+        m_renderer->SetComputeShaderResource(command.slot, command.object);
+        break;
+    case CommandType::SetComputeUnorderedAccessView:
+        m_renderer->SetComputeUnorderedAccessView(command.slot, command.object);
+        break;
+    case CommandType::SetComputeRootConstants:
+        m_renderer->SetComputeRootConstants(command.slot, m_rootConstantPool + command.dataOffset, command.dataSize);
+        break;
+    case CommandType::DispatchCompute:
+        m_renderer->DispatchCompute(command.groups[0], command.groups[1], command.groups[2]);
+        break;
+    case CommandType::SyncCompute:
+        m_renderer->SyncCompute();
+        break;
+    }
+
+    if (stage != PerfMonitor::kInvalidStage) {
+        m_perfMonitor->EndStage(stage);
+    }
+}
+
+void CommandBatchingRenderer::Flush()
+{
+    if (m_commandCount > 0) {
+        for (int i = 0; i < m_commandCount; i++) {
+            Replay(m_commands[i]);
+        }
+        m_stats.batches++;
+        m_stats.batchedCommands += static_cast<uint64_t>(m_commandCount);
+        m_commandCount = 0;
+        m_rootConstantPoolUsed = 0;
+    }
+
+    m_renderer->Flush();
+}
+
+// --- Shaders et ressources ---
+
+void* CommandBatchingRenderer::LoadShader(const char* fileName, const char* entryPoint)
+{
+    return m_renderer->LoadShader(fileName, entryPoint);
+}
+
+void* CommandBatchingRenderer::LoadComputeShader(const char* fileName, const char* entryPoint, const char* profile)
+{
+    return m_renderer->LoadComputeShader(fileName, entryPoint, profile);
+}
+
+void CommandBatchingRenderer::ReleaseShaderResource(void* shader)
+{
+    Flush();
+    Invalidate(shader);
+    m_renderer->ReleaseShaderResource(shader);
+}
+
+bool CommandBatchingRenderer::GetShaderSlotCounts(void* shader, int& shaderResources, int& unorderedAccessViews,
+                                                  int& constantBuffers) const
+{
+    return m_renderer->GetShaderSlotCounts(shader, shaderResources, unorderedAccessViews, constantBuffers);
+}
+
+void* CommandBatchingRenderer::CreateTexture2D(int width, int height, int format, bool allowUAV, const char* debugName)
+{
+    return m_renderer->CreateTexture2D(width, height, format, allowUAV, debugName);
+}
+
+void* CommandBatchingRenderer::CreateStructuredBuffer(int elementCount, int elementStride, bool allowUAV, const char* debugName)
+{
+    return m_renderer->CreateStructuredBuffer(elementCount, elementStride, allowUAV, debugName);
+}
+
+void* CommandBatchingRenderer::CreateConstantBuffer(size_t size, const void* initialData, const char* debugName)
+{
+    return m_renderer->CreateConstantBuffer(size, initialData, debugName);
+}
+
+void CommandBatchingRenderer::ReleaseResource(void* resource)
+{
+    Flush();
+    Invalidate(resource);
+    m_renderer->ReleaseResource(resource);
+}
+
+void CommandBatchingRenderer::ReleaseBuffer(void* buffer)
+{
+    Flush();
+    Invalidate(buffer);
+    m_renderer->ReleaseBuffer(buffer);
+}
+
+void CommandBatchingRenderer::UpdateBuffer(void* buffer, const void* data, size_t size)
+{
+    // Les dispatchs enregistrés lisent le contenu précédent
+    Flush();
+    m_renderer->UpdateBuffer(buffer, data, size);
+}
+
+bool CommandBatchingRenderer::UpdateConstantBuffer(void* buffer, const void* data, size_t size)
+{
+    Flush();
+    return m_renderer->UpdateConstantBuffer(buffer, data, size);
+}
+
+bool CommandBatchingRenderer::CopyResource(void* source, void* destination)
+{
+    Flush();
+    m_workSinceBarrier = true;
+    return m_renderer->CopyResource(source, destination);
+}
+
+size_t CommandBatchingRenderer::GetResourceSize(void* resource) const
+{
+    return m_renderer->GetResourceSize(resource);
+}
+
+size_t CommandBatchingRenderer::GetResourceHugePageSize(void* resource) const
+{
+    return m_renderer->GetResourceHugePageSize(resource);
+}
+
+int CommandBatchingRenderer::GetFloatTextureFormat() const
+{
+    return m_renderer->GetFloatTextureFormat();
+}
+
+bool CommandBatchingRenderer::ReadTexture(void* texture, int& width, int& height, int& format, std::vector<uint8_t>* pixels)
+{
+    Flush();
+    return m_renderer->ReadTexture(texture, width, height, format, pixels);
+}
+
+// --- Ressources intermédiaires ---
+
+void CommandBatchingRenderer::CreateIntermediateResources(const XISParameters& params)
+{
+    // Le backend peut recréer des ressources intermédiaires et l'application
+    // changer ses textures : les liaisons de la frame précédente ne valent plus
+    Flush();
+    InvalidateAll();
+    m_renderer->CreateIntermediateResources(params);
+}
+
+void* CommandBatchingRenderer::GetIntermediateResource(int index)
+{
+    return m_renderer->GetIntermediateResource(index);
+}
+
+void CommandBatchingRenderer::ReleaseIntermediateResources()
+{
+    Flush();
+    InvalidateAll();
+    m_renderer->ReleaseIntermediateResources();
+}
+
+// --- Pipeline graphique ---
+
+void CommandBatchingRenderer::SetShader(void* shader)
+{
+    RecordBind(CommandType::SetShader, m_graphicsState.shader, 0, shader);
+}
+
+void CommandBatchingRenderer::SetConstantBuffer(void* buffer, int slot)
+{
+    RecordSlotBind(CommandType::SetConstantBuffer, m_graphicsState.constantBuffers, slot, buffer);
+}
+
+void CommandBatchingRenderer::SetTexture(void* texture, int slot)
+{
+    RecordSlotBind(CommandType::SetTexture, m_graphicsState.shaderResources, slot, texture);
+}
+
+void CommandBatchingRenderer::SetRenderTarget(void* renderTarget)
+{
+    RecordBind(CommandType::SetRenderTarget, m_graphicsState.renderTarget, 0, renderTarget);
+}
+
+void CommandBatchingRenderer::SetRootConstants(int slot, const void* data, size_t size)
+{
+    RecordRootConstants(CommandType::SetRootConstants, slot, data, size);
+}
+
+bool CommandBatchingRenderer::ExecuteShader()
+{
+    // Le résultat est attendu immédiatement : le flux est rejoué avant l'appel
+    m_stats.workCalls++;
+    Flush();
+    m_workSinceBarrier = true;
+    return m_renderer->ExecuteShader();
+}
+
+// --- Pipeline compute ---
+
+void CommandBatchingRenderer::SetComputeShader(void* shader)
+{
+    RecordBind(CommandType::SetComputeShader, m_computeState.shader, 0, shader);
+}
+
+void CommandBatchingRenderer::SetComputeConstantBuffer(int slot, void* buffer)
+{
+    RecordSlotBind(CommandType::SetComputeConstantBuffer, m_computeState.constantBuffers, slot, buffer);
+}
+
+void CommandBatchingRenderer::SetComputeShaderResource(int slot, void* resource)
+{
+    RecordSlotBind(CommandType::SetComputeShaderResource, m_computeState.shaderResources, slot, resource);
+}
+
+void CommandBatchingRenderer::SetComputeUnorderedAccessView(int slot, void* resource)
+{
+    RecordSlotBind(CommandType::SetComputeUnorderedAccessView, m_computeState.unorderedAccessViews, slot, resource);
+}
+
+void CommandBatchingRenderer::SetComputeRootConstants(int slot, const void* data, size_t size)
+{
+    RecordRootConstants(CommandType::SetComputeRootConstants, slot, data, size);
+}
+
+void CommandBatchingRenderer::DispatchCompute(int groupsX, int groupsY, int groupsZ)
+{
+    m_stats.workCalls++;
+    Command* command = Append(CommandType::DispatchCompute);
+    command->groups[0] = groupsX;
+    command->groups[1] = groupsY;
+    command->groups[2] = groupsZ;
+    command->stage = GetCurrentStage();
+    m_workSinceBarrier = true;
+}
+
+void CommandBatchingRenderer::SyncCompute()
+{
+    m_stats.barriersIn++;
+    if (!m_workSinceBarrier) {
+        return;
+    }
+
+    Append(CommandType::SyncCompute)->stage = GetCurrentStage();
+    m_stats.barriersOut++;
+    m_workSinceBarrier = false;
+}
+
+void CommandBatchingRenderer::SetParallelism(uint32_t threadCount, int rowsPerTask)
+{
+    // Le réglage s'applique aux appels suivants uniquement
+    Flush();
+    m_renderer->SetParallelism(threadCount, rowsPerTask);
+}
+
+} // namespace XIS
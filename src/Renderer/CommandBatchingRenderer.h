@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include "IRenderer.h"
+#include "../Utils/PerfMonitor.h"
+
+namespace XIS {
+
+/**
+ * @brief Renderer qui filtre les liaisons redondantes et soumet par lots
+ *
+ * Les étapes relient leurs shaders, tampons constants et ressources avant
+ * chaque appel, le plus souvent à l'identique. Ce renderer enregistre les
+ * liaisons et les dispatchs dans un flux de commandes de taille fixe :
+ *
+ * - une liaison identique à l'état qu'aura le renderer de la session après
+ *   le flux est supprimée ; les root constants, valables pour un seul appel,
+ *   sont toujours transmises ;
+ * - une barrière (SyncCompute) sans dispatch depuis la précédente est
+ *   supprimée, ce qui fusionne les barrières consécutives ;
+ * - le flux est rejoué d'un bloc (Flush) lorsqu'il est plein, avant tout
+ *   appel dont le résultat ou l'effet dépend des commandes précédentes
+ *   (ExecuteShader, copies, mises à jour et libérations de ressources,
+ *   relectures) et à la fin de chaque étape du pipeline.
+ *
+ * Avec un PerfMonitor associé, chaque dispatch et chaque barrière retient
+ * l'étape ouverte à son enregistrement : rejoué hors de cette étape (flux
+ * plein, Flush tardif), il est encadré par elle, de sorte que les
+ * intervalles et les octets du renderer instrumenté lui restent attribués.
+ *
+ * L'état suivi est invalidé lorsqu'une ressource liée est libérée et au
+ * début et à la fin de chaque frame (ressources intermédiaires), car le
+ * backend ou l'application peuvent réutiliser une adresse pour une autre
+ * ressource. Aucune allocation n'a lieu pendant le traitement des frames.
+ *
+ * Les appels ont lieu sur le thread de la session ; les compteurs, publiés
+ * une fois par frame (EndFrame), peuvent être lus depuis n'importe quel
+ * thread.
+ */
+class CommandBatchingRenderer : public IRenderer {
+public:
+    /**
+     * @brief Compteurs depuis la création du renderer
+     */
+    struct Stats {
+        uint64_t workCalls = 0;           // Dispatchs et ExecuteShader
+        uint64_t stateCallsIn = 0;        // Liaisons et root constants reçues
+        uint64_t stateCallsOut = 0;       // Liaisons et root constants transmises
+        uint64_t barriersIn = 0;          // SyncCompute reçus
+        uint64_t barriersOut = 0;         // SyncCompute transmis
+        uint64_t batches = 0;             // Flux de commandes rejoués
+        uint64_t batchedCommands = 0;     // Commandes rejouées dans ces flux
+    };
+
+    explicit CommandBatchingRenderer(std::shared_ptr<IRenderer> renderer);
+    ~CommandBatchingRenderer() override;
+
+    /**
+     * @brief Rejoue le flux en attente et publie les compteurs de la frame
+     */
+    void EndFrame();
+
+    void CollectStats(Stats& stats) const;
+
+    /**
+     * @brief Associe le moniteur dont les étapes sont retenues par les dispatchs
+     *
+     * @param perfMonitor Moniteur du pipeline, nullptr pour détacher
+     */
+    void SetPerfMonitor(PerfMonitor* perfMonitor);
+
+    IRenderer* GetInnerRenderer() const { return m_renderer.get(); }
+
+    // --- IRenderer ---
+    void* LoadShader(const char* fileName, const char* entryPoint) override;
+    void* LoadComputeShader(const char* fileName, const char* entryPoint, const char* profile) override;
+    void ReleaseShaderResource(void* shader) override;
+    bool GetShaderSlotCounts(void* shader, int& shaderResources, int& unorderedAccessViews,
+                             int& constantBuffers) const override;
+
+    void* CreateTexture2D(int width, int height, int format, bool allowUAV, const char* debugName) override;
+    void* CreateStructuredBuffer(int elementCount, int elementStride, bool allowUAV, const char* debugName) override;
+    void* CreateConstantBuffer(size_t size, const void* initialData = nullptr, const char* debugName = nullptr) override;
+    void ReleaseResource(void* resource) override;
+    void ReleaseBuffer(void* buffer) override;
+    void UpdateBuffer(void* buffer, const void* data, size_t size) override;
+    bool UpdateConstantBuffer(void* buffer, const void* data, size_t size) override;
+    bool CopyResource(void* source, void* destination) override;
+    size_t GetResourceSize(void* resource) const override;
+    size_t GetResourceHugePageSize(void* resource) const override;
+    int GetFloatTextureFormat() const override;
+    bool ReadTexture(void* texture, int& width, int& height, int& format, std::vector<uint8_t>* pixels) override;
+
+    void CreateIntermediateResources(const XISParameters& params) override;
+    void* GetIntermediateResource(int index) override;
+    void ReleaseIntermediateResources() override;
+
+    void SetShader(void* shader) override;
+    void SetConstantBuffer(void* buffer, int slot) override;
+    void SetTexture(void* texture, int slot) override;
+    void SetRenderTarget(void* renderTarget) override;
+    void SetRootConstants(int slot, const void* data, size_t size) override;
+    bool ExecuteShader() override;
+
+    void SetComputeShader(void* shader) override;
+    void SetComputeConstantBuffer(int slot, void* buffer) override;
+    void SetComputeShaderResource(int slot, void* resource) override;
+    void SetComputeUnorderedAccessView(int slot, void* resource) override;
+    void SetComputeRootConstants(int slot, const void* data, size_t size) override;
+    void DispatchCompute(int groupsX, int groupsY, int groupsZ) override;
+    void SyncCompute() override;
+    void SetParallelism(uint32_t threadCount, int rowsPerTask) override;
+    void Flush() override;
+
+private:
+    // Nombre de slots suivis par type de liaison ; au-delà, les liaisons
+    // sont transmises sans filtrage
+    static constexpr int kMaxBindSlots = 16;
+
+    // Capacité du flux de commandes et de la réserve de root constants
+    static constexpr int kMaxCommands = 256;
+    static constexpr size_t kRootConstantPoolSize = 4096;
+    static constexpr size_t kMaxRootConstantSize = 64;
+
+    enum class CommandType : uint8_t {
+        SetShader,
+        SetConstantBuffer,
+        SetTexture,
+        SetRenderTarget,
+        SetRootConstants,
+        SetComputeShader,
+        SetComputeConstantBuffer,
+        SetComputeShaderResource,
+        SetComputeUnorderedAccessView,
+        SetComputeRootConstants,
+        DispatchCompute,
+        SyncCompute
+    };
+
+    struct Command {
+        CommandType type;
+        int slot;
+        void* object;                     // Shader ou ressource liés
+        int groups[3];                    // DispatchCompute
+        uint32_t dataOffset;              // Root constants dans m_rootConstantPool
+        uint32_t dataSize;
+        PerfMonitor::StageId stage;       // Étape ouverte à l'enregistrement (dispatchs et barrières)
+    };
+
+    // État qu'aura le renderer de la session une fois le flux rejoué
+    struct BindState {
+        void* shader;
+        void* constantBuffers[kMaxBindSlots];
+        void* shaderResources[kMaxBindSlots];
+        void* unorderedAccessViews[kMaxBindSlots];
+        void* renderTarget;
+    };
+
+    // Enregistre une liaison, sauf si elle ne change pas l'état suivi
+    void RecordBind(CommandType type, void*& current, int slot, void* object);
+    void RecordSlotBind(CommandType type, void** slots, int slot, void* object);
+    void RecordRootConstants(CommandType type, int slot, const void* data, size_t size);
+    Command* Append(CommandType type);
+
+    void Replay(const Command& command);
+
+    // Oublie l'état suivi : la liaison suivante de chaque slot est transmise
+    void InvalidateAll();
+    void Invalidate(void* object);
+
+    void PublishStats();
+
+    std::shared_ptr<IRenderer> m_renderer;
+
+    Command m_commands[kMaxCommands];
+    int m_commandCount;
+    uint8_t m_rootConstantPool[kRootConstantPoolSize];
+    size_t m_rootConstantPoolUsed;
+
+    BindState m_graphicsState;
+    BindState m_computeState;
+
+    // Un dispatch a été enregistré depuis la dernière barrière transmise
+    bool m_workSinceBarrier;
+
+    // Moniteur du pipeline ; changé uniquement hors traitement de frame
+    PerfMonitor* m_perfMonitor;
+
+    // Étape ouverte sur le thread appelant, kInvalidStage sans moniteur
+    PerfMonitor::StageId GetCurrentStage() const;
+
+    // Compteurs tenus par le thread de la session, publiés par EndFrame
+    Stats m_stats;
+    mutable std::mutex m_statsMutex;
+    Stats m_publishedStats;
+};
+
+} // namespace XIS
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "IRenderer.h"
+
+namespace XIS {
+
+/**
+ * @brief Compteur des envois de tampons constants du thread courant
+ *
+ * Une frame d'une session s'exécute entièrement sur un thread : la différence
+ * du compteur avant et après Pipeline::Execute donne le nombre d'envois de la
+ * frame, sans état partagé entre sessions.
+ */
+class ConstantUploadCounter {
+public:
+    static uint64_t GetThreadCount() { return s_threadUploads; }
+    static void Increment() { s_threadUploads++; }
+
+private:
+    static thread_local uint64_t s_threadUploads;
+};
+
+inline thread_local uint64_t ConstantUploadCounter::s_threadUploads = 0;
+
+/**
+ * @brief Slot des root constants utilisé pour les surcharges par appel
+ *
+ * Le slot 0 reçoit le tampon constant de l'étape (ConstantBlock) ; les
+ * paramètres propres à un seul appel (facteur de réduction temporaire,
+ * position temporelle d'une frame interpolée...) sont passés par root
+ * constants sur ce slot et ne modifient jamais le tampon constant.
+ */
+const int kOverrideRootConstantSlot = 1;
+
+/**
+ * @brief Tampon constant versionné, envoyé au GPU uniquement lorsqu'il change
+ *
+ * Les étapes modifient une copie CPU des constantes via Modify ; le contenu
+ * n'est comparé et envoyé qu'au moment de Flush, juste avant le dispatch.
+ * Une modification qui ne change aucun octet ne provoque aucun envoi.
+ *
+ * @tparam T Structure de constantes (POD, champs de padding explicites)
+ */
+template <typename T>
+class ConstantBlock {
+    static_assert(std::is_trivially_copyable<T>::value, "ConstantBlock requiert une structure POD");
+
+public:
+    ConstantBlock()
+        : m_renderer(nullptr),
+          m_buffer(nullptr),
+          m_data(),
+          m_version(0),
+          m_uploadedVersion(0)
+    {
+    }
+
+    ~ConstantBlock()
+    {
+        Release();
+    }
+
+    ConstantBlock(const ConstantBlock&) = delete;
+    ConstantBlock& operator=(const ConstantBlock&) = delete;
+
+    /**
+     * @brief Crée le tampon constant avec le contenu courant
+     *
+     * @param renderer Renderer propriétaire du tampon
+     * @param debugName Nom de débogage
+     * @return true si la création réussit, false sinon
+     */
+    bool Create(IRenderer* renderer, const char* debugName)
+    {
+        Release();
+
+        m_renderer = renderer;
+        m_buffer = renderer->CreateConstantBuffer(sizeof(T), &m_data, debugName);
+        m_uploadedVersion = m_version;
+        return m_buffer != nullptr;
+    }
+
+    /**
+     * @brief Libère le tampon constant
+     */
+    void Release()
+    {
+        if (m_buffer) {
+            m_renderer->ReleaseBuffer(m_buffer);
+            m_buffer = nullptr;
+        }
+    }
+
+    /**
+     * @brief Modifie les constantes
+     *
+     * @param modifier Fonction recevant une copie modifiable des constantes
+     * @return true si le contenu a changé
+     */
+    template <typename Modifier>
+    bool Modify(Modifier&& modifier)
+    {
+        T next = m_data;
+        modifier(next);
+
+        if (std::memcmp(&next, &m_data, sizeof(T)) == 0) {
+            return false;
+        }
+
+        m_data = next;
+        m_version++;
+        return true;
+    }
+
+    /**
+     * @brief Envoie les constantes si elles ont changé depuis le dernier envoi
+     *
+     * @return false si l'envoi a échoué
+     */
+    bool Flush()
+    {
+        if (!m_buffer || m_uploadedVersion == m_version) {
+            return true;
+        }
+
+        if (!m_renderer->UpdateConstantBuffer(m_buffer, &m_data, sizeof(T))) {
+            return false;
+        }
+
+        m_uploadedVersion = m_version;
+        ConstantUploadCounter::Increment();
+        return true;
+    }
+
+    const T& Get() const { return m_data; }
+    void* GetBuffer() const { return m_buffer; }
+    bool IsDirty() const { return m_uploadedVersion != m_version; }
+
+private:
+    IRenderer* m_renderer;
+    void* m_buffer;
+    T m_data;
+
+    uint64_t m_version;
+    uint64_t m_uploadedVersion;
+};
+
+} // namespace XIS
@@ -1 +1,233 @@
+#pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../Core/XISParameters.h"
+
+namespace XIS {
+
+/**
+ * @brief Interface commune des backends de rendu (DX11, DX12)
+ *
+ * Les ressources (textures, buffers, shaders) sont manipulées via des handles
+ * opaques dont l'interprétation dépend du backend. Une instance de renderer
+ * appartient à une seule session XIS et n'est jamais partagée entre threads.
+ */
+class IRenderer {
+public:
+    virtual ~IRenderer() = default;
+
+    // --- Shaders ---
+
+    /**
+     * @brief Charge un pixel shader
+     *
+     * @param fileName Fichier HLSL source
+     * @param entryPoint Point d'entrée du shader
+     * @return Handle du shader, nullptr en cas d'échec
+     */
+    virtual void* LoadShader(const char* fileName, const char* entryPoint) = 0;
+
+    /**
+     * @brief Charge un compute shader
+     *
+     * @param fileName Fichier HLSL source
+     * @param entryPoint Point d'entrée du shader
+     * @param profile Profil de compilation (ex: "cs_5_0")
+     * @return Handle du shader, nullptr en cas d'échec
+     */
+    virtual void* LoadComputeShader(const char* fileName, const char* entryPoint, const char* profile) = 0;
+
+    /**
+     * @brief Libère un shader chargé par LoadShader ou LoadComputeShader
+     */
+    virtual void ReleaseShaderResource(void* shader) = 0;
+
+    /**
+     * @brief Registres déclarés par un shader (t#, u# et b#)
+     *
+     * Les liaisons des registres suivants peuvent rester d'un appel
+     * précédent : le shader ne les lit pas.
+     *
+     * @return false si le backend ne connaît pas les registres du shader
+     */
+    virtual bool GetShaderSlotCounts(void* shader, int& shaderResources, int& unorderedAccessViews,
+                                     int& constantBuffers) const = 0;
+
+    // --- Ressources ---
+
+    /**
+     * @brief Crée une texture 2D
+     *
+     * @param width Largeur en pixels
+     * @param height Hauteur en pixels
+     * @param format Format de texture propre au backend
+     * @param allowUAV True pour autoriser l'accès en écriture depuis un compute shader
+     * @param debugName Nom de débogage de la ressource
+     * @return Handle de la texture, nullptr en cas d'échec
+     */
+    virtual void* CreateTexture2D(int width, int height, int format, bool allowUAV, const char* debugName) = 0;
+
+    /**
+     * @brief Crée un structured buffer
+     *
+     * @param elementCount Nombre d'éléments
+     * @param elementStride Taille d'un élément en octets
+     * @param allowUAV True pour autoriser l'accès en écriture depuis un compute shader
+     * @param debugName Nom de débogage de la ressource
+     * @return Handle du buffer, nullptr en cas d'échec
+     */
+    virtual void* CreateStructuredBuffer(int elementCount, int elementStride, bool allowUAV, const char* debugName) = 0;
+
+    /**
+     * @brief Crée un tampon constant
+     *
+     * @param size Taille en octets
+     * @param initialData Données initiales (optionnel)
+     * @param debugName Nom de débogage de la ressource (optionnel)
+     * @return Handle du buffer, nullptr en cas d'échec
+     */
+    virtual void* CreateConstantBuffer(size_t size, const void* initialData = nullptr, const char* debugName = nullptr) = 0;
+
+    /**
+     * @brief Libère une texture ou un structured buffer
+     */
+    virtual void ReleaseResource(void* resource) = 0;
+
+    /**
+     * @brief Libère un tampon constant
+     */
+    virtual void ReleaseBuffer(void* buffer) = 0;
+
+    /**
+     * @brief Met à jour le contenu d'un buffer
+     */
+    virtual void UpdateBuffer(void* buffer, const void* data, size_t size) = 0;
+
+    /**
+     * @brief Met à jour le contenu d'un tampon constant
+     *
+     * @return true si la mise à jour réussit, false sinon
+     */
+    virtual bool UpdateConstantBuffer(void* buffer, const void* data, size_t size) = 0;
+
+    /**
+     * @brief Copie le contenu d'une ressource vers une autre
+     *
+     * @param source Ressource source
+     * @param destination Ressource destination
+     * @return true si la copie réussit, false sinon
+     */
+    virtual bool CopyResource(void* source, void* destination) = 0;
+
+    /**
+     * @brief Taille en mémoire d'une ressource
+     *
+     * Calculée à partir des dimensions et du format de la ressource
+     * (textures, buffers, y compris les textures fournies par l'application).
+     *
+     * @return Taille en octets, 0 si la ressource est inconnue
+     */
+    virtual size_t GetResourceSize(void* resource) const = 0;
+
+    /**
+     * @brief Part d'une ressource servie par des pages larges
+     *
+     * Les backends qui ne gèrent pas eux-mêmes la mémoire de leurs
+     * ressources renvoient 0.
+     *
+     * @return Taille en octets, 0 si la ressource est inconnue
+     */
+    virtual size_t GetResourceHugePageSize(void* resource) const = 0;
+
+    /**
+     * @brief Format de texture flottant mono-canal du backend
+     */
+    virtual int GetFloatTextureFormat() const = 0;
+
+    /**
+     * @brief Relit le contenu d'une texture (capture de frames)
+     *
+     * Les lignes sont copiées sans remplissage, dans le format propre au
+     * backend. Lecture synchrone : à réserver aux outils de diagnostic.
+     *
+     * @param texture Texture à relire
+     * @param width Reçoit la largeur
+     * @param height Reçoit la hauteur
+     * @param format Reçoit le format
+     * @param pixels Reçoit le contenu ; nullptr pour ne lire que la description
+     * @return true si la texture est connue et relisible par le backend
+     */
+    virtual bool ReadTexture(void* texture, int& width, int& height, int& format, std::vector<uint8_t>* pixels) = 0;
+
+    // --- Ressources intermédiaires du pipeline ---
+    // Après ReleaseIntermediateResources, GetIntermediateResource renvoie
+    // nullptr pour les ressources libérées ; un backend peut aussi les
+    // conserver pour la frame suivante.
+
+    virtual void CreateIntermediateResources(const XISParameters& params) = 0;
+    virtual void* GetIntermediateResource(int index) = 0;
+    virtual void ReleaseIntermediateResources() = 0;
+
+    // --- Pipeline graphique ---
+
+    virtual void SetShader(void* shader) = 0;
+    virtual void SetConstantBuffer(void* buffer, int slot) = 0;
+    virtual void SetTexture(void* texture, int slot) = 0;
+    virtual void SetRenderTarget(void* renderTarget) = 0;
+
+    /**
+     * @brief Passe des constantes directement au prochain appel (root constants)
+     *
+     * Pour des paramètres propres à un seul appel : aucun tampon constant n'est
+     * modifié. DX12 utilise des root 32-bit constants ; DX11 les émule avec un
+     * tampon dynamique dédié.
+     *
+     * @param slot Registre de tampon constant (b#) lu par le shader
+     * @param data Données (multiple de 4 octets, 64 octets au plus)
+     * @param size Taille en octets
+     */
+    virtual void SetRootConstants(int slot, const void* data, size_t size) = 0;
+
+    virtual bool ExecuteShader() = 0;
+
+    // --- Pipeline compute ---
+
+    virtual void SetComputeShader(void* shader) = 0;
+    virtual void SetComputeConstantBuffer(int slot, void* buffer) = 0;
+    virtual void SetComputeShaderResource(int slot, void* resource) = 0;
+    virtual void SetComputeUnorderedAccessView(int slot, void* resource) = 0;
+
+    /**
+     * @brief Équivalent compute de SetRootConstants
+     */
+    virtual void SetComputeRootConstants(int slot, const void* data, size_t size) = 0;
+
+    virtual void DispatchCompute(int groupsX, int groupsY, int groupsZ) = 0;
+    virtual void SyncCompute() = 0;
+
+    // --- Exécution ---
+
+    /**
+     * @brief Parallélisme des appels suivants (profil d'autotuning)
+     *
+     * Sans effet sur les backends GPU, dont la grille de groupes est fixée
+     * par les shaders (numthreads).
+     *
+     * @param threadCount Threads de calcul utilisés (0 = tous)
+     * @param rowsPerTask Lignes de la sortie par tâche (0 = choix automatique)
+     */
+    virtual void SetParallelism(uint32_t threadCount, int rowsPerTask) = 0;
+
+    /**
+     * @brief Soumet les commandes enregistrées et non encore exécutées
+     *
+     * Appelé à la fin de chaque étape du pipeline, pour que le temps mesuré
+     * pour l'étape couvre son travail. Sans effet sur les backends qui
+     * exécutent chaque appel immédiatement.
+     */
+    virtual void Flush() = 0;
+};
+
+} // namespace XIS
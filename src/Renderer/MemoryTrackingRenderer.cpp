@@ -0,0 +1,404 @@
+#include "MemoryTrackingRenderer.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace XIS {
+
+namespace {
+    const char* const kCategoryTexture = "Texture";
+    const char* const kCategoryStructuredBuffer = "StructuredBuffer";
+    const char* const kCategoryConstantBuffer = "ConstantBuffer";
+    const char* const kCategoryIntermediate = "Intermediate";
+
+    const double kBytesToMiB = 1.0 / (1024.0 * 1024.0);
+}
+
+MemoryTrackingRenderer::MemoryTrackingRenderer(std::shared_ptr<IRenderer> renderer)
+    : m_renderer(std::move(renderer)),
+      m_intermediateCount(0),
+      m_liveBytes(0),
+      m_peakBytes(0),
+      m_hugePageBytes(0),
+      m_allocationCount(0),
+      m_frameAllocations(0),
+      m_frameReleases(0),
+      m_lastFrameAllocations(0),
+      m_lastFrameReleases(0),
+      m_maxAllocationsPerFrame(0),
+      m_frameCount(0)
+{
+}
+
+MemoryTrackingRenderer::~MemoryTrackingRenderer() = default;
+
+void MemoryTrackingRenderer::Track(void* resource, uint64_t bytes, uint64_t hugePageBytes,
+                                   const char* debugName, const char* category)
+{
+    if (!resource) {
+        return;
+    }
+
+    std::string name = debugName && debugName[0] ? debugName : "<unnamed>";
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Un handle réutilisé par le backend sans libération préalable remplace l'ancien
+    auto previous = m_allocations.find(resource);
+    if (previous != m_allocations.end()) {
+        Entry& entry = m_entries[previous->second.entry];
+        entry.liveBytes -= previous->second.bytes;
+        entry.liveCount--;
+        m_liveBytes -= previous->second.bytes;
+        m_hugePageBytes -= previous->second.hugePageBytes;
+        m_allocations.erase(previous);
+    }
+
+    std::string key = std::string(category) + "/" + name;
+    auto it = m_entryIndices.find(key);
+    size_t index;
+    if (it != m_entryIndices.end()) {
+        index = it->second;
+    } else {
+        index = m_entries.size();
+        m_entries.emplace_back();
+        m_entries.back().name = name;
+        m_entries.back().category = category;
+        m_entryIndices.emplace(std::move(key), index);
+    }
+
+    Entry& entry = m_entries[index];
+    entry.liveBytes += bytes;
+    entry.liveCount++;
+    entry.allocationCount++;
+    entry.peakBytes = std::max(entry.peakBytes, entry.liveBytes);
+
+    m_allocations[resource] = { index, bytes, hugePageBytes };
+    m_liveBytes += bytes;
+    m_hugePageBytes += hugePageBytes;
+    m_peakBytes = std::max(m_peakBytes, m_liveBytes);
+    m_allocationCount++;
+    m_frameAllocations++;
+}
+
+void MemoryTrackingRenderer::Untrack(void* resource)
+{
+    if (!resource) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_allocations.find(resource);
+    if (it == m_allocations.end()) {
+        return;
+    }
+
+    Entry& entry = m_entries[it->second.entry];
+    entry.liveBytes -= it->second.bytes;
+    entry.liveCount--;
+    m_liveBytes -= it->second.bytes;
+    m_hugePageBytes -= it->second.hugePageBytes;
+    m_frameReleases++;
+    m_allocations.erase(it);
+}
+
+void MemoryTrackingRenderer::EndFrame()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_lastFrameAllocations = m_frameAllocations;
+    m_lastFrameReleases = m_frameReleases;
+    m_maxAllocationsPerFrame = std::max(m_maxAllocationsPerFrame, m_frameAllocations);
+    m_frameAllocations = 0;
+    m_frameReleases = 0;
+    m_frameCount++;
+}
+
+void MemoryTrackingRenderer::Collect(Snapshot& snapshot) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    snapshot.liveBytes = m_liveBytes;
+    snapshot.liveCount = static_cast<uint32_t>(m_allocations.size());
+    snapshot.peakBytes = m_peakBytes;
+    snapshot.hugePageBytes = m_hugePageBytes;
+    snapshot.allocationCount = m_allocationCount;
+    snapshot.allocationsLastFrame = m_lastFrameAllocations;
+    snapshot.releasesLastFrame = m_lastFrameReleases;
+    snapshot.maxAllocationsPerFrame = m_maxAllocationsPerFrame;
+    snapshot.frameCount = m_frameCount;
+    snapshot.entries = m_entries;
+
+    std::sort(snapshot.entries.begin(), snapshot.entries.end(),
+              [](const Entry& a, const Entry& b) {
+                  return a.liveBytes != b.liveBytes ? a.liveBytes > b.liveBytes : a.peakBytes > b.peakBytes;
+              });
+}
+
+bool MemoryTrackingRenderer::Dump(const char* path) const
+{
+    Snapshot snapshot;
+    Collect(snapshot);
+
+    FILE* file = path ? std::fopen(path, "w") : stdout;
+    if (!file) {
+        return false;
+    }
+
+    std::fprintf(file, "XIS memory: %.2f MiB live in %u resources, peak %.2f MiB\n",
+                 snapshot.liveBytes * kBytesToMiB, snapshot.liveCount, snapshot.peakBytes * kBytesToMiB);
+    std::fprintf(file, "Huge pages: %.2f MiB of live memory\n", snapshot.hugePageBytes * kBytesToMiB);
+    std::fprintf(file, "Allocations: %llu total, %u last frame (%u released), max %u per frame over %llu frames\n\n",
+                 static_cast<unsigned long long>(snapshot.allocationCount), snapshot.allocationsLastFrame,
+                 snapshot.releasesLastFrame, snapshot.maxAllocationsPerFrame,
+                 static_cast<unsigned long long>(snapshot.frameCount));
+
+    std::fprintf(file, "%-16s %-40s %6s %12s %12s %8s\n", "Category", "Name", "Count", "Live MiB", "Peak MiB", "Allocs");
+    for (const Entry& entry : snapshot.entries) {
+        std::fprintf(file, "%-16s %-40s %6u %12.3f %12.3f %8llu\n",
+                     entry.category, entry.name.c_str(), entry.liveCount,
+                     entry.liveBytes * kBytesToMiB, entry.peakBytes * kBytesToMiB,
+                     static_cast<unsigned long long>(entry.allocationCount));
+    }
+
+    bool success = std::ferror(file) == 0;
+    if (path) {
+        success = std::fclose(file) == 0 && success;
+    } else {
+        std::fflush(file);
+    }
+    return success;
+}
+
+void* MemoryTrackingRenderer::LoadShader(const char* fileName, const char* entryPoint)
+{
+    return m_renderer->LoadShader(fileName, entryPoint);
+}
+
+void* MemoryTrackingRenderer::LoadComputeShader(const char* fileName, const char* entryPoint, const char* profile)
+{
+    return m_renderer->LoadComputeShader(fileName, entryPoint, profile);
+}
+
+void MemoryTrackingRenderer::ReleaseShaderResource(void* shader)
+{
+    m_renderer->ReleaseShaderResource(shader);
+}
+
+bool MemoryTrackingRenderer::GetShaderSlotCounts(void* shader, int& shaderResources, int& unorderedAccessViews,
+                                                 int& constantBuffers) const
+{
+    return m_renderer->GetShaderSlotCounts(shader, shaderResources, unorderedAccessViews, constantBuffers);
+}
+
+void* MemoryTrackingRenderer::CreateTexture2D(int width, int height, int format, bool allowUAV, const char* debugName)
+{
+    void* texture = m_renderer->CreateTexture2D(width, height, format, allowUAV, debugName);
+    if (texture) {
+        Track(texture, m_renderer->GetResourceSize(texture), m_renderer->GetResourceHugePageSize(texture),
+              debugName, kCategoryTexture);
+    }
+    return texture;
+}
+
+void* MemoryTrackingRenderer::CreateStructuredBuffer(int elementCount, int elementStride, bool allowUAV, const char* debugName)
+{
+    void* buffer = m_renderer->CreateStructuredBuffer(elementCount, elementStride, allowUAV, debugName);
+    if (buffer) {
+        Track(buffer, static_cast<uint64_t>(elementCount) * static_cast<uint64_t>(elementStride),
+              m_renderer->GetResourceHugePageSize(buffer), debugName, kCategoryStructuredBuffer);
+    }
+    return buffer;
+}
+
+void* MemoryTrackingRenderer::CreateConstantBuffer(size_t size, const void* initialData, const char* debugName)
+{
+    void* buffer = m_renderer->CreateConstantBuffer(size, initialData, debugName);
+    Track(buffer, size, 0, debugName, kCategoryConstantBuffer);
+    return buffer;
+}
+
+void MemoryTrackingRenderer::ReleaseResource(void* resource)
+{
+    Untrack(resource);
+    m_renderer->ReleaseResource(resource);
+}
+
+void MemoryTrackingRenderer::ReleaseBuffer(void* buffer)
+{
+    Untrack(buffer);
+    m_renderer->ReleaseBuffer(buffer);
+}
+
+void MemoryTrackingRenderer::UpdateBuffer(void* buffer, const void* data, size_t size)
+{
+    m_renderer->UpdateBuffer(buffer, data, size);
+}
+
+bool MemoryTrackingRenderer::UpdateConstantBuffer(void* buffer, const void* data, size_t size)
+{
+    return m_renderer->UpdateConstantBuffer(buffer, data, size);
+}
+
+bool MemoryTrackingRenderer::CopyResource(void* source, void* destination)
+{
+    return m_renderer->CopyResource(source, destination);
+}
+
+size_t MemoryTrackingRenderer::GetResourceSize(void* resource) const
+{
+    return m_renderer->GetResourceSize(resource);
+}
+
+size_t MemoryTrackingRenderer::GetResourceHugePageSize(void* resource) const
+{
+    return m_renderer->GetResourceHugePageSize(resource);
+}
+
+int MemoryTrackingRenderer::GetFloatTextureFormat() const
+{
+    return m_renderer->GetFloatTextureFormat();
+}
+
+bool MemoryTrackingRenderer::ReadTexture(void* texture, int& width, int& height, int& format, std::vector<uint8_t>* pixels)
+{
+    return m_renderer->ReadTexture(texture, width, height, format, pixels);
+}
+
+void MemoryTrackingRenderer::CreateIntermediateResources(const XISParameters& params)
+{
+    m_renderer->CreateIntermediateResources(params);
+    SyncIntermediateResources();
+}
+
+void* MemoryTrackingRenderer::GetIntermediateResource(int index)
+{
+    return m_renderer->GetIntermediateResource(index);
+}
+
+void MemoryTrackingRenderer::ReleaseIntermediateResources()
+{
+    // Le backend peut conserver ses ressources intermédiaires pour la frame
+    // suivante (backend CPU) : elles restent alors comptabilisées
+    m_renderer->ReleaseIntermediateResources();
+    SyncIntermediateResources();
+}
+
+void MemoryTrackingRenderer::SyncIntermediateResources()
+{
+    // Les ressources intermédiaires sont créées par le backend lui-même :
+    // elles sont énumérées jusqu'au premier indice vide
+    IntermediateResource current[kMaxIntermediateResources];
+    int currentCount = 0;
+    for (int i = 0; i < kMaxIntermediateResources; i++) {
+        void* resource = m_renderer->GetIntermediateResource(i);
+        if (!resource) {
+            break;
+        }
+        current[currentCount++] = { resource, m_renderer->GetResourceSize(resource) };
+    }
+
+    auto contains = [](const IntermediateResource* list, int count, const IntermediateResource& item) {
+        for (int i = 0; i < count; i++) {
+            if (list[i].resource == item.resource && list[i].bytes == item.bytes) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (int i = 0; i < m_intermediateCount; i++) {
+        if (!contains(current, currentCount, m_intermediateResources[i])) {
+            Untrack(m_intermediateResources[i].resource);
+        }
+    }
+
+    for (int i = 0; i < currentCount; i++) {
+        if (!contains(m_intermediateResources, m_intermediateCount, current[i])) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "Intermediate[%d]", i);
+            Track(current[i].resource, current[i].bytes, m_renderer->GetResourceHugePageSize(current[i].resource),
+                  name, kCategoryIntermediate);
+        }
+    }
+
+    std::copy(current, current + currentCount, m_intermediateResources);
+    m_intermediateCount = currentCount;
+}
+
+void MemoryTrackingRenderer::SetShader(void* shader)
+{
+    m_renderer->SetShader(shader);
+}
+
+void MemoryTrackingRenderer::SetConstantBuffer(void* buffer, int slot)
+{
+    m_renderer->SetConstantBuffer(buffer, slot);
+}
+
+void MemoryTrackingRenderer::SetTexture(void* texture, int slot)
+{
+    m_renderer->SetTexture(texture, slot);
+}
+
+void MemoryTrackingRenderer::SetRenderTarget(void* renderTarget)
+{
+    m_renderer->SetRenderTarget(renderTarget);
+}
+
+void MemoryTrackingRenderer::SetRootConstants(int slot, const void* data, size_t size)
+{
+    m_renderer->SetRootConstants(slot, data, size);
+}
+
+bool MemoryTrackingRenderer::ExecuteShader()
+{
+    return m_renderer->ExecuteShader();
+}
+
+void MemoryTrackingRenderer::SetComputeShader(void* shader)
+{
+    m_renderer->SetComputeShader(shader);
+}
+
+void MemoryTrackingRenderer::SetComputeConstantBuffer(int slot, void* buffer)
+{
+    m_renderer->SetComputeConstantBuffer(slot, buffer);
+}
+
+void MemoryTrackingRenderer::SetComputeShaderResource(int slot, void* resource)
+{
+    m_renderer->SetComputeShaderResource(slot, resource);
+}
+
+void MemoryTrackingRenderer::SetComputeUnorderedAccessView(int slot, void* resource)
+{
+    m_renderer->SetComputeUnorderedAccessView(slot, resource);
+}
+
+void MemoryTrackingRenderer::SetComputeRootConstants(int slot, const void* data, size_t size)
+{
+    m_renderer->SetComputeRootConstants(slot, data, size);
+}
+
+void MemoryTrackingRenderer::DispatchCompute(int groupsX, int groupsY, int groupsZ)
+{
+    m_renderer->DispatchCompute(groupsX, groupsY, groupsZ);
+}
+
+void MemoryTrackingRenderer::SyncCompute()
+{
+    m_renderer->SyncCompute();
+}
+
+void MemoryTrackingRenderer::SetParallelism(uint32_t threadCount, int rowsPerTask)
+{
+    m_renderer->SetParallelism(threadCount, rowsPerTask);
+}
+
+void MemoryTrackingRenderer::Flush()
+{
+    m_renderer->Flush();
+}
+
+} // namespace XIS
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "IRenderer.h"
+
+namespace XIS {
+
+/**
+ * @brief Renderer de suivi mémoire
+ *
+ * Transmet tous les appels au renderer de la session et comptabilise chaque
+ * ressource créée : taille, nom de débogage et catégorie (texture, structured
+ * buffer, tampon constant, ressource intermédiaire). Les octets vivants et
+ * leur maximum sont suivis par nom et au total, ainsi que le nombre de
+ * créations et de libérations par frame et la part des octets vivants
+ * servie par des pages larges.
+ *
+ * Les appels au renderer ont lieu sur le thread de la session ; les rapports
+ * peuvent être lus depuis n'importe quel thread.
+ */
+class MemoryTrackingRenderer : public IRenderer {
+public:
+    /**
+     * @brief Occupation mémoire d'un nom de débogage dans une catégorie
+     */
+    struct Entry {
+        std::string name;
+        const char* category = "";
+        uint64_t liveBytes = 0;
+        uint32_t liveCount = 0;
+        uint64_t peakBytes = 0;           // Maximum atteint par liveBytes
+        uint64_t allocationCount = 0;     // Créations depuis le début de la session
+    };
+
+    struct Snapshot {
+        uint64_t liveBytes = 0;
+        uint32_t liveCount = 0;
+        uint64_t peakBytes = 0;           // Maximum de l'ensemble de travail
+        uint64_t hugePageBytes = 0;       // Octets vivants servis par des pages larges
+        uint64_t allocationCount = 0;
+        uint32_t allocationsLastFrame = 0;
+        uint32_t releasesLastFrame = 0;
+        uint32_t maxAllocationsPerFrame = 0;
+        uint64_t frameCount = 0;
+        std::vector<Entry> entries;       // Triées par octets vivants décroissants
+    };
+
+    explicit MemoryTrackingRenderer(std::shared_ptr<IRenderer> renderer);
+    ~MemoryTrackingRenderer() override;
+
+    /**
+     * @brief Clôt la frame courante pour les compteurs par frame
+     */
+    void EndFrame();
+
+    void Collect(Snapshot& snapshot) const;
+
+    /**
+     * @brief Écrit l'occupation mémoire sous forme de tableau texte
+     *
+     * @param path Fichier de sortie, nullptr pour la sortie standard
+     * @return true si l'écriture réussit
+     */
+    bool Dump(const char* path) const;
+
+    // --- IRenderer ---
+    void* LoadShader(const char* fileName, const char* entryPoint) override;
+    void* LoadComputeShader(const char* fileName, const char* entryPoint, const char* profile) override;
+    void ReleaseShaderResource(void* shader) override;
+    bool GetShaderSlotCounts(void* shader, int& shaderResources, int& unorderedAccessViews,
+                             int& constantBuffers) const override;
+
+    void* CreateTexture2D(int width, int height, int format, bool allowUAV, const char* debugName) override;
+    void* CreateStructuredBuffer(int elementCount, int elementStride, bool allowUAV, const char* debugName) override;
+    void* CreateConstantBuffer(size_t size, const void* initialData = nullptr, const char* debugName = nullptr) override;
+    void ReleaseResource(void* resource) override;
+    void ReleaseBuffer(void* buffer) override;
+    void UpdateBuffer(void* buffer, const void* data, size_t size) override;
+    bool UpdateConstantBuffer(void* buffer, const void* data, size_t size) override;
+    bool CopyResource(void* source, void* destination) override;
+    size_t GetResourceSize(void* resource) const override;
+    size_t GetResourceHugePageSize(void* resource) const override;
+    int GetFloatTextureFormat() const override;
+    bool ReadTexture(void* texture, int& width, int& height, int& format, std::vector<uint8_t>* pixels) override;
+
+    void CreateIntermediateResources(const XISParameters& params) override;
+    void* GetIntermediateResource(int index) override;
+    void ReleaseIntermediateResources() override;
+
+    void SetShader(void* shader) override;
+    void SetConstantBuffer(void* buffer, int slot) override;
+    void SetTexture(void* texture, int slot) override;
+    void SetRenderTarget(void* renderTarget) override;
+    void SetRootConstants(int slot, const void* data, size_t size) override;
+    bool ExecuteShader() override;
+
+    void SetComputeShader(void* shader) override;
+    void SetComputeConstantBuffer(int slot, void* buffer) override;
+    void SetComputeShaderResource(int slot, void* resource) override;
+    void SetComputeUnorderedAccessView(int slot, void* resource) override;
+    void SetComputeRootConstants(int slot, const void* data, size_t size) override;
+    void DispatchCompute(int groupsX, int groupsY, int groupsZ) override;
+    void SyncCompute() override;
+    void SetParallelism(uint32_t threadCount, int rowsPerTask) override;
+    void Flush() override;
+
+private:
+    // Nombre maximal de ressources intermédiaires énumérées
+    static const int kMaxIntermediateResources = 16;
+
+    struct Allocation {
+        size_t entry;                     // Indice dans m_entries
+        uint64_t bytes;
+        uint64_t hugePageBytes;
+    };
+
+    struct IntermediateResource {
+        void* resource;
+        uint64_t bytes;
+    };
+
+    void Track(void* resource, uint64_t bytes, uint64_t hugePageBytes, const char* debugName, const char* category);
+    void Untrack(void* resource);
+
+    /**
+     * Met le suivi des ressources intermédiaires à jour d'après celles que
+     * le backend renvoie : seules les ressources apparues, disparues ou
+     * redimensionnées sont (dé)comptabilisées, si bien qu'un backend qui les
+     * conserve d'une frame à l'autre ne provoque aucune allocation ici.
+     */
+    void SyncIntermediateResources();
+
+    std::shared_ptr<IRenderer> m_renderer;
+
+    mutable std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+    std::unordered_map<std::string, size_t> m_entryIndices;   // "catégorie/nom" -> indice
+    std::unordered_map<void*, Allocation> m_allocations;
+    IntermediateResource m_intermediateResources[kMaxIntermediateResources];
+    int m_intermediateCount;
+
+    uint64_t m_liveBytes;
+    uint64_t m_peakBytes;
+    uint64_t m_hugePageBytes;
+    uint64_t m_allocationCount;
+    uint32_t m_frameAllocations;
+    uint32_t m_frameReleases;
+    uint32_t m_lastFrameAllocations;
+    uint32_t m_lastFrameReleases;
+    uint32_t m_maxAllocationsPerFrame;
+    uint64_t m_frameCount;
+};
+
+} // namespace XIS
@@ -0,0 +1,344 @@
+#include "ProfilingRenderer.h"
+#include <algorithm>
+
+namespace XIS {
+
+namespace {
+    // Intervalle enregistré autour d'un appel au renderer
+    class ScopedSpan {
+    public:
+        ScopedSpan(PerfMonitor* perfMonitor, PerfMonitor::StageId stage)
+            : m_perfMonitor(perfMonitor), m_stage(stage)
+        {
+            if (m_perfMonitor) {
+                m_perfMonitor->StartStage(m_stage);
+            }
+        }
+
+        ~ScopedSpan()
+        {
+            if (m_perfMonitor) {
+                m_perfMonitor->EndStage(m_stage);
+            }
+        }
+
+    private:
+        PerfMonitor* m_perfMonitor;
+        PerfMonitor::StageId m_stage;
+    };
+}
+
+ProfilingRenderer::ProfilingRenderer(std::shared_ptr<IRenderer> renderer)
+    : m_renderer(std::move(renderer)),
+      m_perfMonitor(nullptr),
+      m_dispatchStage(PerfMonitor::kInvalidStage),
+      m_executeStage(PerfMonitor::kInvalidStage),
+      m_copyStage(PerfMonitor::kInvalidStage),
+      m_syncStage(PerfMonitor::kInvalidStage)
+{
+}
+
+ProfilingRenderer::~ProfilingRenderer() = default;
+
+void ProfilingRenderer::SetPerfMonitor(PerfMonitor* perfMonitor)
+{
+    if (perfMonitor) {
+        m_dispatchStage = perfMonitor->RegisterStage("DispatchCompute");
+        m_executeStage = perfMonitor->RegisterStage("ExecuteShader");
+        m_copyStage = perfMonitor->RegisterStage("CopyResource");
+        m_syncStage = perfMonitor->RegisterStage("SyncCompute");
+    }
+
+    m_perfMonitor.store(perfMonitor, std::memory_order_release);
+}
+
+void ProfilingRenderer::TrackResource(void* resource)
+{
+    if (resource) {
+        m_resourceSizes[resource] = m_renderer->GetResourceSize(resource);
+    }
+}
+
+uint64_t ProfilingRenderer::GetSize(void* resource) const
+{
+    if (!resource) {
+        return 0;
+    }
+
+    auto it = m_resourceSizes.find(resource);
+    if (it != m_resourceSizes.end()) {
+        return it->second;
+    }
+
+    // Textures de l'application et ressources intermédiaires : le handle
+    // peut désigner une autre ressource d'une frame à l'autre, pas de cache
+    return m_renderer->GetResourceSize(resource);
+}
+
+uint64_t ProfilingRenderer::SumSizes(void* const* resources, int count) const
+{
+    uint64_t total = 0;
+    for (int i = 0; i < count; i++) {
+        total += GetSize(resources[i]);
+    }
+    return total;
+}
+
+void ProfilingRenderer::SetDeclaredSlots(Bindings& bindings, void* shader) const
+{
+    int shaderResources = 0;
+    int unorderedAccessViews = 0;
+    int constantBuffers = 0;
+    if (!shader || !m_renderer->GetShaderSlotCounts(shader, shaderResources, unorderedAccessViews, constantBuffers)) {
+        shaderResources = kMaxBindSlots;
+        unorderedAccessViews = kMaxBindSlots;
+        constantBuffers = kMaxBindSlots;
+    }
+
+    bindings.shaderResourceCount = std::min(std::max(shaderResources, 0), kMaxBindSlots);
+    bindings.unorderedAccessViewCount = std::min(std::max(unorderedAccessViews, 0), kMaxBindSlots);
+    bindings.constantBufferCount = std::min(std::max(constantBuffers, 0), kMaxBindSlots);
+}
+
+void ProfilingRenderer::Bind(void** slots, int slot, void* resource)
+{
+    if (slot >= 0 && slot < kMaxBindSlots) {
+        slots[slot] = resource;
+    }
+}
+
+void ProfilingRenderer::Unbind(const void* resource)
+{
+    for (Bindings* bindings : { &m_graphicsBindings, &m_computeBindings }) {
+        for (void** slots : { bindings->constantBuffers, bindings->shaderResources, bindings->unorderedAccessViews }) {
+            for (int i = 0; i < kMaxBindSlots; i++) {
+                if (slots[i] == resource) {
+                    slots[i] = nullptr;
+                }
+            }
+        }
+        if (bindings->renderTarget == resource) {
+            bindings->renderTarget = nullptr;
+        }
+    }
+}
+
+void* ProfilingRenderer::LoadShader(const char* fileName, const char* entryPoint)
+{
+    return m_renderer->LoadShader(fileName, entryPoint);
+}
+
+void* ProfilingRenderer::LoadComputeShader(const char* fileName, const char* entryPoint, const char* profile)
+{
+    return m_renderer->LoadComputeShader(fileName, entryPoint, profile);
+}
+
+void ProfilingRenderer::ReleaseShaderResource(void* shader)
+{
+    m_renderer->ReleaseShaderResource(shader);
+}
+
+bool ProfilingRenderer::GetShaderSlotCounts(void* shader, int& shaderResources, int& unorderedAccessViews,
+                                            int& constantBuffers) const
+{
+    return m_renderer->GetShaderSlotCounts(shader, shaderResources, unorderedAccessViews, constantBuffers);
+}
+
+void* ProfilingRenderer::CreateTexture2D(int width, int height, int format, bool allowUAV, const char* debugName)
+{
+    void* texture = m_renderer->CreateTexture2D(width, height, format, allowUAV, debugName);
+    TrackResource(texture);
+    return texture;
+}
+
+void* ProfilingRenderer::CreateStructuredBuffer(int elementCount, int elementStride, bool allowUAV, const char* debugName)
+{
+    void* buffer = m_renderer->CreateStructuredBuffer(elementCount, elementStride, allowUAV, debugName);
+    TrackResource(buffer);
+    return buffer;
+}
+
+void* ProfilingRenderer::CreateConstantBuffer(size_t size, const void* initialData, const char* debugName)
+{
+    void* buffer = m_renderer->CreateConstantBuffer(size, initialData, debugName);
+    if (buffer) {
+        m_resourceSizes[buffer] = size;
+    }
+    return buffer;
+}
+
+void ProfilingRenderer::ReleaseResource(void* resource)
+{
+    m_resourceSizes.erase(resource);
+    Unbind(resource);
+    m_renderer->ReleaseResource(resource);
+}
+
+void ProfilingRenderer::ReleaseBuffer(void* buffer)
+{
+    m_resourceSizes.erase(buffer);
+    Unbind(buffer);
+    m_renderer->ReleaseBuffer(buffer);
+}
+
+void ProfilingRenderer::UpdateBuffer(void* buffer, const void* data, size_t size)
+{
+    m_renderer->UpdateBuffer(buffer, data, size);
+}
+
+bool ProfilingRenderer::UpdateConstantBuffer(void* buffer, const void* data, size_t size)
+{
+    return m_renderer->UpdateConstantBuffer(buffer, data, size);
+}
+
+bool ProfilingRenderer::CopyResource(void* source, void* destination)
+{
+    PerfMonitor* perfMonitor = m_perfMonitor.load(std::memory_order_acquire);
+    ScopedSpan span(perfMonitor, m_copyStage);
+    if (perfMonitor) {
+        perfMonitor->RecordBytes(GetSize(source), GetSize(destination));
+    }
+    return m_renderer->CopyResource(source, destination);
+}
+
+size_t ProfilingRenderer::GetResourceSize(void* resource) const
+{
+    return static_cast<size_t>(GetSize(resource));
+}
+
+size_t ProfilingRenderer::GetResourceHugePageSize(void* resource) const
+{
+    return m_renderer->GetResourceHugePageSize(resource);
+}
+
+int ProfilingRenderer::GetFloatTextureFormat() const
+{
+    return m_renderer->GetFloatTextureFormat();
+}
+
+bool ProfilingRenderer::ReadTexture(void* texture, int& width, int& height, int& format, std::vector<uint8_t>* pixels)
+{
+    return m_renderer->ReadTexture(texture, width, height, format, pixels);
+}
+
+void ProfilingRenderer::CreateIntermediateResources(const XISParameters& params)
+{
+    // Le renderer peut recréer ses ressources intermédiaires : les handles
+    // liés à la frame précédente ne sont plus valides
+    m_graphicsBindings = Bindings();
+    m_computeBindings = Bindings();
+    m_renderer->CreateIntermediateResources(params);
+}
+
+void* ProfilingRenderer::GetIntermediateResource(int index)
+{
+    return m_renderer->GetIntermediateResource(index);
+}
+
+void ProfilingRenderer::ReleaseIntermediateResources()
+{
+    m_renderer->ReleaseIntermediateResources();
+}
+
+void ProfilingRenderer::SetShader(void* shader)
+{
+    SetDeclaredSlots(m_graphicsBindings, shader);
+    m_renderer->SetShader(shader);
+}
+
+void ProfilingRenderer::SetConstantBuffer(void* buffer, int slot)
+{
+    Bind(m_graphicsBindings.constantBuffers, slot, buffer);
+    m_renderer->SetConstantBuffer(buffer, slot);
+}
+
+void ProfilingRenderer::SetTexture(void* texture, int slot)
+{
+    Bind(m_graphicsBindings.shaderResources, slot, texture);
+    m_renderer->SetTexture(texture, slot);
+}
+
+void ProfilingRenderer::SetRenderTarget(void* renderTarget)
+{
+    m_graphicsBindings.renderTarget = renderTarget;
+    m_renderer->SetRenderTarget(renderTarget);
+}
+
+void ProfilingRenderer::SetRootConstants(int slot, const void* data, size_t size)
+{
+    m_renderer->SetRootConstants(slot, data, size);
+}
+
+bool ProfilingRenderer::ExecuteShader()
+{
+    PerfMonitor* perfMonitor = m_perfMonitor.load(std::memory_order_acquire);
+    ScopedSpan span(perfMonitor, m_executeStage);
+    if (perfMonitor) {
+        const Bindings& bindings = m_graphicsBindings;
+        perfMonitor->RecordBytes(SumSizes(bindings.shaderResources, bindings.shaderResourceCount) +
+                                 SumSizes(bindings.constantBuffers, bindings.constantBufferCount),
+                                 GetSize(bindings.renderTarget));
+    }
+    return m_renderer->ExecuteShader();
+}
+
+void ProfilingRenderer::SetComputeShader(void* shader)
+{
+    SetDeclaredSlots(m_computeBindings, shader);
+    m_renderer->SetComputeShader(shader);
+}
+
+void ProfilingRenderer::SetComputeConstantBuffer(int slot, void* buffer)
+{
+    Bind(m_computeBindings.constantBuffers, slot, buffer);
+    m_renderer->SetComputeConstantBuffer(slot, buffer);
+}
+
+void ProfilingRenderer::SetComputeShaderResource(int slot, void* resource)
+{
+    Bind(m_computeBindings.shaderResources, slot, resource);
+    m_renderer->SetComputeShaderResource(slot, resource);
+}
+
+void ProfilingRenderer::SetComputeUnorderedAccessView(int slot, void* resource)
+{
+    Bind(m_computeBindings.unorderedAccessViews, slot, resource);
+    m_renderer->SetComputeUnorderedAccessView(slot, resource);
+}
+
+void ProfilingRenderer::SetComputeRootConstants(int slot, const void* data, size_t size)
+{
+    m_renderer->SetComputeRootConstants(slot, data, size);
+}
+
+void ProfilingRenderer::DispatchCompute(int groupsX, int groupsY, int groupsZ)
+{
+    PerfMonitor* perfMonitor = m_perfMonitor.load(std::memory_order_acquire);
+    ScopedSpan span(perfMonitor, m_dispatchStage);
+    if (perfMonitor) {
+        // Une UAV peut être lue et écrite : elle n'est comptée qu'en écriture
+        const Bindings& bindings = m_computeBindings;
+        perfMonitor->RecordBytes(SumSizes(bindings.shaderResources, bindings.shaderResourceCount) +
+                                 SumSizes(bindings.constantBuffers, bindings.constantBufferCount),
+                                 SumSizes(bindings.unorderedAccessViews, bindings.unorderedAccessViewCount));
+    }
+    m_renderer->DispatchCompute(groupsX, groupsY, groupsZ);
+}
+
+void ProfilingRenderer::SyncCompute()
+{
+    ScopedSpan span(m_perfMonitor.load(std::memory_order_acquire), m_syncStage);
+    m_renderer->SyncCompute();
+}
+
+void ProfilingRenderer::SetParallelism(uint32_t threadCount, int rowsPerTask)
+{
+    m_renderer->SetParallelism(threadCount, rowsPerTask);
+}
+
+void ProfilingRenderer::Flush()
+{
+    m_renderer->Flush();
+}
+
+} // namespace XIS
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include "IRenderer.h"
+#include "../Utils/PerfMonitor.h"
+
+namespace XIS {
+
+/**
+ * @brief Renderer instrumenté
+ *
+ * Transmet tous les appels au renderer de la session et enregistre un
+ * intervalle dans le PerfMonitor du pipeline autour des appels qui
+ * consomment du temps GPU ou bloquent le thread : DispatchCompute,
+ * ExecuteShader, CopyResource et SyncCompute. Ces intervalles s'imbriquent
+ * dans ceux des étapes dans les traces capturées.
+ *
+ * Chaque appel de travail comptabilise aussi les octets lus (ressources en
+ * lecture et tampons constants liés) et écrits (UAV ou render target liés),
+ * en considérant que chaque ressource liée est parcourue entièrement. Seuls
+ * les registres déclarés par le shader courant sont comptés (voir
+ * IRenderer::GetShaderSlotCounts) : les autres peuvent garder les liaisons
+ * d'une étape précédente.
+ */
+class ProfilingRenderer : public IRenderer {
+public:
+    explicit ProfilingRenderer(std::shared_ptr<IRenderer> renderer);
+    ~ProfilingRenderer() override;
+
+    /**
+     * @brief Associe le moniteur qui reçoit les intervalles
+     *
+     * @param perfMonitor Moniteur du pipeline, nullptr pour détacher
+     */
+    void SetPerfMonitor(PerfMonitor* perfMonitor);
+
+    IRenderer* GetInnerRenderer() const { return m_renderer.get(); }
+
+    // --- IRenderer ---
+    void* LoadShader(const char* fileName, const char* entryPoint) override;
+    void* LoadComputeShader(const char* fileName, const char* entryPoint, const char* profile) override;
+    void ReleaseShaderResource(void* shader) override;
+    bool GetShaderSlotCounts(void* shader, int& shaderResources, int& unorderedAccessViews,
+                             int& constantBuffers) const override;
+
+    void* CreateTexture2D(int width, int height, int format, bool allowUAV, const char* debugName) override;
+    void* CreateStructuredBuffer(int elementCount, int elementStride, bool allowUAV, const char* debugName) override;
+    void* CreateConstantBuffer(size_t size, const void* initialData = nullptr, const char* debugName = nullptr) override;
+    void ReleaseResource(void* resource) override;
+    void ReleaseBuffer(void* buffer) override;
+    void UpdateBuffer(void* buffer, const void* data, size_t size) override;
+    bool UpdateConstantBuffer(void* buffer, const void* data, size_t size) override;
+    bool CopyResource(void* source, void* destination) override;
+    size_t GetResourceSize(void* resource) const override;
+    size_t GetResourceHugePageSize(void* resource) const override;
+    int GetFloatTextureFormat() const override;
+    bool ReadTexture(void* texture, int& width, int& height, int& format, std::vector<uint8_t>* pixels) override;
+
+    void CreateIntermediateResources(const XISParameters& params) override;
+    void* GetIntermediateResource(int index) override;
+    void ReleaseIntermediateResources() override;
+
+    void SetShader(void* shader) override;
+    void SetConstantBuffer(void* buffer, int slot) override;
+    void SetTexture(void* texture, int slot) override;
+    void SetRenderTarget(void* renderTarget) override;
+    void SetRootConstants(int slot, const void* data, size_t size) override;
+    bool ExecuteShader() override;
+
+    void SetComputeShader(void* shader) override;
+    void SetComputeConstantBuffer(int slot, void* buffer) override;
+    void SetComputeShaderResource(int slot, void* resource) override;
+    void SetComputeUnorderedAccessView(int slot, void* resource) override;
+    void SetComputeRootConstants(int slot, const void* data, size_t size) override;
+    void DispatchCompute(int groupsX, int groupsY, int groupsZ) override;
+    void SyncCompute() override;
+    void SetParallelism(uint32_t threadCount, int rowsPerTask) override;
+    void Flush() override;
+
+private:
+    // Nombre de slots suivis par type de liaison
+    static constexpr int kMaxBindSlots = 16;
+
+    struct Bindings {
+        void* constantBuffers[kMaxBindSlots] = {};
+        void* shaderResources[kMaxBindSlots] = {};
+        void* unorderedAccessViews[kMaxBindSlots] = {};
+        void* renderTarget = nullptr;
+
+        // Registres déclarés par le shader lié (tous s'il est inconnu)
+        int constantBufferCount = kMaxBindSlots;
+        int shaderResourceCount = kMaxBindSlots;
+        int unorderedAccessViewCount = kMaxBindSlots;
+    };
+
+    // Taille connue ou demandée au renderer de la session
+    uint64_t GetSize(void* resource) const;
+    uint64_t SumSizes(void* const* resources, int count) const;
+    void SetDeclaredSlots(Bindings& bindings, void* shader) const;
+    void TrackResource(void* resource);
+    void Bind(void** slots, int slot, void* resource);
+
+    // Retire une ressource libérée des tables de liaison : un appel suivant
+    // demanderait sinon la taille d'une ressource rendue au renderer
+    void Unbind(const void* resource);
+
+    std::shared_ptr<IRenderer> m_renderer;
+
+    // Tailles des ressources créées via ce renderer
+    std::unordered_map<void*, uint64_t> m_resourceSizes;
+
+    Bindings m_graphicsBindings;
+    Bindings m_computeBindings;
+
+    // Moniteur courant ; changé uniquement hors traitement de frame
+    std::atomic<PerfMonitor*> m_perfMonitor;
+
+    PerfMonitor::StageId m_dispatchStage;
+    PerfMonitor::StageId m_executeStage;
+    PerfMonitor::StageId m_copyStage;
+    PerfMonitor::StageId m_syncStage;
+};
+
+} // namespace XIS
@@ -0,0 +1,53 @@
+#include "ShaderManager.h"
+#include "../Renderer/IRenderer.h"
+#include "../Utils/Logger.h"
+
+namespace XIS {
+
+namespace {
+    const char* kDefaultShaderPath = "Shaders/HLSL/";
+}
+
+ShaderManager::ShaderManager(IRenderer* renderer, const char* shaderPath)
+    : m_renderer(renderer),
+      m_shaderPath(shaderPath ? shaderPath : kDefaultShaderPath)
+{
+    if (!m_shaderPath.empty() && m_shaderPath.back() != '/' && m_shaderPath.back() != '\\') {
+        m_shaderPath += '/';
+    }
+}
+
+ShaderManager::~ShaderManager()
+{
+    ReleaseAll();
+}
+
+void* ShaderManager::LoadComputeShader(const char* fileName, const char* entryPoint, const char* profile)
+{
+    std::string key = std::string(fileName) + ":" + entryPoint;
+
+    auto it = m_computeShaders.find(key);
+    if (it != m_computeShaders.end()) {
+        return it->second;
+    }
+
+    std::string fullPath = m_shaderPath + fileName;
+    void* shader = m_renderer->LoadComputeShader(fullPath.c_str(), entryPoint, profile);
+    if (!shader) {
+        Logger::Error("ShaderManager: Échec du chargement de %s (%s)", fullPath.c_str(), entryPoint);
+        return nullptr;
+    }
+
+    m_computeShaders[key] = shader;
+    return shader;
+}
+
+void ShaderManager::ReleaseAll()
+{
+    for (auto& entry : m_computeShaders) {
+        m_renderer->ReleaseShaderResource(entry.second);
+    }
+    m_computeShaders.clear();
+}
+
+} // namespace XIS
@@ -1 +1,53 @@
+#pragma once
 
+#include <map>
+#include <string>
+
+namespace XIS {
+
+// Déclarations anticipées
+class IRenderer;
+
+/**
+ * @brief Gestionnaire des shaders d'une session
+ *
+ * Charge les shaders via le renderer de la session et les met en cache par
+ * couple (fichier, point d'entrée), de sorte que plusieurs algorithmes
+ * partageant un fichier HLSL ne le compilent qu'une seule fois.
+ */
+class ShaderManager {
+public:
+    /**
+     * @brief Constructeur
+     *
+     * @param renderer Renderer de la session
+     * @param shaderPath Répertoire des shaders (nullptr = chemin par défaut)
+     */
+    ShaderManager(IRenderer* renderer, const char* shaderPath);
+    ~ShaderManager();
+
+    ShaderManager(const ShaderManager&) = delete;
+    ShaderManager& operator=(const ShaderManager&) = delete;
+
+    /**
+     * @brief Charge (ou récupère depuis le cache) un compute shader
+     *
+     * @param fileName Fichier HLSL relatif au répertoire des shaders
+     * @param entryPoint Point d'entrée
+     * @param profile Profil de compilation
+     * @return Handle du shader, nullptr en cas d'échec
+     */
+    void* LoadComputeShader(const char* fileName, const char* entryPoint, const char* profile);
+
+    /**
+     * @brief Libère tous les shaders chargés
+     */
+    void ReleaseAll();
+
+private:
+    IRenderer* m_renderer;
+    std::string m_shaderPath;
+    std::map<std::string, void*> m_computeShaders;
+};
+
+} // namespace XIS
@@ -0,0 +1,68 @@
+#include "BandwidthProbe.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace XIS {
+
+namespace {
+    // 64 Mo par tampon : hors de portée des caches de dernier niveau actuels
+    const size_t kBufferSize = 64ull << 20;
+    const int kPassCount = 3;
+}
+
+double BandwidthProbe::GetPeakGBps()
+{
+    static std::once_flag once;
+    static double peakGBps = 0.0;
+
+    std::call_once(once, []() { peakGBps = Measure(); });
+    return peakGBps;
+}
+
+double BandwidthProbe::Measure()
+{
+    unsigned int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    size_t chunkSize = (kBufferSize / threadCount) & ~static_cast<size_t>(63);
+    if (chunkSize == 0) {
+        return 0.0;
+    }
+
+    std::vector<uint8_t> source(kBufferSize, 1);
+    std::vector<uint8_t> destination(kBufferSize, 0);
+
+    double bestSeconds = 0.0;
+    for (int pass = 0; pass < kPassCount; pass++) {
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount);
+        for (unsigned int t = 0; t < threadCount; t++) {
+            workers.emplace_back([&, t]() {
+                std::memcpy(destination.data() + t * chunkSize, source.data() + t * chunkSize, chunkSize);
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (pass == 0 || seconds < bestSeconds) {
+            bestSeconds = seconds;
+        }
+    }
+
+    if (bestSeconds <= 0.0) {
+        return 0.0;
+    }
+
+    // Lecture de la source et écriture de la destination
+    double bytes = 2.0 * static_cast<double>(chunkSize) * threadCount;
+    return bytes / bestSeconds * 1e-9;
+}
+
+} // namespace XIS
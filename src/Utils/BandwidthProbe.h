@@ -0,0 +1,26 @@
+#pragma once
+
+namespace XIS {
+
+/**
+ * @brief Mesure du débit mémoire crête de la machine
+ *
+ * Copie en parallèle de tampons bien plus grands que les caches, sur tous
+ * les cœurs ; la meilleure de plusieurs passes est retenue. Le débit compte
+ * les octets lus et écrits, comme les compteurs du PerfMonitor.
+ */
+class BandwidthProbe {
+public:
+    /**
+     * @brief Débit crête en Go/s
+     *
+     * Mesuré au premier appel (quelques dizaines de millisecondes) puis
+     * conservé pour la durée du processus.
+     */
+    static double GetPeakGBps();
+
+private:
+    static double Measure();
+};
+
+} // namespace XIS
@@ -0,0 +1,756 @@
+#include "ConfigManager.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <sys/stat.h>
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <chrono>
+#include <condition_variable>
+#endif
+
+namespace XIS {
+
+namespace {
+
+    // -----------------------------------------------------------------------
+    // Profil d'autotuning
+    // -----------------------------------------------------------------------
+
+    std::mutex g_tuningMutex;
+    std::shared_ptr<const TuningProfile> g_tuningProfile;
+    std::once_flag g_environmentOnce;
+
+    std::shared_ptr<const TuningProfile> ReadTuningProfile(const char* path)
+    {
+        auto profile = std::make_shared<TuningProfile>();
+        if (!profile->Load(path)) {
+            return nullptr;
+        }
+
+        if (profile->GetMachineId() != TuningProfile::GetCurrentMachineId()) {
+            Logger::Warning("ConfigManager: le profil %s a été mesuré sur une autre machine (%s)",
+                            path, profile->GetMachineId().c_str());
+        }
+        Logger::Info("ConfigManager: profil d'autotuning %s chargé (%zu résolutions)", path, profile->GetEntries().size());
+        return profile;
+    }
+
+    /**
+     * Charge une seule fois le profil désigné par XIS_TUNING_PROFILE. Un
+     * profil choisi explicitement auparavant consomme ce chargement et n'est
+     * donc jamais remplacé par celui de l'environnement.
+     */
+    void LoadEnvironmentProfile()
+    {
+        std::call_once(g_environmentOnce, [] {
+            const char* path = std::getenv("XIS_TUNING_PROFILE");
+            if (!path || !*path) {
+                return;
+            }
+            std::shared_ptr<const TuningProfile> profile = ReadTuningProfile(path);
+            if (profile) {
+                std::lock_guard<std::mutex> lock(g_tuningMutex);
+                g_tuningProfile = std::move(profile);
+            }
+        });
+    }
+
+    // -----------------------------------------------------------------------
+    // Clés du fichier de configuration
+    // -----------------------------------------------------------------------
+
+    enum class FieldType {
+        Bool,
+        Number,
+        Integer,
+        UpscalingMode,
+        AAQuality,
+        FrameGenMode
+    };
+
+    struct ConfigField {
+        const char* section;              // "" pour les clés générales
+        const char* key;
+        FieldType type;
+        double minValue;
+        double maxValue;
+        void (*apply)(XISConfig& config, double value);
+    };
+
+    const ConfigField kConfigFields[] = {
+        { "", "enableUpscaling", FieldType::Bool, 0, 1,
+          [](XISConfig& c, double v) { c.enableBicubicUpscaling = v != 0.0; } },
+        { "", "enableFrameGeneration", FieldType::Bool, 0, 1,
+          [](XISConfig& c, double v) { c.enableFrameGeneration = v != 0.0; } },
+        { "", "enableAntiAliasing", FieldType::Bool, 0, 1,
+          [](XISConfig& c, double v) { c.enableAntiAliasing = v != 0.0; } },
+        { "", "enableSharpness", FieldType::Bool, 0, 1,
+          [](XISConfig& c, double v) { c.enableSharpness = v != 0.0; } },
+        { "", "latencyWindowSeconds", FieldType::Number, 0.1, 3600,
+          [](XISConfig& c, double v) { c.latencyWindowSeconds = static_cast<float>(v); } },
+        { "", "stageReleaseDelaySeconds", FieldType::Number, 0, 86400,
+          [](XISConfig& c, double v) { c.stageReleaseDelaySeconds = static_cast<float>(v); } },
+
+        { "upscaling", "mode", FieldType::UpscalingMode, 0, 2,
+          [](XISConfig& c, double v) { c.upscalingParams.mode = static_cast<UpscalingMode>(static_cast<int>(v)); } },
+        { "upscaling", "sharpnessStrength", FieldType::Number, 0, 1,
+          [](XISConfig& c, double v) { c.upscalingParams.sharpnessStrength = static_cast<float>(v); } },
+        { "upscaling", "edgePreservation", FieldType::Number, 0, 1,
+          [](XISConfig& c, double v) { c.upscalingParams.edgePreservation = static_cast<float>(v); } },
+        { "upscaling", "outputWidth", FieldType::Integer, 0, 16384,
+          [](XISConfig& c, double v) { c.upscalingParams.outputWidth = static_cast<uint32_t>(v); } },
+        { "upscaling", "outputHeight", FieldType::Integer, 0, 16384,
+          [](XISConfig& c, double v) { c.upscalingParams.outputHeight = static_cast<uint32_t>(v); } },
+        { "upscaling", "preserveFilmGrain", FieldType::Bool, 0, 1,
+          [](XISConfig& c, double v) { c.upscalingParams.preserveFilmGrain = v != 0.0; } },
+
+        { "antiAliasing", "quality", FieldType::AAQuality, 0, 3,
+          [](XISConfig& c, double v) { c.aaQuality = static_cast<AAQuality>(static_cast<int>(v)); } },
+
+        { "frameGeneration", "mode", FieldType::FrameGenMode, 0, 2,
+          [](XISConfig& c, double v) { c.frameGenParams.mode = static_cast<FrameGenMode>(static_cast<int>(v)); } },
+        { "frameGeneration", "targetFrameRate", FieldType::Integer, 1, 1000,
+          [](XISConfig& c, double v) { c.frameGenParams.targetFrameRate = static_cast<uint32_t>(v); } },
+        { "frameGeneration", "motionSensitivity", FieldType::Number, 0, 1,
+          [](XISConfig& c, double v) { c.frameGenParams.motionSensitivity = static_cast<float>(v); } },
+        { "frameGeneration", "artifactReduction", FieldType::Number, 0, 1,
+          [](XISConfig& c, double v) { c.frameGenParams.artifactReduction = static_cast<float>(v); } },
+        { "frameGeneration", "sceneChangeDetection", FieldType::Bool, 0, 1,
+          [](XISConfig& c, double v) { c.frameGenParams.enableSceneChangeDetection = v != 0.0; } },
+        { "frameGeneration", "historyLength", FieldType::Integer, 2, 16,
+          [](XISConfig& c, double v) { c.frameGenParams.historyLength = static_cast<uint32_t>(v); } },
+        { "frameGeneration", "zeroCopyHistory", FieldType::Bool, 0, 1,
+          [](XISConfig& c, double v) { c.frameGenParams.zeroCopyHistory = v != 0.0; } },
+
+        { "dynamicResolution", "enabled", FieldType::Bool, 0, 1,
+          [](XISConfig& c, double v) { c.dynamicResolution.enabled = v != 0.0; } },
+        { "dynamicResolution", "frameTimeBudgetMs", FieldType::Number, 0.1, 1000,
+          [](XISConfig& c, double v) { c.dynamicResolution.frameTimeBudgetMs = static_cast<float>(v); } },
+        { "dynamicResolution", "hysteresisPercent", FieldType::Number, 0, 50,
+          [](XISConfig& c, double v) { c.dynamicResolution.hysteresisPercent = static_cast<float>(v); } },
+        { "dynamicResolution", "minInputScale", FieldType::Number, 0.1, 1,
+          [](XISConfig& c, double v) { c.dynamicResolution.minInputScale = static_cast<float>(v); } },
+        { "dynamicResolution", "maxInputScale", FieldType::Number, 0.1, 1,
+          [](XISConfig& c, double v) { c.dynamicResolution.maxInputScale = static_cast<float>(v); } },
+        { "dynamicResolution", "minSearchRadius", FieldType::Integer, 1, 256,
+          [](XISConfig& c, double v) { c.dynamicResolution.minSearchRadius = static_cast<uint32_t>(v); } },
+        { "dynamicResolution", "maxSearchRadius", FieldType::Integer, 1, 256,
+          [](XISConfig& c, double v) { c.dynamicResolution.maxSearchRadius = static_cast<uint32_t>(v); } },
+        { "dynamicResolution", "proportionalGain", FieldType::Number, 0, 10,
+          [](XISConfig& c, double v) { c.dynamicResolution.proportionalGain = static_cast<float>(v); } },
+        { "dynamicResolution", "integralGain", FieldType::Number, 0, 10,
+          [](XISConfig& c, double v) { c.dynamicResolution.integralGain = static_cast<float>(v); } },
+        { "dynamicResolution", "derivativeGain", FieldType::Number, 0, 10,
+          [](XISConfig& c, double v) { c.dynamicResolution.derivativeGain = static_cast<float>(v); } },
+    };
+
+    const size_t kConfigFieldCount = sizeof(kConfigFields) / sizeof(kConfigFields[0]);
+
+    // Noms des valeurs énumérées, dans l'ordre des énumérations
+    const char* const kUpscalingModeNames[] = { "bicubic", "sharp", "adaptive" };
+    const char* const kAAQualityNames[] = { "off", "low", "medium", "high" };
+    const char* const kFrameGenModeNames[] = { "interp", "mc", "advanced" };
+
+    std::string Trim(const std::string& text)
+    {
+        size_t begin = text.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) {
+            return std::string();
+        }
+        size_t end = text.find_last_not_of(" \t\r\n");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    bool ParseEnum(const std::string& text, const char* const* names, size_t count, double& value)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            if (text == names[i]) {
+                value = static_cast<double>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ParseValue(const ConfigField& field, const std::string& text, double& value)
+    {
+        switch (field.type) {
+            case FieldType::Bool:
+                if (text == "true" || text == "on" || text == "yes" || text == "1") {
+                    value = 1.0;
+                    return true;
+                }
+                if (text == "false" || text == "off" || text == "no" || text == "0") {
+                    value = 0.0;
+                    return true;
+                }
+                return false;
+
+            case FieldType::UpscalingMode:
+                return ParseEnum(text, kUpscalingModeNames, 3, value);
+
+            case FieldType::AAQuality:
+                return ParseEnum(text, kAAQualityNames, 4, value);
+
+            case FieldType::FrameGenMode:
+                return ParseEnum(text, kFrameGenModeNames, 3, value);
+
+            case FieldType::Integer:
+            case FieldType::Number:
+            default: {
+                char* end = nullptr;
+                value = std::strtod(text.c_str(), &end);
+                if (end == text.c_str() || *end != '\0' || value != value) {
+                    return false;
+                }
+                if (field.type == FieldType::Integer && value != static_cast<double>(static_cast<int64_t>(value))) {
+                    return false;
+                }
+                return true;
+            }
+        }
+    }
+
+    const ConfigField* FindField(const std::string& section, const std::string& key, uint16_t& index)
+    {
+        for (size_t i = 0; i < kConfigFieldCount; ++i) {
+            if (section == kConfigFields[i].section && key == kConfigFields[i].key) {
+                index = static_cast<uint16_t>(i);
+                return &kConfigFields[i];
+            }
+        }
+        return nullptr;
+    }
+
+    bool IsKnownSection(const std::string& section)
+    {
+        for (size_t i = 0; i < kConfigFieldCount; ++i) {
+            if (section == kConfigFields[i].section) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ReadTextFile(const char* path, std::string& text)
+    {
+        FILE* file = std::fopen(path, "rb");
+        if (!file) {
+            return false;
+        }
+
+        text.clear();
+        char buffer[4096];
+        size_t read;
+        while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            text.append(buffer, read);
+        }
+        bool ok = !std::ferror(file);
+        std::fclose(file);
+        return ok;
+    }
+
+    // -----------------------------------------------------------------------
+    // Versions publiées et abonnés
+    // -----------------------------------------------------------------------
+
+    std::mutex g_patchMutex;
+    std::shared_ptr<const ConfigPatch> g_configPatch;
+    uint64_t g_configVersion = 0;
+    std::string g_configText;             // Contenu de la version courante, pour ignorer les réécritures identiques
+
+    // Tenu pendant les appels aux abonnés : RemoveConfigListener attend la
+    // fin d'un appel en cours
+    std::mutex g_listenerMutex;
+    std::vector<std::pair<uint64_t, ConfigManager::ConfigListener>> g_listeners;
+    uint64_t g_nextListenerId = 1;
+
+    /**
+     * Relit le fichier et publie la nouvelle version si elle est valide et
+     * différente de la version courante
+     *
+     * @return false si le fichier est illisible ou invalide
+     */
+    bool ReloadConfigFile(const std::string& path)
+    {
+        std::string text;
+        if (!ReadTextFile(path.c_str(), text)) {
+            Logger::Error("ConfigManager: impossible de lire %s", path.c_str());
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(g_patchMutex);
+            if (g_configPatch && text == g_configText) {
+                return true;
+            }
+        }
+
+        auto patch = std::make_shared<ConfigPatch>();
+        std::string error;
+        if (!ConfigManager::ParseConfig(text, *patch, error)) {
+            Logger::Error("ConfigManager: %s rejeté, %s", path.c_str(), error.c_str());
+            return false;
+        }
+
+        uint64_t version;
+        {
+            std::lock_guard<std::mutex> lock(g_patchMutex);
+            g_configPatch = patch;
+            g_configText = std::move(text);
+            version = ++g_configVersion;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(g_listenerMutex);
+            for (const auto& listener : g_listeners) {
+                listener.second(*patch);
+            }
+        }
+
+        Logger::Info("ConfigManager: %s appliqué (version %llu, %zu réglages)", path.c_str(),
+                     static_cast<unsigned long long>(version), patch->GetSize());
+        return true;
+    }
+
+    // -----------------------------------------------------------------------
+    // Surveillance du fichier
+    // -----------------------------------------------------------------------
+
+    /**
+     * Thread de surveillance d'un fichier. Sous Linux, inotify surveille le
+     * répertoire du fichier afin de suivre aussi les remplacements par
+     * renommage (écriture atomique des éditeurs et outils de déploiement) ;
+     * ailleurs, la date et la taille du fichier sont relevées périodiquement.
+     */
+    class ConfigWatcher {
+    public:
+        ~ConfigWatcher() { Stop(); }
+
+        bool Start(const std::string& path)
+        {
+            Stop();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+#ifdef __linux__
+            size_t slash = path.find_last_of('/');
+            std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+            std::string fileName = slash == std::string::npos ? path : path.substr(slash + 1);
+
+            m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (m_inotify < 0 || pipe2(m_stopPipe, O_CLOEXEC | O_NONBLOCK) != 0 ||
+                inotify_add_watch(m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+                Logger::Error("ConfigManager: impossible de surveiller %s (errno %d)", directory.c_str(), errno);
+                CloseDescriptors();
+                return false;
+            }
+            m_thread = std::thread(&ConfigWatcher::WatchLoop, this, path, fileName);
+#else
+            m_stopping = false;
+            m_thread = std::thread(&ConfigWatcher::PollLoop, this, path);
+#endif
+            return true;
+        }
+
+        void Stop()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_thread.joinable()) {
+                return;
+            }
+#ifdef __linux__
+            char stop = 1;
+            ssize_t written = write(m_stopPipe[1], &stop, 1);
+            (void)written;
+            m_thread.join();
+            CloseDescriptors();
+#else
+            {
+                std::lock_guard<std::mutex> wakeLock(m_wakeMutex);
+                m_stopping = true;
+            }
+            m_wake.notify_all();
+            m_thread.join();
+#endif
+        }
+
+    private:
+        // Délai sans événement avant de relire le fichier (écritures en plusieurs fois)
+        static const int kSettleMs = 100;
+
+#ifdef __linux__
+        void CloseDescriptors()
+        {
+            if (m_inotify >= 0) {
+                close(m_inotify);
+            }
+            for (int& descriptor : m_stopPipe) {
+                if (descriptor >= 0) {
+                    close(descriptor);
+                }
+                descriptor = -1;
+            }
+            m_inotify = -1;
+        }
+
+        // Consomme les événements en attente ; true si l'un concerne le fichier
+        bool DrainEvents(const std::string& fileName)
+        {
+            alignas(inotify_event) char buffer[4096];
+            bool matched = false;
+            for (;;) {
+                ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+                if (length <= 0) {
+                    return matched;
+                }
+                for (ssize_t offset = 0; offset < length;) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    if (event->len > 0 && fileName == event->name) {
+                        matched = true;
+                    }
+                    offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                }
+            }
+        }
+
+        void WatchLoop(std::string path, std::string fileName)
+        {
+            pollfd descriptors[2] = {
+                { m_inotify, POLLIN, 0 },
+                { m_stopPipe[0], POLLIN, 0 }
+            };
+
+            bool changed = false;
+            for (;;) {
+                // Attente sans limite, puis délai de stabilisation après un changement
+                int ready = poll(descriptors, 2, changed ? kSettleMs : -1);
+                if (ready < 0 && errno != EINTR) {
+                    Logger::Error("ConfigManager: surveillance de %s interrompue (errno %d)", path.c_str(), errno);
+                    return;
+                }
+                if (descriptors[1].revents & POLLIN) {
+                    return;
+                }
+                if (ready > 0 && (descriptors[0].revents & POLLIN)) {
+                    changed = DrainEvents(fileName) || changed;
+                    continue;
+                }
+                if (ready == 0 && changed) {
+                    changed = false;
+                    ReloadConfigFile(path);
+                }
+            }
+        }
+
+        int m_inotify = -1;
+        int m_stopPipe[2] = { -1, -1 };
+#else
+        static bool ReadStamp(const std::string& path, long long& stamp)
+        {
+            struct stat status;
+            if (stat(path.c_str(), &status) != 0) {
+                return false;
+            }
+            stamp = static_cast<long long>(status.st_mtime) * 1000003LL + static_cast<long long>(status.st_size);
+            return true;
+        }
+
+        void PollLoop(std::string path)
+        {
+            long long lastStamp = 0;
+            ReadStamp(path, lastStamp);
+
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            while (!m_wake.wait_for(lock, std::chrono::milliseconds(500), [this] { return m_stopping; })) {
+                long long stamp = 0;
+                if (ReadStamp(path, stamp) && stamp != lastStamp) {
+                    lastStamp = stamp;
+                    lock.unlock();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(kSettleMs));
+                    ReloadConfigFile(path);
+                    lock.lock();
+                }
+            }
+        }
+
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wake;
+        bool m_stopping = false;
+#endif
+
+        std::mutex m_mutex;
+        std::thread m_thread;
+    };
+
+    // Détruit en premier à la sortie du processus (déclaré en dernier)
+    ConfigWatcher g_configWatcher;
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// ConfigPatch
+// ---------------------------------------------------------------------------
+
+bool ConfigPatch::ApplyTo(XISConfig& config) const
+{
+    XISConfig next = config;
+    for (const Assignment& assignment : m_assignments) {
+        kConfigFields[assignment.field].apply(next, assignment.value);
+    }
+
+    std::string error;
+    if (!ConfigManager::ValidateConfig(next, error)) {
+        Logger::Warning("ConfigManager: réglages ignorés pour cette session, %s", error.c_str());
+        return false;
+    }
+
+    config = next;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Profil d'autotuning
+// ---------------------------------------------------------------------------
+
+bool ConfigManager::LoadTuningProfile(const char* path)
+{
+    if (!path) {
+        return false;
+    }
+
+    std::shared_ptr<const TuningProfile> profile = ReadTuningProfile(path);
+    if (!profile) {
+        return false;
+    }
+
+    SetTuningProfile(std::move(profile));
+    return true;
+}
+
+void ConfigManager::SetTuningProfile(std::shared_ptr<const TuningProfile> profile)
+{
+    std::call_once(g_environmentOnce, [] {});
+
+    std::lock_guard<std::mutex> lock(g_tuningMutex);
+    g_tuningProfile = std::move(profile);
+}
+
+std::shared_ptr<const TuningProfile> ConfigManager::GetTuningProfile()
+{
+    LoadEnvironmentProfile();
+
+    std::lock_guard<std::mutex> lock(g_tuningMutex);
+    return g_tuningProfile;
+}
+
+// ---------------------------------------------------------------------------
+// Fichier de configuration
+// ---------------------------------------------------------------------------
+
+bool ConfigManager::ParseConfig(const std::string& text, ConfigPatch& patch, std::string& error)
+{
+    ConfigPatch parsed;
+    std::string section;
+    int lineNumber = 0;
+    size_t position = 0;
+
+    while (position < text.size()) {
+        size_t end = text.find('\n', position);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string line = Trim(text.substr(position, end - position));
+        position = end + 1;
+        ++lineNumber;
+
+        if (line.empty() || line[0] == '#' || line[0] == ';') {
+            continue;
+        }
+
+        char where[32];
+        std::snprintf(where, sizeof(where), "ligne %d : ", lineNumber);
+
+        if (line[0] == '[') {
+            if (line.back() != ']') {
+                error = std::string(where) + "section mal formée";
+                return false;
+            }
+            section = Trim(line.substr(1, line.size() - 2));
+            if (!IsKnownSection(section)) {
+                error = std::string(where) + "section inconnue [" + section + "]";
+                return false;
+            }
+            continue;
+        }
+
+        size_t separator = line.find('=');
+        if (separator == std::string::npos) {
+            error = std::string(where) + "« clé = valeur » attendu";
+            return false;
+        }
+        std::string key = Trim(line.substr(0, separator));
+        std::string value = Trim(line.substr(separator + 1));
+
+        uint16_t index = 0;
+        const ConfigField* field = FindField(section, key, index);
+        if (!field) {
+            error = std::string(where) + "clé inconnue « " + key + " »" +
+                    (section.empty() ? std::string() : " dans [" + section + "]");
+            return false;
+        }
+
+        double number = 0.0;
+        if (!ParseValue(*field, value, number)) {
+            error = std::string(where) + "valeur invalide pour " + key + " : " + value;
+            return false;
+        }
+        if (number < field->minValue || number > field->maxValue) {
+            char range[96];
+            std::snprintf(range, sizeof(range), " (attendu entre %g et %g)", field->minValue, field->maxValue);
+            error = std::string(where) + key + " hors limites" + range;
+            return false;
+        }
+
+        parsed.m_assignments.push_back({ index, number });
+    }
+
+    // Cohérence entre clés, vérifiée sur la configuration par défaut
+    XISConfig config;
+    for (const ConfigPatch::Assignment& assignment : parsed.m_assignments) {
+        kConfigFields[assignment.field].apply(config, assignment.value);
+    }
+    if (!ValidateConfig(config, error)) {
+        return false;
+    }
+
+    patch = std::move(parsed);
+    return true;
+}
+
+bool ConfigManager::LoadConfigFile(const char* path, ConfigPatch& patch)
+{
+    std::string text;
+    if (!path || !ReadTextFile(path, text)) {
+        Logger::Error("ConfigManager: impossible de lire %s", path ? path : "(null)");
+        return false;
+    }
+
+    std::string error;
+    if (!ParseConfig(text, patch, error)) {
+        Logger::Error("ConfigManager: %s invalide, %s", path, error.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ConfigManager::ValidateConfig(const XISConfig& config, std::string& error)
+{
+    for (float value : { config.upscalingParams.sharpnessStrength, config.upscalingParams.edgePreservation,
+                         config.frameGenParams.motionSensitivity, config.frameGenParams.artifactReduction }) {
+        if (!(value >= 0.0f && value <= 1.0f)) {
+            error = "les forces et sensibilités doivent être comprises entre 0 et 1";
+            return false;
+        }
+    }
+    if ((config.upscalingParams.outputWidth == 0) != (config.upscalingParams.outputHeight == 0)) {
+        error = "outputWidth et outputHeight doivent être tous deux nuls ou tous deux définis";
+        return false;
+    }
+    if (config.frameGenParams.targetFrameRate == 0) {
+        error = "targetFrameRate doit être positif";
+        return false;
+    }
+    if (config.frameGenParams.historyLength < 2 || config.frameGenParams.historyLength > 16) {
+        error = "historyLength doit être compris entre 2 et 16";
+        return false;
+    }
+    if (!(config.latencyWindowSeconds > 0.0f)) {
+        error = "latencyWindowSeconds doit être positif";
+        return false;
+    }
+    if (!(config.stageReleaseDelaySeconds >= 0.0f)) {
+        error = "stageReleaseDelaySeconds doit être positif ou nul";
+        return false;
+    }
+
+    const DynamicResolutionParameters& dynamic = config.dynamicResolution;
+    if (!(dynamic.frameTimeBudgetMs > 0.0f)) {
+        error = "frameTimeBudgetMs doit être positif";
+        return false;
+    }
+    if (!(dynamic.minInputScale >= 0.1f && dynamic.minInputScale <= dynamic.maxInputScale && dynamic.maxInputScale <= 1.0f)) {
+        error = "échelles d'entrée attendues telles que 0.1 <= minInputScale <= maxInputScale <= 1";
+        return false;
+    }
+    if (dynamic.minSearchRadius == 0 || dynamic.minSearchRadius > dynamic.maxSearchRadius) {
+        error = "rayons de recherche attendus tels que 1 <= minSearchRadius <= maxSearchRadius";
+        return false;
+    }
+    if (!(dynamic.proportionalGain >= 0.0f && dynamic.integralGain >= 0.0f && dynamic.derivativeGain >= 0.0f)) {
+        error = "les gains du régulateur doivent être positifs ou nuls";
+        return false;
+    }
+    return true;
+}
+
+bool ConfigManager::WatchConfigFile(const char* path)
+{
+    if (!path || !*path) {
+        return false;
+    }
+
+    g_configWatcher.Stop();
+    if (!ReloadConfigFile(path)) {
+        return false;
+    }
+    return g_configWatcher.Start(path);
+}
+
+void ConfigManager::StopWatchingConfigFile()
+{
+    g_configWatcher.Stop();
+}
+
+std::shared_ptr<const ConfigPatch> ConfigManager::GetConfigPatch()
+{
+    std::lock_guard<std::mutex> lock(g_patchMutex);
+    return g_configPatch;
+}
+
+uint64_t ConfigManager::GetConfigVersion()
+{
+    std::lock_guard<std::mutex> lock(g_patchMutex);
+    return g_configVersion;
+}
+
+uint64_t ConfigManager::AddConfigListener(ConfigListener listener)
+{
+    std::lock_guard<std::mutex> lock(g_listenerMutex);
+    uint64_t id = g_nextListenerId++;
+    g_listeners.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void ConfigManager::RemoveConfigListener(uint64_t id)
+{
+    std::lock_guard<std::mutex> lock(g_listenerMutex);
+    g_listeners.erase(std::remove_if(g_listeners.begin(), g_listeners.end(),
+                                     [id](const std::pair<uint64_t, ConfigListener>& listener) {
+                                         return listener.first == id;
+                                     }),
+                      g_listeners.end());
+}
+
+} // namespace XIS
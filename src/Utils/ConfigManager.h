@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Core/XISParameters.h"
+#include "TuningProfile.h"
+
+namespace XIS {
+
+/**
+ * @brief Réglages lus dans un fichier de configuration
+ *
+ * Seules les clés présentes dans le fichier sont appliquées : les réglages
+ * propres à chaque session qui n'y figurent pas (résolution de sortie
+ * choisie par l'application, chemin des shaders...) sont conservés.
+ */
+class ConfigPatch {
+public:
+    /**
+     * @brief Applique les réglages à une configuration
+     *
+     * @return false si le résultat est incohérent ; config est alors inchangée
+     */
+    bool ApplyTo(XISConfig& config) const;
+
+    size_t GetSize() const { return m_assignments.size(); }
+
+private:
+    friend class ConfigManager;
+
+    struct Assignment {
+        uint16_t field;                   // Indice dans la table des clés
+        double value;                     // Valeur numérique (booléens et énumérations compris)
+    };
+
+    std::vector<Assignment> m_assignments;
+};
+
+/**
+ * @brief Configuration du processus partagée par toutes les sessions
+ *
+ * Profil d'autotuning : au premier accès, le profil désigné par la variable
+ * d'environnement XIS_TUNING_PROFILE est chargé s'il existe ;
+ * LoadTuningProfile permet d'en charger un autre. Les sessions lisent le
+ * profil à leur initialisation : un profil chargé plus tard ne s'applique
+ * qu'aux sessions créées ensuite.
+ *
+ * Fichier de configuration : WatchConfigFile lit le fichier puis le
+ * surveille (inotify sous Linux, date de modification ailleurs). Chaque
+ * version valide est appliquée aux sessions existantes, qui la prennent en
+ * compte au début de leur frame suivante (SnapshotChannel, sans verrou sur
+ * le chemin de frame), et aux sessions créées ensuite. Une version invalide
+ * est rejetée en entier et la précédente reste en vigueur.
+ *
+ * Format : lignes « clé = valeur », regroupées en sections [upscaling],
+ * [antiAliasing], [frameGeneration] et [dynamicResolution] ; les clés
+ * générales précèdent la première section. Les lignes commençant par # ou
+ * ; sont ignorées. Une clé inconnue ou une valeur hors limites rend le
+ * fichier invalide.
+ */
+class ConfigManager {
+public:
+    // --- Profil d'autotuning ---
+
+    /**
+     * @brief Charge un profil d'autotuning
+     *
+     * @return false si le fichier est illisible ; le profil courant est alors conservé
+     */
+    static bool LoadTuningProfile(const char* path);
+
+    /**
+     * @brief Remplace le profil d'autotuning (nullptr = réglages par défaut)
+     */
+    static void SetTuningProfile(std::shared_ptr<const TuningProfile> profile);
+
+    /**
+     * @brief Profil d'autotuning courant, nullptr si aucun n'est chargé
+     */
+    static std::shared_ptr<const TuningProfile> GetTuningProfile();
+
+    // --- Fichier de configuration ---
+
+    /**
+     * @brief Analyse le contenu d'un fichier de configuration
+     *
+     * @param error Reçoit la description de la première erreur (avec son numéro de ligne)
+     * @return false si une ligne est invalide ou si le résultat appliqué à la
+     *         configuration par défaut est incohérent
+     */
+    static bool ParseConfig(const std::string& text, ConfigPatch& patch, std::string& error);
+
+    /**
+     * @brief Lit et analyse un fichier de configuration (erreurs journalisées)
+     */
+    static bool LoadConfigFile(const char* path, ConfigPatch& patch);
+
+    /**
+     * @brief Vérifie les limites et la cohérence d'une configuration
+     */
+    static bool ValidateConfig(const XISConfig& config, std::string& error);
+
+    /**
+     * @brief Lit un fichier de configuration puis le surveille
+     *
+     * Remplace le fichier surveillé précédemment, s'il y en a un.
+     *
+     * @return false si le fichier est illisible ou invalide (il n'est alors pas surveillé)
+     */
+    static bool WatchConfigFile(const char* path);
+
+    /**
+     * @brief Arrête la surveillance ; les réglages déjà appliqués sont conservés
+     */
+    static void StopWatchingConfigFile();
+
+    /**
+     * @brief Dernière version valide du fichier surveillé, nullptr si aucune
+     */
+    static std::shared_ptr<const ConfigPatch> GetConfigPatch();
+
+    /**
+     * @brief Nombre de versions du fichier appliquées depuis le démarrage
+     */
+    static uint64_t GetConfigVersion();
+
+    /**
+     * @brief Fonction appelée à chaque nouvelle version valide du fichier
+     *
+     * Appelée depuis le thread de surveillance ; elle doit se contenter de
+     * publier les réglages (Pipeline::ApplyConfigPatch).
+     */
+    using ConfigListener = std::function<void(const ConfigPatch& patch)>;
+
+    /**
+     * @brief Enregistre une fonction appelée à chaque nouvelle version
+     *
+     * @return Identifiant à passer à RemoveConfigListener
+     */
+    static uint64_t AddConfigListener(ConfigListener listener);
+
+    /**
+     * @brief Retire une fonction ; au retour, elle n'est plus et ne sera plus appelée
+     */
+    static void RemoveConfigListener(uint64_t id);
+};
+
+} // namespace XIS
@@ -0,0 +1,130 @@
+#include "FrameArena.h"
+#include "Logger.h"
+#include <algorithm>
+#include <new>
+
+namespace XIS {
+
+namespace {
+    // Blocs alignés sur une ligne de cache : un alignement demandé jusqu'à
+    // 64 donne alors les mêmes décalages dans n'importe quel bloc
+    const size_t kBlockAlignment = 64;
+
+    // Le bloc principal grandit par pages entières
+    const size_t kGrowthGranularity = 4096;
+
+    size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    void* AllocateBlock(size_t size)
+    {
+        return ::operator new(size, std::align_val_t(kBlockAlignment), std::nothrow);
+    }
+
+    void FreeBlock(void* block)
+    {
+        ::operator delete(block, std::align_val_t(kBlockAlignment));
+    }
+}
+
+/**
+ * En-tête d'un bloc de débordement, suivi des données
+ */
+struct alignas(64) FrameArena::OverflowBlock {
+    OverflowBlock* next;
+};
+
+FrameArena::FrameArena(size_t initialCapacity)
+{
+    if (initialCapacity > 0) {
+        Grow(AlignUp(initialCapacity, kGrowthGranularity));
+    }
+}
+
+FrameArena::~FrameArena()
+{
+    ReleaseOverflow();
+    if (m_block) {
+        FreeBlock(m_block);
+    }
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+    alignment = std::min(std::max<size_t>(alignment, 1), kBlockAlignment);
+
+    m_logicalOffset = AlignUp(m_logicalOffset, alignment) + size;
+    m_peak = std::max(m_peak, m_logicalOffset);
+
+    size_t offset = AlignUp(m_offset, alignment);
+    if (m_block && offset + size <= m_capacity) {
+        m_offset = offset + size;
+        return m_block + offset;
+    }
+
+    return AllocateOverflow(size, alignment);
+}
+
+void FrameArena::Rewind(const Marker& marker)
+{
+    m_offset = marker.offset;
+    m_logicalOffset = marker.logicalOffset;
+}
+
+void FrameArena::Reset()
+{
+    if (m_overflow) {
+        // Le bloc principal n'a pas suffi : il prend la taille du pic
+        ReleaseOverflow();
+        Grow(AlignUp(m_peak, kGrowthGranularity));
+    }
+
+    m_offset = 0;
+    m_logicalOffset = 0;
+}
+
+bool FrameArena::Grow(size_t capacity)
+{
+    if (m_block) {
+        FreeBlock(m_block);
+    }
+
+    m_block = static_cast<uint8_t*>(AllocateBlock(capacity));
+    m_capacity = m_block ? capacity : 0;
+    if (!m_block) {
+        Logger::Error("FrameArena: impossible d'allouer %zu octets", capacity);
+        return false;
+    }
+
+    m_heapAllocations++;
+    return true;
+}
+
+void* FrameArena::AllocateOverflow(size_t size, size_t alignment)
+{
+    (void)alignment; // Les données suivent un en-tête de kBlockAlignment octets
+
+    void* memory = AllocateBlock(sizeof(OverflowBlock) + std::max<size_t>(size, 1));
+    if (!memory) {
+        Logger::Error("FrameArena: impossible d'allouer %zu octets", size);
+        return nullptr;
+    }
+    m_heapAllocations++;
+
+    OverflowBlock* block = new (memory) OverflowBlock{ m_overflow };
+    m_overflow = block;
+    return block + 1;
+}
+
+void FrameArena::ReleaseOverflow()
+{
+    while (m_overflow) {
+        OverflowBlock* next = m_overflow->next;
+        FreeBlock(m_overflow);
+        m_overflow = next;
+    }
+}
+
+} // namespace XIS
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace XIS {
+
+/**
+ * @brief Allocateur linéaire pour les données temporaires d'une frame
+ *
+ * Allocate avance un pointeur dans un bloc préalloué ; rien n'est libéré
+ * individuellement, Reset rend toute la mémoire d'un coup à la fin de la
+ * frame. Si le bloc est épuisé, les allocations suivantes sont servies par
+ * des blocs de débordement pris sur le tas jusqu'au Reset suivant, qui les
+ * libère et agrandit le bloc principal au pic d'utilisation observé : après
+ * quelques frames, une charge stable ne fait plus aucune allocation.
+ *
+ * Un arena n'est utilisé que par un thread à la fois : un par session pour
+ * les données de la frame (XISContext::GetFrameArena), un par thread de
+ * calcul pour les tuiles de travail des kernels CPU (CPUWorkerPool).
+ */
+class alignas(64) FrameArena {
+public:
+    /**
+     * @brief Position de l'arena, pour rendre la mémoire d'une portée
+     */
+    struct Marker {
+        size_t offset;
+        size_t logicalOffset;
+    };
+
+    /**
+     * @brief Rend à la sortie d'une portée la mémoire allouée depuis son entrée
+     */
+    class Scope {
+    public:
+        explicit Scope(FrameArena& arena) : m_arena(arena), m_marker(arena.GetMarker()) {}
+        ~Scope() { m_arena.Rewind(m_marker); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameArena& m_arena;
+        Marker m_marker;
+    };
+
+    /**
+     * @param initialCapacity Taille du bloc principal (0 = fixée par le premier Reset)
+     */
+    explicit FrameArena(size_t initialCapacity = 0);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @brief Alloue size octets alignés sur alignment (puissance de deux, 64 au plus)
+     *
+     * Le contenu n'est pas initialisé. Valide jusqu'au Reset ou au Rewind
+     * qui la précède.
+     *
+     * @return nullptr seulement si le tas est épuisé
+     */
+    void* Allocate(size_t size, size_t alignment = 16);
+
+    template <typename T>
+    T* AllocateArray(size_t count)
+    {
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T) < 16 ? 16 : alignof(T)));
+    }
+
+    Marker GetMarker() const { return { m_offset, m_logicalOffset }; }
+
+    /**
+     * @brief Rend la mémoire allouée depuis marker
+     *
+     * Les blocs de débordement ne sont libérés qu'au Reset.
+     */
+    void Rewind(const Marker& marker);
+
+    /**
+     * @brief Rend toute la mémoire ; à appeler à la fin de chaque frame
+     *
+     * Seul moment où l'arena libère ou agrandit son bloc principal.
+     */
+    void Reset();
+
+    size_t GetCapacity() const { return m_capacity; }
+    size_t GetPeakUsage() const { return m_peak; }
+
+    /**
+     * @brief Allocations faites sur le tas depuis la création (bloc principal et débordements)
+     */
+    uint64_t GetHeapAllocationCount() const { return m_heapAllocations; }
+
+private:
+    struct OverflowBlock;
+
+    bool Grow(size_t capacity);
+    void* AllocateOverflow(size_t size, size_t alignment);
+    void ReleaseOverflow();
+
+    uint8_t* m_block = nullptr;
+    size_t m_capacity = 0;
+    size_t m_offset = 0;
+
+    // Occupation qu'aurait un bloc unique assez grand, débordements compris :
+    // c'est la taille visée au Reset
+    size_t m_logicalOffset = 0;
+    size_t m_peak = 0;
+
+    OverflowBlock* m_overflow = nullptr;
+    uint64_t m_heapAllocations = 0;
+};
+
+} // namespace XIS
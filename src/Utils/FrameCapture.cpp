@@ -0,0 +1,689 @@
+#include "FrameCapture.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace XIS {
+
+namespace {
+    // En-tête du fichier puis enregistrements { type, réservé, taille, contenu }
+    const char kMagic[8] = { 'X', 'I', 'S', 'C', 'A', 'P', '\0', '\1' };
+    const uint32_t kVersion = 2;
+    const size_t kHeaderSize = sizeof(kMagic) + 2 * sizeof(uint32_t);
+    const size_t kRecordHeaderSize = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+
+    enum RecordType : uint32_t {
+        kRecordConfig = 1,
+        kRecordFrame = 2,
+        kRecordEnd = 3
+    };
+
+    enum FrameEncoding : uint8_t {
+        kEncodingKey = 0,                 // Contenu brut, codage des plages nulles
+        kEncodingDelta = 1                // Différence avec la frame précédente
+    };
+
+    // Plages nulles plus courtes que ce seuil restent dans les littéraux
+    const size_t kMinZeroRun = 4;
+
+    // --- Sérialisation ---
+
+    template <typename T>
+    void Put(std::vector<uint8_t>& out, T value)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    void PutBool(std::vector<uint8_t>& out, bool value)
+    {
+        out.push_back(value ? 1 : 0);
+    }
+
+    void PutVarint(std::vector<uint8_t>& out, uint64_t value)
+    {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    /**
+     * Lecture bornée d'un contenu ; toute lecture hors limites invalide le
+     * lecteur au lieu de lire au-delà de la projection
+     */
+    class ByteReader {
+    public:
+        ByteReader(const uint8_t* data, size_t size) : m_data(data), m_size(size), m_position(0), m_valid(true) {}
+
+        template <typename T>
+        T Get()
+        {
+            T value = T();
+            if (m_position + sizeof(T) > m_size) {
+                m_valid = false;
+                return value;
+            }
+            std::memcpy(&value, m_data + m_position, sizeof(T));
+            m_position += sizeof(T);
+            return value;
+        }
+
+        bool GetBool() { return Get<uint8_t>() != 0; }
+
+        std::string GetString()
+        {
+            uint32_t length = Get<uint32_t>();
+            if (!m_valid || m_position + length > m_size) {
+                m_valid = false;
+                return std::string();
+            }
+            std::string value(reinterpret_cast<const char*>(m_data + m_position), length);
+            m_position += length;
+            return value;
+        }
+
+        const uint8_t* GetRemaining(size_t& size) const
+        {
+            size = m_size - m_position;
+            return m_data + m_position;
+        }
+
+        bool IsValid() const { return m_valid; }
+
+    private:
+        const uint8_t* m_data;
+        size_t m_size;
+        size_t m_position;
+        bool m_valid;
+    };
+
+    void SerializeConfig(const XISConfig& config, std::vector<uint8_t>& out)
+    {
+        PutBool(out, config.enableBicubicUpscaling);
+        PutBool(out, config.enableFrameGeneration);
+        PutBool(out, config.enableAntiAliasing);
+        Put<int32_t>(out, static_cast<int32_t>(config.aaQuality));
+        PutBool(out, config.enableSharpness);
+
+        const UpscalingParameters& upscaling = config.upscalingParams;
+        Put<int32_t>(out, static_cast<int32_t>(upscaling.mode));
+        Put(out, upscaling.sharpnessStrength);
+        Put(out, upscaling.edgePreservation);
+        Put(out, upscaling.outputWidth);
+        Put(out, upscaling.outputHeight);
+        PutBool(out, upscaling.preserveFilmGrain);
+
+        const FrameGenParameters& frameGen = config.frameGenParams;
+        Put<int32_t>(out, static_cast<int32_t>(frameGen.mode));
+        Put(out, frameGen.targetFrameRate);
+        Put(out, frameGen.motionSensitivity);
+        Put(out, frameGen.artifactReduction);
+        PutBool(out, frameGen.enableSceneChangeDetection);
+        Put(out, frameGen.historyLength);
+        PutBool(out, frameGen.zeroCopyHistory);
+
+        const DynamicResolutionParameters& dynamic = config.dynamicResolution;
+        PutBool(out, dynamic.enabled);
+        Put(out, dynamic.frameTimeBudgetMs);
+        Put(out, dynamic.hysteresisPercent);
+        Put(out, dynamic.minInputScale);
+        Put(out, dynamic.maxInputScale);
+        Put(out, dynamic.minSearchRadius);
+        Put(out, dynamic.maxSearchRadius);
+        Put(out, dynamic.proportionalGain);
+        Put(out, dynamic.integralGain);
+        Put(out, dynamic.derivativeGain);
+
+        PutBool(out, config.enableLogging);
+        PutBool(out, config.enablePerfMonitoring);
+        Put(out, config.latencyWindowSeconds);
+
+        const char* shaderPath = config.shaderPath ? config.shaderPath : "";
+        uint32_t length = static_cast<uint32_t>(std::strlen(shaderPath));
+        Put(out, length);
+        out.insert(out.end(), shaderPath, shaderPath + length);
+    }
+
+    bool DeserializeConfig(ByteReader& reader, XISConfig& config, std::string& shaderPath)
+    {
+        config.enableBicubicUpscaling = reader.GetBool();
+        config.enableFrameGeneration = reader.GetBool();
+        config.enableAntiAliasing = reader.GetBool();
+        config.aaQuality = static_cast<AAQuality>(reader.Get<int32_t>());
+        config.enableSharpness = reader.GetBool();
+
+        UpscalingParameters& upscaling = config.upscalingParams;
+        upscaling.mode = static_cast<UpscalingMode>(reader.Get<int32_t>());
+        upscaling.sharpnessStrength = reader.Get<float>();
+        upscaling.edgePreservation = reader.Get<float>();
+        upscaling.outputWidth = reader.Get<uint32_t>();
+        upscaling.outputHeight = reader.Get<uint32_t>();
+        upscaling.preserveFilmGrain = reader.GetBool();
+
+        FrameGenParameters& frameGen = config.frameGenParams;
+        frameGen.mode = static_cast<FrameGenMode>(reader.Get<int32_t>());
+        frameGen.targetFrameRate = reader.Get<uint32_t>();
+        frameGen.motionSensitivity = reader.Get<float>();
+        frameGen.artifactReduction = reader.Get<float>();
+        frameGen.enableSceneChangeDetection = reader.GetBool();
+        frameGen.historyLength = reader.Get<uint32_t>();
+        frameGen.zeroCopyHistory = reader.GetBool();
+
+        DynamicResolutionParameters& dynamic = config.dynamicResolution;
+        dynamic.enabled = reader.GetBool();
+        dynamic.frameTimeBudgetMs = reader.Get<float>();
+        dynamic.hysteresisPercent = reader.Get<float>();
+        dynamic.minInputScale = reader.Get<float>();
+        dynamic.maxInputScale = reader.Get<float>();
+        dynamic.minSearchRadius = reader.Get<uint32_t>();
+        dynamic.maxSearchRadius = reader.Get<uint32_t>();
+        dynamic.proportionalGain = reader.Get<float>();
+        dynamic.integralGain = reader.Get<float>();
+        dynamic.derivativeGain = reader.Get<float>();
+
+        config.enableLogging = reader.GetBool();
+        config.enablePerfMonitoring = reader.GetBool();
+        config.latencyWindowSeconds = reader.Get<float>();
+
+        shaderPath = reader.GetString();
+        config.shaderPath = shaderPath.empty() ? nullptr : shaderPath.c_str();
+        return reader.IsValid();
+    }
+
+    // --- Compression ---
+
+    inline bool IsZeroWord(const uint8_t* data)
+    {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        return word == 0;
+    }
+
+    size_t ZeroRunEnd(const uint8_t* data, size_t position, size_t size)
+    {
+        while (position + 8 <= size && IsZeroWord(data + position)) {
+            position += 8;
+        }
+        while (position < size && data[position] == 0) {
+            position++;
+        }
+        return position;
+    }
+
+    /**
+     * Alternance de plages nulles et de littéraux, chacune précédée de
+     * varint(longueur << 1 | nulle)
+     */
+    void EncodeZeroRuns(const uint8_t* data, size_t size, std::vector<uint8_t>& out)
+    {
+        size_t position = 0;
+        while (position < size) {
+            size_t runEnd = ZeroRunEnd(data, position, size);
+            if (runEnd - position >= kMinZeroRun || runEnd == size) {
+                if (runEnd > position) {
+                    PutVarint(out, (static_cast<uint64_t>(runEnd - position) << 1) | 1);
+                }
+                position = runEnd;
+                continue;
+            }
+
+            // Littéral jusqu'à la prochaine plage nulle suffisamment longue
+            size_t literalEnd = runEnd;
+            while (literalEnd < size) {
+                if (data[literalEnd] != 0) {
+                    literalEnd++;
+                    continue;
+                }
+                size_t zeroEnd = ZeroRunEnd(data, literalEnd, size);
+                if (zeroEnd - literalEnd >= kMinZeroRun || zeroEnd == size) {
+                    break;
+                }
+                literalEnd = zeroEnd;
+            }
+
+            PutVarint(out, static_cast<uint64_t>(literalEnd - position) << 1);
+            out.insert(out.end(), data + position, data + literalEnd);
+            position = literalEnd;
+        }
+    }
+
+    /**
+     * Décode dans output ; en mode accumulate, les octets décodés sont
+     * ajoutés (modulo 256) au contenu existant au lieu de le remplacer
+     */
+    bool DecodeZeroRuns(const uint8_t* data, size_t size, uint8_t* output, size_t outputSize, bool accumulate)
+    {
+        size_t in = 0;
+        size_t out = 0;
+        while (in < size) {
+            uint64_t token = 0;
+            int shift = 0;
+            for (;;) {
+                if (in >= size || shift > 63) {
+                    return false;
+                }
+                uint8_t byte = data[in++];
+                token |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    break;
+                }
+                shift += 7;
+            }
+
+            uint64_t length = token >> 1;
+            if (length > outputSize - out) {
+                return false;
+            }
+
+            if (token & 1) {
+                if (!accumulate) {
+                    std::memset(output + out, 0, static_cast<size_t>(length));
+                }
+            } else {
+                if (length > size - in) {
+                    return false;
+                }
+                if (accumulate) {
+                    for (size_t i = 0; i < length; ++i) {
+                        output[out + i] = static_cast<uint8_t>(output[out + i] + data[in + i]);
+                    }
+                } else {
+                    std::memcpy(output + out, data + in, static_cast<size_t>(length));
+                }
+                in += static_cast<size_t>(length);
+            }
+            out += static_cast<size_t>(length);
+        }
+
+        return out == outputSize;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// FrameCaptureWriter
+// ---------------------------------------------------------------------------
+
+FrameCaptureWriter::FrameCaptureWriter()
+    : m_file(nullptr),
+      m_failed(false),
+      m_frameCount(0),
+      m_framesWritten(0),
+      m_rawBytes(0),
+      m_encodedBytes(0)
+{
+}
+
+FrameCaptureWriter::~FrameCaptureWriter()
+{
+    Close();
+}
+
+bool FrameCaptureWriter::Open(const std::string& path, uint32_t frameCount)
+{
+    Close();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file) {
+        Logger::Error("FrameCapture: impossible de créer %s", path.c_str());
+        return false;
+    }
+
+    m_path = path;
+    m_failed = false;
+    m_frameCount = frameCount;
+    m_framesWritten = 0;
+    m_rawBytes = 0;
+    m_encodedBytes = 0;
+    m_previous.clear();
+
+    uint32_t header[2] = { kVersion, 0 };
+    m_failed = std::fwrite(kMagic, sizeof(kMagic), 1, m_file) != 1 ||
+               std::fwrite(header, sizeof(header), 1, m_file) != 1;
+    return !m_failed;
+}
+
+bool FrameCaptureWriter::WriteRecord(uint32_t type, const std::vector<uint8_t>& payload)
+{
+    if (!m_file || m_failed) {
+        return false;
+    }
+
+    uint32_t header[2] = { type, 0 };
+    uint64_t size = payload.size();
+    m_failed = std::fwrite(header, sizeof(header), 1, m_file) != 1 ||
+               std::fwrite(&size, sizeof(size), 1, m_file) != 1 ||
+               (size > 0 && std::fwrite(payload.data(), payload.size(), 1, m_file) != 1);
+    if (m_failed) {
+        Logger::Error("FrameCapture: échec d'écriture dans %s", m_path.c_str());
+    }
+    return !m_failed;
+}
+
+bool FrameCaptureWriter::WriteConfig(const XISConfig& config)
+{
+    m_payload.clear();
+    SerializeConfig(config, m_payload);
+    return WriteRecord(kRecordConfig, m_payload);
+}
+
+bool FrameCaptureWriter::WriteFrame(const CapturedFrame& frame)
+{
+    if (IsComplete()) {
+        return false;
+    }
+
+    m_payload.clear();
+    Put(m_payload, frame.index);
+    Put(m_payload, frame.frameDeltaTime);
+    Put(m_payload, frame.qualityFactor);
+    Put<int32_t>(m_payload, frame.shedLevel);
+
+    const XISOperatingPoint& point = frame.operatingPoint;
+    Put(m_payload, point.qualityLevel);
+    Put(m_payload, point.inputScale);
+    Put<int32_t>(m_payload, static_cast<int32_t>(point.aaQuality));
+    Put(m_payload, point.motionSearchRadius);
+    Put(m_payload, point.frameTimeBudgetMs);
+
+    Put<int32_t>(m_payload, frame.inputWidth);
+    Put<int32_t>(m_payload, frame.inputHeight);
+    Put<int32_t>(m_payload, frame.inputFormat);
+    Put<int32_t>(m_payload, frame.outputWidth);
+    Put<int32_t>(m_payload, frame.outputHeight);
+    Put<int32_t>(m_payload, frame.outputFormat);
+    Put<uint64_t>(m_payload, frame.pixelBytes);
+
+    bool keyFrame = m_previous.size() != frame.pixelBytes || m_framesWritten % kKeyFrameInterval == 0;
+    m_payload.push_back(keyFrame ? kEncodingKey : kEncodingDelta);
+    size_t headerBytes = m_payload.size();
+
+    if (keyFrame) {
+        EncodeZeroRuns(frame.pixels, frame.pixelBytes, m_payload);
+        m_previous.assign(frame.pixels, frame.pixels + frame.pixelBytes);
+    } else {
+        // Différence calculée en place dans la copie de la frame précédente,
+        // qui reçoit ensuite la frame courante
+        for (size_t i = 0; i < frame.pixelBytes; ++i) {
+            m_previous[i] = static_cast<uint8_t>(frame.pixels[i] - m_previous[i]);
+        }
+        EncodeZeroRuns(m_previous.data(), m_previous.size(), m_payload);
+        std::memcpy(m_previous.data(), frame.pixels, frame.pixelBytes);
+    }
+
+    m_rawBytes += frame.pixelBytes;
+    m_encodedBytes += m_payload.size() - headerBytes;
+
+    if (!WriteRecord(kRecordFrame, m_payload)) {
+        return false;
+    }
+    m_framesWritten++;
+    return true;
+}
+
+bool FrameCaptureWriter::Close()
+{
+    if (!m_file) {
+        return !m_failed;
+    }
+
+    std::vector<uint8_t> payload;
+    Put(payload, m_framesWritten);
+    WriteRecord(kRecordEnd, payload);
+
+    if (std::fclose(m_file) != 0) {
+        m_failed = true;
+    }
+    m_file = nullptr;
+    m_previous.clear();
+    m_previous.shrink_to_fit();
+    return !m_failed;
+}
+
+// ---------------------------------------------------------------------------
+// FrameCaptureReader
+// ---------------------------------------------------------------------------
+
+FrameCaptureReader::FrameCaptureReader()
+    : m_data(nullptr),
+      m_size(0),
+#ifdef _WIN32
+      m_fileHandle(nullptr),
+      m_mappingHandle(nullptr),
+#endif
+      m_firstRecord(0),
+      m_position(0),
+      m_nextFrame(0)
+{
+}
+
+FrameCaptureReader::~FrameCaptureReader()
+{
+    Close();
+}
+
+bool FrameCaptureReader::Open(const std::string& path)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        Logger::Error("FrameCapture: impossible d'ouvrir %s", path.c_str());
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0
+                         ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)
+                         : nullptr;
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        Logger::Error("FrameCapture: projection de %s impossible", path.c_str());
+        return false;
+    }
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        Logger::Error("FrameCapture: impossible d'ouvrir %s", path.c_str());
+        return false;
+    }
+    struct stat status;
+    void* view = fstat(file, &status) == 0 && status.st_size > 0
+                     ? mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0)
+                     : MAP_FAILED;
+    ::close(file);
+    if (view == MAP_FAILED) {
+        Logger::Error("FrameCapture: projection de %s impossible", path.c_str());
+        return false;
+    }
+    // Lecture séquentielle : lecture anticipée agressive par le noyau
+    madvise(view, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(status.st_size);
+#endif
+
+    uint32_t version = 0;
+    if (m_size < kHeaderSize || std::memcmp(m_data, kMagic, sizeof(kMagic)) != 0) {
+        Logger::Error("FrameCapture: %s n'est pas une capture XIS", path.c_str());
+        Close();
+        return false;
+    }
+    std::memcpy(&version, m_data + sizeof(kMagic), sizeof(version));
+    if (version != kVersion) {
+        Logger::Error("FrameCapture: version %u de %s non prise en charge", version, path.c_str());
+        Close();
+        return false;
+    }
+
+    // Index des frames ; la première configuration est lue immédiatement.
+    // Un fichier tronqué (capture interrompue) reste lisible jusqu'au
+    // dernier enregistrement complet.
+    m_firstRecord = kHeaderSize;
+    bool hasConfig = false;
+    size_t position = m_firstRecord;
+    while (position + kRecordHeaderSize <= m_size) {
+        uint32_t type;
+        uint64_t size;
+        std::memcpy(&type, m_data + position, sizeof(type));
+        std::memcpy(&size, m_data + position + 2 * sizeof(uint32_t), sizeof(size));
+        if (size > m_size - position - kRecordHeaderSize) {
+            Logger::Warning("FrameCapture: %s tronqué après %zu frames", path.c_str(), m_frameOffsets.size());
+            break;
+        }
+
+        if (type == kRecordConfig && !hasConfig) {
+            hasConfig = ReadConfig(m_data + position + kRecordHeaderSize, static_cast<size_t>(size));
+        } else if (type == kRecordFrame) {
+            m_frameOffsets.push_back(position);
+        } else if (type == kRecordEnd) {
+            break;
+        }
+        position += kRecordHeaderSize + static_cast<size_t>(size);
+    }
+
+    if (!hasConfig) {
+        Logger::Error("FrameCapture: %s ne contient pas de configuration", path.c_str());
+        Close();
+        return false;
+    }
+
+    Rewind();
+    return true;
+}
+
+void FrameCaptureReader::Close()
+{
+    if (m_data) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+        m_mappingHandle = nullptr;
+        m_fileHandle = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_frameOffsets.clear();
+    m_pixels.clear();
+    m_position = 0;
+    m_nextFrame = 0;
+}
+
+void FrameCaptureReader::Rewind()
+{
+    m_position = m_firstRecord;
+    m_nextFrame = 0;
+}
+
+bool FrameCaptureReader::ReadConfig(const uint8_t* payload, size_t size)
+{
+    ByteReader reader(payload, size);
+    XISConfig config;
+    std::string shaderPath;
+    if (!DeserializeConfig(reader, config, shaderPath)) {
+        return false;
+    }
+
+    m_config = config;
+    m_shaderPath = shaderPath;
+    m_config.shaderPath = m_shaderPath.empty() ? nullptr : m_shaderPath.c_str();
+    return true;
+}
+
+bool FrameCaptureReader::ReadNextFrame(CapturedFrame& frame, bool& configChanged)
+{
+    configChanged = false;
+    if (!m_data || m_nextFrame >= m_frameOffsets.size()) {
+        return false;
+    }
+
+    // Configurations placées entre la frame précédente et celle-ci
+    const size_t frameOffset = m_frameOffsets[m_nextFrame];
+    while (m_position < frameOffset) {
+        uint32_t type;
+        uint64_t size;
+        std::memcpy(&type, m_data + m_position, sizeof(type));
+        std::memcpy(&size, m_data + m_position + 2 * sizeof(uint32_t), sizeof(size));
+        if (type == kRecordConfig) {
+            if (!ReadConfig(m_data + m_position + kRecordHeaderSize, static_cast<size_t>(size))) {
+                return false;
+            }
+            configChanged = true;
+        }
+        m_position += kRecordHeaderSize + static_cast<size_t>(size);
+    }
+
+    uint64_t recordSize;
+    std::memcpy(&recordSize, m_data + frameOffset + 2 * sizeof(uint32_t), sizeof(recordSize));
+    ByteReader reader(m_data + frameOffset + kRecordHeaderSize, static_cast<size_t>(recordSize));
+
+    frame = CapturedFrame();
+    frame.index = reader.Get<uint32_t>();
+    frame.frameDeltaTime = reader.Get<float>();
+    frame.qualityFactor = reader.Get<float>();
+    frame.shedLevel = reader.Get<int32_t>();
+    frame.operatingPoint.qualityLevel = reader.Get<float>();
+    frame.operatingPoint.inputScale = reader.Get<float>();
+    frame.operatingPoint.aaQuality = static_cast<AAQuality>(reader.Get<int32_t>());
+    frame.operatingPoint.motionSearchRadius = reader.Get<uint32_t>();
+    frame.operatingPoint.frameTimeBudgetMs = reader.Get<float>();
+    frame.inputWidth = reader.Get<int32_t>();
+    frame.inputHeight = reader.Get<int32_t>();
+    frame.inputFormat = reader.Get<int32_t>();
+    frame.outputWidth = reader.Get<int32_t>();
+    frame.outputHeight = reader.Get<int32_t>();
+    frame.outputFormat = reader.Get<int32_t>();
+    uint64_t pixelBytes = reader.Get<uint64_t>();
+    uint8_t encoding = reader.Get<uint8_t>();
+    if (!reader.IsValid()) {
+        return false;
+    }
+
+    size_t encodedSize;
+    const uint8_t* encoded = reader.GetRemaining(encodedSize);
+
+    bool delta = encoding == kEncodingDelta;
+    if (delta && m_pixels.size() != pixelBytes) {
+        Logger::Error("FrameCapture: frame %u sans frame de référence", frame.index);
+        return false;
+    }
+    m_pixels.resize(static_cast<size_t>(pixelBytes));
+    if (!DecodeZeroRuns(encoded, encodedSize, m_pixels.data(), m_pixels.size(), delta)) {
+        Logger::Error("FrameCapture: frame %u corrompue", frame.index);
+        return false;
+    }
+
+    frame.pixels = m_pixels.data();
+    frame.pixelBytes = m_pixels.size();
+    m_position = frameOffset + kRecordHeaderSize + static_cast<size_t>(recordSize);
+    m_nextFrame++;
+    return true;
+}
+
+} // namespace XIS
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../Core/XISParameters.h"
+
+namespace XIS {
+
+/**
+ * @brief Frame enregistrée dans une capture
+ *
+ * Contient tout ce qui influence le traitement d'une frame en dehors de la
+ * configuration : paramètres de la frame, délestage demandé, point de
+ * fonctionnement de la résolution dynamique et contenu de la texture
+ * d'entrée. Les formats sont ceux du backend qui a enregistré la capture.
+ */
+struct CapturedFrame {
+    uint32_t index = 0;                   // Rang dans la capture
+    float frameDeltaTime = 0.0f;
+    float qualityFactor = 1.0f;
+    int shedLevel = 0;                    // ShedLevel
+    XISOperatingPoint operatingPoint;
+
+    int inputWidth = 0;
+    int inputHeight = 0;
+    int inputFormat = 0;
+    int outputWidth = 0;
+    int outputHeight = 0;
+    int outputFormat = 0;
+
+    const uint8_t* pixels = nullptr;      // Lignes de l'entrée, sans remplissage
+    size_t pixelBytes = 0;
+};
+
+/**
+ * @brief Écriture d'une capture de frames
+ *
+ * Le fichier est une suite d'enregistrements : configuration (écrite au
+ * début puis à chaque changement pris en compte par le pipeline) et frames.
+ * Le contenu de l'entrée est compressé sans perte : différence octet par
+ * octet avec la frame précédente (une frame clé toutes les kKeyFrameInterval
+ * frames ou au changement de taille), puis codage des plages nulles. Les
+ * zones immobiles de l'image ne coûtent presque rien.
+ *
+ * Utilisée par le seul thread de frame.
+ */
+class FrameCaptureWriter {
+public:
+    static const uint32_t kKeyFrameInterval = 60;
+
+    FrameCaptureWriter();
+    ~FrameCaptureWriter();
+
+    FrameCaptureWriter(const FrameCaptureWriter&) = delete;
+    FrameCaptureWriter& operator=(const FrameCaptureWriter&) = delete;
+
+    /**
+     * @brief Crée le fichier de capture
+     *
+     * @param path Chemin du fichier
+     * @param frameCount Nombre de frames à enregistrer
+     * @return true si le fichier a été créé
+     */
+    bool Open(const std::string& path, uint32_t frameCount);
+
+    /**
+     * @brief Enregistre la configuration appliquée aux frames suivantes
+     */
+    bool WriteConfig(const XISConfig& config);
+
+    /**
+     * @brief Enregistre une frame
+     */
+    bool WriteFrame(const CapturedFrame& frame);
+
+    /**
+     * @brief Termine le fichier (enregistrement de fin, fermeture)
+     *
+     * @return true si toutes les écritures ont réussi
+     */
+    bool Close();
+
+    bool IsComplete() const { return m_framesWritten >= m_frameCount; }
+    uint32_t GetFramesWritten() const { return m_framesWritten; }
+    uint64_t GetRawBytes() const { return m_rawBytes; }
+    uint64_t GetEncodedBytes() const { return m_encodedBytes; }
+    const std::string& GetPath() const { return m_path; }
+
+private:
+    bool WriteRecord(uint32_t type, const std::vector<uint8_t>& payload);
+
+    FILE* m_file;
+    std::string m_path;
+    bool m_failed;
+    uint32_t m_frameCount;
+    uint32_t m_framesWritten;
+    uint64_t m_rawBytes;
+    uint64_t m_encodedBytes;
+
+    std::vector<uint8_t> m_previous;      // Entrée de la frame précédente
+    std::vector<uint8_t> m_payload;       // Réutilisés d'une frame à l'autre
+};
+
+/**
+ * @brief Lecture d'une capture de frames
+ *
+ * Le fichier est projeté en mémoire : seules les pages des frames lues sont
+ * chargées et aucune copie du fichier n'est faite. Les frames se lisent dans
+ * l'ordre, chaque frame delta étant reconstruite à partir de la précédente.
+ */
+class FrameCaptureReader {
+public:
+    FrameCaptureReader();
+    ~FrameCaptureReader();
+
+    FrameCaptureReader(const FrameCaptureReader&) = delete;
+    FrameCaptureReader& operator=(const FrameCaptureReader&) = delete;
+
+    /**
+     * @brief Ouvre et indexe une capture
+     *
+     * @return true si le fichier est une capture valide contenant au moins
+     *         une configuration
+     */
+    bool Open(const std::string& path);
+    void Close();
+
+    size_t GetFrameCount() const { return m_frameOffsets.size(); }
+
+    /**
+     * @brief Configuration en vigueur pour la dernière frame lue (ou la
+     *        première frame si aucune n'a été lue)
+     */
+    const XISConfig& GetConfig() const { return m_config; }
+
+    /**
+     * @brief Lit la frame suivante
+     *
+     * @param frame Reçoit la frame ; frame.pixels reste valide jusqu'à la
+     *        lecture suivante
+     * @param configChanged Reçoit true si une nouvelle configuration
+     *        s'applique à partir de cette frame
+     * @return false à la fin de la capture ou si le fichier est corrompu
+     */
+    bool ReadNextFrame(CapturedFrame& frame, bool& configChanged);
+
+    /**
+     * @brief Revient à la première frame
+     */
+    void Rewind();
+
+private:
+    bool ReadConfig(const uint8_t* payload, size_t size);
+
+    const uint8_t* m_data;
+    size_t m_size;
+#ifdef _WIN32
+    void* m_fileHandle;
+    void* m_mappingHandle;
+#endif
+
+    std::vector<size_t> m_frameOffsets;   // Enregistrements de frames
+    size_t m_firstRecord;                 // Premier enregistrement après l'en-tête
+    size_t m_position;                    // Prochain enregistrement à lire
+    uint32_t m_nextFrame;
+
+    XISConfig m_config;
+    std::string m_shaderPath;             // Stockage de m_config.shaderPath
+    std::vector<uint8_t> m_pixels;        // Entrée reconstruite
+};
+
+} // namespace XIS
@@ -0,0 +1,173 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace XIS {
+
+namespace {
+    // 32 classes par puissance de deux ; les valeurs inférieures à 64 ont
+    // chacune leur classe
+    const int kSubBucketBits = 5;
+    const uint64_t kSubBucketHalf = 1ull << kSubBucketBits;      // 32
+    const uint64_t kLinearRange = kSubBucketHalf * 2;            // 64
+
+    // Borne haute : 2^34 ns, environ 17 s
+    const int kMaxValueBits = 34;
+    const uint64_t kMaxValue = (1ull << kMaxValueBits) - 1;
+
+    const int kBucketCount = static_cast<int>(kLinearRange) +
+                             (kMaxValueBits - kSubBucketBits - 1) * static_cast<int>(kSubBucketHalf);
+
+    int HighestBit(uint64_t value)
+    {
+        int bit = 0;
+        while (value >>= 1) {
+            bit++;
+        }
+        return bit;
+    }
+}
+
+LatencyHistogram::LatencyHistogram()
+    : m_buckets(kBucketCount, 0),
+      m_count(0),
+      m_sum(0),
+      m_max(0)
+{
+}
+
+int LatencyHistogram::GetBucketIndex(uint64_t value)
+{
+    if (value < kLinearRange) {
+        return static_cast<int>(value);
+    }
+
+    // Décalage tel que (value >> shift) soit dans [32, 63]
+    int shift = HighestBit(value) - kSubBucketBits;
+    return static_cast<int>(kLinearRange) + (shift - 1) * static_cast<int>(kSubBucketHalf) +
+           static_cast<int>((value >> shift) - kSubBucketHalf);
+}
+
+uint64_t LatencyHistogram::GetBucketMidpoint(int index)
+{
+    if (index < static_cast<int>(kLinearRange)) {
+        return static_cast<uint64_t>(index);
+    }
+
+    int offset = index - static_cast<int>(kLinearRange);
+    int shift = offset / static_cast<int>(kSubBucketHalf) + 1;
+    uint64_t sub = kSubBucketHalf + offset % kSubBucketHalf;
+    uint64_t lower = sub << shift;
+    return lower + ((1ull << shift) >> 1);
+}
+
+void LatencyHistogram::Record(uint64_t valueNs)
+{
+    valueNs = std::min(valueNs, kMaxValue);
+
+    m_buckets[GetBucketIndex(valueNs)]++;
+    m_count++;
+    m_sum += valueNs;
+    m_max = std::max(m_max, valueNs);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other)
+{
+    if (other.m_count == 0) {
+        return;
+    }
+
+    for (int i = 0; i < kBucketCount; i++) {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_max = std::max(m_max, other.m_max);
+}
+
+void LatencyHistogram::Reset()
+{
+    std::fill(m_buckets.begin(), m_buckets.end(), 0u);
+    m_count = 0;
+    m_sum = 0;
+    m_max = 0;
+}
+
+uint64_t LatencyHistogram::GetPercentile(double percentile) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    percentile = std::max(0.0, std::min(100.0, percentile));
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_count));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; i++) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            // Le maximum exact borne la classe la plus haute
+            return std::min(GetBucketMidpoint(i), m_max);
+        }
+    }
+
+    return m_max;
+}
+
+WindowedLatencyHistogram::WindowedLatencyHistogram(uint64_t windowNs, int sliceCount)
+    : m_sliceNs(std::max<uint64_t>(1, windowNs / std::max(1, sliceCount))),
+      m_currentSlice(0),
+      m_slices(std::max(1, sliceCount)),
+      m_sliceIds(m_slices.size(), 0)
+{
+}
+
+void WindowedLatencyHistogram::Advance(uint64_t timeNs)
+{
+    uint64_t slice = timeNs / m_sliceNs;
+    if (slice <= m_currentSlice) {
+        return;
+    }
+
+    // Vider les tranches sorties de la fenêtre
+    uint64_t elapsed = std::min<uint64_t>(slice - m_currentSlice, m_slices.size());
+    for (uint64_t i = 0; i < elapsed; i++) {
+        size_t entry = (slice - i) % m_slices.size();
+        m_slices[entry].Reset();
+        m_sliceIds[entry] = slice - i;
+    }
+    m_currentSlice = slice;
+}
+
+void WindowedLatencyHistogram::Record(uint64_t timeNs, uint64_t valueNs)
+{
+    Advance(timeNs);
+    m_slices[m_currentSlice % m_slices.size()].Record(valueNs);
+}
+
+void WindowedLatencyHistogram::Collect(uint64_t nowNs, LatencyHistogram& result) const
+{
+    // Sans nouvel échantillon, les tranches anciennes ne sont pas vidées :
+    // elles sont ignorées ici
+    uint64_t nowSlice = std::max(nowNs / m_sliceNs, m_currentSlice);
+    for (size_t i = 0; i < m_slices.size(); i++) {
+        if (m_sliceIds[i] + m_slices.size() > nowSlice) {
+            result.Merge(m_slices[i]);
+        }
+    }
+}
+
+void WindowedLatencyHistogram::Reset()
+{
+    for (LatencyHistogram& slice : m_slices) {
+        slice.Reset();
+    }
+    std::fill(m_sliceIds.begin(), m_sliceIds.end(), 0);
+
+    // Sinon le premier échantillon suivant, dans la tranche courante, irait
+    // dans une entrée marquée tranche 0 et serait ignoré par Collect
+    m_currentSlice = 0;
+}
+
+} // namespace XIS
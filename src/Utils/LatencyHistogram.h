@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace XIS {
+
+/**
+ * @brief Histogramme de latences à précision relative constante (type HDR)
+ *
+ * Les valeurs (en nanosecondes) sont rangées dans des classes log-linéaires :
+ * chaque puissance de deux est découpée en 32 classes, soit une erreur
+ * relative inférieure à 1,6 % sur les centiles, de 1 ns à environ 17 s.
+ * Le maximum et la somme sont exacts. Deux histogrammes se fusionnent par
+ * simple addition des compteurs, ce qui permet d'agréger plusieurs fenêtres
+ * ou plusieurs sessions sans perte.
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    /**
+     * @brief Enregistre une valeur
+     *
+     * @param valueNs Durée en nanosecondes (saturée à la borne haute)
+     */
+    void Record(uint64_t valueNs);
+
+    /**
+     * @brief Ajoute les échantillons d'un autre histogramme
+     */
+    void Merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Supprime tous les échantillons
+     */
+    void Reset();
+
+    /**
+     * @brief Valeur du centile demandé
+     *
+     * @param percentile Centile dans [0, 100]
+     * @return Valeur en nanosecondes (milieu de la classe), 0 si vide
+     */
+    uint64_t GetPercentile(double percentile) const;
+
+    uint64_t GetCount() const { return m_count; }
+    uint64_t GetMax() const { return m_max; }
+    double GetMean() const { return m_count ? static_cast<double>(m_sum) / m_count : 0.0; }
+
+private:
+    static int GetBucketIndex(uint64_t value);
+    static uint64_t GetBucketMidpoint(int index);
+
+    std::vector<uint32_t> m_buckets;
+    uint64_t m_count;
+    uint64_t m_sum;
+    uint64_t m_max;
+};
+
+/**
+ * @brief Histogramme de latences sur une fenêtre glissante
+ *
+ * La fenêtre est découpée en tranches de durée égale ; la tranche la plus
+ * ancienne est vidée lorsque le temps avance d'une tranche. La fenêtre
+ * couvre donc entre (n-1)/n et la totalité de la durée demandée.
+ */
+class WindowedLatencyHistogram {
+public:
+    /**
+     * @param windowNs Durée de la fenêtre en nanosecondes
+     * @param sliceCount Nombre de tranches
+     */
+    WindowedLatencyHistogram(uint64_t windowNs, int sliceCount);
+
+    /**
+     * @brief Enregistre une valeur à un instant donné
+     *
+     * @param timeNs Instant de l'échantillon (croissant d'un appel à l'autre)
+     * @param valueNs Durée en nanosecondes
+     */
+    void Record(uint64_t timeNs, uint64_t valueNs);
+
+    /**
+     * @brief Ajoute à result les échantillons de la fenêtre se terminant à nowNs
+     */
+    void Collect(uint64_t nowNs, LatencyHistogram& result) const;
+
+    void Reset();
+
+private:
+    void Advance(uint64_t timeNs);
+
+    uint64_t m_sliceNs;
+    uint64_t m_currentSlice;
+    std::vector<LatencyHistogram> m_slices;
+    std::vector<uint64_t> m_sliceIds;   // Tranche de temps couverte par chaque entrée
+};
+
+} // namespace XIS
@@ -0,0 +1,493 @@
+#include "Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+namespace XIS {
+
+namespace {
+    const size_t kRingSize = 1024;                 // Puissance de deux
+    const size_t kStringBytes = 160;               // Chaînes copiées par message
+    const size_t kCallSiteCount = 256;             // Puissance de deux
+    const size_t kMessageBytes = 1024;
+    const int64_t kRateWindowNs = 1000000000;
+    const auto kDrainInterval = std::chrono::milliseconds(5);
+
+    // Message en attente : arguments bruts, chaînes copiées à la suite
+    struct LogRecord {
+        const char* format;
+        int64_t timeNs;
+        uint64_t values[Logger::kMaxArgs];
+        Logger::ArgType types[Logger::kMaxArgs];
+        uint32_t suppressed;                       // Messages supprimés avant celui-ci
+        LogLevel level;
+        uint8_t argCount;
+        char strings[kStringBytes];
+    };
+
+    // Cellule de file bornée multi-producteurs (Vyukov) : le numéro de
+    // séquence indique si la cellule est libre ou pleine pour un tour donné
+    struct Cell {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    // Limitation de débit d'un site d'appel. Les accès concurrents sont
+    // approximatifs : au pire quelques messages de plus passent la limite.
+    struct CallSite {
+        std::atomic<const char*> format{ nullptr };
+        std::atomic<int64_t> windowStart{ 0 };
+        std::atomic<uint32_t> count{ 0 };
+        std::atomic<uint32_t> suppressed{ 0 };
+    };
+
+    int64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    const char* GetLevelName(LogLevel level)
+    {
+        switch (level) {
+        case LogLevel::Debug: return "Debug";
+        case LogLevel::Info: return "Info";
+        case LogLevel::Warning: return "Warning";
+        case LogLevel::Error: return "Error";
+        }
+        return "";
+    }
+
+    void DefaultSink(LogLevel level, const char* message)
+    {
+        (void)level;
+        std::fputs(message, stderr);
+        std::fputc('\n', stderr);
+#ifdef _WIN32
+        OutputDebugStringA(message);
+        OutputDebugStringA("\n");
+#endif
+    }
+
+    // Ajoute au message la conversion printf spec appliquée à un argument
+    void AppendConversion(char* out, size_t size, size_t& length, const char* spec, const Logger::ArgType type,
+                          uint64_t value, const char* strings)
+    {
+        if (length >= size) {
+            return;
+        }
+
+        int written = 0;
+        char* dest = out + length;
+        size_t available = size - length;
+
+        switch (type) {
+        case Logger::ArgType::Signed: {
+            int64_t signedValue;
+            std::memcpy(&signedValue, &value, sizeof(signedValue));
+            written = std::snprintf(dest, available, spec, static_cast<long long>(signedValue));
+            break;
+        }
+        case Logger::ArgType::Unsigned:
+            written = std::snprintf(dest, available, spec, static_cast<unsigned long long>(value));
+            break;
+        case Logger::ArgType::Double: {
+            double doubleValue;
+            std::memcpy(&doubleValue, &value, sizeof(doubleValue));
+            written = std::snprintf(dest, available, spec, doubleValue);
+            break;
+        }
+        case Logger::ArgType::Pointer:
+            written = std::snprintf(dest, available, spec, reinterpret_cast<const void*>(static_cast<uintptr_t>(value)));
+            break;
+        case Logger::ArgType::String:
+            written = std::snprintf(dest, available, spec, strings + value);
+            break;
+        }
+
+        if (written > 0) {
+            length = std::min(size - 1, length + static_cast<size_t>(written));
+        }
+    }
+
+    /**
+     * Formate un message à partir des arguments bruts. Chaque conversion est
+     * réécrite selon le type réellement capturé : entiers en long long,
+     * flottants en double, chaînes depuis la copie du message. Un argument
+     * manquant ou de type incompatible produit "?" au lieu d'un comportement
+     * indéfini.
+     */
+    size_t FormatRecord(const LogRecord& record, char* out, size_t size)
+    {
+        size_t length = 0;
+        int argIndex = 0;
+
+        auto append = [&](const char* text, size_t count) {
+            count = std::min(count, size - 1 - length);
+            std::memcpy(out + length, text, count);
+            length += count;
+        };
+
+        const char* p = record.format;
+        while (*p && length < size - 1) {
+            if (*p != '%') {
+                const char* next = std::strchr(p, '%');
+                size_t count = next ? static_cast<size_t>(next - p) : std::strlen(p);
+                append(p, count);
+                p += count;
+                continue;
+            }
+
+            if (p[1] == '%') {
+                append("%", 1);
+                p += 2;
+                continue;
+            }
+
+            // %[flags][width][.precision][length]conversion
+            char spec[32];
+            size_t specLength = 0;
+            spec[specLength++] = *p++;
+            while (*p && std::strchr("-+ #0", *p) && specLength < 16) {
+                spec[specLength++] = *p++;
+            }
+            while (*p && ((*p >= '0' && *p <= '9') || *p == '.' || *p == '*') && specLength < 24) {
+                // Largeur et précision dynamiques non prises en charge : ignorées
+                if (*p != '*') {
+                    spec[specLength++] = *p;
+                } else if (argIndex < record.argCount) {
+                    argIndex++;
+                }
+                p++;
+            }
+            while (*p && std::strchr("hljztL", *p)) {
+                p++;
+            }
+            if (!*p) {
+                break;
+            }
+
+            char conversion = *p++;
+            bool isInteger = std::strchr("diouxXc", conversion) != nullptr;
+            bool isFloat = std::strchr("eEfFgGaA", conversion) != nullptr;
+
+            if (argIndex >= record.argCount) {
+                append("?", 1);
+                continue;
+            }
+
+            Logger::ArgType type = record.types[argIndex];
+            uint64_t value = record.values[argIndex];
+            argIndex++;
+
+            if (isInteger && (type == Logger::ArgType::Signed || type == Logger::ArgType::Unsigned)) {
+                if (conversion != 'c') {
+                    spec[specLength++] = 'l';
+                    spec[specLength++] = 'l';
+                }
+                // Le signe suit la conversion demandée, pas le type capturé
+                bool signedConversion = conversion == 'd' || conversion == 'i';
+                type = signedConversion ? Logger::ArgType::Signed : Logger::ArgType::Unsigned;
+                if (conversion == 'c') {
+                    type = Logger::ArgType::Signed;
+                    value = static_cast<uint64_t>(static_cast<int>(value));
+                }
+            } else if (isFloat && type == Logger::ArgType::Double) {
+            } else if (conversion == 's' && type == Logger::ArgType::String) {
+            } else if (conversion == 'p' && type == Logger::ArgType::Pointer) {
+            } else {
+                append("?", 1);
+                continue;
+            }
+
+            spec[specLength++] = conversion;
+            spec[specLength] = '\0';
+
+            if (conversion == 'c') {
+                char c = static_cast<char>(value);
+                append(&c, 1);
+            } else {
+                AppendConversion(out, size, length, spec, type, value, record.strings);
+            }
+        }
+
+        out[length] = '\0';
+        return length;
+    }
+
+    class LoggerState {
+    public:
+        LoggerState()
+            : m_cells(new Cell[kRingSize]),
+              m_enqueuePos(0),
+              m_dequeuePos(0),
+              m_dropped(0),
+              m_sink(&DefaultSink),
+              m_startNs(NowNs()),
+              m_running(false),
+              m_stopping(false)
+        {
+            for (size_t i = 0; i < kRingSize; i++) {
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // Dépôt d'un message depuis n'importe quel thread, sans verrou
+        void Enqueue(LogLevel level, const char* format, const Logger::Arg* args, int argCount)
+        {
+            int64_t now = NowNs();
+            uint32_t suppressed = 0;
+            if (!Admit(format, now, suppressed)) {
+                return;
+            }
+
+            EnsureStarted();
+
+            size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &m_cells[pos & (kRingSize - 1)];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    // Anneau plein : le message est perdu, l'appelant n'attend pas
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                } else {
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            LogRecord& record = cell->record;
+            record.format = format;
+            record.timeNs = now;
+            record.level = level;
+            record.suppressed = suppressed;
+            record.argCount = static_cast<uint8_t>(argCount);
+
+            size_t stringUsed = 0;
+            for (int i = 0; i < argCount; i++) {
+                record.types[i] = args[i].type;
+                if (args[i].type == Logger::ArgType::String) {
+                    // Copie tronquée : la chaîne de l'appelant peut disparaître
+                    const char* text = args[i].s ? args[i].s : "(null)";
+                    size_t available = kStringBytes - stringUsed;
+                    size_t count = available > 0 ? std::min(std::strlen(text), available - 1) : 0;
+                    if (available > 0) {
+                        std::memcpy(record.strings + stringUsed, text, count);
+                        record.strings[stringUsed + count] = '\0';
+                        record.values[i] = stringUsed;
+                        stringUsed += count + 1;
+                    } else {
+                        record.values[i] = kStringBytes - 1;
+                    }
+                } else {
+                    std::memcpy(&record.values[i], &args[i].u, sizeof(uint64_t));
+                }
+            }
+            if (stringUsed == 0) {
+                record.strings[0] = '\0';
+            }
+            record.strings[kStringBytes - 1] = '\0';
+
+            cell->sequence.store(pos + 1, std::memory_order_release);
+
+            // Après l'arrêt du thread (sortie du processus), écriture immédiate
+            if (m_stopping.load(std::memory_order_acquire)) {
+                Drain();
+            }
+        }
+
+        // Formate et écrit tous les messages disponibles
+        void Drain()
+        {
+            std::lock_guard<std::mutex> lock(m_drainMutex);
+
+            char message[kMessageBytes];
+            for (;;) {
+                size_t pos = m_dequeuePos;
+                Cell& cell = m_cells[pos & (kRingSize - 1)];
+                if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+                    break;
+                }
+
+                const LogRecord& record = cell.record;
+                int prefix = std::snprintf(message, sizeof(message), "[XIS %10.3f] %s: ",
+                                           (record.timeNs - m_startNs) * 1e-6, GetLevelName(record.level));
+                size_t length = static_cast<size_t>(std::max(prefix, 0));
+                length += FormatRecord(record, message + length, sizeof(message) - length);
+                if (record.suppressed > 0 && length < sizeof(message)) {
+                    std::snprintf(message + length, sizeof(message) - length,
+                                  " (%u messages identiques supprimés)", record.suppressed);
+                }
+                LogLevel level = record.level;
+
+                cell.sequence.store(pos + kRingSize, std::memory_order_release);
+                m_dequeuePos = pos + 1;
+
+                m_sink.load(std::memory_order_acquire)(level, message);
+            }
+
+            uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+            if (dropped != m_reportedDropped) {
+                std::snprintf(message, sizeof(message), "[XIS] Logger: %llu messages perdus (journal saturé)",
+                              static_cast<unsigned long long>(dropped - m_reportedDropped));
+                m_reportedDropped = dropped;
+                m_sink.load(std::memory_order_acquire)(LogLevel::Warning, message);
+            }
+        }
+
+        void Stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_threadMutex);
+                if (!m_running) {
+                    return;
+                }
+                m_stopping.store(true, std::memory_order_release);
+            }
+            m_wakeup.notify_one();
+            m_thread.join();
+            Drain();
+        }
+
+        void SetSink(Logger::Sink sink)
+        {
+            m_sink.store(sink ? sink : &DefaultSink, std::memory_order_release);
+        }
+
+        uint64_t GetDroppedCount() const
+        {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        bool Admit(const char* format, int64_t now, uint32_t& suppressed)
+        {
+            uintptr_t key = reinterpret_cast<uintptr_t>(format);
+            CallSite& site = m_callSites[((key >> 4) ^ (key >> 12)) & (kCallSiteCount - 1)];
+
+            if (site.format.load(std::memory_order_relaxed) != format) {
+                // Nouveau site (ou collision) : la fenêtre repart de zéro
+                site.format.store(format, std::memory_order_relaxed);
+                site.windowStart.store(now, std::memory_order_relaxed);
+                site.count.store(0, std::memory_order_relaxed);
+                site.suppressed.store(0, std::memory_order_relaxed);
+            } else if (now - site.windowStart.load(std::memory_order_relaxed) >= kRateWindowNs) {
+                site.windowStart.store(now, std::memory_order_relaxed);
+                site.count.store(0, std::memory_order_relaxed);
+            }
+
+            if (site.count.fetch_add(1, std::memory_order_relaxed) < Logger::kMaxMessagesPerSecond) {
+                suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+                return true;
+            }
+
+            site.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        void EnsureStarted()
+        {
+            if (m_running.load(std::memory_order_acquire)) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(m_threadMutex);
+            if (m_running.load(std::memory_order_relaxed) || m_stopping.load(std::memory_order_relaxed)) {
+                return;
+            }
+            m_thread = std::thread(&LoggerState::Run, this);
+            m_running.store(true, std::memory_order_release);
+        }
+
+        // Les producteurs ne réveillent pas le thread (un appel système par
+        // message) : il vide l'anneau à intervalle régulier
+        void Run()
+        {
+            std::unique_lock<std::mutex> lock(m_threadMutex);
+            while (!m_stopping.load(std::memory_order_relaxed)) {
+                lock.unlock();
+                Drain();
+                lock.lock();
+                m_wakeup.wait_for(lock, kDrainInterval, [this]() { return m_stopping.load(std::memory_order_relaxed); });
+            }
+        }
+
+        std::unique_ptr<Cell[]> m_cells;
+        alignas(64) std::atomic<size_t> m_enqueuePos;
+        alignas(64) size_t m_dequeuePos;            // Protégé par m_drainMutex
+        uint64_t m_reportedDropped = 0;             // Protégé par m_drainMutex
+        std::atomic<uint64_t> m_dropped;
+        CallSite m_callSites[kCallSiteCount];
+        std::atomic<Logger::Sink> m_sink;
+        int64_t m_startNs;
+
+        std::mutex m_drainMutex;
+        std::mutex m_threadMutex;
+        std::condition_variable m_wakeup;
+        std::thread m_thread;
+        std::atomic<bool> m_running;
+        std::atomic<bool> m_stopping;
+    };
+
+    void StopAtExit();
+
+    // Jamais détruit : des destructeurs statiques peuvent encore journaliser.
+    // Le thread est arrêté à la sortie du processus, les messages suivants
+    // sont alors écrits par Flush.
+    LoggerState& GetState()
+    {
+        static LoggerState* state = []() {
+            LoggerState* created = new LoggerState();
+            std::atexit(&StopAtExit);
+            return created;
+        }();
+        return *state;
+    }
+
+    void StopAtExit()
+    {
+        GetState().Stop();
+    }
+}
+
+void Logger::Enqueue(LogLevel level, const char* format, const Arg* args, int argCount)
+{
+    GetState().Enqueue(level, format, args, argCount);
+}
+
+void Logger::SetSink(Sink sink)
+{
+    GetState().SetSink(sink);
+}
+
+void Logger::Flush()
+{
+    GetState().Drain();
+}
+
+uint64_t Logger::GetDroppedCount()
+{
+    return GetState().GetDroppedCount();
+}
+
+} // namespace XIS
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Seuil de compilation des messages
+ *
+ * Les appels sous le seuil sont supprimés à la compilation : ni capture des
+ * arguments ni appel de fonction. Par défaut, les messages Debug ne sont
+ * conservés que dans les builds de débogage.
+ */
+#define XIS_LOG_LEVEL_DEBUG   0
+#define XIS_LOG_LEVEL_INFO    1
+#define XIS_LOG_LEVEL_WARNING 2
+#define XIS_LOG_LEVEL_ERROR   3
+#define XIS_LOG_LEVEL_NONE    4
+
+#ifndef XIS_LOG_LEVEL
+#ifdef NDEBUG
+#define XIS_LOG_LEVEL XIS_LOG_LEVEL_INFO
+#else
+#define XIS_LOG_LEVEL XIS_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+namespace XIS {
+
+enum class LogLevel : uint8_t {
+    Debug = XIS_LOG_LEVEL_DEBUG,
+    Info = XIS_LOG_LEVEL_INFO,
+    Warning = XIS_LOG_LEVEL_WARNING,
+    Error = XIS_LOG_LEVEL_ERROR
+};
+
+/**
+ * @brief Journal asynchrone
+ *
+ * Les appels n'effectuent aucun formatage : le pointeur de format et les
+ * arguments bruts (chaînes copiées) sont déposés dans un anneau sans verrou,
+ * puis formatés et écrits par un thread dédié. Un anneau plein fait perdre
+ * le message plutôt que bloquer l'appelant.
+ *
+ * Chaque site d'appel (identifié par sa chaîne de format) est limité à
+ * kMaxMessagesPerSecond messages par seconde ; le nombre de messages
+ * supprimés est indiqué avec le message suivant du même site.
+ *
+ * Le format doit être une chaîne littérale (durée de vie statique) et suivre
+ * la syntaxe printf ; au plus kMaxArgs arguments sont acceptés.
+ */
+class Logger {
+public:
+    static const int kMaxArgs = 8;
+    static const uint32_t kMaxMessagesPerSecond = 10;
+
+    template <typename... Args>
+    static void Debug(const char* format, Args... args) { Log<LogLevel::Debug>(format, args...); }
+
+    template <typename... Args>
+    static void Info(const char* format, Args... args) { Log<LogLevel::Info>(format, args...); }
+
+    template <typename... Args>
+    static void Warning(const char* format, Args... args) { Log<LogLevel::Warning>(format, args...); }
+
+    template <typename... Args>
+    static void Error(const char* format, Args... args) { Log<LogLevel::Error>(format, args...); }
+
+    /**
+     * @brief Destination des messages formatés
+     *
+     * Appelée depuis le thread du journal. Par défaut, les messages sont
+     * écrits sur la sortie d'erreur (et le débogueur sous Windows).
+     */
+    using Sink = void (*)(LogLevel level, const char* message);
+    static void SetSink(Sink sink);
+
+    /**
+     * @brief Écrit tous les messages en attente avant de revenir
+     */
+    static void Flush();
+
+    /**
+     * @brief Nombre de messages perdus faute de place dans l'anneau
+     */
+    static uint64_t GetDroppedCount();
+
+    // Argument brut capturé à l'appel (usage interne)
+    enum class ArgType : uint8_t { Signed, Unsigned, Double, Pointer, String };
+
+    struct Arg {
+        ArgType type;
+        union {
+            int64_t i;
+            uint64_t u;
+            double d;
+            const void* p;
+            const char* s;
+        };
+    };
+
+private:
+    template <LogLevel Level, typename... Args>
+    static void Log(const char* format, Args... args)
+    {
+        if constexpr (static_cast<int>(Level) >= XIS_LOG_LEVEL) {
+            static_assert(sizeof...(Args) <= kMaxArgs, "Logger: trop d'arguments");
+            const Arg packed[sizeof...(Args) + 1] = { MakeArg(args)..., MakeArg(0) };
+            Enqueue(Level, format, packed, static_cast<int>(sizeof...(Args)));
+        }
+    }
+
+    template <typename T>
+    static Arg MakeArg(T value)
+    {
+        Arg arg;
+        if constexpr (std::is_enum<T>::value) {
+            return MakeArg(static_cast<typename std::underlying_type<T>::type>(value));
+        } else if constexpr (std::is_floating_point<T>::value) {
+            arg.type = ArgType::Double;
+            arg.d = static_cast<double>(value);
+        } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+            arg.type = ArgType::Signed;
+            arg.i = static_cast<int64_t>(value);
+        } else if constexpr (std::is_integral<T>::value) {
+            arg.type = ArgType::Unsigned;
+            arg.u = static_cast<uint64_t>(value);
+        } else if constexpr (std::is_same<typename std::decay<T>::type, const char*>::value ||
+                             std::is_same<typename std::decay<T>::type, char*>::value) {
+            arg.type = ArgType::String;
+            arg.s = value;
+        } else {
+            static_assert(std::is_pointer<T>::value, "Logger: type d'argument non pris en charge");
+            arg.type = ArgType::Pointer;
+            arg.p = static_cast<const void*>(value);
+        }
+        return arg;
+    }
+
+    static void Enqueue(LogLevel level, const char* format, const Arg* args, int argCount);
+};
+
+} // namespace XIS
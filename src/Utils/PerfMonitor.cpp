@@ -0,0 +1,924 @@
+#include "PerfMonitor.h"
+#include "TraceWriter.h"
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define XIS_PERF_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define XIS_PERF_HAS_TSC 1
+#endif
+
+namespace XIS {
+
+namespace {
+    // Capacité d'un anneau (puissance de deux) : quelques frames d'avance
+    // pour le consommateur même avec une instrumentation fine
+    const uint32_t kRingCapacity = 4096;
+
+    // Nombre de frames dont les durées d'étapes sont accumulées en parallèle
+    const uint32_t kFrameSlots = 4;
+
+    // Période de réveil du thread consommateur partagé
+    const std::chrono::milliseconds kConsumerPeriod(2);
+
+    // Profondeur d'imbrication des étapes suivie par le producteur
+    const int kMaxOpenStages = 16;
+
+    std::atomic<uint64_t> g_nextMonitorId(1);
+
+    // Nom de l'intervalle couvrant une frame dans les traces
+    const char* const kFrameSpanName = "Pipeline::Execute";
+
+    // Fenêtre glissante des histogrammes de latence
+    const float kDefaultLatencyWindowSeconds = 10.0f;
+    const int kLatencyWindowSlices = 10;
+
+    int64_t ReadNanoseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // TSC invariant (fréquence constante, synchronisé entre cœurs) :
+    // CPUID 0x80000007, EDX bit 8. Sans lui, les horodatages de deux cœurs
+    // ne sont pas comparables et le compteur dérive avec la fréquence
+    bool DetectInvariantTsc()
+    {
+#if defined(XIS_PERF_HAS_TSC) && defined(_MSC_VER)
+        int registers[4] = {};
+        __cpuid(registers, 0x80000000);
+        if (static_cast<unsigned int>(registers[0]) < 0x80000007u) {
+            return false;
+        }
+        __cpuid(registers, 0x80000007);
+        return (registers[3] & (1 << 8)) != 0;
+#elif defined(XIS_PERF_HAS_TSC)
+        if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007u) {
+            return false;
+        }
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+        return (edx & (1u << 8)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    bool UseTsc()
+    {
+        static const bool useTsc = [] {
+            bool invariant = DetectInvariantTsc();
+#if defined(XIS_PERF_HAS_TSC)
+            if (!invariant) {
+                Logger::Info("PerfMonitor: TSC non invariant, horloge système utilisée");
+            }
+#endif
+            return invariant;
+        }();
+        return useTsc;
+    }
+
+    // Lecture du compteur de cycles invariant (TSC) lorsqu'il est disponible :
+    // quelques ns, contre plusieurs dizaines pour une horloge système. Sans
+    // TSC, les ticks sont des ns de l'horloge système
+    inline uint64_t ReadTicks()
+    {
+#if defined(XIS_PERF_HAS_TSC)
+        if (UseTsc()) {
+            return __rdtsc();
+        }
+#endif
+        return static_cast<uint64_t>(ReadNanoseconds());
+    }
+
+    /**
+     * @brief Thread consommateur partagé par les moniteurs du processus
+     *
+     * Un seul réveil par période quel que soit le nombre de sessions. Le
+     * thread démarre avec le premier moniteur inscrit et s'arrête avec le
+     * dernier ; la génération distingue un thread en cours d'arrêt de son
+     * successeur.
+     */
+    class SharedConsumer {
+    public:
+        static SharedConsumer& Get()
+        {
+            // Jamais détruit : un moniteur peut survivre aux objets statiques
+            static SharedConsumer* consumer = new SharedConsumer();
+            return *consumer;
+        }
+
+        void Register(PerfMonitor* monitor)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_monitors.push_back(monitor);
+            if (m_monitors.size() == 1) {
+                m_generation++;
+                m_thread = std::thread(&SharedConsumer::Loop, this, m_generation);
+            }
+        }
+
+        // Au retour, le thread n'agrège plus ce moniteur
+        void Unregister(PerfMonitor* monitor)
+        {
+            std::thread stopped;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_monitors.erase(std::remove(m_monitors.begin(), m_monitors.end(), monitor), m_monitors.end());
+                if (m_monitors.empty()) {
+                    m_generation++;
+                    stopped = std::move(m_thread);
+                }
+            }
+
+            m_condition.notify_all();
+            if (stopped.joinable()) {
+                stopped.join();
+            }
+        }
+
+    private:
+        void Loop(uint64_t generation)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true) {
+                m_condition.wait_for(lock, kConsumerPeriod);
+                if (m_generation != generation) {
+                    return;
+                }
+
+                // Sous verrou : Unregister attend la fin de l'agrégation en cours
+                for (PerfMonitor* monitor : m_monitors) {
+                    monitor->Flush();
+                }
+            }
+        }
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::vector<PerfMonitor*> m_monitors;
+        std::thread m_thread;
+        uint64_t m_generation = 0;
+    };
+}
+
+/**
+ * @brief Anneau d'événements d'un thread producteur
+ *
+ * Un seul producteur (le thread propriétaire) et un seul consommateur (le
+ * thread d'agrégation, sous m_aggregateMutex). Les index sont séparés sur
+ * des lignes de cache distinctes pour éviter le faux partage.
+ */
+struct PerfMonitor::EventRing {
+    Event events[kRingCapacity];
+
+    alignas(64) std::atomic<uint64_t> head{0};   // Écrit par le producteur
+    uint64_t cachedTail = 0;                      // Copie locale du producteur
+
+    alignas(64) std::atomic<uint64_t> tail{0};   // Écrit par le consommateur
+    std::atomic<uint64_t> dropped{0};
+
+    // Levé par le producteur à sa sortie, après son dernier événement
+    std::atomic<bool> retired{false};
+
+    // Piste du thread dans les traces
+    uint32_t track = 0;
+
+    // Étapes ouvertes par le producteur (GetCurrentStage), propres à son thread
+    StageId openStages[kMaxOpenStages];
+    int openDepth = 0;
+
+    // Début des étapes ouvertes, propre au consommateur
+    uint64_t stageBegin[kMaxStages] = {};
+
+    bool Push(const Event& event)
+    {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - cachedTail >= kRingCapacity) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h - cachedTail >= kRingCapacity) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        events[h & (kRingCapacity - 1)] = event;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+/**
+ * @brief État du consommateur
+ */
+struct PerfMonitor::AggregateState {
+    struct PendingEvent {
+        Event event;
+        size_t ring;
+        uint64_t position;                // Position dans l'anneau
+    };
+
+    struct FrameSlot {
+        uint32_t frameId = 0;
+        uint64_t beginTicks = 0;
+        uint64_t stageTicks[kMaxStages] = {};
+        bool stageSeen[kMaxStages] = {};
+
+        // Octets transférés
+        uint64_t stageCalls[kMaxStages] = {};
+        uint64_t stageRead[kMaxStages] = {};
+        uint64_t stageWritten[kMaxStages] = {};
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+    };
+
+    // Cumuls depuis la dernière remise à zéro
+    struct BandwidthTotals {
+        uint64_t frames = 0;
+        uint64_t frameTicks = 0;
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+        uint64_t stageFrames[kMaxStages] = {};
+        uint64_t stageCalls[kMaxStages] = {};
+        uint64_t stageTicks[kMaxStages] = {};
+        uint64_t stageRead[kMaxStages] = {};
+        uint64_t stageWritten[kMaxStages] = {};
+    };
+
+    // Tampons réutilisés d'une agrégation à l'autre
+    std::vector<EventRing*> rings;
+    std::vector<PendingEvent> pending;
+
+    FrameSlot frames[kFrameSlots];
+    uint64_t lastFrameEndTicks = 0;
+    BandwidthTotals bandwidth;
+
+    // Histogrammes de latence, créés au premier échantillon de chaque étape
+    uint64_t latencyWindowNs = 0;
+    std::unique_ptr<WindowedLatencyHistogram> frameLatency;
+    std::unique_ptr<WindowedLatencyHistogram> stageLatency[kMaxStages];
+
+    WindowedLatencyHistogram& GetLatency(StageId stage)
+    {
+        std::unique_ptr<WindowedLatencyHistogram>& histogram = stage < kMaxStages ? stageLatency[stage] : frameLatency;
+        if (!histogram) {
+            histogram = std::make_unique<WindowedLatencyHistogram>(latencyWindowNs, kLatencyWindowSlices);
+        }
+        return *histogram;
+    }
+
+    // Capture de trace
+    struct Capture {
+        std::string path;
+        uint32_t firstFrame = 0;
+        uint32_t lastFrame = 0;
+        double usPerTick = 0.0;   // Fixé au premier événement : horodatages cohérents dans la trace
+        std::unique_ptr<TraceWriter> writer;
+        std::vector<bool> threads;        // Pistes ayant au moins un événement
+        std::vector<bool> frameThreads;
+    } capture;
+
+    FrameSlot& GetFrame(uint32_t frameId)
+    {
+        FrameSlot& slot = frames[frameId % kFrameSlots];
+        if (slot.frameId != frameId) {
+            slot = FrameSlot();
+            slot.frameId = frameId;
+        }
+        return slot;
+    }
+};
+
+namespace {
+    // Anneau du thread courant pour un moniteur
+    struct ThreadRingEntry {
+        uint64_t monitorId = 0;
+        std::shared_ptr<void> ring;       // Partagé avec le moniteur
+        std::atomic<bool>* retired = nullptr;
+    };
+
+    // Anneaux du thread courant, un par moniteur dans lequel il écrit : un
+    // thread de l'ordonnanceur alterne entre toutes les sessions. La
+    // recherche part du dernier anneau utilisé. À la sortie du thread, ses
+    // anneaux sont marqués retirés ; les moniteurs les libèrent une fois vidés.
+    struct ThreadRings {
+        std::vector<ThreadRingEntry> entries;
+        size_t last = 0;
+
+        ~ThreadRings()
+        {
+            for (ThreadRingEntry& entry : entries) {
+                entry.retired->store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    thread_local ThreadRings t_threadRings;
+}
+
+PerfMonitor::PerfMonitor(bool startConsumer)
+    : m_monitorId(g_nextMonitorId.fetch_add(1, std::memory_order_relaxed)),
+      m_stageCount(0),
+      m_upscalingStage(kInvalidStage),
+      m_frameGenStage(kInvalidStage),
+      m_queueWaitStage(kInvalidStage),
+      m_nextTrack(0),
+      m_retiredDroppedEvents(0),
+      m_frameId(0),
+      m_frameStartTicks(0),
+      m_calibrationTicks(ReadTicks()),
+      m_calibrationNs(ReadNanoseconds()),
+      m_aggregateState(std::make_unique<AggregateState>()),
+      m_captureActive(false),
+      m_sharedConsumer(startConsumer)
+{
+    std::memset(m_stageNames, 0, sizeof(m_stageNames));
+    std::fill(m_stageTimesMs, m_stageTimesMs + kMaxStages, 0.0f);
+
+    // Attente en file avant le traitement d'une frame (ordonnanceur)
+    m_queueWaitStage = RegisterStage("QueueWait");
+
+    SetLatencyWindow(kDefaultLatencyWindowSeconds);
+
+    if (m_sharedConsumer) {
+        SharedConsumer::Get().Register(this);
+    }
+}
+
+PerfMonitor::~PerfMonitor()
+{
+    if (m_sharedConsumer) {
+        SharedConsumer::Get().Unregister(this);
+        Aggregate();
+    }
+
+    // Les anneaux encore référencés par des threads leur survivent jusqu'à
+    // leur prochain anneau ou leur sortie ; les identifiants de moniteur ne
+    // sont jamais réutilisés
+}
+
+PerfMonitor::StageId PerfMonitor::RegisterStage(const char* stageName)
+{
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+
+    for (StageId i = 0; i < m_stageCount; i++) {
+        if (std::strncmp(m_stageNames[i], stageName, sizeof(m_stageNames[i]) - 1) == 0) {
+            return i;
+        }
+    }
+
+    if (m_stageCount >= kMaxStages) {
+        return kInvalidStage;
+    }
+
+    StageId id = m_stageCount++;
+    std::strncpy(m_stageNames[id], stageName, sizeof(m_stageNames[id]) - 1);
+
+    // Étapes reportées dans XISPerformanceStats
+    if (std::strcmp(m_stageNames[id], "Upscaling") == 0) {
+        m_upscalingStage = id;
+    } else if (std::strcmp(m_stageNames[id], "FrameGen") == 0) {
+        m_frameGenStage = id;
+    }
+
+    return id;
+}
+
+uint64_t PerfMonitor::ReadTimestamp()
+{
+    return ReadTicks();
+}
+
+void PerfMonitor::StartFrame(uint64_t queuedSince)
+{
+    uint32_t frameId = m_frameId.load(std::memory_order_relaxed) + 1;
+    m_frameId.store(frameId, std::memory_order_relaxed);
+    m_frameStartTicks = ReadTicks();
+
+    EventRing* ring = GetThreadRing();
+
+    // L'attente en file précède la frame sur la même piste
+    if (queuedSince != 0 && queuedSince < m_frameStartTicks) {
+        Event queueBegin = { queuedSince, 0, frameId, m_queueWaitStage, EventType::StageBegin };
+        Event queueEnd = { m_frameStartTicks, 0, frameId, m_queueWaitStage, EventType::StageEnd };
+        ring->Push(queueBegin);
+        ring->Push(queueEnd);
+    }
+
+    Event event = { m_frameStartTicks, 0, frameId, kInvalidStage, EventType::FrameBegin };
+    ring->Push(event);
+}
+
+float PerfMonitor::EndFrame()
+{
+    uint64_t ticks = ReadTicks();
+
+    Event event = { ticks, 0, m_frameId.load(std::memory_order_relaxed), kInvalidStage, EventType::FrameEnd };
+    GetThreadRing()->Push(event);
+
+    return static_cast<float>((ticks - m_frameStartTicks) * GetMsPerTick());
+}
+
+void PerfMonitor::Record(StageId stage, EventType type, uint64_t value)
+{
+    if (stage >= kMaxStages) {
+        return;
+    }
+
+    Event event = { ReadTicks(), value, m_frameId.load(std::memory_order_relaxed), stage, type };
+    EventRing* ring = GetThreadRing();
+    ring->Push(event);
+
+    if (type == EventType::StageBegin) {
+        if (ring->openDepth < kMaxOpenStages) {
+            ring->openStages[ring->openDepth] = stage;
+        }
+        ring->openDepth++;
+    } else if (type == EventType::StageEnd && ring->openDepth > 0) {
+        ring->openDepth--;
+    }
+}
+
+PerfMonitor::StageId PerfMonitor::GetCurrentStage()
+{
+    const EventRing* ring = GetThreadRing();
+    if (ring->openDepth == 0 || ring->openDepth > kMaxOpenStages) {
+        return kInvalidStage;
+    }
+    return ring->openStages[ring->openDepth - 1];
+}
+
+void PerfMonitor::RecordBytes(uint64_t bytesRead, uint64_t bytesWritten)
+{
+    uint64_t ticks = ReadTicks();
+    uint32_t frameId = m_frameId.load(std::memory_order_relaxed);
+    EventRing* ring = GetThreadRing();
+
+    Event readEvent = { ticks, bytesRead, frameId, kInvalidStage, EventType::BytesRead };
+    Event writeEvent = { ticks, bytesWritten, frameId, kInvalidStage, EventType::BytesWritten };
+    ring->Push(readEvent);
+    ring->Push(writeEvent);
+}
+
+PerfMonitor::EventRing* PerfMonitor::GetThreadRing()
+{
+    ThreadRings& rings = t_threadRings;
+    if (rings.last < rings.entries.size() && rings.entries[rings.last].monitorId == m_monitorId) {
+        return static_cast<EventRing*>(rings.entries[rings.last].ring.get());
+    }
+
+    for (size_t i = 0; i < rings.entries.size(); i++) {
+        if (rings.entries[i].monitorId == m_monitorId) {
+            rings.last = i;
+            return static_cast<EventRing*>(rings.entries[i].ring.get());
+        }
+    }
+
+    return CreateThreadRing();
+}
+
+PerfMonitor::EventRing* PerfMonitor::CreateThreadRing()
+{
+    // Chemin lent : premier événement de ce thread pour ce moniteur
+    auto ring = std::make_shared<EventRing>();
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        ring->track = m_nextTrack++;
+        m_rings.push_back(ring);
+    }
+
+    // Oublier les anneaux des moniteurs détruits, que seul ce thread référence encore
+    ThreadRings& rings = t_threadRings;
+    rings.entries.erase(std::remove_if(rings.entries.begin(), rings.entries.end(),
+                                       [](const ThreadRingEntry& entry) { return entry.ring.use_count() == 1; }),
+                        rings.entries.end());
+
+    ThreadRingEntry entry;
+    entry.monitorId = m_monitorId;
+    entry.ring = ring;
+    entry.retired = &ring->retired;
+    rings.entries.push_back(std::move(entry));
+    rings.last = rings.entries.size() - 1;
+
+    return ring.get();
+}
+
+double PerfMonitor::GetMsPerTick() const
+{
+#if defined(XIS_PERF_HAS_TSC)
+    if (!UseTsc()) {
+        return 1e-6;
+    }
+
+    // Étalonnage continu depuis la création du moniteur : la précision
+    // s'améliore avec le temps écoulé
+    uint64_t ticks = ReadTicks() - m_calibrationTicks;
+    int64_t ns = ReadNanoseconds() - m_calibrationNs;
+    if (ticks == 0 || ns <= 0) {
+        return 0.0;
+    }
+    return (static_cast<double>(ns) / static_cast<double>(ticks)) * 1e-6;
+#else
+    return 1e-6;
+#endif
+}
+
+void PerfMonitor::Flush()
+{
+    Aggregate();
+}
+
+void PerfMonitor::Aggregate()
+{
+    std::lock_guard<std::mutex> aggregateLock(m_aggregateMutex);
+    AggregateState& state = *m_aggregateState;
+
+    // Vider tous les anneaux. Un thread de travail termine ses étapes avant
+    // la fin de la frame : ses événements sont visibles dès que FrameEnd l'est.
+    std::vector<EventRing*>& rings = state.rings;
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        rings.clear();
+        for (auto it = m_rings.begin(); it != m_rings.end();) {
+            EventRing* ring = it->get();
+
+            // Thread producteur terminé et anneau vidé lors d'un passage
+            // précédent : plus aucun événement ne peut y arriver
+            if (ring->retired.load(std::memory_order_acquire) &&
+                ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire)) {
+                m_retiredDroppedEvents += ring->dropped.load(std::memory_order_relaxed);
+                it = m_rings.erase(it);
+                continue;
+            }
+
+            rings.push_back(ring);
+            ++it;
+        }
+    }
+
+    // Un anneau ne contient jamais plus de kRingCapacity événements : la
+    // réserve ne grandit qu'à l'apparition d'un nouveau thread producteur
+    state.pending.clear();
+    state.pending.reserve(rings.size() * kRingCapacity);
+
+    for (size_t r = 0; r < rings.size(); r++) {
+        EventRing* ring = rings[r];
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+
+        for (uint64_t i = tail; i < head; i++) {
+            state.pending.push_back({ ring->events[i & (kRingCapacity - 1)], r, i });
+        }
+
+        ring->tail.store(head, std::memory_order_release);
+    }
+
+    if (state.pending.empty()) {
+        return;
+    }
+
+    // Les compteurs TSC invariants sont synchronisés entre cœurs : l'ordre des
+    // horodatages est l'ordre réel des événements. À horodatage égal, l'ordre
+    // d'écriture est conservé (même résultat qu'un tri stable, sans le tampon
+    // temporaire que std::stable_sort alloue à chaque appel).
+    std::sort(state.pending.begin(), state.pending.end(),
+              [](const AggregateState::PendingEvent& a, const AggregateState::PendingEvent& b) {
+                  if (a.event.ticks != b.event.ticks) {
+                      return a.event.ticks < b.event.ticks;
+                  }
+                  return a.ring != b.ring ? a.ring < b.ring : a.position < b.position;
+              });
+
+    double msPerTick = GetMsPerTick();
+    double nsPerTick = msPerTick * 1e6;
+
+    for (const AggregateState::PendingEvent& pending : state.pending) {
+        const Event& event = pending.event;
+
+        EventRing* ring = rings[pending.ring];
+        if (state.capture.writer) {
+            CaptureEvent(event, ring->track);
+        }
+
+        switch (event.type) {
+            case EventType::FrameBegin:
+                state.GetFrame(event.frameId).beginTicks = event.ticks;
+                break;
+
+            case EventType::StageBegin:
+                ring->stageBegin[event.stage] = event.ticks;
+                break;
+
+            case EventType::StageEnd: {
+                uint64_t& begin = ring->stageBegin[event.stage];
+                if (begin != 0 && event.ticks >= begin) {
+                    AggregateState::FrameSlot& frame = state.GetFrame(event.frameId);
+                    frame.stageTicks[event.stage] += event.ticks - begin;
+                    frame.stageSeen[event.stage] = true;
+                    frame.stageCalls[event.stage]++;
+                }
+                begin = 0;
+                break;
+            }
+
+            case EventType::BytesRead:
+            case EventType::BytesWritten: {
+                AggregateState::FrameSlot& frame = state.GetFrame(event.frameId);
+                bool read = event.type == EventType::BytesRead;
+                (read ? frame.bytesRead : frame.bytesWritten) += event.value;
+
+                // Attribution à toutes les étapes ouvertes sur ce thread
+                for (StageId s = 0; s < kMaxStages; s++) {
+                    if (ring->stageBegin[s] != 0) {
+                        (read ? frame.stageRead[s] : frame.stageWritten[s]) += event.value;
+                    }
+                }
+                break;
+            }
+
+            case EventType::FrameEnd: {
+                AggregateState::FrameSlot& frame = state.GetFrame(event.frameId);
+
+                std::lock_guard<std::mutex> statsLock(m_statsMutex);
+
+                if (frame.beginTicks != 0) {
+                    m_stats.processingTimeMs = static_cast<float>((event.ticks - frame.beginTicks) * msPerTick);
+                    RecordLatency(event.ticks, kInvalidStage, event.ticks - frame.beginTicks, nsPerTick);
+
+                    AggregateState::BandwidthTotals& totals = state.bandwidth;
+                    totals.frames++;
+                    totals.frameTicks += event.ticks - frame.beginTicks;
+                    totals.bytesRead += frame.bytesRead;
+                    totals.bytesWritten += frame.bytesWritten;
+                    for (StageId s = 0; s < kMaxStages; s++) {
+                        if (frame.stageSeen[s]) {
+                            totals.stageFrames[s]++;
+                            totals.stageCalls[s] += frame.stageCalls[s];
+                            totals.stageTicks[s] += frame.stageTicks[s];
+                            totals.stageRead[s] += frame.stageRead[s];
+                            totals.stageWritten[s] += frame.stageWritten[s];
+                        }
+                    }
+                }
+
+                for (StageId s = 0; s < kMaxStages; s++) {
+                    m_stageTimesMs[s] = frame.stageSeen[s] ? static_cast<float>(frame.stageTicks[s] * msPerTick) : 0.0f;
+                    if (frame.stageSeen[s]) {
+                        RecordLatency(event.ticks, s, frame.stageTicks[s], nsPerTick);
+                    }
+                }
+                m_stats.upscalingTimeMs = m_upscalingStage < kMaxStages ? m_stageTimesMs[m_upscalingStage] : 0.0f;
+                m_stats.frameGenTimeMs = m_frameGenStage < kMaxStages ? m_stageTimesMs[m_frameGenStage] : 0.0f;
+
+                // FPS estimés à partir de l'intervalle entre deux fins de frame
+                if (state.lastFrameEndTicks != 0 && event.ticks > state.lastFrameEndTicks) {
+                    float intervalMs = static_cast<float>((event.ticks - state.lastFrameEndTicks) * msPerTick);
+                    m_stats.outputFps = intervalMs > 0.0f ? 1000.0f / intervalMs : 0.0f;
+                }
+                state.lastFrameEndTicks = event.ticks;
+
+                if (state.capture.writer && event.frameId == state.capture.lastFrame) {
+                    FinishCapture();
+                }
+                break;
+            }
+        }
+    }
+}
+
+uint64_t PerfMonitor::TicksToNs(uint64_t ticks, double nsPerTick) const
+{
+    return static_cast<uint64_t>(ticks * nsPerTick);
+}
+
+void PerfMonitor::RecordLatency(uint64_t ticks, StageId stage, uint64_t durationTicks, double nsPerTick)
+{
+    m_aggregateState->GetLatency(stage).Record(TicksToNs(ticks - m_calibrationTicks, nsPerTick),
+                                               TicksToNs(durationTicks, nsPerTick));
+}
+
+void PerfMonitor::SetLatencyWindow(float windowSeconds)
+{
+    std::lock_guard<std::mutex> lock(m_aggregateMutex);
+    AggregateState& state = *m_aggregateState;
+
+    state.latencyWindowNs = static_cast<uint64_t>(std::max(0.1f, windowSeconds) * 1e9);
+    state.frameLatency.reset();
+    for (auto& histogram : state.stageLatency) {
+        histogram.reset();
+    }
+}
+
+void PerfMonitor::CollectLatency(LatencySnapshot& snapshot) const
+{
+    uint64_t nowNs = TicksToNs(ReadTicks() - m_calibrationTicks, GetMsPerTick() * 1e6);
+
+    std::lock_guard<std::mutex> lock(m_aggregateMutex);
+    const AggregateState& state = *m_aggregateState;
+
+    snapshot.windowSeconds = static_cast<float>(state.latencyWindowNs * 1e-9);
+    snapshot.frame.Reset();
+    snapshot.stages.clear();
+
+    if (state.frameLatency) {
+        state.frameLatency->Collect(nowNs, snapshot.frame);
+    }
+
+    for (StageId s = 0; s < kMaxStages; s++) {
+        if (!state.stageLatency[s]) {
+            continue;
+        }
+
+        LatencyHistogram histogram;
+        state.stageLatency[s]->Collect(nowNs, histogram);
+        if (histogram.GetCount() > 0) {
+            snapshot.stages.emplace_back(m_stageNames[s], std::move(histogram));
+        }
+    }
+}
+
+void PerfMonitor::ResetLatency()
+{
+    std::lock_guard<std::mutex> lock(m_aggregateMutex);
+    AggregateState& state = *m_aggregateState;
+
+    if (state.frameLatency) {
+        state.frameLatency->Reset();
+    }
+    for (auto& histogram : state.stageLatency) {
+        if (histogram) {
+            histogram->Reset();
+        }
+    }
+}
+
+void PerfMonitor::CollectBandwidth(BandwidthSnapshot& snapshot) const
+{
+    double msPerTick = GetMsPerTick();
+
+    std::lock_guard<std::mutex> lock(m_aggregateMutex);
+    const AggregateState::BandwidthTotals& totals = m_aggregateState->bandwidth;
+
+    snapshot = BandwidthSnapshot();
+    snapshot.frames = totals.frames;
+    snapshot.frameTimeMs = totals.frameTicks * msPerTick;
+    snapshot.bytesRead = totals.bytesRead;
+    snapshot.bytesWritten = totals.bytesWritten;
+
+    for (StageId s = 0; s < kMaxStages; s++) {
+        if (totals.stageRead[s] == 0 && totals.stageWritten[s] == 0) {
+            continue;
+        }
+
+        BandwidthSnapshot::Stage stage;
+        stage.name = m_stageNames[s];
+        stage.frames = totals.stageFrames[s];
+        stage.calls = totals.stageCalls[s];
+        stage.timeMs = totals.stageTicks[s] * msPerTick;
+        stage.bytesRead = totals.stageRead[s];
+        stage.bytesWritten = totals.stageWritten[s];
+        snapshot.stages.push_back(std::move(stage));
+    }
+}
+
+void PerfMonitor::ResetBandwidth()
+{
+    std::lock_guard<std::mutex> lock(m_aggregateMutex);
+    m_aggregateState->bandwidth = AggregateState::BandwidthTotals();
+}
+
+void PerfMonitor::CaptureEvent(const Event& event, uint32_t track)
+{
+    AggregateState::Capture& capture = m_aggregateState->capture;
+
+    // Comparaison modulo 2^32 : les identifiants de frame peuvent reboucler
+    if (event.frameId - capture.firstFrame > capture.lastFrame - capture.firstFrame) {
+        return;
+    }
+
+    if (capture.usPerTick == 0.0) {
+        capture.usPerTick = GetMsPerTick() * 1000.0;
+    }
+
+    uint32_t threadId = track;
+    double timestampUs = (event.ticks - m_calibrationTicks) * capture.usPerTick;
+
+    if (capture.threads.size() <= track) {
+        capture.threads.resize(track + 1, false);
+        capture.frameThreads.resize(track + 1, false);
+    }
+    capture.threads[track] = true;
+
+    switch (event.type) {
+        case EventType::FrameBegin:
+            capture.frameThreads[track] = true;
+            capture.writer->AddBegin(kFrameSpanName, timestampUs, threadId, event.frameId);
+            break;
+
+        case EventType::FrameEnd:
+            capture.writer->AddEnd(kFrameSpanName, timestampUs, threadId, event.frameId);
+            break;
+
+        case EventType::StageBegin:
+            capture.writer->AddBegin(m_stageNames[event.stage], timestampUs, threadId, event.frameId);
+            break;
+
+        case EventType::StageEnd:
+            capture.writer->AddEnd(m_stageNames[event.stage], timestampUs, threadId, event.frameId);
+            break;
+
+        case EventType::BytesRead:
+        case EventType::BytesWritten:
+            break;
+    }
+}
+
+void PerfMonitor::FinishCapture()
+{
+    AggregateState::Capture& capture = m_aggregateState->capture;
+
+    // Une piste par thread instrumenté présent dans la trace
+    for (size_t track = 0; track < capture.threads.size(); track++) {
+        if (capture.threads[track]) {
+            capture.writer->SetThreadName(static_cast<uint32_t>(track),
+                                          (capture.frameThreads[track] ? "XIS frame thread " : "XIS worker ") +
+                                              std::to_string(track));
+        }
+    }
+
+    if (capture.writer->WriteJson(capture.path)) {
+        Logger::Info("PerfMonitor: trace de %u frames écrite dans %s%s",
+                     capture.lastFrame - capture.firstFrame + 1, capture.path.c_str(),
+                     capture.writer->IsTruncated() ? " (tronquée)" : "");
+    } else {
+        Logger::Error("PerfMonitor: échec de l'écriture de la trace %s", capture.path.c_str());
+    }
+
+    capture.writer.reset();
+    capture.threads.clear();
+    capture.frameThreads.clear();
+    m_captureActive.store(false, std::memory_order_release);
+}
+
+bool PerfMonitor::StartTraceCapture(const char* outputPath, uint32_t frameCount)
+{
+    if (!outputPath || frameCount == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_aggregateMutex);
+
+    if (m_captureActive.load(std::memory_order_acquire)) {
+        Logger::Warning("PerfMonitor: une capture de trace est déjà en cours");
+        return false;
+    }
+
+    AggregateState::Capture& capture = m_aggregateState->capture;
+    capture.path = outputPath;
+    capture.firstFrame = m_frameId.load(std::memory_order_relaxed) + 1;
+    capture.lastFrame = capture.firstFrame + std::min(frameCount, kMaxTraceFrames) - 1;
+    capture.usPerTick = 0.0;
+    capture.writer = std::make_unique<TraceWriter>(kMaxTraceEvents);
+    capture.threads.clear();
+    capture.frameThreads.clear();
+
+    m_captureActive.store(true, std::memory_order_release);
+    return true;
+}
+
+float PerfMonitor::GetStageTimeMs(StageId stage) const
+{
+    if (stage >= kMaxStages) {
+        return 0.0f;
+    }
+
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_stageTimesMs[stage];
+}
+
+XISPerformanceStats PerfMonitor::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_stats;
+}
+
+uint64_t PerfMonitor::GetDroppedEventCount() const
+{
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+
+    uint64_t dropped = m_retiredDroppedEvents;
+    for (const auto& ring : m_rings) {
+        dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+} // namespace XIS
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../Core/XISParameters.h"
+#include "LatencyHistogram.h"
+
+namespace XIS {
+
+/**
+ * @brief Mesure des temps de traitement du pipeline
+ *
+ * Chaque pipeline possède son propre moniteur : les statistiques d'une
+ * session ne sont jamais mélangées avec celles d'une autre.
+ *
+ * Les étapes sont enregistrées une fois à l'initialisation et désignées
+ * ensuite par un identifiant entier. Chaque thread instrumenté écrit des
+ * événements horodatés dans son propre anneau sans verrou (un producteur,
+ * un consommateur) ; un thread consommateur, partagé par tous les moniteurs
+ * du processus, les agrège hors du chemin de frame. L'anneau d'un thread
+ * terminé est libéré une fois vidé. Le coût d'un événement se limite à une
+ * lecture du compteur de cycles (TSC s'il est invariant, horloge système
+ * sinon) et une écriture dans l'anneau, ce qui permet de laisser
+ * l'instrumentation active en production.
+ */
+class PerfMonitor {
+public:
+    using StageId = uint16_t;
+
+    // Nombre maximal d'étapes enregistrables
+    static constexpr StageId kMaxStages = 32;
+    static constexpr StageId kInvalidStage = 0xFFFF;
+
+    /**
+     * @brief Constructeur
+     *
+     * @param startConsumer True pour confier l'agrégation au thread consommateur
+     *        partagé ; sinon elle n'a lieu que lors des appels explicites à Flush
+     */
+    explicit PerfMonitor(bool startConsumer = true);
+    ~PerfMonitor();
+
+    PerfMonitor(const PerfMonitor&) = delete;
+    PerfMonitor& operator=(const PerfMonitor&) = delete;
+
+    /**
+     * @brief Enregistre une étape et retourne son identifiant
+     *
+     * À appeler à l'initialisation : enregistrer deux fois le même nom
+     * retourne le même identifiant.
+     *
+     * @param stageName Nom de l'étape (copié)
+     * @return Identifiant de l'étape, kInvalidStage si la table est pleine
+     */
+    StageId RegisterStage(const char* stageName);
+
+    /**
+     * @brief Lit l'horloge utilisée pour horodater les événements
+     *
+     * Permet de transmettre un instant (ex: la soumission d'une frame à
+     * l'ordonnanceur) à StartFrame.
+     */
+    static uint64_t ReadTimestamp();
+
+    /**
+     * @brief Marque le début du traitement d'une frame
+     *
+     * Doit être appelé depuis le thread de frame.
+     *
+     * @param queuedSince Instant (ReadTimestamp) de mise en file de la frame,
+     *        0 si elle n'est pas passée par une file d'attente
+     */
+    void StartFrame(uint64_t queuedSince = 0);
+
+    /**
+     * @brief Marque la fin du traitement d'une frame
+     *
+     * Doit être appelé depuis le thread de frame. Les statistiques agrégées
+     * sont mises à jour de manière asynchrone par le thread consommateur.
+     *
+     * @return Durée de la frame en ms, mesurée directement par le thread de frame
+     */
+    float EndFrame();
+
+    /**
+     * @brief Marque le début d'une étape
+     *
+     * Peut être appelé depuis n'importe quel thread.
+     */
+    void StartStage(StageId stage) { Record(stage, EventType::StageBegin); }
+
+    /**
+     * @brief Marque la fin d'une étape
+     *
+     * Peut être appelé depuis n'importe quel thread.
+     */
+    void EndStage(StageId stage) { Record(stage, EventType::StageEnd); }
+
+    /**
+     * @brief Étape ouverte la plus interne sur le thread appelant
+     *
+     * Permet à un renderer qui diffère ses appels de les rattacher, lors de
+     * leur exécution, à l'étape qui les a émis.
+     *
+     * @return L'étape, kInvalidStage si aucune n'est ouverte sur ce thread
+     */
+    StageId GetCurrentStage();
+
+    /**
+     * @brief Comptabilise des octets lus et écrits
+     *
+     * Les octets sont attribués à toutes les étapes ouvertes sur le thread
+     * appelant (ex: le dispatch et l'étape qui le contient) et à la frame.
+     */
+    void RecordBytes(uint64_t bytesRead, uint64_t bytesWritten);
+
+    /**
+     * @brief Agrège immédiatement les événements en attente
+     *
+     * Utilisé à l'arrêt et lorsque le thread consommateur n'est pas démarré.
+     */
+    void Flush();
+
+    /**
+     * @brief Obtient le temps de la dernière exécution agrégée d'une étape
+     *
+     * @return Temps en ms, 0 si l'étape n'a pas été exécutée
+     */
+    float GetStageTimeMs(StageId stage) const;
+
+    /**
+     * @brief Obtient les statistiques de la dernière frame agrégée
+     */
+    XISPerformanceStats GetStats() const;
+
+    /**
+     * @brief Nombre d'événements perdus parce qu'un anneau était plein
+     */
+    uint64_t GetDroppedEventCount() const;
+
+    /**
+     * @brief Démarre la capture d'une trace Chrome/Perfetto
+     *
+     * La capture commence à la frame suivante et couvre frameCount frames ;
+     * le fichier est écrit par le thread consommateur à la fin de la
+     * dernière frame capturée.
+     *
+     * @param outputPath Fichier JSON de sortie
+     * @param frameCount Nombre de frames à capturer (borné à kMaxTraceFrames)
+     * @return true si la capture a démarré, false si une capture est déjà en cours
+     */
+    bool StartTraceCapture(const char* outputPath, uint32_t frameCount);
+
+    /**
+     * @brief Indique si une capture de trace est en cours
+     */
+    bool IsTraceCaptureActive() const { return m_captureActive.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Histogrammes de latence sur la fenêtre glissante
+     */
+    struct LatencySnapshot {
+        float windowSeconds = 0.0f;
+        LatencyHistogram frame;                                        // Durée totale des frames
+        std::vector<std::pair<std::string, LatencyHistogram>> stages;  // Durée cumulée par frame, par étape
+    };
+
+    /**
+     * @brief Configure la fenêtre glissante des histogrammes de latence
+     *
+     * Vide les histogrammes existants.
+     *
+     * @param windowSeconds Durée de la fenêtre en secondes
+     */
+    void SetLatencyWindow(float windowSeconds);
+
+    /**
+     * @brief Copie les histogrammes de latence de la fenêtre courante
+     *
+     * Seules les étapes ayant au moins un échantillon sont retournées.
+     */
+    void CollectLatency(LatencySnapshot& snapshot) const;
+
+    /**
+     * @brief Vide les histogrammes de latence
+     */
+    void ResetLatency();
+
+    /**
+     * @brief Octets et temps cumulés depuis la dernière remise à zéro
+     */
+    struct BandwidthSnapshot {
+        struct Stage {
+            std::string name;
+            uint64_t frames = 0;          // Frames où l'étape a été exécutée
+            uint64_t calls = 0;           // Nombre d'exécutions de l'étape
+            double timeMs = 0.0;          // Temps cumulé
+            uint64_t bytesRead = 0;
+            uint64_t bytesWritten = 0;
+        };
+
+        uint64_t frames = 0;
+        double frameTimeMs = 0.0;
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+        std::vector<Stage> stages;        // Étapes ayant transféré au moins un octet
+    };
+
+    void CollectBandwidth(BandwidthSnapshot& snapshot) const;
+    void ResetBandwidth();
+
+    // Nombre maximal de frames et d'événements d'une capture
+    static constexpr uint32_t kMaxTraceFrames = 1000;
+    static constexpr size_t kMaxTraceEvents = 4 * 1024 * 1024;
+
+private:
+    enum class EventType : uint8_t {
+        FrameBegin,
+        FrameEnd,
+        StageBegin,
+        StageEnd,
+        BytesRead,
+        BytesWritten
+    };
+
+    struct Event {
+        uint64_t ticks;
+        uint64_t value;     // Octets pour BytesRead/BytesWritten
+        uint32_t frameId;
+        StageId stage;
+        EventType type;
+    };
+
+    struct EventRing;
+    struct AggregateState;
+
+    void Record(StageId stage, EventType type, uint64_t value = 0);
+    EventRing* GetThreadRing();
+    EventRing* CreateThreadRing();
+    void Aggregate();
+    void CaptureEvent(const Event& event, uint32_t track);
+    void RecordLatency(uint64_t ticks, StageId stage, uint64_t durationTicks, double nsPerTick);
+    uint64_t TicksToNs(uint64_t ticks, double nsPerTick) const;
+    void FinishCapture();
+    double GetMsPerTick() const;
+
+    // Identifiant unique du moniteur, utilisé par le cache d'anneaux des threads
+    const uint64_t m_monitorId;
+
+    // Table des étapes, écrite uniquement à l'enregistrement
+    std::mutex m_registryMutex;
+    char m_stageNames[kMaxStages][32];
+    StageId m_stageCount;
+    StageId m_upscalingStage;
+    StageId m_frameGenStage;
+    StageId m_queueWaitStage;
+
+    // Anneaux des threads producteurs, partagés avec leur thread jusqu'à sa
+    // sortie ; chacun a sa piste dans les traces
+    mutable std::mutex m_ringsMutex;
+    std::vector<std::shared_ptr<EventRing>> m_rings;
+    uint32_t m_nextTrack;
+    uint64_t m_retiredDroppedEvents;      // Événements perdus des anneaux libérés
+
+    // Frame courante (écrite par le thread de frame)
+    std::atomic<uint32_t> m_frameId;
+    uint64_t m_frameStartTicks;
+
+    // Étalonnage compteur de cycles -> temps
+    uint64_t m_calibrationTicks;
+    int64_t m_calibrationNs;
+
+    // État du consommateur, propre au thread d'agrégation
+    mutable std::mutex m_aggregateMutex;
+    std::unique_ptr<AggregateState> m_aggregateState;
+
+    // Capture de trace en cours (état détaillé dans AggregateState)
+    std::atomic<bool> m_captureActive;
+
+    // Statistiques publiées
+    mutable std::mutex m_statsMutex;
+    XISPerformanceStats m_stats;
+    float m_stageTimesMs[kMaxStages];
+
+    // Agrégation confiée au thread consommateur partagé
+    bool m_sharedConsumer;
+};
+
+} // namespace XIS
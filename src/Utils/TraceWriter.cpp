@@ -0,0 +1,89 @@
+#include "TraceWriter.h"
+#include <cstdio>
+
+namespace XIS {
+
+namespace {
+    // Les noms d'étapes et de threads sont des identifiants internes ; seuls
+    // les caractères qui cassent une chaîne JSON sont échappés
+    void WriteJsonString(FILE* file, const char* text)
+    {
+        std::fputc('"', file);
+        for (const char* c = text; *c; c++) {
+            if (*c == '"' || *c == '\\') {
+                std::fputc('\\', file);
+            }
+            if (static_cast<unsigned char>(*c) >= 0x20) {
+                std::fputc(*c, file);
+            }
+        }
+        std::fputc('"', file);
+    }
+}
+
+TraceWriter::TraceWriter(size_t maxEvents)
+    : m_maxEvents(maxEvents),
+      m_truncated(false)
+{
+    m_events.reserve(maxEvents < 65536 ? maxEvents : 65536);
+}
+
+void TraceWriter::AddBegin(const char* name, double timestampUs, uint32_t threadId, uint32_t frameId)
+{
+    Add(name, 'B', timestampUs, threadId, frameId);
+}
+
+void TraceWriter::AddEnd(const char* name, double timestampUs, uint32_t threadId, uint32_t frameId)
+{
+    Add(name, 'E', timestampUs, threadId, frameId);
+}
+
+void TraceWriter::Add(const char* name, char phase, double timestampUs, uint32_t threadId, uint32_t frameId)
+{
+    if (m_events.size() >= m_maxEvents) {
+        m_truncated = true;
+        return;
+    }
+
+    m_events.push_back({ name, timestampUs, threadId, frameId, phase });
+}
+
+void TraceWriter::SetThreadName(uint32_t threadId, const std::string& name)
+{
+    m_threadNames[threadId] = name;
+}
+
+bool TraceWriter::WriteJson(const std::string& path) const
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    std::fputs("{\"traceEvents\":[\n", file);
+
+    bool first = true;
+    for (const auto& thread : m_threadNames) {
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                     first ? "" : ",\n", thread.first);
+        WriteJsonString(file, thread.second.c_str());
+        std::fputs("}}", file);
+        first = false;
+    }
+
+    for (const TraceEvent& event : m_events) {
+        std::fprintf(file, "%s{\"name\":", first ? "" : ",\n");
+        WriteJsonString(file, event.name);
+        std::fprintf(file, ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"frame\":%u}}",
+                     event.phase, event.timestampUs, event.threadId, event.frameId);
+        first = false;
+    }
+
+    std::fprintf(file, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"truncated\":%s}}\n",
+                 m_truncated ? "true" : "false");
+
+    bool success = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && success;
+}
+
+} // namespace XIS
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace XIS {
+
+/**
+ * @brief Écriture d'une trace au format Chrome Trace Event (JSON)
+ *
+ * Le fichier produit s'ouvre dans chrome://tracing et dans Perfetto
+ * (ui.perfetto.dev). Les intervalles sont des paires début/fin par thread :
+ * l'imbrication (frame → étape → dispatch) découle de l'ordre des
+ * horodatages sur chaque piste.
+ */
+class TraceWriter {
+public:
+    /**
+     * @brief Constructeur
+     *
+     * @param maxEvents Nombre maximal d'événements conservés ; au-delà, les
+     *        événements sont ignorés et la trace est marquée tronquée
+     */
+    explicit TraceWriter(size_t maxEvents);
+
+    /**
+     * @brief Ajoute le début d'un intervalle
+     *
+     * @param name Nom de l'intervalle (doit rester valide jusqu'à l'écriture)
+     * @param timestampUs Horodatage en microsecondes
+     * @param threadId Piste (thread) de l'intervalle
+     * @param frameId Frame à laquelle l'intervalle appartient
+     */
+    void AddBegin(const char* name, double timestampUs, uint32_t threadId, uint32_t frameId);
+
+    /**
+     * @brief Ajoute la fin d'un intervalle
+     */
+    void AddEnd(const char* name, double timestampUs, uint32_t threadId, uint32_t frameId);
+
+    /**
+     * @brief Nomme une piste
+     */
+    void SetThreadName(uint32_t threadId, const std::string& name);
+
+    size_t GetEventCount() const { return m_events.size(); }
+    bool IsTruncated() const { return m_truncated; }
+
+    /**
+     * @brief Écrit la trace
+     *
+     * @param path Chemin du fichier de sortie
+     * @return true si l'écriture réussit, false sinon
+     */
+    bool WriteJson(const std::string& path) const;
+
+private:
+    struct TraceEvent {
+        const char* name;
+        double timestampUs;
+        uint32_t threadId;
+        uint32_t frameId;
+        char phase;
+    };
+
+    void Add(const char* name, char phase, double timestampUs, uint32_t threadId, uint32_t frameId);
+
+    size_t m_maxEvents;
+    bool m_truncated;
+    std::vector<TraceEvent> m_events;
+    std::map<uint32_t, std::string> m_threadNames;
+};
+
+} // namespace XIS
@@ -0,0 +1,236 @@
+#include "TuningProfile.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+namespace XIS {
+
+namespace {
+
+    // Supprime les blancs en début et en fin de chaîne
+    std::string Trim(const std::string& text)
+    {
+        size_t begin = text.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) {
+            return std::string();
+        }
+        size_t end = text.find_last_not_of(" \t\r\n");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    bool ParseInt(const std::string& text, int& value)
+    {
+        char* end = nullptr;
+        long parsed = std::strtol(text.c_str(), &end, 10);
+        if (end == text.c_str() || *end != '\0' || parsed < 0 || parsed > 65536) {
+            return false;
+        }
+        value = static_cast<int>(parsed);
+        return true;
+    }
+
+    bool SetParameter(TuningParameters& params, const std::string& key, const std::string& text)
+    {
+        int value = 0;
+        if (!ParseInt(text, value)) {
+            return false;
+        }
+
+        if (key == "motionBlockSize") params.motionBlockSize = std::max(1, value);
+        else if (key == "motionSearchRadius") params.motionSearchRadius = std::max(1, value);
+        else if (key == "aaKernelLow") params.aaKernelSize[0] = std::max(1, value);
+        else if (key == "aaKernelMedium") params.aaKernelSize[1] = std::max(1, value);
+        else if (key == "aaKernelHigh") params.aaKernelSize[2] = std::max(1, value);
+        else if (key == "rowsPerTask") params.rowsPerTask = value;
+        else if (key == "workerThreads") params.workerThreads = static_cast<uint32_t>(value);
+        // Clé inconnue : ignorée
+        return true;
+    }
+
+    // Écart relatif entre deux nombres de pixels, symétrique
+    double PixelDistance(int widthA, int heightA, int widthB, int heightB)
+    {
+        double a = std::max(1.0, static_cast<double>(widthA) * heightA);
+        double b = std::max(1.0, static_cast<double>(widthB) * heightB);
+        return std::fabs(std::log(a / b));
+    }
+
+} // namespace
+
+bool TuningProfile::Load(const std::string& path)
+{
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file) {
+        Logger::Error("TuningProfile: impossible d'ouvrir %s", path.c_str());
+        return false;
+    }
+
+    std::string machineId;
+    std::vector<TuningEntry> entries;
+    TuningEntry* current = nullptr;
+    int lineNumber = 0;
+    bool valid = true;
+
+    char buffer[512];
+    while (valid && std::fgets(buffer, sizeof(buffer), file)) {
+        ++lineNumber;
+        std::string line = Trim(buffer);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        if (line[0] == '[') {
+            TuningEntry entry;
+            char close = 0;
+            if (std::sscanf(line.c_str(), "[%dx%d->%dx%d%c", &entry.inputWidth, &entry.inputHeight,
+                            &entry.outputWidth, &entry.outputHeight, &close) != 5 || close != ']' ||
+                entry.inputWidth <= 0 || entry.inputHeight <= 0 ||
+                entry.outputWidth <= 0 || entry.outputHeight <= 0) {
+                valid = false;
+                break;
+            }
+            entries.push_back(entry);
+            current = &entries.back();
+            continue;
+        }
+
+        size_t separator = line.find('=');
+        if (separator == std::string::npos) {
+            valid = false;
+            break;
+        }
+        std::string key = Trim(line.substr(0, separator));
+        std::string value = Trim(line.substr(separator + 1));
+
+        if (!current) {
+            if (key == "machine") {
+                machineId = value;
+            }
+            continue;
+        }
+        valid = SetParameter(current->params, key, value);
+    }
+    std::fclose(file);
+
+    if (!valid) {
+        Logger::Error("TuningProfile: %s, ligne %d mal formée", path.c_str(), lineNumber);
+        return false;
+    }
+
+    m_machineId = machineId;
+    m_entries.clear();
+    for (const TuningEntry& entry : entries) {
+        Set(entry);
+    }
+    return true;
+}
+
+bool TuningProfile::Save(const std::string& path) const
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        Logger::Error("TuningProfile: impossible de créer %s", path.c_str());
+        return false;
+    }
+
+    std::fprintf(file, "# Profil d'autotuning XIS\n");
+    std::fprintf(file, "machine = %s\n", m_machineId.c_str());
+
+    for (const TuningEntry& entry : m_entries) {
+        const TuningParameters& params = entry.params;
+        std::fprintf(file, "\n[%dx%d->%dx%d]\n", entry.inputWidth, entry.inputHeight,
+                     entry.outputWidth, entry.outputHeight);
+        std::fprintf(file, "motionBlockSize = %d\n", params.motionBlockSize);
+        std::fprintf(file, "motionSearchRadius = %d\n", params.motionSearchRadius);
+        std::fprintf(file, "aaKernelLow = %d\n", params.aaKernelSize[0]);
+        std::fprintf(file, "aaKernelMedium = %d\n", params.aaKernelSize[1]);
+        std::fprintf(file, "aaKernelHigh = %d\n", params.aaKernelSize[2]);
+        std::fprintf(file, "rowsPerTask = %d\n", params.rowsPerTask);
+        std::fprintf(file, "workerThreads = %u\n", params.workerThreads);
+    }
+
+    return std::fclose(file) == 0;
+}
+
+void TuningProfile::Set(const TuningEntry& entry)
+{
+    for (TuningEntry& existing : m_entries) {
+        if (existing.inputWidth == entry.inputWidth && existing.inputHeight == entry.inputHeight &&
+            existing.outputWidth == entry.outputWidth && existing.outputHeight == entry.outputHeight) {
+            existing.params = entry.params;
+            return;
+        }
+    }
+    m_entries.push_back(entry);
+}
+
+TuningParameters TuningProfile::Find(int inputWidth, int inputHeight, int outputWidth, int outputHeight,
+                                     bool* exactMatch) const
+{
+    const TuningEntry* best = nullptr;
+    double bestDistance = std::numeric_limits<double>::max();
+
+    for (const TuningEntry& entry : m_entries) {
+        double distance = PixelDistance(entry.inputWidth, entry.inputHeight, inputWidth, inputHeight) +
+                          PixelDistance(entry.outputWidth, entry.outputHeight, outputWidth, outputHeight);
+        bool exact = entry.inputWidth == inputWidth && entry.inputHeight == inputHeight &&
+                     entry.outputWidth == outputWidth && entry.outputHeight == outputHeight;
+        if (exact) {
+            if (exactMatch) {
+                *exactMatch = true;
+            }
+            return entry.params;
+        }
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = &entry;
+        }
+    }
+
+    if (exactMatch) {
+        *exactMatch = false;
+    }
+    return best ? best->params : TuningParameters();
+}
+
+std::string TuningProfile::GetCurrentMachineId()
+{
+    std::string model;
+
+#ifdef _WIN32
+    const char* identifier = std::getenv("PROCESSOR_IDENTIFIER");
+    if (identifier) {
+        model = identifier;
+    }
+#else
+    FILE* cpuinfo = std::fopen("/proc/cpuinfo", "r");
+    if (cpuinfo) {
+        char line[512];
+        while (std::fgets(line, sizeof(line), cpuinfo)) {
+            if (std::strncmp(line, "model name", 10) == 0) {
+                const char* colon = std::strchr(line, ':');
+                if (colon) {
+                    model = Trim(colon + 1);
+                }
+                break;
+            }
+        }
+        std::fclose(cpuinfo);
+    }
+#endif
+
+    if (model.empty()) {
+        model = "unknown";
+    }
+
+    char threads[32];
+    std::snprintf(threads, sizeof(threads), "%u", std::max(1u, std::thread::hardware_concurrency()));
+    return model + " / " + threads + " threads";
+}
+
+} // namespace XIS
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace XIS {
+
+/**
+ * @brief Réglages d'exécution choisis par l'autotuning pour une résolution
+ *
+ * Les valeurs par défaut sont les constantes historiques du pipeline ; un
+ * profil ne contient que des réglages mesurés sur la machine qui l'a produit.
+ */
+struct TuningParameters {
+    int motionBlockSize = 16;             // Taille des blocs de l'estimation de mouvement (pixels)
+    int motionSearchRadius = 32;          // Rayon de recherche hors résolution dynamique (pixels)
+    int aaKernelSize[3] = { 1, 3, 5 };    // Noyau d'antialiasing des qualités Low, Medium, High
+    int rowsPerTask = 0;                  // Lignes par tâche du backend CPU (0 = automatique)
+    uint32_t workerThreads = 0;           // Threads de calcul utilisés (0 = tous ceux du backend)
+};
+
+/**
+ * @brief Réglages retenus pour une paire (résolution d'entrée, résolution de sortie)
+ */
+struct TuningEntry {
+    int inputWidth = 0;
+    int inputHeight = 0;
+    int outputWidth = 0;
+    int outputHeight = 0;
+    TuningParameters params;
+};
+
+/**
+ * @brief Profil d'autotuning d'une machine
+ *
+ * Fichier texte produit par tests/PerformanceTests/Autotuner : une ligne
+ * « machine = ... » identifiant le processeur mesuré, puis une section
+ * [LxH->LxH] par paire de résolutions, chacune composée de lignes
+ * « clé = valeur ». Les lignes commençant par # sont ignorées, ainsi que
+ * les clés inconnues (profils produits par une version plus récente).
+ */
+class TuningProfile {
+public:
+    /**
+     * @brief Lit un profil
+     *
+     * @return false si le fichier est illisible ou mal formé ; le profil est alors inchangé
+     */
+    bool Load(const std::string& path);
+
+    /**
+     * @brief Écrit le profil (remplace le fichier)
+     */
+    bool Save(const std::string& path) const;
+
+    /**
+     * @brief Ajoute ou remplace les réglages d'une paire de résolutions
+     */
+    void Set(const TuningEntry& entry);
+
+    /**
+     * @brief Réglages à appliquer pour une paire de résolutions
+     *
+     * La paire exacte si elle a été mesurée, sinon la paire mesurée dont le
+     * nombre de pixels d'entrée et de sortie est le plus proche (écart
+     * relatif). Un profil vide donne les réglages par défaut.
+     *
+     * @param exactMatch Reçoit true si la paire exacte a été mesurée (optionnel)
+     */
+    TuningParameters Find(int inputWidth, int inputHeight, int outputWidth, int outputHeight,
+                          bool* exactMatch = nullptr) const;
+
+    const std::vector<TuningEntry>& GetEntries() const { return m_entries; }
+    bool IsEmpty() const { return m_entries.empty(); }
+
+    /**
+     * @brief Machine sur laquelle le profil a été mesuré
+     */
+    const std::string& GetMachineId() const { return m_machineId; }
+    void SetMachineId(const std::string& machineId) { m_machineId = machineId; }
+
+    /**
+     * @brief Identifiant de la machine courante (modèle de processeur et nombre de threads)
+     */
+    static std::string GetCurrentMachineId();
+
+private:
+    std::string m_machineId;
+    std::vector<TuningEntry> m_entries;
+};
+
+} // namespace XIS
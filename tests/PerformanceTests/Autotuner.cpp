@@ -0,0 +1,538 @@
+/**
+ * @brief Autotuning des réglages d'exécution sur la machine courante
+ *
+ * Pour chaque paire de résolutions (entrée, sortie) demandée, mesure le
+ * pipeline complet sur le backend CPU avec différents réglages et retient
+ * le moins coûteux dont la sortie reste assez proche de celle des réglages
+ * par défaut. Les gagnants sont écrits dans un profil d'autotuning
+ * (TuningProfile) que les sessions chargent à leur initialisation
+ * (XIS::LoadTuningProfile ou variable XIS_TUNING_PROFILE).
+ *
+ * La recherche procède par coordonnées, chaque étape partant des gagnants
+ * des précédentes :
+ *  1. taille des blocs et rayon de recherche de l'estimation de mouvement ;
+ *  2. taille du noyau d'antialiasing, pour chacune des qualités Low, Medium
+ *     et High (la référence est alors la même qualité avec le noyau par
+ *     défaut) ;
+ *  3. nombre de threads et lignes par tâche du backend CPU. Ces réglages ne
+ *     changent pas la sortie : un candidat dont la sortie diffère est rejeté.
+ *
+ * Les étapes 1 et 2 sont soumises à la contrainte de qualité (SSIM moyen et
+ * SSIM de la pire frame par rapport à la référence). Un candidat ne
+ * remplace le réglage courant que s'il est plus rapide d'au moins
+ * --min-gain, pour ne pas retenir le bruit de mesure.
+ *
+ * La grille de groupes des shaders GPU (numthreads 8x8) est fixée à la
+ * compilation des shaders : son équivalent CPU, la taille des blocs de
+ * lignes, est réglé à la place.
+ *
+ * Exemple :
+ *   Autotuner --resolutions 720p,1080p,1440p --scale 2 --profile xis_tuning.ini
+ */
+
+#include "../../include/XIS/XIS.h"
+#include "../../src/Renderer/CPU/CPUWorkerPool.h"
+#include "../../src/Utils/ConfigManager.h"
+#include "../../src/Utils/TuningProfile.h"
+#include "BenchmarkSupport.h"
+#include "ImageMetrics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace XIS;
+using namespace XIS::Benchmark;
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Options
+// ---------------------------------------------------------------------------
+
+struct Options {
+    std::vector<Resolution> resolutions;  // Résolutions de sortie
+    float scale = 2.0f;                   // Rapport sortie/entrée
+    uint32_t frames = 16;                 // Longueur de la séquence mesurée
+    uint32_t costSkipFrames = 2;          // Premières frames exclues du coût (initialisation)
+    uint32_t threads = 0;                 // Threads du backend (0 = tous les cœurs)
+    uint32_t metricThreads = 0;           // Threads des mesures de qualité
+
+    UpscalingSetting upscaling;
+    AASetting aa;
+    FrameGenSetting frameGen;
+
+    double minSsim = 0.99;                // SSIM moyen minimal par rapport à la référence
+    double minFrameSsim = 0.97;           // SSIM minimal de la pire frame
+    double minGain = 0.03;                // Gain relatif minimal pour changer de réglage
+
+    std::string profilePath;              // Profil écrit (complété s'il existe)
+};
+
+void PrintUsage()
+{
+    std::fprintf(stderr,
+        "Usage: Autotuner --profile FILE [options]\n"
+        "  --profile FILE       Profil d'autotuning écrit ; les autres résolutions qu'il contient sont conservées\n"
+        "  --resolutions LIST   Résolutions de sortie : 720p,1080p,1440p,4K,8K ou LxH (défaut : 720p,1080p)\n"
+        "  --scale S            Rapport sortie/entrée (défaut : 2)\n"
+        "  --frames N           Frames mesurées par réglage (défaut : 16)\n"
+        "  --upscaling MODE     bicubic, sharp ou adaptive (défaut : adaptive)\n"
+        "  --aa QUALITY         Qualité d'AA des étapes 1 et 3 : low, medium ou high (défaut : medium)\n"
+        "  --framegen MODE      interp, mc ou advanced (défaut : mc)\n"
+        "  --min-ssim X         SSIM moyen minimal par rapport aux réglages par défaut (défaut : 0.99)\n"
+        "  --min-frame-ssim X   SSIM minimal de la pire frame (défaut : 0.97)\n"
+        "  --min-gain X         Gain relatif minimal pour retenir un réglage (défaut : 0.03)\n"
+        "  --threads N          Threads du backend CPU, 0 = tous les cœurs (défaut : 0)\n"
+        "  --metric-threads N   Threads des mesures de qualité, 0 = tous les cœurs (défaut : 0)\n");
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+    std::string resolutions = "720p,1080p";
+    std::string upscaling = "adaptive";
+    std::string aa = "medium";
+    std::string frameGen = "mc";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Valeur manquante pour %s\n", arg.c_str());
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--profile") options.profilePath = value;
+        else if (arg == "--resolutions") resolutions = value;
+        else if (arg == "--scale") options.scale = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--frames") options.frames = static_cast<uint32_t>(std::max(4, std::atoi(value.c_str())));
+        else if (arg == "--upscaling") upscaling = value;
+        else if (arg == "--aa") aa = value;
+        else if (arg == "--framegen") frameGen = value;
+        else if (arg == "--min-ssim") options.minSsim = std::atof(value.c_str());
+        else if (arg == "--min-frame-ssim") options.minFrameSsim = std::atof(value.c_str());
+        else if (arg == "--min-gain") options.minGain = std::max(0.0, std::atof(value.c_str()));
+        else if (arg == "--threads") options.threads = static_cast<uint32_t>(std::max(0, std::atoi(value.c_str())));
+        else if (arg == "--metric-threads") options.metricThreads = static_cast<uint32_t>(std::max(0, std::atoi(value.c_str())));
+        else {
+            std::fprintf(stderr, "Option inconnue : %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (options.profilePath.empty()) {
+        std::fprintf(stderr, "--profile est obligatoire\n");
+        return false;
+    }
+    if (options.scale < 1.0f) {
+        std::fprintf(stderr, "Rapport d'échelle invalide (>= 1 attendu) : %g\n", options.scale);
+        return false;
+    }
+    if (!ParseUpscaling(upscaling, options.upscaling)) {
+        std::fprintf(stderr, "Mode d'upscaling invalide : %s\n", upscaling.c_str());
+        return false;
+    }
+    if (!ParseAA(aa, options.aa) || options.aa.quality == AAQuality::Off) {
+        std::fprintf(stderr, "Qualité d'AA invalide : %s\n", aa.c_str());
+        return false;
+    }
+    if (!ParseFrameGen(frameGen, options.frameGen) || !options.frameGen.enabled) {
+        std::fprintf(stderr, "Mode de génération de frames invalide : %s\n", frameGen.c_str());
+        return false;
+    }
+
+    for (const std::string& item : Split(resolutions)) {
+        Resolution resolution;
+        if (!ParseResolution(item, resolution)) {
+            std::fprintf(stderr, "Résolution invalide : %s\n", item.c_str());
+            return false;
+        }
+        options.resolutions.push_back(resolution);
+    }
+
+    if (options.threads == 0) {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return !options.resolutions.empty();
+}
+
+// ---------------------------------------------------------------------------
+// Mesure d'un réglage
+// ---------------------------------------------------------------------------
+
+struct Measurement {
+    bool ok = false;
+    double medianMs = 0.0;
+    double ssim = 1.0;                    // Moyenne des frames
+    double minSsim = 1.0;                 // Pire frame
+    uint64_t hash = 0;                    // Condensat de toutes les sorties
+};
+
+/**
+ * Paire de résolutions en cours de réglage et ressources partagées par ses mesures
+ */
+struct TuningTarget {
+    TuningEntry entry;                    // Résolutions et meilleurs réglages courants
+    const FrameSequence* sequence = nullptr;
+    QualityEvaluator* evaluator = nullptr;
+};
+
+double Median(std::vector<double> values)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+/**
+ * Traite la séquence sur une session neuve avec les réglages donnés
+ *
+ * Le profil d'autotuning du processus est remplacé, le temps de la mesure,
+ * par un profil ne contenant que ces réglages. Chaque sortie, ainsi que la
+ * frame intermédiaire générée (seule à dépendre des réglages de mouvement),
+ * est comparée à reference si elle est fournie, ou y est enregistrée si
+ * store est vrai.
+ */
+Measurement Measure(const Options& options, const TuningTarget& target, AAQuality aaQuality,
+                    const TuningParameters& params, ReferenceFrames* reference, bool store)
+{
+    const TuningEntry& entry = target.entry;
+    Measurement measurement;
+
+    auto profile = std::make_shared<TuningProfile>();
+    TuningEntry candidate = entry;
+    candidate.params = params;
+    profile->Set(candidate);
+    ConfigManager::SetTuningProfile(profile);
+
+    XISConfig config;
+    config.enableBicubicUpscaling = true;
+    config.upscalingParams.mode = options.upscaling.mode;
+    config.upscalingParams.outputWidth = static_cast<uint32_t>(entry.outputWidth);
+    config.upscalingParams.outputHeight = static_cast<uint32_t>(entry.outputHeight);
+    config.enableAntiAliasing = true;
+    config.aaQuality = aaQuality;
+    config.enableFrameGeneration = true;
+    config.frameGenParams.mode = options.frameGen.mode;
+    config.enableSharpness = true;
+
+    XISSessionHandle session = CPU::CreateSession(config, options.threads);
+    ConfigManager::SetTuningProfile(nullptr);
+
+    void* output = session ? CPU::CreateTexture(static_cast<uint32_t>(entry.outputWidth),
+                                                static_cast<uint32_t>(entry.outputHeight)) : nullptr;
+    void* generated = output ? CPU::CreateTexture(static_cast<uint32_t>(entry.outputWidth),
+                                                  static_cast<uint32_t>(entry.outputHeight)) : nullptr;
+    if (!session || !output || !generated) {
+        std::fprintf(stderr, "[Autotuner] échec de la création de la session\n");
+        CPU::ReleaseTexture(output);
+        DestroySession(session);
+        return measurement;
+    }
+
+    XISParameters frameParams;
+    frameParams.outputTexture = output;
+    frameParams.generatedFrameTexture = generated;
+    frameParams.frameDeltaTime = 1.0f / 60.0f;
+    frameParams.isDX11 = false;
+
+    std::vector<double> frameTimesMs;
+    double ssimSum = 0.0;
+    uint32_t compared = 0;
+    uint64_t hash = 14695981039346656037ull;
+    size_t rowBytes = static_cast<size_t>(entry.outputWidth) * 4;
+    if (!store && reference) {
+        target.evaluator->Reset();
+    }
+
+    measurement.ok = true;
+    for (uint32_t i = 0; i < options.frames; ++i) {
+        frameParams.inputTexture = target.sequence->GetFrame(i);
+        auto start = std::chrono::steady_clock::now();
+        bool processed = ProcessFrame(session, frameParams);
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!processed) {
+            std::fprintf(stderr, "[Autotuner] échec du traitement de la frame %u\n", i);
+            measurement.ok = false;
+            break;
+        }
+        if (i >= options.costSkipFrames) {
+            frameTimesMs.push_back(elapsed);
+        }
+
+        // Dans l'ordre d'affichage : frame générée entre les entrées i - 1 et
+        // i (à partir de la deuxième frame) en 2i - 1, puis sortie en 2i
+        for (uint32_t k = i > 0 ? 0u : 1u; k < 2; ++k) {
+            uint32_t index = i * 2 + k - 1;
+            uint32_t pitch = 0;
+            const uint8_t* pixels = CPU::MapTexture(k == 0 ? generated : output, &pitch);
+            for (int y = 0; y < entry.outputHeight; ++y) {
+                const uint8_t* row = pixels + static_cast<size_t>(pitch) * y;
+                for (size_t x = 0; x < rowBytes; ++x) {
+                    hash ^= row[x];
+                    hash *= 1099511628211ull;
+                }
+            }
+
+            if (store && reference) {
+                reference->Store(index, pixels, pitch, static_cast<uint32_t>(entry.outputWidth),
+                                 static_cast<uint32_t>(entry.outputHeight));
+            } else if (reference) {
+                FrameQuality quality = target.evaluator->Compare(pixels, pitch, reference->GetFrame(index), reference->GetPitch(),
+                                                                 entry.outputWidth, entry.outputHeight);
+                ssimSum += quality.ssim;
+                measurement.minSsim = std::min(measurement.minSsim, quality.ssim);
+                compared++;
+            }
+        }
+    }
+
+    CPU::ReleaseTexture(generated);
+    CPU::ReleaseTexture(output);
+    DestroySession(session);
+
+    measurement.medianMs = Median(frameTimesMs);
+    measurement.ssim = compared > 0 ? ssimSum / compared : 1.0;
+    measurement.hash = hash;
+    return measurement;
+}
+
+bool MeetsQuality(const Options& options, const Measurement& measurement)
+{
+    return measurement.ssim >= options.minSsim && measurement.minSsim >= options.minFrameSsim;
+}
+
+bool IsFaster(const Options& options, const Measurement& candidate, const Measurement& best)
+{
+    return candidate.medianMs < best.medianMs * (1.0 - options.minGain);
+}
+
+void PrintCandidate(const char* label, const Measurement& measurement, bool accepted)
+{
+    if (!measurement.ok) {
+        std::fprintf(stderr, "    %-28s échec\n", label);
+        return;
+    }
+    std::fprintf(stderr, "    %-28s %9.3f ms  SSIM %.4f (min %.4f)%s\n", label, measurement.medianMs,
+                 measurement.ssim, measurement.minSsim, accepted ? "" : "  rejeté");
+}
+
+// ---------------------------------------------------------------------------
+// Étapes de la recherche
+// ---------------------------------------------------------------------------
+
+/**
+ * Étape 1 : taille des blocs et rayon de recherche de l'estimation de mouvement
+ */
+bool TuneMotion(const Options& options, TuningTarget& target)
+{
+    static const int kBlockSizes[] = { 8, 16, 24, 32 };
+    static const int kSearchRadii[] = { 8, 16, 24, 32, 48 };
+
+    std::fprintf(stderr, "  estimation de mouvement\n");
+    ReferenceFrames reference;
+    TuningParameters defaults = target.entry.params;
+    Measurement best = Measure(options, target, options.aa.quality, defaults, &reference, true);
+    if (!best.ok) {
+        return false;
+    }
+    PrintCandidate("défaut", best, true);
+
+    for (int blockSize : kBlockSizes) {
+        for (int searchRadius : kSearchRadii) {
+            if (blockSize == defaults.motionBlockSize && searchRadius == defaults.motionSearchRadius) {
+                continue;
+            }
+            TuningParameters params = target.entry.params;
+            params.motionBlockSize = blockSize;
+            params.motionSearchRadius = searchRadius;
+
+            Measurement measurement = Measure(options, target, options.aa.quality, params, &reference, false);
+            bool accepted = measurement.ok && MeetsQuality(options, measurement);
+
+            char label[64];
+            std::snprintf(label, sizeof(label), "blocs %d, rayon %d", blockSize, searchRadius);
+            PrintCandidate(label, measurement, accepted);
+
+            if (accepted && IsFaster(options, measurement, best)) {
+                best = measurement;
+                target.entry.params.motionBlockSize = blockSize;
+                target.entry.params.motionSearchRadius = searchRadius;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Étape 2 : taille du noyau d'antialiasing de chaque qualité
+ */
+bool TuneAntiAliasing(const Options& options, TuningTarget& target)
+{
+    static const int kKernelSizes[] = { 1, 3, 5, 7 };
+    static const AAQuality kQualities[] = { AAQuality::Low, AAQuality::Medium, AAQuality::High };
+    static const char* const kQualityNames[] = { "low", "medium", "high" };
+
+    for (int q = 0; q < 3; ++q) {
+        std::fprintf(stderr, "  antialiasing %s\n", kQualityNames[q]);
+        ReferenceFrames reference;
+        int defaultKernel = target.entry.params.aaKernelSize[q];
+        Measurement best = Measure(options, target, kQualities[q], target.entry.params, &reference, true);
+        if (!best.ok) {
+            return false;
+        }
+        PrintCandidate("défaut", best, true);
+
+        for (int kernelSize : kKernelSizes) {
+            if (kernelSize == defaultKernel) {
+                continue;
+            }
+            TuningParameters params = target.entry.params;
+            params.aaKernelSize[q] = kernelSize;
+
+            Measurement measurement = Measure(options, target, kQualities[q], params, &reference, false);
+            bool accepted = measurement.ok && MeetsQuality(options, measurement);
+
+            char label[64];
+            std::snprintf(label, sizeof(label), "noyau %d", kernelSize);
+            PrintCandidate(label, measurement, accepted);
+
+            if (accepted && IsFaster(options, measurement, best)) {
+                best = measurement;
+                target.entry.params.aaKernelSize[q] = kernelSize;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Étape 3 : threads et lignes par tâche ; la sortie ne doit pas changer
+ */
+bool TuneParallelism(const Options& options, TuningTarget& target)
+{
+    static const int kRowsPerTask[] = { 0, 1, 2, 4, 8, 16, 32, 64 };
+
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t threads = 1; threads < options.threads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(options.threads);
+
+    std::fprintf(stderr, "  parallélisme (%u threads disponibles)\n", options.threads);
+    TuningParameters current = target.entry.params;
+    current.workerThreads = 0;
+    current.rowsPerTask = 0;
+    Measurement best = Measure(options, target, options.aa.quality, current, nullptr, false);
+    if (!best.ok) {
+        return false;
+    }
+    PrintCandidate("défaut", best, true);
+    uint64_t expectedHash = best.hash;
+
+    for (uint32_t threads : threadCounts) {
+        for (int rowsPerTask : kRowsPerTask) {
+            if (threads == options.threads && rowsPerTask == 0) {
+                continue;
+            }
+            TuningParameters params = current;
+            params.workerThreads = threads == options.threads ? 0 : threads;
+            params.rowsPerTask = rowsPerTask;
+
+            Measurement measurement = Measure(options, target, options.aa.quality, params, nullptr, false);
+            bool accepted = measurement.ok && measurement.hash == expectedHash;
+
+            char label[64];
+            std::snprintf(label, sizeof(label), "%u threads, %d lignes", threads, rowsPerTask);
+            PrintCandidate(label, measurement, accepted);
+            if (measurement.ok && !accepted) {
+                std::fprintf(stderr, "    sortie différente de la référence : réglage ignoré\n");
+            }
+
+            if (accepted && IsFaster(options, measurement, best)) {
+                best = measurement;
+                target.entry.params.workerThreads = params.workerThreads;
+                target.entry.params.rowsPerTask = rowsPerTask;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+
+    // Les paires déjà mesurées et absentes de cette exécution sont conservées
+    TuningProfile profile;
+    FILE* existing = std::fopen(options.profilePath.c_str(), "r");
+    if (existing) {
+        std::fclose(existing);
+        if (!profile.Load(options.profilePath)) {
+            std::fprintf(stderr, "%s : profil existant illisible\n", options.profilePath.c_str());
+            return 2;
+        }
+        if (profile.GetMachineId() != TuningProfile::GetCurrentMachineId()) {
+            std::fprintf(stderr, "%s : profil d'une autre machine, remplacé\n", options.profilePath.c_str());
+            profile = TuningProfile();
+        }
+    }
+    profile.SetMachineId(TuningProfile::GetCurrentMachineId());
+
+    CPUWorkerPool metricPool(options.metricThreads);
+    QualityEvaluator evaluator(metricPool);
+
+    for (const Resolution& resolution : options.resolutions) {
+        FrameSequence sequence;
+        uint32_t inputWidth = EvenDimension(resolution.width / options.scale);
+        uint32_t inputHeight = EvenDimension(resolution.height / options.scale);
+        if (!sequence.CreateSynthetic(inputWidth, inputHeight, options.frames)) {
+            std::fprintf(stderr, "Frames d'entrée indisponibles\n");
+            return 1;
+        }
+
+        TuningTarget target;
+        target.entry.inputWidth = static_cast<int>(inputWidth);
+        target.entry.inputHeight = static_cast<int>(inputHeight);
+        target.entry.outputWidth = static_cast<int>(resolution.width);
+        target.entry.outputHeight = static_cast<int>(resolution.height);
+        target.sequence = &sequence;
+        target.evaluator = &evaluator;
+
+        std::fprintf(stderr, "[Autotuner] %ux%u -> %ux%u\n", inputWidth, inputHeight, resolution.width, resolution.height);
+        if (!TuneMotion(options, target) || !TuneAntiAliasing(options, target) || !TuneParallelism(options, target)) {
+            return 1;
+        }
+
+        const TuningParameters& params = target.entry.params;
+        std::fprintf(stderr, "  retenu : blocs %d, rayon %d, noyaux AA %d/%d/%d, %u threads, %d lignes par tâche\n",
+                     params.motionBlockSize, params.motionSearchRadius, params.aaKernelSize[0],
+                     params.aaKernelSize[1], params.aaKernelSize[2], params.workerThreads, params.rowsPerTask);
+        profile.Set(target.entry);
+    }
+
+    if (!profile.Save(options.profilePath)) {
+        std::fprintf(stderr, "Impossible d'écrire %s\n", options.profilePath.c_str());
+        return 1;
+    }
+    std::fprintf(stderr, "[Autotuner] profil écrit : %s\n", options.profilePath.c_str());
+    return 0;
+}
@@ -0,0 +1,473 @@
+#pragma once
+
+/**
+ * @brief Outils communs aux benchmarks de tests/PerformanceTests
+ *
+ * Analyse des options, réglages du pipeline, séquence de frames d'entrée,
+ * description de la machine et écriture JSON, pour que les résultats des
+ * différents benchmarks aient la même forme et puissent être rapprochés par
+ * tools/Profiler.
+ */
+
+#include "../../include/XIS/XIS.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/utsname.h>
+
+namespace XIS {
+namespace Benchmark {
+
+// ---------------------------------------------------------------------------
+// Options
+// ---------------------------------------------------------------------------
+
+inline std::vector<std::string> Split(const std::string& text)
+{
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        if (end > start) {
+            parts.push_back(text.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    return parts;
+}
+
+inline bool ParseSize(const std::string& text, uint32_t& width, uint32_t& height)
+{
+    unsigned w = 0;
+    unsigned h = 0;
+    if (std::sscanf(text.c_str(), "%ux%u", &w, &h) != 2 || w == 0 || h == 0) {
+        return false;
+    }
+    width = w;
+    height = h;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Machine
+// ---------------------------------------------------------------------------
+
+inline std::string ReadCpuModel()
+{
+    FILE* file = std::fopen("/proc/cpuinfo", "r");
+    if (!file) {
+        return "unknown";
+    }
+
+    char line[512];
+    std::string model = "unknown";
+    while (std::fgets(line, sizeof(line), file)) {
+        if (std::strncmp(line, "model name", 10) == 0) {
+            const char* value = std::strchr(line, ':');
+            if (value) {
+                model = value + 1;
+                model.erase(0, model.find_first_not_of(" \t"));
+                model.erase(model.find_last_not_of(" \t\n") + 1);
+            }
+            break;
+        }
+    }
+    std::fclose(file);
+    return model;
+}
+
+// Valeur en octets d'un champ "Nom: N kB" de /proc
+inline uint64_t ReadProcKilobytes(const char* path, const char* field)
+{
+    FILE* file = std::fopen(path, "r");
+    if (!file) {
+        return 0;
+    }
+
+    char line[256];
+    uint64_t value = 0;
+    size_t fieldLength = std::strlen(field);
+    while (std::fgets(line, sizeof(line), file)) {
+        if (std::strncmp(line, field, fieldLength) == 0 && line[fieldLength] == ':') {
+            value = std::strtoull(line + fieldLength + 1, nullptr, 10) * 1024;
+            break;
+        }
+    }
+    std::fclose(file);
+    return value;
+}
+
+// ---------------------------------------------------------------------------
+// Écriture JSON
+// ---------------------------------------------------------------------------
+
+class JsonWriter {
+public:
+    void BeginObject(const char* key = nullptr) { Open(key, '{'); }
+    void EndObject() { Close('}'); }
+    void BeginArray(const char* key = nullptr) { Open(key, '['); }
+    void EndArray() { Close(']'); }
+
+    void String(const char* key, const std::string& value)
+    {
+        Key(key);
+        m_text += '"';
+        for (char c : value) {
+            switch (c) {
+            case '"': m_text += "\\\""; break;
+            case '\\': m_text += "\\\\"; break;
+            case '\n': m_text += "\\n"; break;
+            case '\t': m_text += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    m_text += escaped;
+                } else {
+                    m_text += c;
+                }
+            }
+        }
+        m_text += '"';
+    }
+
+    void Number(const char* key, double value)
+    {
+        Key(key);
+        char text[64];
+        std::snprintf(text, sizeof(text), "%.6g", value);
+        m_text += text;
+    }
+
+    void Integer(const char* key, uint64_t value)
+    {
+        Key(key);
+        m_text += std::to_string(value);
+    }
+
+    void Bool(const char* key, bool value)
+    {
+        Key(key);
+        m_text += value ? "true" : "false";
+    }
+
+    const std::string& GetText() const { return m_text; }
+
+private:
+    void Key(const char* key)
+    {
+        if (m_needComma) {
+            m_text += ',';
+        }
+        m_text += '\n';
+        m_text.append(m_depth * 2, ' ');
+        if (key) {
+            m_text += '"';
+            m_text += key;
+            m_text += "\": ";
+        }
+        m_needComma = true;
+    }
+
+    void Open(const char* key, char bracket)
+    {
+        if (m_depth > 0 || key) {
+            Key(key);
+        }
+        m_text += bracket;
+        m_depth++;
+        m_needComma = false;
+    }
+
+    void Close(char bracket)
+    {
+        m_depth--;
+        m_text += '\n';
+        m_text.append(m_depth * 2, ' ');
+        m_text += bracket;
+        m_needComma = true;
+    }
+
+    std::string m_text;
+    int m_depth = 0;
+    bool m_needComma = false;
+};
+
+/**
+ * Objet "machine" : sert d'empreinte aux références de RegressionGate
+ */
+inline void WriteMachine(JsonWriter& json)
+{
+    struct utsname system = {};
+    uname(&system);
+    json.BeginObject("machine");
+    json.String("cpuModel", ReadCpuModel());
+    json.Integer("logicalCores", std::thread::hardware_concurrency());
+    json.Integer("memoryBytes", ReadProcKilobytes("/proc/meminfo", "MemTotal"));
+    json.String("kernel", std::string(system.sysname) + " " + system.release);
+    json.String("architecture", system.machine);
+    json.EndObject();
+}
+
+// ---------------------------------------------------------------------------
+// Réglages du pipeline
+// ---------------------------------------------------------------------------
+
+struct Resolution {
+    std::string name;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+struct FrameGenSetting {
+    std::string name;
+    bool enabled = false;
+    FrameGenMode mode = FrameGenMode::MotionCompensated;
+};
+
+struct AASetting {
+    std::string name;
+    AAQuality quality = AAQuality::Medium;
+};
+
+struct UpscalingSetting {
+    std::string name;
+    UpscalingMode mode = UpscalingMode::BicubicAdaptive;
+};
+
+inline bool ParseResolution(const std::string& text, Resolution& resolution)
+{
+    static const Resolution kNamed[] = {
+        { "720p", 1280, 720 },
+        { "1080p", 1920, 1080 },
+        { "1440p", 2560, 1440 },
+        { "4K", 3840, 2160 },
+        { "8K", 7680, 4320 },
+    };
+
+    for (const Resolution& named : kNamed) {
+        if (text == named.name) {
+            resolution = named;
+            return true;
+        }
+    }
+
+    resolution.name = text;
+    return ParseSize(text, resolution.width, resolution.height);
+}
+
+inline bool ParseAA(const std::string& text, AASetting& setting)
+{
+    static const AASetting kSettings[] = {
+        { "off", AAQuality::Off },
+        { "low", AAQuality::Low },
+        { "medium", AAQuality::Medium },
+        { "high", AAQuality::High },
+    };
+
+    for (const AASetting& candidate : kSettings) {
+        if (text == candidate.name) {
+            setting = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool ParseFrameGen(const std::string& text, FrameGenSetting& setting)
+{
+    static const FrameGenSetting kSettings[] = {
+        { "off", false, FrameGenMode::MotionCompensated },
+        { "interp", true, FrameGenMode::Interpolation },
+        { "mc", true, FrameGenMode::MotionCompensated },
+        { "advanced", true, FrameGenMode::Advanced },
+    };
+
+    for (const FrameGenSetting& candidate : kSettings) {
+        if (text == candidate.name) {
+            setting = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool ParseUpscaling(const std::string& text, UpscalingSetting& setting)
+{
+    static const UpscalingSetting kSettings[] = {
+        { "bicubic", UpscalingMode::Bicubic },
+        { "sharp", UpscalingMode::BicubicSharp },
+        { "adaptive", UpscalingMode::BicubicAdaptive },
+    };
+
+    for (const UpscalingSetting& candidate : kSettings) {
+        if (text == candidate.name) {
+            setting = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline uint32_t EvenDimension(double value)
+{
+    uint32_t dimension = static_cast<uint32_t>(value + 0.5);
+    return std::max(2u, dimension & ~1u);
+}
+
+// ---------------------------------------------------------------------------
+// Frames d'entrée
+// ---------------------------------------------------------------------------
+
+/**
+ * Séquence de frames d'entrée réutilisées en boucle
+ */
+class FrameSequence {
+public:
+    ~FrameSequence() { Release(); }
+
+    // Motif en mouvement : dégradé, damier et disque se déplaçant à des
+    // vitesses différentes, pour donner du travail à l'estimation de
+    // mouvement et des contours à l'antialiasing
+    bool CreateSynthetic(uint32_t width, uint32_t height, uint32_t length)
+    {
+        Release();
+        m_width = width;
+        m_height = height;
+
+        for (uint32_t f = 0; f < length; ++f) {
+            void* texture = CPU::CreateTexture(width, height);
+            if (!texture) {
+                return false;
+            }
+            m_frames.push_back(texture);
+
+            uint32_t pitch = 0;
+            uint8_t* data = CPU::MapTexture(texture, &pitch);
+            int shiftX = static_cast<int>(f) * 6;
+            int shiftY = static_cast<int>(f) * 2;
+            int centerX = static_cast<int>(width / 3 + f * 10);
+            int centerY = static_cast<int>(height / 2);
+            int radius = static_cast<int>(std::min(width, height) / 6);
+
+            for (uint32_t y = 0; y < height; ++y) {
+                uint8_t* row = data + static_cast<size_t>(y) * pitch;
+                for (uint32_t x = 0; x < width; ++x) {
+                    int cx = static_cast<int>(x) - shiftX;
+                    int cy = static_cast<int>(y) - shiftY;
+                    bool checker = (((cx >> 5) ^ (cy >> 5)) & 1) != 0;
+                    int dx = static_cast<int>(x) - centerX;
+                    int dy = static_cast<int>(y) - centerY;
+                    bool disc = dx * dx + dy * dy < radius * radius;
+
+                    uint8_t* pixel = row + static_cast<size_t>(x) * 4;
+                    pixel[0] = disc ? 230 : static_cast<uint8_t>(x * 255 / width);
+                    pixel[1] = disc ? 60 : (checker ? 200 : 40);
+                    pixel[2] = disc ? 40 : static_cast<uint8_t>(y * 255 / height);
+                    pixel[3] = 255;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Frames RGBA 8 bits concaténées, sans en-tête
+    bool LoadRecorded(const std::string& path, uint32_t width, uint32_t height, uint32_t maxFrames)
+    {
+        Release();
+        m_width = width;
+        m_height = height;
+
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            std::fprintf(stderr, "Impossible d'ouvrir %s\n", path.c_str());
+            return false;
+        }
+
+        std::vector<uint8_t> row(static_cast<size_t>(width) * 4);
+        bool complete = true;
+        while (complete && m_frames.size() < maxFrames) {
+            void* texture = CPU::CreateTexture(width, height);
+            if (!texture) {
+                break;
+            }
+
+            uint32_t pitch = 0;
+            uint8_t* data = CPU::MapTexture(texture, &pitch);
+            for (uint32_t y = 0; y < height && complete; ++y) {
+                complete = std::fread(data + static_cast<size_t>(y) * pitch, 1, row.size(), file) == row.size();
+            }
+
+            if (complete) {
+                m_frames.push_back(texture);
+            } else {
+                CPU::ReleaseTexture(texture);
+            }
+        }
+        std::fclose(file);
+
+        if (m_frames.size() < 2) {
+            std::fprintf(stderr, "%s : au moins deux frames %ux%u attendues\n", path.c_str(), width, height);
+            return false;
+        }
+        return true;
+    }
+
+    void* GetFrame(uint64_t index) const { return m_frames[index % m_frames.size()]; }
+    uint32_t GetWidth() const { return m_width; }
+    uint32_t GetHeight() const { return m_height; }
+    size_t GetLength() const { return m_frames.size(); }
+
+private:
+    void Release()
+    {
+        for (void* frame : m_frames) {
+            CPU::ReleaseTexture(frame);
+        }
+        m_frames.clear();
+    }
+
+    std::vector<void*> m_frames;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+};
+
+/**
+ * Sorties d'une configuration de référence, conservées en mémoire pour les
+ * mesures de qualité
+ */
+class ReferenceFrames {
+public:
+    void Store(uint32_t index, const uint8_t* pixels, uint32_t pitch, uint32_t width, uint32_t height)
+    {
+        m_pitch = static_cast<size_t>(width) * 4;
+        if (m_frames.size() <= index) {
+            m_frames.resize(index + 1);
+        }
+        std::vector<uint8_t>& frame = m_frames[index];
+        frame.resize(m_pitch * height);
+        for (uint32_t y = 0; y < height; ++y) {
+            std::memcpy(frame.data() + m_pitch * y, pixels + static_cast<size_t>(pitch) * y, m_pitch);
+        }
+    }
+
+    const uint8_t* GetFrame(uint32_t index) const { return m_frames[index].data(); }
+    size_t GetPitch() const { return m_pitch; }
+
+private:
+    std::vector<std::vector<uint8_t>> m_frames;
+    size_t m_pitch = 0;
+};
+
+} // namespace Benchmark
+} // namespace XIS
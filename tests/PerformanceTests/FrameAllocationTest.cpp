@@ -0,0 +1,350 @@
+/**
+ * @brief Vérifie que le pipeline n'alloue plus sur le tas en régime établi
+ *
+ * Les opérateurs new et delete globaux sont remplacés par des versions qui
+ * comptent les allocations de tous les threads du processus (thread de
+ * frame, threads de calcul du backend CPU, agrégation des statistiques...).
+ * Pour chaque combinaison de qualité d'AA, de mode de génération de frames
+ * et de nombre de threads, une session CPU traite des frames de
+ * préchauffage, pendant lesquelles les ressources, les arenas de frame et
+ * les tampons internes atteignent leur taille, puis des frames mesurées qui
+ * ne doivent faire aucune allocation.
+ *
+ * Exemple :
+ *   FrameAllocationTest --resolution 1080p --aa off,high --framegen off,mc --threads 1,0
+ *
+ * Codes de retour : 0 si aucune frame mesurée n'a alloué, 1 sinon, 2 en cas
+ * d'erreur d'utilisation.
+ */
+
+#include "../../include/XIS/XIS.h"
+#include "BenchmarkSupport.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace XIS;
+using namespace XIS::Benchmark;
+
+// ---------------------------------------------------------------------------
+// Allocateur compteur
+// ---------------------------------------------------------------------------
+
+namespace {
+
+std::atomic<bool> g_counting{false};
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_allocatedBytes{0};
+
+void* CountedAllocate(size_t size, size_t alignment)
+{
+    if (g_counting.load(std::memory_order_relaxed)) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    if (size == 0) {
+        size = 1;
+    }
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+} // namespace
+
+void* operator new(size_t size)
+{
+    void* memory = CountedAllocate(size, 0);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    void* memory = CountedAllocate(size, static_cast<size_t>(alignment));
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size, 0);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size, 0);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size, static_cast<size_t>(alignment));
+}
+
+// Les variantes nothrow de delete se ramènent à celles-ci
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Options
+// ---------------------------------------------------------------------------
+
+struct Options {
+    Resolution resolution;
+    float scale = 2.0f;
+    std::vector<AASetting> aaSettings;
+    std::vector<FrameGenSetting> frameGenSettings;
+    std::vector<uint32_t> threadCounts;
+    bool dynamicResolution = false;
+
+    uint32_t warmupFrames = 10;
+    uint32_t frames = 50;
+};
+
+void PrintUsage()
+{
+    std::fprintf(stderr,
+        "Usage: FrameAllocationTest [options]\n"
+        "  --resolution R       Résolution de sortie : 720p,1080p,1440p,4K,8K ou LxH (défaut : 720p)\n"
+        "  --scale S            Rapport sortie/entrée (défaut : 2)\n"
+        "  --aa LIST            off,low,medium,high (défaut : off,high)\n"
+        "  --framegen LIST      off,interp,mc,advanced (défaut : off,mc)\n"
+        "  --threads LIST       Threads de calcul, 0 = tous les cœurs (défaut : 1,0)\n"
+        "  --dynamic            Active la résolution dynamique\n"
+        "  --warmup N           Frames de préchauffage (défaut : 10)\n"
+        "  --frames N           Frames mesurées (défaut : 50)\n");
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+    std::string resolution = "720p";
+    std::string aa = "off,high";
+    std::string frameGen = "off,mc";
+    std::string threads = "1,0";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (arg == "--dynamic") {
+            options.dynamicResolution = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Valeur manquante pour %s\n", arg.c_str());
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--resolution") resolution = value;
+        else if (arg == "--scale") options.scale = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--aa") aa = value;
+        else if (arg == "--framegen") frameGen = value;
+        else if (arg == "--threads") threads = value;
+        else if (arg == "--warmup") options.warmupFrames = static_cast<uint32_t>(std::max(0, std::atoi(value.c_str())));
+        else if (arg == "--frames") options.frames = static_cast<uint32_t>(std::max(1, std::atoi(value.c_str())));
+        else {
+            std::fprintf(stderr, "Option inconnue : %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (!ParseResolution(resolution, options.resolution)) {
+        std::fprintf(stderr, "Résolution invalide : %s\n", resolution.c_str());
+        return false;
+    }
+    if (options.scale < 1.0f) {
+        std::fprintf(stderr, "Rapport d'échelle invalide (>= 1 attendu)\n");
+        return false;
+    }
+    for (const std::string& item : Split(aa)) {
+        AASetting setting;
+        if (!ParseAA(item, setting)) {
+            std::fprintf(stderr, "Qualité d'AA invalide : %s\n", item.c_str());
+            return false;
+        }
+        options.aaSettings.push_back(setting);
+    }
+    for (const std::string& item : Split(frameGen)) {
+        FrameGenSetting setting;
+        if (!ParseFrameGen(item, setting)) {
+            std::fprintf(stderr, "Mode de génération de frames invalide : %s\n", item.c_str());
+            return false;
+        }
+        options.frameGenSettings.push_back(setting);
+    }
+    for (const std::string& item : Split(threads)) {
+        options.threadCounts.push_back(static_cast<uint32_t>(std::max(0, std::atoi(item.c_str()))));
+    }
+
+    return !options.aaSettings.empty() && !options.frameGenSettings.empty() && !options.threadCounts.empty();
+}
+
+// ---------------------------------------------------------------------------
+// Mesure
+// ---------------------------------------------------------------------------
+
+struct Result {
+    bool ok = false;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+Result Run(const Options& options, const AASetting& aa, const FrameGenSetting& frameGen, uint32_t threads,
+           const FrameSequence& sequence)
+{
+    Result result;
+
+    XISConfig config;
+    config.enableBicubicUpscaling = true;
+    config.enableAntiAliasing = aa.quality != AAQuality::Off;
+    config.aaQuality = aa.quality;
+    config.enableFrameGeneration = frameGen.enabled;
+    config.frameGenParams.mode = frameGen.mode;
+    config.enableSharpness = true;
+    config.upscalingParams.outputWidth = options.resolution.width;
+    config.upscalingParams.outputHeight = options.resolution.height;
+    config.dynamicResolution.enabled = options.dynamicResolution;
+
+    XISSessionHandle session = CPU::CreateSession(config, threads);
+    void* output = session ? CPU::CreateTexture(options.resolution.width, options.resolution.height) : nullptr;
+    if (!session || !output) {
+        DestroySession(session);
+        return result;
+    }
+
+    XISParameters params;
+    params.outputTexture = output;
+    params.frameDeltaTime = 1.0f / 60.0f;
+    params.isDX11 = false;
+
+    uint64_t frameIndex = 0;
+    bool ok = true;
+    for (uint32_t i = 0; i < options.warmupFrames && ok; ++i) {
+        params.inputTexture = sequence.GetFrame(frameIndex++);
+        ok = ProcessFrame(session, params);
+    }
+
+    uint64_t allocationsBefore = g_allocations.load();
+    uint64_t bytesBefore = g_allocatedBytes.load();
+    g_counting.store(true);
+    for (uint32_t i = 0; i < options.frames && ok; ++i) {
+        params.inputTexture = sequence.GetFrame(frameIndex++);
+        ok = ProcessFrame(session, params);
+    }
+    g_counting.store(false);
+
+    result.ok = ok;
+    result.allocations = g_allocations.load() - allocationsBefore;
+    result.bytes = g_allocatedBytes.load() - bytesBefore;
+
+    DestroySession(session);
+    CPU::ReleaseTexture(output);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+
+    FrameSequence sequence;
+    uint32_t inputWidth = EvenDimension(options.resolution.width / options.scale);
+    uint32_t inputHeight = EvenDimension(options.resolution.height / options.scale);
+    if (!sequence.CreateSynthetic(inputWidth, inputHeight, 4)) {
+        std::fprintf(stderr, "Frames d'entrée %ux%u indisponibles\n", inputWidth, inputHeight);
+        return 1;
+    }
+
+    int failures = 0;
+    for (const AASetting& aa : options.aaSettings) {
+        for (const FrameGenSetting& frameGen : options.frameGenSettings) {
+            for (uint32_t threads : options.threadCounts) {
+                Result result = Run(options, aa, frameGen, threads, sequence);
+                bool passed = result.ok && result.allocations == 0;
+                std::printf("%-4s %s_x%.2g_aa-%s_fg-%s_t%u : %llu allocations (%llu octets) sur %u frames%s\n",
+                            passed ? "OK" : "ÉCHEC", options.resolution.name.c_str(), options.scale,
+                            aa.name.c_str(), frameGen.name.c_str(), threads,
+                            static_cast<unsigned long long>(result.allocations),
+                            static_cast<unsigned long long>(result.bytes), options.frames,
+                            result.ok ? "" : ", échec du traitement");
+                if (!passed) {
+                    failures++;
+                }
+            }
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
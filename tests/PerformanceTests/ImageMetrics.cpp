@@ -0,0 +1,267 @@
+#include "ImageMetrics.h"
+#include "../../src/Renderer/CPU/CPUWorkerPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define XIS_METRICS_SSE2 1
+#endif
+
+namespace XIS {
+namespace Benchmark {
+
+namespace {
+    // Lignes par tâche ; multiple de kWindowStep pour que chaque fenêtre
+    // SSIM appartienne à une seule bande
+    const int kBandRows = 16;
+    const int kWindowSize = 8;
+    const int kWindowStep = 4;
+
+    const double kC1 = (0.01 * 255.0) * (0.01 * 255.0);
+    const double kC2 = (0.03 * 255.0) * (0.03 * 255.0);
+
+#if XIS_METRICS_SSE2
+    inline uint32_t HorizontalSum(__m128i value)
+    {
+        value = _mm_add_epi32(value, _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2)));
+        value = _mm_add_epi32(value, _mm_shuffle_epi32(value, _MM_SHUFFLE(2, 3, 0, 1)));
+        return static_cast<uint32_t>(_mm_cvtsi128_si32(value));
+    }
+#endif
+
+    // Luminance BT.601 en entiers : (77 R + 150 G + 29 B + 128) >> 8
+    void ConvertRowToLuma(const uint8_t* rgba, uint8_t* luma, int width)
+    {
+        int x = 0;
+#if XIS_METRICS_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i weights = _mm_setr_epi16(77, 150, 29, 0, 77, 150, 29, 0);
+        const __m128i rounding = _mm_set1_epi32(128);
+        for (; x + 4 <= width; x += 4) {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + x * 4));
+            // [R·77 + G·150, B·29] par pixel, puis somme des paires
+            __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), weights);
+            __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), weights);
+            lo = _mm_add_epi32(lo, _mm_srli_epi64(lo, 32));
+            hi = _mm_add_epi32(hi, _mm_srli_epi64(hi, 32));
+            __m128i sums = _mm_unpacklo_epi64(_mm_shuffle_epi32(lo, _MM_SHUFFLE(3, 1, 2, 0)),
+                                              _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 1, 2, 0)));
+            sums = _mm_srli_epi32(_mm_add_epi32(sums, rounding), 8);
+            __m128i packed = _mm_packs_epi32(sums, sums);
+            packed = _mm_packus_epi16(packed, packed);
+            int value = _mm_cvtsi128_si32(packed);
+            std::memcpy(luma + x, &value, sizeof(value));
+        }
+#endif
+        for (; x < width; ++x) {
+            const uint8_t* pixel = rgba + x * 4;
+            luma[x] = static_cast<uint8_t>((77 * pixel[0] + 150 * pixel[1] + 29 * pixel[2] + 128) >> 8);
+        }
+    }
+
+    // Somme des carrés des écarts sur R, G et B (alpha ignoré)
+    uint64_t RowSquaredError(const uint8_t* a, const uint8_t* b, int width)
+    {
+        uint64_t sum = 0;
+        int x = 0;
+#if XIS_METRICS_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i colorMask = _mm_set1_epi32(0x00FFFFFF);
+        __m128i accumulator = zero;
+        for (; x + 4 <= width; x += 4) {
+            __m128i va = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x * 4)), colorMask);
+            __m128i vb = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x * 4)), colorMask);
+            __m128i difference = _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+            __m128i lo = _mm_unpacklo_epi8(difference, zero);
+            __m128i hi = _mm_unpackhi_epi8(difference, zero);
+            accumulator = _mm_add_epi32(accumulator, _mm_madd_epi16(lo, lo));
+            accumulator = _mm_add_epi32(accumulator, _mm_madd_epi16(hi, hi));
+        }
+        sum = HorizontalSum(accumulator);
+#endif
+        for (; x < width; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                int difference = a[x * 4 + c] - b[x * 4 + c];
+                sum += static_cast<uint64_t>(difference * difference);
+            }
+        }
+        return sum;
+    }
+
+    // Somme de |(c - cPrevious) - (r - rPrevious)|
+    uint64_t RowFlicker(const uint8_t* c, const uint8_t* cPrevious, const uint8_t* r, const uint8_t* rPrevious, int width)
+    {
+        uint64_t sum = 0;
+        int x = 0;
+#if XIS_METRICS_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i accumulator = zero;
+        for (; x + 8 <= width; x += 8) {
+            __m128i vc = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(c + x)), zero);
+            __m128i vcp = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(cPrevious + x)), zero);
+            __m128i vr = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(r + x)), zero);
+            __m128i vrp = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(rPrevious + x)), zero);
+            __m128i difference = _mm_sub_epi16(_mm_sub_epi16(vc, vcp), _mm_sub_epi16(vr, vrp));
+            __m128i magnitude = _mm_max_epi16(difference, _mm_sub_epi16(zero, difference));
+            accumulator = _mm_add_epi32(accumulator, _mm_madd_epi16(magnitude, ones));
+        }
+        sum = HorizontalSum(accumulator);
+#endif
+        for (; x < width; ++x) {
+            int difference = (c[x] - cPrevious[x]) - (r[x] - rPrevious[x]);
+            sum += static_cast<uint64_t>(std::abs(difference));
+        }
+        return sum;
+    }
+
+    // SSIM d'une fenêtre kWindowSize x kWindowSize
+    double WindowSsim(const uint8_t* a, const uint8_t* b, size_t stride)
+    {
+        uint32_t sumA = 0, sumB = 0, sumAA = 0, sumBB = 0, sumAB = 0;
+#if XIS_METRICS_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i va = zero, vb = zero, vaa = zero, vbb = zero, vab = zero;
+        for (int row = 0; row < kWindowSize; ++row) {
+            __m128i pa = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + row * stride)), zero);
+            __m128i pb = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + row * stride)), zero);
+            va = _mm_add_epi16(va, pa);
+            vb = _mm_add_epi16(vb, pb);
+            vaa = _mm_add_epi32(vaa, _mm_madd_epi16(pa, pa));
+            vbb = _mm_add_epi32(vbb, _mm_madd_epi16(pb, pb));
+            vab = _mm_add_epi32(vab, _mm_madd_epi16(pa, pb));
+        }
+        sumA = HorizontalSum(_mm_madd_epi16(va, ones));
+        sumB = HorizontalSum(_mm_madd_epi16(vb, ones));
+        sumAA = HorizontalSum(vaa);
+        sumBB = HorizontalSum(vbb);
+        sumAB = HorizontalSum(vab);
+#else
+        for (int row = 0; row < kWindowSize; ++row) {
+            for (int x = 0; x < kWindowSize; ++x) {
+                uint32_t pa = a[row * stride + x];
+                uint32_t pb = b[row * stride + x];
+                sumA += pa;
+                sumB += pb;
+                sumAA += pa * pa;
+                sumBB += pb * pb;
+                sumAB += pa * pb;
+            }
+        }
+#endif
+        const double n = static_cast<double>(kWindowSize * kWindowSize);
+        double meanA = sumA / n;
+        double meanB = sumB / n;
+        double varianceA = sumAA / n - meanA * meanA;
+        double varianceB = sumBB / n - meanB * meanB;
+        double covariance = sumAB / n - meanA * meanB;
+        return ((2.0 * meanA * meanB + kC1) * (2.0 * covariance + kC2)) /
+               ((meanA * meanA + meanB * meanB + kC1) * (varianceA + varianceB + kC2));
+    }
+}
+
+QualityEvaluator::QualityEvaluator(CPUWorkerPool& pool)
+    : m_pool(pool)
+{
+}
+
+void QualityEvaluator::Reset()
+{
+    m_hasPrevious = false;
+}
+
+FrameQuality QualityEvaluator::Compare(const uint8_t* candidate, size_t candidatePitch,
+                                       const uint8_t* reference, size_t referencePitch,
+                                       int width, int height)
+{
+    FrameQuality quality;
+    if (width <= 0 || height <= 0) {
+        return quality;
+    }
+
+    if (width != m_width || height != m_height) {
+        size_t pixels = static_cast<size_t>(width) * static_cast<size_t>(height);
+        m_candidateLuma.assign(pixels, 0);
+        m_referenceLuma.assign(pixels, 0);
+        m_previousCandidateLuma.assign(pixels, 0);
+        m_previousReferenceLuma.assign(pixels, 0);
+        m_width = width;
+        m_height = height;
+        m_hasPrevious = false;
+    }
+
+    const size_t lumaStride = static_cast<size_t>(width);
+    const bool flicker = m_hasPrevious;
+    const int bandCount = (height + kBandRows - 1) / kBandRows;
+    m_bands.assign(static_cast<size_t>(bandCount), BandSums());
+
+    // Luminance, erreur quadratique et scintillement, ligne par ligne
+    m_pool.ParallelFor(bandCount, 1, [&](int begin, int end) {
+        for (int band = begin; band < end; ++band) {
+            BandSums& sums = m_bands[band];
+            int lastRow = std::min(height, (band + 1) * kBandRows);
+            for (int y = band * kBandRows; y < lastRow; ++y) {
+                const uint8_t* candidateRow = candidate + static_cast<size_t>(y) * candidatePitch;
+                const uint8_t* referenceRow = reference + static_cast<size_t>(y) * referencePitch;
+                size_t offset = static_cast<size_t>(y) * lumaStride;
+
+                ConvertRowToLuma(candidateRow, m_candidateLuma.data() + offset, width);
+                ConvertRowToLuma(referenceRow, m_referenceLuma.data() + offset, width);
+                sums.squaredError += RowSquaredError(candidateRow, referenceRow, width);
+                if (flicker) {
+                    sums.flicker += RowFlicker(m_candidateLuma.data() + offset, m_previousCandidateLuma.data() + offset,
+                                               m_referenceLuma.data() + offset, m_previousReferenceLuma.data() + offset,
+                                               width);
+                }
+            }
+        }
+    });
+
+    // SSIM : la luminance de toutes les lignes est disponible
+    m_pool.ParallelFor(bandCount, 1, [&](int begin, int end) {
+        for (int band = begin; band < end; ++band) {
+            BandSums& sums = m_bands[band];
+            int lastTop = std::min((band + 1) * kBandRows, height - kWindowSize + 1);
+            for (int y = band * kBandRows; y < lastTop; y += kWindowStep) {
+                const uint8_t* candidateRow = m_candidateLuma.data() + static_cast<size_t>(y) * lumaStride;
+                const uint8_t* referenceRow = m_referenceLuma.data() + static_cast<size_t>(y) * lumaStride;
+                for (int x = 0; x + kWindowSize <= width; x += kWindowStep) {
+                    sums.ssim += WindowSsim(candidateRow + x, referenceRow + x, lumaStride);
+                    sums.windows++;
+                }
+            }
+        }
+    });
+
+    BandSums total;
+    for (const BandSums& sums : m_bands) {
+        total.squaredError += sums.squaredError;
+        total.flicker += sums.flicker;
+        total.ssim += sums.ssim;
+        total.windows += sums.windows;
+    }
+
+    const double pixels = static_cast<double>(width) * static_cast<double>(height);
+    quality.mse = static_cast<double>(total.squaredError) / (pixels * 3.0);
+    quality.psnr = quality.mse > 0.0 ? std::min(kMaxPsnr, 10.0 * std::log10(255.0 * 255.0 / quality.mse)) : kMaxPsnr;
+    if (total.windows > 0) {
+        quality.ssim = total.ssim / static_cast<double>(total.windows);
+    } else {
+        quality.ssim = quality.mse > 0.0 ? 0.0 : 1.0;
+    }
+    quality.hasFlicker = flicker;
+    quality.flicker = flicker ? static_cast<double>(total.flicker) / pixels : 0.0;
+
+    m_candidateLuma.swap(m_previousCandidateLuma);
+    m_referenceLuma.swap(m_previousReferenceLuma);
+    m_hasPrevious = true;
+    return quality;
+}
+
+} // namespace Benchmark
+} // namespace XIS
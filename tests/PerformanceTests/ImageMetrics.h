@@ -0,0 +1,89 @@
+#pragma once
+
+/**
+ * @brief Mesures de qualité d'image pour les benchmarks
+ *
+ * PSNR sur les canaux RGB, SSIM et scintillement temporel sur la luminance,
+ * calculés entre une séquence candidate et une séquence de référence de même
+ * taille (RGBA 8 bits). Les kernels sont vectorisés (SSE2 lorsque
+ * disponible) et répartis par bandes de lignes sur un CPUWorkerPool.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace XIS {
+
+class CPUWorkerPool;
+
+namespace Benchmark {
+
+/**
+ * @brief Qualité d'une frame candidate par rapport à la référence
+ */
+struct FrameQuality {
+    double mse = 0.0;                     // Erreur quadratique moyenne RGB (niveaux²)
+    double psnr = 0.0;                    // dB, plafonné à kMaxPsnr pour des images identiques
+    double ssim = 0.0;                    // [-1, 1], 1 pour des images identiques
+    double flicker = 0.0;                 // Écart moyen des variations temporelles de luminance (niveaux)
+    bool hasFlicker = false;              // false pour la première frame de la séquence
+};
+
+/**
+ * @brief Comparaison frame par frame d'une séquence candidate à une référence
+ *
+ * Le SSIM est calculé sur des fenêtres 8x8 espacées de 4 pixels. Le
+ * scintillement compare la variation de luminance d'une frame à la suivante
+ * dans les deux séquences : un traitement stable dans le temps suit les
+ * variations de la référence, un traitement instable en ajoute. Il est
+ * donc nul pour la première frame, et Reset doit être appelé entre deux
+ * séquences.
+ */
+class QualityEvaluator {
+public:
+    static constexpr double kMaxPsnr = 100.0;
+
+    explicit QualityEvaluator(CPUWorkerPool& pool);
+
+    /**
+     * @brief Oublie la frame précédente (nouvelle séquence)
+     */
+    void Reset();
+
+    /**
+     * @brief Compare la frame suivante de la séquence
+     *
+     * @param candidate Pixels RGBA 8 bits de la frame candidate
+     * @param candidatePitch Octets entre deux lignes de la frame candidate
+     * @param reference Pixels RGBA 8 bits de la frame de référence
+     * @param referencePitch Octets entre deux lignes de la frame de référence
+     */
+    FrameQuality Compare(const uint8_t* candidate, size_t candidatePitch,
+                         const uint8_t* reference, size_t referencePitch,
+                         int width, int height);
+
+private:
+    struct BandSums {
+        uint64_t squaredError = 0;
+        uint64_t flicker = 0;
+        double ssim = 0.0;
+        uint64_t windows = 0;
+    };
+
+    CPUWorkerPool& m_pool;
+    int m_width = 0;
+    int m_height = 0;
+    bool m_hasPrevious = false;
+
+    // Luminance des frames courante et précédente des deux séquences
+    std::vector<uint8_t> m_candidateLuma;
+    std::vector<uint8_t> m_referenceLuma;
+    std::vector<uint8_t> m_previousCandidateLuma;
+    std::vector<uint8_t> m_previousReferenceLuma;
+
+    std::vector<BandSums> m_bands;        // Sommes partielles, une par bande
+};
+
+} // namespace Benchmark
+} // namespace XIS
@@ -0,0 +1,782 @@
+/**
+ * @brief Microbenchmarks des kernels CPU
+ *
+ * Mesure chaque kernel du backend CPU isolément, hors pipeline : mêmes
+ * liaisons que celles posées par les étapes, mais sans session, sans
+ * décorateurs de profilage et sans copies intermédiaires. Chaque kernel est
+ * décliné par variante (format des textures, qui sélectionne les chemins de
+ * lecture et d'écriture, ou implémentation SIMD pour la fonction de coût de
+ * l'estimation de mouvement), par nombre de threads et par taille de tuile
+ * (lignes par tâche du pool).
+ *
+ * Chaque combinaison est mesurée cache chaud (données déjà lues par
+ * l'exécution précédente) et cache froid (cache vidé avant chaque
+ * exécution). Les résultats sont le temps médian, les nanosecondes et cycles
+ * par pixel, et le débit en Go/s calculé sur le trafic minimal du kernel
+ * (chaque entrée lue et chaque sortie écrite une fois).
+ *
+ * Exemple :
+ *   KernelBenchmark --size 1920x1080 --threads 1,0 --tiles 1,8,32,0 \
+ *                   --kernels BicubicUpscaleCS,BlockSAD --output kernels.json
+ */
+
+#include "../../src/Renderer/CPU/CPUKernels.h"
+#include "../../src/Renderer/CPU/CPUWorkerPool.h"
+#include "BenchmarkSupport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define XIS_BENCHMARK_TSC 1
+#endif
+
+using namespace XIS;
+using namespace XIS::Benchmark;
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Options
+// ---------------------------------------------------------------------------
+
+struct Options {
+    uint32_t width = 1920;                // Résolution de sortie de référence
+    uint32_t height = 1080;
+    std::vector<uint32_t> threadCounts = { 1, 0 };
+    std::vector<int> tiles = { 1, 8, 32, 0 };   // Lignes par tâche, 0 = choix du CPURenderer
+    std::vector<std::string> kernels;     // Vide = tous
+    uint32_t iterations = 15;
+    uint32_t warmupIterations = 2;
+    size_t flushBytes = 0;                // 0 = quatre fois le dernier niveau de cache
+    std::string outputPath;
+};
+
+void PrintUsage()
+{
+    std::fprintf(stderr,
+        "Usage: KernelBenchmark [options]\n"
+        "  --size WxH           Résolution de sortie de référence (défaut : 1920x1080)\n"
+        "  --threads LIST       Threads de calcul, 0 = tous les cœurs (défaut : 1,0)\n"
+        "  --tiles LIST         Lignes par tâche, 0 = automatique (défaut : 1,8,32,0)\n"
+        "  --kernels LIST       BicubicUpscaleCS, BlockSAD, MotionEstimationCS,\n"
+        "                       MotionRefinementCS, FrameInterpolationCS,\n"
+        "                       PSAntiAliasing, PSDownsample (défaut : tous)\n"
+        "  --iterations N       Exécutions mesurées par combinaison (défaut : 15)\n"
+        "  --warmup N           Exécutions non mesurées (défaut : 2)\n"
+        "  --flush-mb N         Taille du tampon de vidage de cache (défaut : 4 x LLC)\n"
+        "  --output FILE        Fichier JSON (défaut : sortie standard)\n");
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h" || i + 1 >= argc) {
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--size") {
+            if (!ParseSize(value, options.width, options.height)) {
+                std::fprintf(stderr, "Taille invalide : %s\n", value.c_str());
+                return false;
+            }
+        } else if (arg == "--threads") {
+            options.threadCounts.clear();
+            for (const std::string& part : Split(value)) {
+                options.threadCounts.push_back(static_cast<uint32_t>(std::atoi(part.c_str())));
+            }
+        } else if (arg == "--tiles") {
+            options.tiles.clear();
+            for (const std::string& part : Split(value)) {
+                options.tiles.push_back(std::max(0, std::atoi(part.c_str())));
+            }
+        } else if (arg == "--kernels") {
+            options.kernels = Split(value);
+        } else if (arg == "--iterations") {
+            options.iterations = static_cast<uint32_t>(std::max(1, std::atoi(value.c_str())));
+        } else if (arg == "--warmup") {
+            options.warmupIterations = static_cast<uint32_t>(std::max(0, std::atoi(value.c_str())));
+        } else if (arg == "--flush-mb") {
+            options.flushBytes = static_cast<size_t>(std::max(1, std::atoi(value.c_str()))) << 20;
+        } else if (arg == "--output") {
+            options.outputPath = value;
+        } else {
+            std::fprintf(stderr, "Option inconnue : %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    return !options.threadCounts.empty() && !options.tiles.empty();
+}
+
+bool IsSelected(const Options& options, const char* kernel)
+{
+    return options.kernels.empty() ||
+           std::find(options.kernels.begin(), options.kernels.end(), kernel) != options.kernels.end();
+}
+
+// ---------------------------------------------------------------------------
+// Cache et horloge
+// ---------------------------------------------------------------------------
+
+// Taille du dernier niveau de cache, 32 Mo si elle n'est pas publiée
+size_t GetLastLevelCacheSize()
+{
+    long size = 0;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (size <= 0) {
+        size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+#endif
+    return size > 0 ? static_cast<size_t>(size) : (32u << 20);
+}
+
+/**
+ * Évince les données du kernel en écrivant puis relisant un tampon plus
+ * grand que le dernier niveau de cache
+ */
+class CacheFlusher {
+public:
+    explicit CacheFlusher(size_t bytes) : m_buffer(bytes / sizeof(uint64_t), 0) {}
+
+    void Flush()
+    {
+        m_round++;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < m_buffer.size(); i += 8) {
+            m_buffer[i] += m_round;
+            sum += m_buffer[i];
+        }
+        m_sink = sum;
+    }
+
+    size_t GetSize() const { return m_buffer.size() * sizeof(uint64_t); }
+
+private:
+    std::vector<uint64_t> m_buffer;
+    uint64_t m_round = 0;
+    volatile uint64_t m_sink = 0;
+};
+
+inline uint64_t ReadCycleCounter()
+{
+#if XIS_BENCHMARK_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Ressources
+// ---------------------------------------------------------------------------
+
+struct DownsampleConstants {
+    float downsampleFactor;
+    float preserveDetail;
+    float threshold;
+    float reserved;
+};
+
+struct AAConstants {
+    float threshold;
+    float blendFactor;
+    int kernelSize;
+    float reserved;
+};
+
+struct BicubicConstants {
+    int inputWidth;
+    int inputHeight;
+    int outputWidth;
+    int outputHeight;
+    float sharpnessFactor;
+    float padding[3];
+};
+
+struct MotionConstants {
+    int frameWidth;
+    int frameHeight;
+    int blockSize;
+    int searchRadius;
+    float temporalWeight;
+    float spatialWeight;
+    int padding[2];
+};
+
+struct InterpolationConstants {
+    int frameWidth;
+    int frameHeight;
+    float qualityFactor;
+    int useOcclusion;
+};
+
+/**
+ * Ressources d'un kernel ; libérées avec lui
+ */
+class Fixture {
+public:
+    ~Fixture()
+    {
+        for (CPUResource* resource : m_resources) {
+            ReleaseCPUResource(resource);
+        }
+    }
+
+    // Texture remplie d'un motif à contours nets, décalé de shift pixels
+    CPUTexture* Texture(int width, int height, CPUTextureFormat format, int shift = 0)
+    {
+        CPUTexture* texture = Track(CreateCPUTexture(width, height, format));
+        for (int y = 0; y < height; ++y) {
+            uint8_t* row = texture->GetRow(y);
+            for (int x = 0; x < width; ++x) {
+                int sx = x - shift;
+                float checker = (((sx >> 4) ^ (y >> 4)) & 1) ? 0.8f : 0.2f;
+                float gradient = static_cast<float>((sx * 7 + y * 3) & 255) / 255.0f;
+                float value[4] = { checker, 0.5f * (checker + gradient), gradient, 1.0f };
+                WriteTexel(*texture, row, x, value);
+            }
+        }
+        return texture;
+    }
+
+    CPUBuffer* Buffer(size_t size, int stride = 0)
+    {
+        return Track(CreateCPUBuffer(size, stride));
+    }
+
+    template <typename T>
+    CPUBuffer* Constants(const T& value)
+    {
+        CPUBuffer* buffer = Buffer(sizeof(T));
+        std::memcpy(buffer->data, &value, sizeof(T));
+        return buffer;
+    }
+
+private:
+    template <typename T>
+    T* Track(T* resource)
+    {
+        if (!resource) {
+            std::fprintf(stderr, "Allocation impossible\n");
+            std::exit(2);
+        }
+        m_resources.push_back(resource);
+        return resource;
+    }
+
+    static void WriteTexel(CPUTexture& texture, uint8_t* row, int x, const float value[4])
+    {
+        switch (texture.format) {
+        case CPUTextureFormat::RGBA8:
+            for (int c = 0; c < 4; ++c) {
+                row[x * 4 + c] = static_cast<uint8_t>(value[c] * 255.0f + 0.5f);
+            }
+            break;
+        case CPUTextureFormat::R32F:
+            reinterpret_cast<float*>(row)[x] = value[0];
+            break;
+        case CPUTextureFormat::RG32F:
+            std::memcpy(row + x * 8, value, 8);
+            break;
+        case CPUTextureFormat::RGBA32F:
+            std::memcpy(row + x * 16, value, 16);
+            break;
+        }
+    }
+
+    std::vector<CPUResource*> m_resources;
+};
+
+uint64_t TextureBytes(const CPUTexture& texture)
+{
+    return static_cast<uint64_t>(texture.width) * texture.height * GetCPUFormatSize(texture.format);
+}
+
+// Poids Catmull-Rom pour kBicubicPrecision positions fractionnaires
+void FillBicubicWeights(CPUBuffer& buffer)
+{
+    float* weights = reinterpret_cast<float*>(buffer.data);
+    for (int i = 0; i < 256; ++i) {
+        float t = i / 256.0f;
+        float t2 = t * t;
+        float t3 = t2 * t;
+        weights[i * 4 + 0] = 0.5f * (-t3 + 2.0f * t2 - t);
+        weights[i * 4 + 1] = 0.5f * (3.0f * t3 - 5.0f * t2 + 2.0f);
+        weights[i * 4 + 2] = 0.5f * (-3.0f * t3 + 4.0f * t2 + t);
+        weights[i * 4 + 3] = 0.5f * (t3 - t2);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Charges de travail
+// ---------------------------------------------------------------------------
+
+/**
+ * Un kernel dans une variante donnée, prêt à être exécuté par bandes de lignes
+ */
+struct Workload {
+    std::string kernel;
+    std::string variant;
+    int rows = 0;                         // Lignes (ou lignes de blocs) à répartir
+    uint64_t pixels = 0;                  // Pixels produits (ou comparés) par exécution
+    uint64_t bytes = 0;                   // Trafic minimal par exécution
+    std::shared_ptr<Fixture> fixture;
+    std::function<void(int, int, FrameArena&)> run;
+};
+
+const char* FormatName(CPUTextureFormat format)
+{
+    switch (format) {
+    case CPUTextureFormat::RGBA8: return "rgba8";
+    case CPUTextureFormat::R32F: return "r32f";
+    case CPUTextureFormat::RG32F: return "rg32f";
+    case CPUTextureFormat::RGBA32F: return "rgba32f";
+    }
+    return "unknown";
+}
+
+/**
+ * Lie un kernel du backend : prepare fixe les zones valides, run traite
+ * ensuite les bandes de lignes
+ */
+bool BindKernel(Workload& workload, const char* entryPoint, const std::shared_ptr<CPUKernelBindings>& bindings)
+{
+    const CPUKernel* kernel = FindCPUKernel(entryPoint);
+    int rows = kernel ? kernel->prepare(*bindings) : -1;
+    if (rows <= 0) {
+        std::fprintf(stderr, "%s (%s) : liaisons invalides\n", entryPoint, workload.variant.c_str());
+        return false;
+    }
+
+    workload.rows = rows;
+    workload.run = [kernel, bindings](int rowBegin, int rowEnd, FrameArena& scratch) {
+        kernel->run(*bindings, rowBegin, rowEnd, scratch);
+    };
+    return true;
+}
+
+const CPUTextureFormat kColorFormats[] = { CPUTextureFormat::RGBA8, CPUTextureFormat::RGBA32F };
+
+void AddBicubic(const Options& options, std::vector<Workload>& workloads)
+{
+    for (CPUTextureFormat format : kColorFormats) {
+        Workload workload;
+        workload.kernel = "BicubicUpscaleCS";
+        workload.variant = std::string(FormatName(format)) + "/x2";
+        workload.fixture = std::make_shared<Fixture>();
+
+        int inWidth = static_cast<int>(options.width / 2);
+        int inHeight = static_cast<int>(options.height / 2);
+        CPUTexture* input = workload.fixture->Texture(inWidth, inHeight, format);
+        CPUTexture* output = workload.fixture->Texture(options.width, options.height, format);
+        CPUBuffer* weights = workload.fixture->Buffer(sizeof(float) * 256 * 4, sizeof(float) * 4);
+        FillBicubicWeights(*weights);
+
+        auto bindings = std::make_shared<CPUKernelBindings>();
+        bindings->shaderResources[0] = input;
+        bindings->shaderResources[1] = weights;
+        bindings->unorderedAccess[0] = output;
+        bindings->constantBuffers[0] = workload.fixture->Constants(BicubicConstants{
+            inWidth, inHeight, static_cast<int>(options.width), static_cast<int>(options.height), 0.0f, {} });
+
+        if (BindKernel(workload, "BicubicUpscaleCS", bindings)) {
+            workload.pixels = static_cast<uint64_t>(output->width) * output->height;
+            workload.bytes = TextureBytes(*input) + TextureBytes(*output) + weights->size;
+            workloads.push_back(workload);
+        }
+    }
+}
+
+void AddDownsample(const Options& options, std::vector<Workload>& workloads)
+{
+    for (CPUTextureFormat format : kColorFormats) {
+        Workload workload;
+        workload.kernel = "PSDownsample";
+        workload.variant = std::string(FormatName(format)) + "/x0.5";
+        workload.fixture = std::make_shared<Fixture>();
+
+        CPUTexture* input = workload.fixture->Texture(options.width, options.height, format);
+        CPUTexture* output = workload.fixture->Texture(options.width, options.height, format);
+
+        auto bindings = std::make_shared<CPUKernelBindings>();
+        bindings->shaderResources[0] = input;
+        bindings->unorderedAccess[0] = output;
+        bindings->constantBuffers[0] = workload.fixture->Constants(DownsampleConstants{ 0.5f, 1.0f, 0.1f, 0.0f });
+
+        if (BindKernel(workload, "PSDownsample", bindings)) {
+            workload.pixels = static_cast<uint64_t>(output->width) * output->height;
+            workload.bytes = TextureBytes(*input) + TextureBytes(*output);
+            workloads.push_back(workload);
+        }
+    }
+}
+
+void AddAntiAliasing(const Options& options, std::vector<Workload>& workloads)
+{
+    // Seuil nul : tous les pixels prennent le chemin de lissage (pire cas) ;
+    // seuil 0.1 : seuls les contours du motif sont lissés
+    const float thresholds[] = { 0.0f, 0.1f };
+
+    for (CPUTextureFormat format : kColorFormats) {
+        for (float threshold : thresholds) {
+            Workload workload;
+            workload.kernel = "PSAntiAliasing";
+            workload.variant = std::string(FormatName(format)) + (threshold > 0.0f ? "/edges" : "/all");
+            workload.fixture = std::make_shared<Fixture>();
+
+            CPUTexture* input = workload.fixture->Texture(options.width, options.height, format);
+            CPUTexture* output = workload.fixture->Texture(options.width, options.height, format);
+
+            auto bindings = std::make_shared<CPUKernelBindings>();
+            bindings->shaderResources[0] = input;
+            bindings->unorderedAccess[0] = output;
+            bindings->constantBuffers[0] = workload.fixture->Constants(AAConstants{ threshold, 0.5f, 3, 0.0f });
+
+            if (BindKernel(workload, "PSAntiAliasing", bindings)) {
+                workload.pixels = static_cast<uint64_t>(output->width) * output->height;
+                workload.bytes = TextureBytes(*input) + TextureBytes(*output);
+                workloads.push_back(workload);
+            }
+        }
+    }
+}
+
+MotionConstants MakeMotionConstants(const Options& options, int blockSize)
+{
+    return MotionConstants{ static_cast<int>(options.width), static_cast<int>(options.height), blockSize, 16, 0.5f, 0.5f, {} };
+}
+
+void AddMotionEstimation(const Options& options, std::vector<Workload>& workloads)
+{
+    const int blockSizes[] = { 8, 16 };
+
+    for (CPUTextureFormat format : kColorFormats) {
+        for (int blockSize : blockSizes) {
+            Workload workload;
+            workload.kernel = "MotionEstimationCS";
+            workload.variant = std::string(FormatName(format)) + "/block" + std::to_string(blockSize);
+            workload.fixture = std::make_shared<Fixture>();
+
+            CPUTexture* previous = workload.fixture->Texture(options.width, options.height, format, 0);
+            CPUTexture* current = workload.fixture->Texture(options.width, options.height, format, 5);
+            size_t blocks = static_cast<size_t>((options.width + blockSize - 1) / blockSize) *
+                            ((options.height + blockSize - 1) / blockSize);
+            CPUBuffer* blockMotion = workload.fixture->Buffer(blocks * sizeof(float) * 4, sizeof(float) * 4);
+
+            auto bindings = std::make_shared<CPUKernelBindings>();
+            bindings->shaderResources[0] = previous;
+            bindings->shaderResources[1] = current;
+            bindings->unorderedAccess[0] = blockMotion;
+            bindings->constantBuffers[0] = workload.fixture->Constants(MakeMotionConstants(options, blockSize));
+
+            if (BindKernel(workload, "MotionEstimationCS", bindings)) {
+                workload.pixels = static_cast<uint64_t>(options.width) * options.height;
+                workload.bytes = TextureBytes(*previous) + TextureBytes(*current) + blockMotion->size;
+                workloads.push_back(workload);
+            }
+        }
+    }
+}
+
+/**
+ * Fonction de coût seule : un SAD par bloc, au déplacement fixe (3, 2), sur
+ * toute l'image. Exécuté par lignes de blocs, comme MotionEstimationCS.
+ */
+void AddBlockSAD(const Options& options, std::vector<Workload>& workloads)
+{
+    const struct {
+        CPUBlockSADVariant variant;
+        const char* name;
+    } variants[] = {
+        { CPUBlockSADVariant::Scalar, "scalar" },
+        { CPUBlockSADVariant::SSE2, "sse2" },
+    };
+    const int blockSizes[] = { 8, 16, 32 };
+    const int dx = 3;
+    const int dy = 2;
+
+    for (const auto& variant : variants) {
+        CPUBlockSADFn sad = GetCPUBlockSAD(variant.variant);
+        if (!sad) {
+            continue;
+        }
+
+        for (int blockSize : blockSizes) {
+            Workload workload;
+            workload.kernel = "BlockSAD";
+            workload.variant = std::string(variant.name) + "/block" + std::to_string(blockSize);
+            workload.fixture = std::make_shared<Fixture>();
+
+            CPUTexture* previous = workload.fixture->Texture(options.width, options.height, CPUTextureFormat::RGBA8, 0);
+            CPUTexture* current = workload.fixture->Texture(options.width, options.height, CPUTextureFormat::RGBA8, 5);
+
+            // Blocs entièrement dans l'image après déplacement
+            const int gridWidth = (previous->width - dx) / blockSize;
+            const int gridHeight = (previous->height - dy) / blockSize;
+            auto checksum = std::make_shared<std::vector<uint32_t>>(gridHeight);
+
+            workload.rows = gridHeight;
+            workload.pixels = static_cast<uint64_t>(gridWidth) * gridHeight * blockSize * blockSize;
+            workload.bytes = workload.pixels * 8;
+            workload.run = [=](int rowBegin, int rowEnd, FrameArena&) {
+                for (int by = rowBegin; by < rowEnd; ++by) {
+                    uint32_t sum = 0;
+                    for (int bx = 0; bx < gridWidth; ++bx) {
+                        sum += sad(previous->GetRow(by * blockSize) + static_cast<size_t>(bx * blockSize) * 4, previous->pitch,
+                                   current->GetRow(by * blockSize + dy) + static_cast<size_t>(bx * blockSize + dx) * 4, current->pitch,
+                                   blockSize, blockSize);
+                    }
+                    (*checksum)[by] = sum;
+                }
+            };
+            workloads.push_back(workload);
+        }
+    }
+}
+
+void AddMotionRefinement(const Options& options, std::vector<Workload>& workloads)
+{
+    const CPUTextureFormat formats[] = { CPUTextureFormat::RGBA8, CPUTextureFormat::RG32F };
+    const int blockSize = 16;
+
+    for (CPUTextureFormat format : formats) {
+        Workload workload;
+        workload.kernel = "MotionRefinementCS";
+        workload.variant = std::string(FormatName(format)) + "/block" + std::to_string(blockSize);
+        workload.fixture = std::make_shared<Fixture>();
+
+        int gridWidth = static_cast<int>((options.width + blockSize - 1) / blockSize);
+        int gridHeight = static_cast<int>((options.height + blockSize - 1) / blockSize);
+        CPUBuffer* blockMotion = workload.fixture->Buffer(static_cast<size_t>(gridWidth) * gridHeight * sizeof(float) * 4, sizeof(float) * 4);
+        float* blocks = reinterpret_cast<float*>(blockMotion->data);
+        for (int i = 0; i < gridWidth * gridHeight; ++i) {
+            blocks[i * 4 + 0] = static_cast<float>(i % 7 - 3);
+            blocks[i * 4 + 1] = static_cast<float>(i % 5 - 2);
+            blocks[i * 4 + 2] = 0.25f + 0.5f * static_cast<float>(i % 3) / 2.0f;
+        }
+        CPUTexture* motionVectors = workload.fixture->Texture(options.width, options.height, format);
+
+        auto bindings = std::make_shared<CPUKernelBindings>();
+        bindings->shaderResources[0] = blockMotion;
+        bindings->unorderedAccess[0] = motionVectors;
+        bindings->constantBuffers[0] = workload.fixture->Constants(MakeMotionConstants(options, blockSize));
+
+        if (BindKernel(workload, "MotionRefinementCS", bindings)) {
+            workload.pixels = static_cast<uint64_t>(motionVectors->width) * motionVectors->height;
+            workload.bytes = blockMotion->size + TextureBytes(*motionVectors);
+            workloads.push_back(workload);
+        }
+    }
+}
+
+void AddFrameInterpolation(const Options& options, std::vector<Workload>& workloads)
+{
+    const bool occlusionSettings[] = { false, true };
+
+    for (CPUTextureFormat format : kColorFormats) {
+        for (bool useOcclusion : occlusionSettings) {
+            Workload workload;
+            workload.kernel = "FrameInterpolationCS";
+            workload.variant = std::string(FormatName(format)) + (useOcclusion ? "/occlusion" : "/blend");
+            workload.fixture = std::make_shared<Fixture>();
+
+            CPUTexture* previous = workload.fixture->Texture(options.width, options.height, format, 0);
+            CPUTexture* current = workload.fixture->Texture(options.width, options.height, format, 5);
+            CPUTexture* motionVectors = workload.fixture->Texture(options.width, options.height, CPUTextureFormat::RG32F);
+            for (uint32_t y = 0; y < options.height; ++y) {
+                float* row = reinterpret_cast<float*>(motionVectors->GetRow(static_cast<int>(y)));
+                for (uint32_t x = 0; x < options.width; ++x) {
+                    row[x * 2 + 0] = 5.0f;
+                    row[x * 2 + 1] = 0.0f;
+                }
+            }
+            CPUTexture* output = workload.fixture->Texture(options.width, options.height, format);
+            CPUTexture* occlusion = workload.fixture->Texture(options.width, options.height, CPUTextureFormat::R32F);
+
+            auto bindings = std::make_shared<CPUKernelBindings>();
+            bindings->shaderResources[0] = previous;
+            bindings->shaderResources[1] = current;
+            bindings->shaderResources[2] = motionVectors;
+            bindings->unorderedAccess[0] = output;
+            bindings->unorderedAccess[1] = occlusion;
+            bindings->constantBuffers[0] = workload.fixture->Constants(InterpolationConstants{
+                static_cast<int>(options.width), static_cast<int>(options.height), 1.0f, useOcclusion ? 1 : 0 });
+
+            if (BindKernel(workload, "FrameInterpolationCS", bindings)) {
+                workload.pixels = static_cast<uint64_t>(output->width) * output->height;
+                workload.bytes = TextureBytes(*previous) + TextureBytes(*current) + TextureBytes(*motionVectors) +
+                                 TextureBytes(*output) + (useOcclusion ? TextureBytes(*occlusion) : 0);
+                workloads.push_back(workload);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Mesure
+// ---------------------------------------------------------------------------
+
+struct Measurement {
+    double medianMs = 0.0;
+    double minMs = 0.0;
+    double cyclesPerPixel = 0.0;          // Cycles de référence (TSC), 0 si indisponible
+};
+
+Measurement Measure(const Options& options, const Workload& workload, CPUWorkerPool& pool, int grain,
+                    bool cold, CacheFlusher& flusher)
+{
+    auto execute = [&]() {
+        pool.ParallelFor(workload.rows, grain, [&workload](int rowBegin, int rowEnd, FrameArena& scratch) {
+            workload.run(rowBegin, rowEnd, scratch);
+        });
+    };
+
+    for (uint32_t i = 0; i < options.warmupIterations; ++i) {
+        execute();
+    }
+
+    std::vector<double> times(options.iterations);
+    std::vector<double> cycles(options.iterations);
+    for (uint32_t i = 0; i < options.iterations; ++i) {
+        if (cold) {
+            flusher.Flush();
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        uint64_t startCycles = ReadCycleCounter();
+        execute();
+        uint64_t endCycles = ReadCycleCounter();
+        times[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        cycles[i] = static_cast<double>(endCycles - startCycles);
+    }
+
+    std::vector<double> sortedCycles = cycles;
+    std::nth_element(sortedCycles.begin(), sortedCycles.begin() + sortedCycles.size() / 2, sortedCycles.end());
+
+    Measurement measurement;
+    measurement.minMs = *std::min_element(times.begin(), times.end());
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    measurement.medianMs = times[times.size() / 2];
+    measurement.cyclesPerPixel = sortedCycles[sortedCycles.size() / 2] / static_cast<double>(std::max<uint64_t>(1, workload.pixels));
+    return measurement;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+
+    std::vector<Workload> workloads;
+    if (IsSelected(options, "BicubicUpscaleCS")) AddBicubic(options, workloads);
+    if (IsSelected(options, "BlockSAD")) AddBlockSAD(options, workloads);
+    if (IsSelected(options, "MotionEstimationCS")) AddMotionEstimation(options, workloads);
+    if (IsSelected(options, "MotionRefinementCS")) AddMotionRefinement(options, workloads);
+    if (IsSelected(options, "FrameInterpolationCS")) AddFrameInterpolation(options, workloads);
+    if (IsSelected(options, "PSAntiAliasing")) AddAntiAliasing(options, workloads);
+    if (IsSelected(options, "PSDownsample")) AddDownsample(options, workloads);
+
+    if (workloads.empty()) {
+        std::fprintf(stderr, "Aucun kernel à mesurer\n");
+        return 2;
+    }
+
+    CacheFlusher flusher(options.flushBytes ? options.flushBytes : GetLastLevelCacheSize() * 4);
+
+    JsonWriter json;
+    json.BeginObject();
+    json.String("benchmark", "XIS KernelBenchmark");
+    json.Integer("formatVersion", 1);
+    WriteMachine(json);
+
+    json.BeginObject("settings");
+    json.Integer("width", options.width);
+    json.Integer("height", options.height);
+    json.Integer("iterations", options.iterations);
+    json.Integer("warmupIterations", options.warmupIterations);
+    json.Integer("flushBytes", flusher.GetSize());
+    json.Bool("cycleCounter", ReadCycleCounter() != 0);
+    json.EndObject();
+
+    std::fprintf(stderr, "%-22s %-18s %7s %5s %-5s %9s %8s %9s %8s\n",
+                 "Kernel", "Variante", "Threads", "Tuile", "Cache", "Médiane", "ns/px", "cycles/px", "Go/s");
+
+    json.BeginArray("results");
+    for (uint32_t threads : options.threadCounts) {
+        CPUWorkerPool pool(threads);
+
+        for (const Workload& workload : workloads) {
+            for (int tile : options.tiles) {
+                // 0 : même découpage que CPURenderer
+                int grain = tile > 0 ? tile : std::max(1, workload.rows / static_cast<int>(pool.GetThreadCount() * 4));
+                if (tile > workload.rows) {
+                    continue;
+                }
+
+                for (bool cold : { false, true }) {
+                    Measurement measurement = Measure(options, workload, pool, grain, cold, flusher);
+                    double nsPerPixel = measurement.medianMs * 1e6 / static_cast<double>(workload.pixels);
+                    double gbps = static_cast<double>(workload.bytes) / (measurement.medianMs * 1e6);
+
+                    std::fprintf(stderr, "%-22s %-18s %7u %5d %-5s %7.3fms %8.2f %9.1f %8.2f\n",
+                                 workload.kernel.c_str(), workload.variant.c_str(), pool.GetThreadCount(), grain,
+                                 cold ? "froid" : "chaud", measurement.medianMs, nsPerPixel, measurement.cyclesPerPixel, gbps);
+
+                    json.BeginObject();
+                    json.String("kernel", workload.kernel);
+                    json.String("variant", workload.variant);
+                    json.Integer("threads", pool.GetThreadCount());
+                    json.Integer("tileRows", static_cast<uint64_t>(grain));
+                    json.Bool("autoTile", tile == 0);
+                    json.String("cache", cold ? "cold" : "warm");
+                    json.Integer("pixels", workload.pixels);
+                    json.Integer("bytes", workload.bytes);
+                    json.Number("medianMs", measurement.medianMs);
+                    json.Number("minMs", measurement.minMs);
+                    json.Number("nsPerPixel", nsPerPixel);
+                    json.Number("cyclesPerPixel", measurement.cyclesPerPixel);
+                    json.Number("gbps", gbps);
+                    json.EndObject();
+                }
+            }
+        }
+    }
+    json.EndArray();
+    json.EndObject();
+
+    std::string text = json.GetText() + "\n";
+    if (options.outputPath.empty()) {
+        std::fputs(text.c_str(), stdout);
+        return 0;
+    }
+
+    FILE* file = std::fopen(options.outputPath.c_str(), "w");
+    if (!file || std::fputs(text.c_str(), file) < 0) {
+        std::fprintf(stderr, "Impossible d'écrire %s\n", options.outputPath.c_str());
+        if (file) {
+            std::fclose(file);
+        }
+        return 1;
+    }
+    std::fclose(file);
+    return 0;
+}
@@ -0,0 +1,486 @@
+/**
+ * @brief Benchmark de bout en bout du pipeline XIS
+ *
+ * Exécute le pipeline complet (XIS::ProcessFrame → Pipeline::Execute) sur le
+ * backend CPU, sans GPU ni affichage, pour chaque combinaison de résolution
+ * de sortie, rapport d'échelle, qualité d'AA, mode de génération de frames et
+ * nombre de threads demandée. Les frames sont synthétiques (motif en
+ * mouvement) ou lues depuis une séquence enregistrée (RGBA 8 bits brut).
+ *
+ * Le résultat est un document JSON : description de la machine, puis pour
+ * chaque configuration le débit, les centiles de latence par frame et par
+ * étape, le trafic mémoire par étape, la mémoire maximale (session et
+ * processus) et un échantillon par répétition pour les comparaisons
+ * statistiques entre versions.
+ *
+ * Exemple :
+ *   PipelineBenchmark --resolutions 1080p,4K --scales 1.5,2 --aa off,high \
+ *                     --framegen off,mc --threads 1,0 --output results.json
+ */
+
+#include "../../include/XIS/XIS.h"
+#include "BenchmarkSupport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace XIS;
+using namespace XIS::Benchmark;
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Options
+// ---------------------------------------------------------------------------
+
+struct Options {
+    std::vector<Resolution> resolutions;
+    std::vector<float> scales;
+    std::vector<AASetting> aaSettings;
+    std::vector<FrameGenSetting> frameGenSettings;
+    std::vector<uint32_t> threadCounts;
+
+    uint32_t frames = 30;                 // Frames mesurées par répétition
+    uint32_t warmupFrames = 5;
+    uint32_t repetitions = 8;             // Échantillons pour RegressionGate (5 au minimum)
+    double maxSeconds = 20.0;             // Durée de mesure maximale par configuration
+    uint32_t sequenceLength = 4;          // Frames synthétiques distinctes
+
+    std::string inputPath;                // Séquence enregistrée (RGBA 8 bits brut)
+    uint32_t inputWidth = 0;
+    uint32_t inputHeight = 0;
+
+    std::string outputPath;               // Vide = sortie standard
+};
+
+void PrintUsage()
+{
+    std::fprintf(stderr,
+        "Usage: PipelineBenchmark [options]\n"
+        "  --resolutions LIST   Résolutions de sortie : 720p,1080p,1440p,4K,8K ou LxH (défaut : toutes)\n"
+        "  --scales LIST        Rapports sortie/entrée (défaut : 1.5,2)\n"
+        "  --aa LIST            off,low,medium,high (défaut : medium)\n"
+        "  --framegen LIST      off,interp,mc,advanced (défaut : mc)\n"
+        "  --threads LIST       Threads de calcul, 0 = tous les cœurs (défaut : 0)\n"
+        "  --frames N           Frames mesurées par répétition (défaut : 30)\n"
+        "  --warmup N           Frames de préchauffage (défaut : 5)\n"
+        "  --repetitions N      Répétitions par configuration (défaut : 8)\n"
+        "  --max-seconds S      Durée de mesure maximale par configuration (défaut : 20)\n"
+        "  --sequence N         Frames synthétiques distinctes (défaut : 4)\n"
+        "  --input FILE         Séquence enregistrée, frames RGBA 8 bits brutes concaténées\n"
+        "  --input-size LxH     Taille des frames de --input (les résolutions sont alors ignorées)\n"
+        "  --output FILE        Fichier JSON (défaut : sortie standard)\n");
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+    std::string resolutions = "720p,1080p,1440p,4K,8K";
+    std::string scales = "1.5,2";
+    std::string aa = "medium";
+    std::string frameGen = "mc";
+    std::string threads = "0";
+    std::string inputSize;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Valeur manquante pour %s\n", arg.c_str());
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--resolutions") resolutions = value;
+        else if (arg == "--scales") scales = value;
+        else if (arg == "--aa") aa = value;
+        else if (arg == "--framegen") frameGen = value;
+        else if (arg == "--threads") threads = value;
+        else if (arg == "--frames") options.frames = static_cast<uint32_t>(std::max(1, std::atoi(value.c_str())));
+        else if (arg == "--warmup") options.warmupFrames = static_cast<uint32_t>(std::max(0, std::atoi(value.c_str())));
+        else if (arg == "--repetitions") options.repetitions = static_cast<uint32_t>(std::max(1, std::atoi(value.c_str())));
+        else if (arg == "--max-seconds") options.maxSeconds = std::max(0.1, std::atof(value.c_str()));
+        else if (arg == "--sequence") options.sequenceLength = static_cast<uint32_t>(std::max(2, std::atoi(value.c_str())));
+        else if (arg == "--input") options.inputPath = value;
+        else if (arg == "--input-size") inputSize = value;
+        else if (arg == "--output") options.outputPath = value;
+        else {
+            std::fprintf(stderr, "Option inconnue : %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (!options.inputPath.empty() && !ParseSize(inputSize, options.inputWidth, options.inputHeight)) {
+        std::fprintf(stderr, "--input exige --input-size LxH\n");
+        return false;
+    }
+
+    for (const std::string& item : Split(resolutions)) {
+        Resolution resolution;
+        if (!ParseResolution(item, resolution)) {
+            std::fprintf(stderr, "Résolution invalide : %s\n", item.c_str());
+            return false;
+        }
+        options.resolutions.push_back(resolution);
+    }
+    for (const std::string& item : Split(scales)) {
+        float scale = static_cast<float>(std::atof(item.c_str()));
+        if (scale < 1.0f) {
+            std::fprintf(stderr, "Rapport d'échelle invalide (>= 1 attendu) : %s\n", item.c_str());
+            return false;
+        }
+        options.scales.push_back(scale);
+    }
+    for (const std::string& item : Split(aa)) {
+        AASetting setting;
+        if (!ParseAA(item, setting)) {
+            std::fprintf(stderr, "Qualité d'AA invalide : %s\n", item.c_str());
+            return false;
+        }
+        options.aaSettings.push_back(setting);
+    }
+    for (const std::string& item : Split(frameGen)) {
+        FrameGenSetting setting;
+        if (!ParseFrameGen(item, setting)) {
+            std::fprintf(stderr, "Mode de génération de frames invalide : %s\n", item.c_str());
+            return false;
+        }
+        options.frameGenSettings.push_back(setting);
+    }
+    for (const std::string& item : Split(threads)) {
+        options.threadCounts.push_back(static_cast<uint32_t>(std::max(0, std::atoi(item.c_str()))));
+    }
+
+    return !options.scales.empty() && !options.aaSettings.empty() &&
+           !options.frameGenSettings.empty() && !options.threadCounts.empty() &&
+           (!options.resolutions.empty() || !options.inputPath.empty());
+}
+
+// ---------------------------------------------------------------------------
+// Processus
+// ---------------------------------------------------------------------------
+
+// Remet à zéro le pic de mémoire résidente (VmHWM) du processus
+bool ResetPeakRss()
+{
+    FILE* file = std::fopen("/proc/self/clear_refs", "w");
+    if (!file) {
+        return false;
+    }
+    bool success = std::fputs("5", file) >= 0;
+    return std::fclose(file) == 0 && success;
+}
+
+// ---------------------------------------------------------------------------
+// Écriture JSON
+// ---------------------------------------------------------------------------
+
+void WriteLatency(JsonWriter& json, const char* key, const XISLatencyStats& stats)
+{
+    json.BeginObject(key);
+    json.Integer("samples", stats.sampleCount);
+    json.Number("p50", stats.p50Ms);
+    json.Number("p90", stats.p90Ms);
+    json.Number("p99", stats.p99Ms);
+    json.Number("p999", stats.p999Ms);
+    json.Number("max", stats.maxMs);
+    json.Number("mean", stats.meanMs);
+    json.EndObject();
+}
+
+// ---------------------------------------------------------------------------
+// Exécution d'une configuration
+// ---------------------------------------------------------------------------
+
+struct RunSetup {
+    std::string name;
+    uint32_t outputWidth = 0;
+    uint32_t outputHeight = 0;
+    float scale = 1.0f;
+    AASetting aa;
+    FrameGenSetting frameGen;
+    uint32_t threads = 0;
+};
+
+double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool RunConfiguration(const Options& options, const RunSetup& setup, const FrameSequence& sequence, JsonWriter& json)
+{
+    json.BeginObject();
+    json.String("name", setup.name);
+    json.Integer("inputWidth", sequence.GetWidth());
+    json.Integer("inputHeight", sequence.GetHeight());
+    json.Integer("outputWidth", setup.outputWidth);
+    json.Integer("outputHeight", setup.outputHeight);
+    json.Number("scale", setup.scale);
+    json.String("aaQuality", setup.aa.name);
+    json.String("frameGen", setup.frameGen.name);
+    json.Integer("threads", setup.threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : setup.threads);
+
+    XISConfig config;
+    config.enableBicubicUpscaling = true;
+    config.enableAntiAliasing = setup.aa.quality != AAQuality::Off;
+    config.aaQuality = setup.aa.quality;
+    config.enableFrameGeneration = setup.frameGen.enabled;
+    config.frameGenParams.mode = setup.frameGen.mode;
+    config.enableSharpness = true;
+    config.upscalingParams.outputWidth = setup.outputWidth;
+    config.upscalingParams.outputHeight = setup.outputHeight;
+    // Une fenêtre plus longue que la mesure : tous les échantillons comptent
+    config.latencyWindowSeconds = 3600.0f;
+
+    bool rssReset = ResetPeakRss();
+
+    XISSessionHandle session = CPU::CreateSession(config, setup.threads);
+    void* output = session ? CPU::CreateTexture(setup.outputWidth, setup.outputHeight) : nullptr;
+    if (!session || !output) {
+        json.Bool("ok", false);
+        json.String("error", session ? "échec de la création de la texture de sortie" : "échec de la création de la session");
+        DestroySession(session);
+        json.EndObject();
+        return false;
+    }
+
+    XISParameters params;
+    params.outputTexture = output;
+    params.frameDeltaTime = 1.0f / 60.0f;
+    params.isDX11 = false;
+
+    uint64_t frameIndex = 0;
+    bool ok = true;
+    auto processNext = [&]() {
+        params.inputTexture = sequence.GetFrame(frameIndex++);
+        return ProcessFrame(session, params);
+    };
+
+    for (uint32_t i = 0; i < options.warmupFrames && ok; ++i) {
+        ok = processNext();
+    }
+
+    ResetLatencyStats(session);
+
+    // Une mesure par répétition : temps moyen par frame et temps par étape,
+    // pour les tests de significativité entre deux versions
+    struct Sample {
+        uint32_t frames = 0;
+        double frameMs = 0.0;
+        XISBandwidthReport bandwidth;
+    };
+    std::vector<Sample> samples(options.repetitions);
+
+    const double budgetMs = options.maxSeconds * 1000.0 / options.repetitions;
+    uint64_t measuredFrames = 0;
+    double measuredMs = 0.0;
+
+    for (uint32_t r = 0; r < options.repetitions && ok; ++r) {
+        ResetBandwidthStats(session);
+
+        Sample& sample = samples[r];
+        auto start = std::chrono::steady_clock::now();
+        while (ok && sample.frames < options.frames) {
+            ok = processNext();
+            sample.frames++;
+            if (ElapsedMs(start) > budgetMs) {
+                break;
+            }
+        }
+
+        double elapsedMs = ElapsedMs(start);
+        sample.frameMs = elapsedMs / sample.frames;
+        GetBandwidthReport(session, sample.bandwidth);
+
+        measuredFrames += sample.frames;
+        measuredMs += elapsedMs;
+    }
+
+    json.Bool("ok", ok);
+    json.Integer("frames", measuredFrames);
+    json.Number("seconds", measuredMs / 1000.0);
+    json.Number("fps", measuredMs > 0.0 ? measuredFrames * 1000.0 / measuredMs : 0.0);
+
+    XISLatencyReport latency;
+    GetLatencyReport(session, latency);
+    WriteLatency(json, "frameMs", latency.frame);
+
+    // Latences sur toute la mesure, trafic de la dernière répétition
+    const Sample* lastSample = &samples[0];
+    for (const Sample& sample : samples) {
+        if (sample.frames > 0) {
+            lastSample = &sample;
+        }
+    }
+    const XISBandwidthReport& bandwidth = lastSample->bandwidth;
+    json.Number("peakBandwidthGBps", bandwidth.peakGBps);
+    json.BeginArray("stages");
+    for (uint32_t i = 0; i < latency.stageCount; ++i) {
+        const XISStageLatency& stage = latency.stages[i];
+        json.BeginObject();
+        json.String("name", stage.stageName);
+        WriteLatency(json, "latencyMs", stage.latency);
+        for (uint32_t j = 0; j < bandwidth.stageCount; ++j) {
+            const XISStageBandwidth& traffic = bandwidth.stages[j];
+            if (std::strcmp(traffic.stageName, stage.stageName) == 0) {
+                json.Integer("bytesReadPerFrame", traffic.bytesReadPerFrame);
+                json.Integer("bytesWrittenPerFrame", traffic.bytesWrittenPerFrame);
+                json.Number("achievedGBps", traffic.achievedGBps);
+                json.Bool("bandwidthBound", traffic.bandwidthBound);
+                break;
+            }
+        }
+        json.EndObject();
+    }
+    json.EndArray();
+
+    json.BeginArray("samples");
+    for (const Sample& sample : samples) {
+        if (sample.frames == 0) {
+            continue;
+        }
+        json.BeginObject();
+        json.Integer("frames", sample.frames);
+        json.Number("frameMs", sample.frameMs);
+        json.BeginObject("stageMs");
+        for (uint32_t j = 0; j < sample.bandwidth.stageCount; ++j) {
+            json.Number(sample.bandwidth.stages[j].stageName, sample.bandwidth.stages[j].timeMsPerFrame);
+        }
+        json.EndObject();
+        json.EndObject();
+    }
+    json.EndArray();
+
+    XISMemoryReport memory;
+    GetMemoryReport(session, memory);
+
+    DestroySession(session);
+    CPU::ReleaseTexture(output);
+
+    json.BeginObject("memory");
+    json.Integer("sessionPeakBytes", memory.peakBytes);
+    json.Integer("sessionAllocations", memory.allocationCount);
+    json.Integer("processPeakRssBytes", ReadProcKilobytes("/proc/self/status", "VmHWM"));
+    json.Bool("processPeakRssReset", rssReset);
+    json.EndObject();
+
+    json.EndObject();
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+
+    JsonWriter json;
+    json.BeginObject();
+    json.String("benchmark", "XIS PipelineBenchmark");
+    json.Integer("formatVersion", 1);
+
+    WriteMachine(json);
+
+    json.BeginObject("settings");
+    json.Integer("frames", options.frames);
+    json.Integer("warmupFrames", options.warmupFrames);
+    json.Integer("repetitions", options.repetitions);
+    json.Number("maxSeconds", options.maxSeconds);
+    json.String("source", options.inputPath.empty() ? "synthetic" : options.inputPath);
+    json.EndObject();
+
+    // Sorties à parcourir : résolutions demandées (entrée = sortie / échelle)
+    // ou, pour une séquence enregistrée, entrée fixe et sortie = entrée × échelle
+    struct Target {
+        std::string name;
+        uint32_t outputWidth;
+        uint32_t outputHeight;
+        uint32_t inputWidth;
+        uint32_t inputHeight;
+        float scale;
+    };
+    std::vector<Target> targets;
+    for (float scale : options.scales) {
+        if (!options.inputPath.empty()) {
+            char name[64];
+            std::snprintf(name, sizeof(name), "%ux%u", EvenDimension(options.inputWidth * scale), EvenDimension(options.inputHeight * scale));
+            targets.push_back({ name, EvenDimension(options.inputWidth * scale), EvenDimension(options.inputHeight * scale),
+                                options.inputWidth, options.inputHeight, scale });
+            continue;
+        }
+        for (const Resolution& resolution : options.resolutions) {
+            targets.push_back({ resolution.name, resolution.width, resolution.height,
+                                EvenDimension(resolution.width / scale), EvenDimension(resolution.height / scale), scale });
+        }
+    }
+
+    json.BeginArray("runs");
+    FrameSequence sequence;
+    int failures = 0;
+
+    for (const Target& target : targets) {
+        bool loaded = sequence.GetLength() > 0 &&
+                      sequence.GetWidth() == target.inputWidth && sequence.GetHeight() == target.inputHeight;
+        if (!loaded) {
+            loaded = options.inputPath.empty()
+                ? sequence.CreateSynthetic(target.inputWidth, target.inputHeight, options.sequenceLength)
+                : sequence.LoadRecorded(options.inputPath, target.inputWidth, target.inputHeight, options.sequenceLength);
+        }
+        if (!loaded) {
+            std::fprintf(stderr, "Frames d'entrée %ux%u indisponibles\n", target.inputWidth, target.inputHeight);
+            failures++;
+            continue;
+        }
+
+        for (const AASetting& aa : options.aaSettings) {
+            for (const FrameGenSetting& frameGen : options.frameGenSettings) {
+                for (uint32_t threads : options.threadCounts) {
+                    RunSetup setup;
+                    char name[128];
+                    std::snprintf(name, sizeof(name), "%s_x%.2g_aa-%s_fg-%s_t%u",
+                                  target.name.c_str(), target.scale, aa.name.c_str(), frameGen.name.c_str(), threads);
+                    setup.name = name;
+                    setup.outputWidth = target.outputWidth;
+                    setup.outputHeight = target.outputHeight;
+                    setup.scale = target.scale;
+                    setup.aa = aa;
+                    setup.frameGen = frameGen;
+                    setup.threads = threads;
+
+                    std::fprintf(stderr, "[PipelineBenchmark] %s\n", name);
+                    if (!RunConfiguration(options, setup, sequence, json)) {
+                        failures++;
+                    }
+                }
+            }
+        }
+    }
+
+    json.EndArray();
+    json.Integer("failures", static_cast<uint64_t>(failures));
+    json.EndObject();
+
+    FILE* output = options.outputPath.empty() ? stdout : std::fopen(options.outputPath.c_str(), "w");
+    if (!output) {
+        std::fprintf(stderr, "Impossible d'écrire %s\n", options.outputPath.c_str());
+        return 1;
+    }
+    std::fprintf(output, "%s\n", json.GetText().c_str());
+    if (output != stdout) {
+        std::fclose(output);
+    }
+
+    return failures == 0 ? 0 : 1;
+}
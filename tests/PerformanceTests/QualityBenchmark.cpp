@@ -0,0 +1,583 @@
+/**
+ * @brief Qualité d'image en fonction du coût, pour choisir des préréglages
+ *
+ * Exécute le pipeline complet sur le backend CPU avec une configuration de
+ * référence (par défaut la plus coûteuse), puis avec chaque combinaison
+ * demandée de mode d'upscaling, qualité d'AA et mode de génération de
+ * frames, sur la même séquence d'entrée. Chaque sortie est comparée à la
+ * sortie de référence de même rang : PSNR (RGB), SSIM et scintillement
+ * temporel (luminance), calculés par les kernels vectorisés et
+ * multithreadés d'ImageMetrics. Le coût est le temps médian de traitement
+ * par frame.
+ *
+ * Les combinaisons qu'aucune autre ne domine (moins coûteuse et de SSIM au
+ * moins égal) forment la frontière de Pareto, parmi laquelle choisir les
+ * préréglages de production. Le résultat est un document JSON et,
+ * optionnellement, un graphique SVG qualité/coût.
+ *
+ * Comparer deux configurations seulement revient à ne donner qu'une valeur
+ * à --upscaling, --aa et --framegen.
+ *
+ * Exemple :
+ *   QualityBenchmark --resolution 1080p --scale 2 --aa off,low,high \
+ *                    --framegen off,mc --output quality.json --plot quality.svg
+ */
+
+#include "../../include/XIS/XIS.h"
+#include "../../src/Renderer/CPU/CPUWorkerPool.h"
+#include "BenchmarkSupport.h"
+#include "ImageMetrics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace XIS;
+using namespace XIS::Benchmark;
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Options
+// ---------------------------------------------------------------------------
+
+struct Combination {
+    std::string name;
+    UpscalingSetting upscaling;
+    AASetting aa;
+    FrameGenSetting frameGen;
+};
+
+struct Options {
+    Resolution resolution;                // Résolution de sortie
+    float scale = 2.0f;                   // Rapport sortie/entrée
+    uint32_t frames = 24;                 // Longueur de la séquence comparée
+    uint32_t costSkipFrames = 2;          // Premières frames exclues du coût (initialisation)
+    uint32_t threads = 0;                 // Threads du pipeline
+    uint32_t metricThreads = 0;           // Threads des mesures de qualité
+
+    Combination reference;
+    std::vector<UpscalingSetting> upscalingSettings;
+    std::vector<AASetting> aaSettings;
+    std::vector<FrameGenSetting> frameGenSettings;
+
+    std::string inputPath;                // Séquence enregistrée (RGBA 8 bits brut)
+    uint32_t inputWidth = 0;
+    uint32_t inputHeight = 0;
+
+    std::string outputPath;               // Vide = sortie standard
+    std::string plotPath;                 // Graphique SVG, vide = aucun
+};
+
+void PrintUsage()
+{
+    std::fprintf(stderr,
+        "Usage: QualityBenchmark [options]\n"
+        "  --resolution RES     Résolution de sortie : 720p,1080p,1440p,4K,8K ou LxH (défaut : 720p)\n"
+        "  --scale S            Rapport sortie/entrée (défaut : 2)\n"
+        "  --frames N           Frames de la séquence comparée (défaut : 24)\n"
+        "  --upscaling LIST     bicubic,sharp,adaptive (défaut : tous)\n"
+        "  --aa LIST            off,low,medium,high (défaut : tous)\n"
+        "  --framegen LIST      off,interp,mc,advanced (défaut : tous)\n"
+        "  --reference U,A,F    Configuration de référence (défaut : adaptive,high,advanced)\n"
+        "  --threads N          Threads du pipeline, 0 = tous les cœurs (défaut : 0)\n"
+        "  --metric-threads N   Threads des mesures de qualité, 0 = tous les cœurs (défaut : 0)\n"
+        "  --input FILE         Séquence enregistrée, frames RGBA 8 bits brutes concaténées\n"
+        "  --input-size LxH     Taille des frames de --input (--resolution est alors ignorée)\n"
+        "  --output FILE        Fichier JSON (défaut : sortie standard)\n"
+        "  --plot FILE          Graphique SVG du SSIM en fonction du coût\n");
+}
+
+std::string CombinationName(const Combination& combination)
+{
+    return "up-" + combination.upscaling.name + "_aa-" + combination.aa.name + "_fg-" + combination.frameGen.name;
+}
+
+bool ParseReference(const std::string& text, Combination& reference)
+{
+    std::vector<std::string> parts = Split(text);
+    if (parts.size() != 3 ||
+        !ParseUpscaling(parts[0], reference.upscaling) ||
+        !ParseAA(parts[1], reference.aa) ||
+        !ParseFrameGen(parts[2], reference.frameGen)) {
+        return false;
+    }
+    reference.name = CombinationName(reference);
+    return true;
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+    std::string resolution = "720p";
+    std::string upscaling = "bicubic,sharp,adaptive";
+    std::string aa = "off,low,medium,high";
+    std::string frameGen = "off,interp,mc,advanced";
+    std::string reference = "adaptive,high,advanced";
+    std::string inputSize;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Valeur manquante pour %s\n", arg.c_str());
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--resolution") resolution = value;
+        else if (arg == "--scale") options.scale = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--frames") options.frames = static_cast<uint32_t>(std::max(2, std::atoi(value.c_str())));
+        else if (arg == "--upscaling") upscaling = value;
+        else if (arg == "--aa") aa = value;
+        else if (arg == "--framegen") frameGen = value;
+        else if (arg == "--reference") reference = value;
+        else if (arg == "--threads") options.threads = static_cast<uint32_t>(std::max(0, std::atoi(value.c_str())));
+        else if (arg == "--metric-threads") options.metricThreads = static_cast<uint32_t>(std::max(0, std::atoi(value.c_str())));
+        else if (arg == "--input") options.inputPath = value;
+        else if (arg == "--input-size") inputSize = value;
+        else if (arg == "--output") options.outputPath = value;
+        else if (arg == "--plot") options.plotPath = value;
+        else {
+            std::fprintf(stderr, "Option inconnue : %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (options.scale < 1.0f) {
+        std::fprintf(stderr, "Rapport d'échelle invalide (>= 1 attendu) : %g\n", options.scale);
+        return false;
+    }
+    if (!options.inputPath.empty() && !ParseSize(inputSize, options.inputWidth, options.inputHeight)) {
+        std::fprintf(stderr, "--input exige --input-size LxH\n");
+        return false;
+    }
+    if (!ParseResolution(resolution, options.resolution)) {
+        std::fprintf(stderr, "Résolution invalide : %s\n", resolution.c_str());
+        return false;
+    }
+    if (!ParseReference(reference, options.reference)) {
+        std::fprintf(stderr, "Référence invalide (mode,aa,framegen attendus) : %s\n", reference.c_str());
+        return false;
+    }
+
+    for (const std::string& item : Split(upscaling)) {
+        UpscalingSetting setting;
+        if (!ParseUpscaling(item, setting)) {
+            std::fprintf(stderr, "Mode d'upscaling invalide : %s\n", item.c_str());
+            return false;
+        }
+        options.upscalingSettings.push_back(setting);
+    }
+    for (const std::string& item : Split(aa)) {
+        AASetting setting;
+        if (!ParseAA(item, setting)) {
+            std::fprintf(stderr, "Qualité d'AA invalide : %s\n", item.c_str());
+            return false;
+        }
+        options.aaSettings.push_back(setting);
+    }
+    for (const std::string& item : Split(frameGen)) {
+        FrameGenSetting setting;
+        if (!ParseFrameGen(item, setting)) {
+            std::fprintf(stderr, "Mode de génération de frames invalide : %s\n", item.c_str());
+            return false;
+        }
+        options.frameGenSettings.push_back(setting);
+    }
+
+    return !options.upscalingSettings.empty() && !options.aaSettings.empty() && !options.frameGenSettings.empty();
+}
+
+// ---------------------------------------------------------------------------
+// Exécution d'une configuration
+// ---------------------------------------------------------------------------
+
+struct RunResult {
+    Combination combination;
+    bool ok = false;
+    double medianMs = 0.0;
+    double p90Ms = 0.0;
+    double psnr = 0.0;                    // Moyenne des frames
+    double ssim = 0.0;                    // Moyenne des frames
+    double minSsim = 0.0;                 // Pire frame
+    double flicker = 0.0;                 // Moyenne des frames après la première
+    bool pareto = false;
+};
+
+using FrameCallback = std::function<void(uint32_t index, const uint8_t* pixels, uint32_t pitch)>;
+
+double Percentile(std::vector<double> values, double fraction)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(values.size() - 1) + 0.5);
+    return values[std::min(index, values.size() - 1)];
+}
+
+/**
+ * Traite la séquence sur une session neuve ; onFrame reçoit chaque sortie
+ */
+bool RunSequence(const Options& options, const Combination& combination, const FrameSequence& sequence,
+                 uint32_t outputWidth, uint32_t outputHeight, const FrameCallback& onFrame,
+                 std::vector<double>& frameTimesMs)
+{
+    XISConfig config;
+    config.enableBicubicUpscaling = true;
+    config.upscalingParams.mode = combination.upscaling.mode;
+    config.upscalingParams.outputWidth = outputWidth;
+    config.upscalingParams.outputHeight = outputHeight;
+    config.enableAntiAliasing = combination.aa.quality != AAQuality::Off;
+    config.aaQuality = combination.aa.quality;
+    config.enableFrameGeneration = combination.frameGen.enabled;
+    config.frameGenParams.mode = combination.frameGen.mode;
+    config.enableSharpness = true;
+
+    XISSessionHandle session = CPU::CreateSession(config, options.threads);
+    void* output = session ? CPU::CreateTexture(outputWidth, outputHeight) : nullptr;
+    if (!session || !output) {
+        std::fprintf(stderr, "%s : échec de la création de la session\n", combination.name.c_str());
+        DestroySession(session);
+        return false;
+    }
+
+    XISParameters params;
+    params.outputTexture = output;
+    params.frameDeltaTime = 1.0f / 60.0f;
+    params.isDX11 = false;
+
+    bool ok = true;
+    frameTimesMs.clear();
+    for (uint32_t i = 0; i < options.frames && ok; ++i) {
+        params.inputTexture = sequence.GetFrame(i);
+        auto start = std::chrono::steady_clock::now();
+        ok = ProcessFrame(session, params);
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!ok) {
+            std::fprintf(stderr, "%s : échec du traitement de la frame %u\n", combination.name.c_str(), i);
+            break;
+        }
+        if (i >= options.costSkipFrames) {
+            frameTimesMs.push_back(elapsed);
+        }
+
+        uint32_t pitch = 0;
+        const uint8_t* pixels = CPU::MapTexture(output, &pitch);
+        onFrame(i, pixels, pitch);
+    }
+
+    CPU::ReleaseTexture(output);
+    DestroySession(session);
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Frontière de Pareto
+// ---------------------------------------------------------------------------
+
+/**
+ * Marque les combinaisons non dominées : aucune autre n'est à la fois moins
+ * coûteuse (ou aussi coûteuse) et de SSIM supérieur ou égal
+ */
+void MarkParetoFrontier(std::vector<RunResult>& results)
+{
+    std::vector<RunResult*> sorted;
+    for (RunResult& result : results) {
+        if (result.ok) {
+            sorted.push_back(&result);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const RunResult* a, const RunResult* b) {
+        return a->medianMs != b->medianMs ? a->medianMs < b->medianMs : a->ssim > b->ssim;
+    });
+
+    double bestSsim = -2.0;
+    for (RunResult* result : sorted) {
+        if (result->ssim > bestSsim) {
+            result->pareto = true;
+            bestSsim = result->ssim;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Graphique
+// ---------------------------------------------------------------------------
+
+bool WritePlot(const std::string& path, const std::vector<RunResult>& results)
+{
+    const double width = 960.0, height = 600.0;
+    const double left = 70.0, right = 260.0, top = 30.0, bottom = 50.0;
+
+    double maxMs = 0.0;
+    double minSsim = 1.0;
+    for (const RunResult& result : results) {
+        if (result.ok) {
+            maxMs = std::max(maxMs, result.medianMs);
+            minSsim = std::min(minSsim, result.ssim);
+        }
+    }
+    maxMs = maxMs > 0.0 ? maxMs * 1.05 : 1.0;
+    minSsim = std::max(-1.0, std::floor(minSsim * 100.0 - 1.0) / 100.0);
+    const double ssimRange = std::max(1e-3, 1.0 - minSsim);
+
+    auto px = [&](double ms) { return left + ms / maxMs * (width - left - right); };
+    auto py = [&](double ssim) { return top + (1.0 - ssim) / ssimRange * (height - top - bottom); };
+
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        std::fprintf(stderr, "Impossible d'écrire %s\n", path.c_str());
+        return false;
+    }
+
+    std::fprintf(file, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%.0f\" height=\"%.0f\" font-family=\"sans-serif\" font-size=\"11\">\n", width, height);
+    std::fprintf(file, "<rect width=\"100%%\" height=\"100%%\" fill=\"white\"/>\n");
+
+    // Axes et graduations
+    std::fprintf(file, "<line x1=\"%.1f\" y1=\"%.1f\" x2=\"%.1f\" y2=\"%.1f\" stroke=\"black\"/>\n", left, height - bottom, width - right, height - bottom);
+    std::fprintf(file, "<line x1=\"%.1f\" y1=\"%.1f\" x2=\"%.1f\" y2=\"%.1f\" stroke=\"black\"/>\n", left, top, left, height - bottom);
+    for (int tick = 0; tick <= 5; ++tick) {
+        double ms = maxMs * tick / 5.0;
+        double ssim = minSsim + ssimRange * tick / 5.0;
+        std::fprintf(file, "<text x=\"%.1f\" y=\"%.1f\" text-anchor=\"middle\">%.2f</text>\n", px(ms), height - bottom + 16.0, ms);
+        std::fprintf(file, "<text x=\"%.1f\" y=\"%.1f\" text-anchor=\"end\">%.3f</text>\n", left - 6.0, py(ssim) + 4.0, ssim);
+    }
+    std::fprintf(file, "<text x=\"%.1f\" y=\"%.1f\" text-anchor=\"middle\">Coût médian par frame (ms)</text>\n", (left + width - right) / 2.0, height - 12.0);
+    std::fprintf(file, "<text x=\"16\" y=\"%.1f\" transform=\"rotate(-90 16 %.1f)\" text-anchor=\"middle\">SSIM</text>\n", (top + height - bottom) / 2.0, (top + height - bottom) / 2.0);
+
+    // Frontière, puis les points (frontière en rouge, nommés)
+    std::vector<const RunResult*> frontier;
+    for (const RunResult& result : results) {
+        if (result.pareto) {
+            frontier.push_back(&result);
+        }
+    }
+    std::sort(frontier.begin(), frontier.end(), [](const RunResult* a, const RunResult* b) { return a->medianMs < b->medianMs; });
+    std::fprintf(file, "<polyline fill=\"none\" stroke=\"#c0392b\" points=\"");
+    for (const RunResult* result : frontier) {
+        std::fprintf(file, "%.1f,%.1f ", px(result->medianMs), py(result->ssim));
+    }
+    std::fprintf(file, "\"/>\n");
+
+    for (const RunResult& result : results) {
+        if (!result.ok) {
+            continue;
+        }
+        std::fprintf(file, "<circle cx=\"%.1f\" cy=\"%.1f\" r=\"4\" fill=\"%s\"><title>%s : %.3f ms, SSIM %.4f, PSNR %.2f dB</title></circle>\n",
+                     px(result.medianMs), py(result.ssim), result.pareto ? "#c0392b" : "#7f8c8d",
+                     result.combination.name.c_str(), result.medianMs, result.ssim, result.psnr);
+        if (result.pareto) {
+            std::fprintf(file, "<text x=\"%.1f\" y=\"%.1f\">%s</text>\n", px(result.medianMs) + 7.0, py(result.ssim) + 4.0,
+                         result.combination.name.c_str());
+        }
+    }
+
+    std::fprintf(file, "</svg>\n");
+    return std::fclose(file) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+
+    // Entrée = sortie / échelle, ou sortie = entrée × échelle pour une séquence enregistrée
+    uint32_t outputWidth = options.resolution.width;
+    uint32_t outputHeight = options.resolution.height;
+    FrameSequence sequence;
+    bool loaded = false;
+    if (options.inputPath.empty()) {
+        loaded = sequence.CreateSynthetic(EvenDimension(outputWidth / options.scale),
+                                          EvenDimension(outputHeight / options.scale), options.frames);
+    } else {
+        outputWidth = EvenDimension(options.inputWidth * options.scale);
+        outputHeight = EvenDimension(options.inputHeight * options.scale);
+        loaded = sequence.LoadRecorded(options.inputPath, options.inputWidth, options.inputHeight, options.frames);
+    }
+    if (!loaded) {
+        std::fprintf(stderr, "Frames d'entrée indisponibles\n");
+        return 1;
+    }
+    options.frames = std::min<uint32_t>(options.frames, static_cast<uint32_t>(sequence.GetLength()));
+    options.costSkipFrames = std::min(options.costSkipFrames, options.frames - 1);
+
+    // Référence
+    std::fprintf(stderr, "[QualityBenchmark] référence %s\n", options.reference.name.c_str());
+    ReferenceFrames reference;
+    std::vector<double> frameTimesMs;
+    bool referenceOk = RunSequence(options, options.reference, sequence, outputWidth, outputHeight,
+        [&](uint32_t index, const uint8_t* pixels, uint32_t pitch) {
+            reference.Store(index, pixels, pitch, outputWidth, outputHeight);
+        }, frameTimesMs);
+    if (!referenceOk) {
+        return 1;
+    }
+    double referenceMs = Percentile(frameTimesMs, 0.5);
+
+    // Combinaisons comparées à la référence
+    CPUWorkerPool metricPool(options.metricThreads);
+    QualityEvaluator evaluator(metricPool);
+    std::vector<RunResult> results;
+    double metricMs = 0.0;
+    uint64_t metricFrames = 0;
+
+    for (const UpscalingSetting& upscaling : options.upscalingSettings) {
+        for (const AASetting& aa : options.aaSettings) {
+            for (const FrameGenSetting& frameGen : options.frameGenSettings) {
+                RunResult result;
+                result.combination.upscaling = upscaling;
+                result.combination.aa = aa;
+                result.combination.frameGen = frameGen;
+                result.combination.name = CombinationName(result.combination);
+                std::fprintf(stderr, "[QualityBenchmark] %s\n", result.combination.name.c_str());
+
+                std::vector<FrameQuality> qualities;
+                evaluator.Reset();
+                result.ok = RunSequence(options, result.combination, sequence, outputWidth, outputHeight,
+                    [&](uint32_t index, const uint8_t* pixels, uint32_t pitch) {
+                        auto start = std::chrono::steady_clock::now();
+                        qualities.push_back(evaluator.Compare(pixels, pitch, reference.GetFrame(index), reference.GetPitch(),
+                                                              static_cast<int>(outputWidth), static_cast<int>(outputHeight)));
+                        metricMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                        metricFrames++;
+                    }, frameTimesMs);
+
+                if (result.ok && !qualities.empty()) {
+                    result.medianMs = Percentile(frameTimesMs, 0.5);
+                    result.p90Ms = Percentile(frameTimesMs, 0.9);
+                    result.minSsim = 1.0;
+                    uint32_t flickerFrames = 0;
+                    for (const FrameQuality& quality : qualities) {
+                        result.psnr += quality.psnr;
+                        result.ssim += quality.ssim;
+                        result.minSsim = std::min(result.minSsim, quality.ssim);
+                        if (quality.hasFlicker) {
+                            result.flicker += quality.flicker;
+                            flickerFrames++;
+                        }
+                    }
+                    result.psnr /= static_cast<double>(qualities.size());
+                    result.ssim /= static_cast<double>(qualities.size());
+                    result.flicker = flickerFrames > 0 ? result.flicker / flickerFrames : 0.0;
+                }
+                results.push_back(result);
+            }
+        }
+    }
+
+    MarkParetoFrontier(results);
+
+    // Tableau récapitulatif, par coût croissant
+    std::vector<const RunResult*> byCost;
+    for (const RunResult& result : results) {
+        byCost.push_back(&result);
+    }
+    std::sort(byCost.begin(), byCost.end(), [](const RunResult* a, const RunResult* b) { return a->medianMs < b->medianMs; });
+    std::fprintf(stderr, "\n  %-36s %9s %9s %8s %8s %8s\n", "combinaison", "ms", "PSNR", "SSIM", "SSIMmin", "flicker");
+    for (const RunResult* result : byCost) {
+        if (!result->ok) {
+            std::fprintf(stderr, "  %-36s  échec\n", result->combination.name.c_str());
+            continue;
+        }
+        std::fprintf(stderr, "%c %-36s %9.3f %9.2f %8.4f %8.4f %8.3f\n", result->pareto ? '*' : ' ',
+                     result->combination.name.c_str(), result->medianMs, result->psnr, result->ssim,
+                     result->minSsim, result->flicker);
+    }
+    std::fprintf(stderr, "\n* frontière de Pareto (coût, SSIM) ; mesures : %.3f ms par frame\n",
+                 metricFrames > 0 ? metricMs / static_cast<double>(metricFrames) : 0.0);
+
+    // Document JSON
+    JsonWriter json;
+    json.BeginObject();
+    json.String("benchmark", "XIS QualityBenchmark");
+    json.Integer("formatVersion", 1);
+
+    WriteMachine(json);
+
+    json.BeginObject("settings");
+    json.String("source", options.inputPath.empty() ? "synthetic" : options.inputPath);
+    json.Integer("frames", options.frames);
+    json.Integer("costSkipFrames", options.costSkipFrames);
+    json.Integer("inputWidth", sequence.GetWidth());
+    json.Integer("inputHeight", sequence.GetHeight());
+    json.Integer("outputWidth", outputWidth);
+    json.Integer("outputHeight", outputHeight);
+    json.Number("scale", options.scale);
+    json.Integer("threads", options.threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : options.threads);
+    json.Integer("metricThreads", metricPool.GetThreadCount());
+    json.EndObject();
+
+    json.BeginObject("reference");
+    json.String("name", options.reference.name);
+    json.Number("medianMs", referenceMs);
+    json.EndObject();
+
+    json.BeginArray("runs");
+    int failures = 0;
+    for (const RunResult& result : results) {
+        json.BeginObject();
+        json.String("name", result.combination.name);
+        json.String("upscaling", result.combination.upscaling.name);
+        json.String("aaQuality", result.combination.aa.name);
+        json.String("frameGen", result.combination.frameGen.name);
+        json.Bool("ok", result.ok);
+        if (result.ok) {
+            json.Number("medianMs", result.medianMs);
+            json.Number("p90Ms", result.p90Ms);
+            json.Number("psnr", result.psnr);
+            json.Number("ssim", result.ssim);
+            json.Number("minSsim", result.minSsim);
+            json.Number("flicker", result.flicker);
+            json.Bool("pareto", result.pareto);
+        } else {
+            failures++;
+        }
+        json.EndObject();
+    }
+    json.EndArray();
+
+    json.BeginArray("paretoFrontier");
+    for (const RunResult* result : byCost) {
+        if (result->pareto) {
+            json.BeginObject();
+            json.String("name", result->combination.name);
+            json.Number("medianMs", result->medianMs);
+            json.Number("ssim", result->ssim);
+            json.EndObject();
+        }
+    }
+    json.EndArray();
+    json.Integer("failures", static_cast<uint64_t>(failures));
+    json.EndObject();
+
+    FILE* output = options.outputPath.empty() ? stdout : std::fopen(options.outputPath.c_str(), "w");
+    if (!output) {
+        std::fprintf(stderr, "Impossible d'écrire %s\n", options.outputPath.c_str());
+        return 1;
+    }
+    std::fprintf(output, "%s\n", json.GetText().c_str());
+    if (output != stdout) {
+        std::fclose(output);
+    }
+
+    if (!options.plotPath.empty() && !WritePlot(options.plotPath, results)) {
+        return 1;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+/**
+ * @brief Tests des liaisons du backend CPU après libération des ressources
+ *
+ *  - une ressource libérée est retirée des liaisons : l'appel suivant
+ *    échoue proprement au lieu de lire la ressource rendue ;
+ *  - le renderer instrumenté (ProfilingRenderer) ne demande plus la taille
+ *    d'une ressource libérée ;
+ *  - il ne compte que les registres déclarés par le shader courant, pas
+ *    les liaisons laissées par un shader précédent ;
+ *  - une double libération est ignorée sans relire la ressource.
+ */
+
+#include "../../src/Renderer/CPU/CPURenderer.h"
+#include "../../src/Renderer/ProfilingRenderer.h"
+#include "../../src/Utils/PerfMonitor.h"
+#include "TestSupport.h"
+
+#include <memory>
+
+using namespace XIS;
+using UnitTest::Check;
+
+namespace {
+
+void TestReleasedTextureIsUnbound()
+{
+    const char* test = "ReleasedTextureIsUnbound";
+    CPURenderer renderer(1);
+
+    void* source = renderer.CreateTexture2D(16, 16, 0, false, "Source");
+    void* target = renderer.CreateTexture2D(16, 16, 0, true, "Target");
+    // Point d'entrée inconnu : kernel de copie t0 -> u0
+    renderer.SetShader(renderer.LoadShader("Copy.hlsl", "PSCopy"));
+    renderer.SetTexture(source, 0);
+    renderer.SetRenderTarget(target);
+    Check(renderer.ExecuteShader(), test, "copie avec des liaisons valides");
+
+    renderer.ReleaseResource(source);
+    Check(!renderer.ExecuteShader(), test, "la texture libérée est restée liée");
+
+    void* replacement = renderer.CreateTexture2D(16, 16, 0, false, "Replacement");
+    renderer.SetTexture(replacement, 0);
+    Check(renderer.ExecuteShader(), test, "copie après une nouvelle liaison");
+
+    renderer.ReleaseResource(replacement);
+    renderer.ReleaseResource(target);
+}
+
+// Renderer CPU qui signale les demandes de taille d'une ressource libérée
+class ReleaseCheckingRenderer : public CPURenderer {
+public:
+    ReleaseCheckingRenderer() : CPURenderer(1) {}
+
+    void ReleaseResource(void* resource) override
+    {
+        m_released = resource;
+        CPURenderer::ReleaseResource(resource);
+    }
+
+    size_t GetResourceSize(void* resource) const override
+    {
+        if (resource && resource == m_released) {
+            m_releasedQueried = true;
+            return 0;
+        }
+        return CPURenderer::GetResourceSize(resource);
+    }
+
+    bool WasReleasedQueried() const { return m_releasedQueried; }
+
+private:
+    void* m_released = nullptr;
+    mutable bool m_releasedQueried = false;
+};
+
+void TestProfilingUnbindsReleasedResources()
+{
+    const char* test = "ProfilingUnbindsReleasedResources";
+    auto inner = std::make_shared<ReleaseCheckingRenderer>();
+    ProfilingRenderer renderer(inner);
+    PerfMonitor perfMonitor;
+    renderer.SetPerfMonitor(&perfMonitor);
+
+    void* source = renderer.CreateTexture2D(16, 16, 0, false, "Source");
+    void* target = renderer.CreateTexture2D(16, 16, 0, true, "Target");
+    void* shader = renderer.LoadComputeShader("Copy.hlsl", "CSCopy", "cs_5_0");
+    renderer.SetComputeShader(shader);
+    renderer.SetComputeShaderResource(0, source);
+    renderer.SetComputeUnorderedAccessView(0, target);
+    perfMonitor.StartFrame();
+    renderer.DispatchCompute(1, 1, 1);
+
+    // Sans retrait des liaisons, le dispatch suivant demanderait la taille
+    // de la source libérée au renderer CPU
+    renderer.ReleaseResource(source);
+    renderer.DispatchCompute(1, 1, 1);
+    perfMonitor.EndFrame();
+    Check(!inner->WasReleasedQueried(), test, "taille demandée pour une ressource libérée encore liée");
+
+    renderer.SetPerfMonitor(nullptr);
+    renderer.ReleaseResource(target);
+}
+
+void TestProfilingCountsDeclaredSlots()
+{
+    const char* test = "ProfilingCountsDeclaredSlots";
+    auto inner = std::make_shared<CPURenderer>(1);
+    ProfilingRenderer renderer(inner);
+    PerfMonitor perfMonitor(false);
+    renderer.SetPerfMonitor(&perfMonitor);
+
+    void* source = renderer.CreateTexture2D(16, 16, 0, false, "Source");
+    void* stale = renderer.CreateTexture2D(64, 64, 0, false, "Stale");
+    void* target = renderer.CreateTexture2D(16, 16, 0, true, "Target");
+
+    // Liaisons d'un shader précédent en t1 : le kernel de copie ne lit que t0
+    renderer.SetComputeShader(renderer.LoadComputeShader("Upscale.hlsl", "BicubicUpscaleCS", "cs_5_0"));
+    renderer.SetComputeShaderResource(1, stale);
+    renderer.SetComputeShader(renderer.LoadComputeShader("Copy.hlsl", "CSCopy", "cs_5_0"));
+    renderer.SetComputeShaderResource(0, source);
+    renderer.SetComputeUnorderedAccessView(0, target);
+
+    perfMonitor.StartFrame();
+    renderer.DispatchCompute(1, 1, 1);
+    perfMonitor.EndFrame();
+    perfMonitor.Flush();
+
+    PerfMonitor::BandwidthSnapshot bandwidth;
+    perfMonitor.CollectBandwidth(bandwidth);
+    const uint64_t textureBytes = inner->GetResourceSize(source);
+    Check(bandwidth.bytesRead == textureBytes, test, "octets lus hors des registres déclarés");
+    Check(bandwidth.bytesWritten == textureBytes, test, "octets écrits hors des registres déclarés");
+
+    renderer.SetPerfMonitor(nullptr);
+    renderer.ReleaseResource(target);
+    renderer.ReleaseResource(stale);
+    renderer.ReleaseResource(source);
+}
+
+void TestDoubleReleaseIsIgnored()
+{
+    const char* test = "DoubleReleaseIsIgnored";
+    CPURenderer renderer(1);
+
+    // Une seconde texture garde l'allocateur occupé : la double libération
+    // de la première ne doit toucher ni sa mémoire ni celle de la seconde
+    void* first = renderer.CreateTexture2D(16, 16, 0, false, "First");
+    void* second = renderer.CreateTexture2D(16, 16, 0, false, "Second");
+    renderer.ReleaseResource(first);
+    renderer.ReleaseResource(first);
+
+    int width = 0;
+    int height = 0;
+    int format = 0;
+    Check(renderer.ReadTexture(second, width, height, format, nullptr) && width == 16, test,
+          "la seconde texture a été libérée par la double libération");
+    renderer.ReleaseResource(second);
+}
+
+} // namespace
+
+int main()
+{
+    return UnitTest::Run("CPURendererBindingTest", {
+        TestReleasedTextureIsUnbound,
+        TestProfilingUnbindsReleasedResources,
+        TestProfilingCountsDeclaredSlots,
+        TestDoubleReleaseIsIgnored
+    });
+}
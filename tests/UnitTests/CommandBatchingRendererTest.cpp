@@ -0,0 +1,316 @@
+/**
+ * @brief Tests du renderer de mise en lots (CommandBatchingRenderer)
+ *
+ * Le renderer de la session est remplacé par un renderer qui enregistre les
+ * appels reçus :
+ *  - les liaisons redondantes sont supprimées, les root constants toujours
+ *    transmises, dans l'ordre d'enregistrement ;
+ *  - les barrières sans dispatch intermédiaire sont fusionnées ;
+ *  - la libération d'une ressource liée invalide l'état suivi ;
+ *  - un flux plein est rejoué sans perte ni réordonnancement ;
+ *  - un dispatch rejoué hors de son étape y reste attribué ;
+ *  - les compteurs sont publiés une fois par frame.
+ */
+
+#include "../../src/Renderer/CommandBatchingRenderer.h"
+#include "../../src/Utils/PerfMonitor.h"
+#include "TestSupport.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace XIS;
+using UnitTest::Check;
+
+namespace {
+
+// Objets factices : seules leurs adresses sont utilisées
+char g_shader;
+char g_otherShader;
+char g_resourceA;
+char g_resourceB;
+
+// Renderer de session qui enregistre les appels reçus
+class RecordingRenderer : public IRenderer {
+public:
+    struct Call {
+        std::string name;
+        int slot = 0;
+        const void* object = nullptr;
+        PerfMonitor::StageId stage = PerfMonitor::kInvalidStage;  // Étape ouverte lors d'un dispatch
+    };
+
+    std::vector<Call> calls;
+    PerfMonitor* perfMonitor = nullptr;
+
+    size_t Count(const char* name) const
+    {
+        size_t count = 0;
+        for (const Call& call : calls) {
+            count += call.name == name ? 1 : 0;
+        }
+        return count;
+    }
+
+    void* LoadShader(const char*, const char*) override { return &g_shader; }
+    void* LoadComputeShader(const char*, const char*, const char*) override { return &g_shader; }
+    void ReleaseShaderResource(void*) override {}
+    bool GetShaderSlotCounts(void*, int&, int&, int&) const override { return false; }
+
+    void* CreateTexture2D(int, int, int, bool, const char*) override { return nullptr; }
+    void* CreateStructuredBuffer(int, int, bool, const char*) override { return nullptr; }
+    void* CreateConstantBuffer(size_t, const void*, const char*) override { return nullptr; }
+    void ReleaseResource(void* resource) override { Record("ReleaseResource", 0, resource); }
+    void ReleaseBuffer(void* buffer) override { Record("ReleaseBuffer", 0, buffer); }
+    void UpdateBuffer(void*, const void*, size_t) override {}
+    bool UpdateConstantBuffer(void*, const void*, size_t) override { return true; }
+    bool CopyResource(void*, void*) override { return true; }
+    size_t GetResourceSize(void*) const override { return 0; }
+    size_t GetResourceHugePageSize(void*) const override { return 0; }
+    int GetFloatTextureFormat() const override { return 0; }
+    bool ReadTexture(void*, int&, int&, int&, std::vector<uint8_t>*) override { return false; }
+
+    void CreateIntermediateResources(const XISParameters&) override {}
+    void* GetIntermediateResource(int) override { return nullptr; }
+    void ReleaseIntermediateResources() override {}
+
+    void SetShader(void* shader) override { Record("SetShader", 0, shader); }
+    void SetConstantBuffer(void* buffer, int slot) override { Record("SetConstantBuffer", slot, buffer); }
+    void SetTexture(void* texture, int slot) override { Record("SetTexture", slot, texture); }
+    void SetRenderTarget(void* renderTarget) override { Record("SetRenderTarget", 0, renderTarget); }
+    void SetRootConstants(int slot, const void*, size_t) override { Record("SetRootConstants", slot, nullptr); }
+    bool ExecuteShader() override
+    {
+        Record("ExecuteShader", 0, nullptr);
+        return true;
+    }
+
+    void SetComputeShader(void* shader) override { Record("SetComputeShader", 0, shader); }
+    void SetComputeConstantBuffer(int slot, void* buffer) override { Record("SetComputeConstantBuffer", slot, buffer); }
+    void SetComputeShaderResource(int slot, void* resource) override
+    {
+        Record("SetComputeShaderResource", slot, resource);
+    }
+    void SetComputeUnorderedAccessView(int slot, void* resource) override
+    {
+        Record("SetComputeUnorderedAccessView", slot, resource);
+    }
+    void SetComputeRootConstants(int slot, const void*, size_t) override
+    {
+        Record("SetComputeRootConstants", slot, nullptr);
+    }
+    void DispatchCompute(int groupsX, int, int) override
+    {
+        Record("DispatchCompute", groupsX, nullptr);
+        if (perfMonitor) {
+            calls.back().stage = perfMonitor->GetCurrentStage();
+        }
+    }
+    void SyncCompute() override { Record("SyncCompute", 0, nullptr); }
+    void SetParallelism(uint32_t, int) override {}
+    void Flush() override {}
+
+private:
+    void Record(const char* name, int slot, const void* object)
+    {
+        Call call;
+        call.name = name;
+        call.slot = slot;
+        call.object = object;
+        calls.push_back(call);
+    }
+};
+
+void TestRedundantBindsAreDropped()
+{
+    const char* test = "RedundantBindsAreDropped";
+    auto inner = std::make_shared<RecordingRenderer>();
+    CommandBatchingRenderer renderer(inner);
+
+    const float constants[4] = {};
+    for (int i = 0; i < 3; ++i) {
+        renderer.SetComputeShader(&g_shader);
+        renderer.SetComputeShaderResource(0, &g_resourceA);
+        renderer.SetComputeUnorderedAccessView(0, &g_resourceB);
+        renderer.SetComputeRootConstants(1, constants, sizeof(constants));
+        renderer.DispatchCompute(i + 1, 1, 1);
+    }
+    Check(inner->calls.empty(), test, "appels transmis avant le Flush");
+
+    renderer.Flush();
+    Check(inner->Count("SetComputeShader") == 1, test, "shader relié à l'identique transmis");
+    Check(inner->Count("SetComputeShaderResource") == 1, test, "ressource reliée à l'identique transmise");
+    Check(inner->Count("SetComputeUnorderedAccessView") == 1, test, "UAV relié à l'identique transmis");
+    Check(inner->Count("SetComputeRootConstants") == 3, test, "root constants supprimées");
+    Check(inner->Count("DispatchCompute") == 3, test, "dispatchs perdus");
+
+    // Les root constants précèdent le dispatch qu'elles paramètrent
+    int dispatch = 0;
+    for (size_t i = 0; i < inner->calls.size(); ++i) {
+        if (inner->calls[i].name == "DispatchCompute") {
+            dispatch++;
+            Check(inner->calls[i].slot == dispatch, test, "dispatchs réordonnés");
+            Check(i > 0 && inner->calls[i - 1].name == "SetComputeRootConstants", test,
+                  "root constants détachées de leur dispatch");
+        }
+    }
+
+    // Un autre shader est transmis, le retour au premier aussi
+    inner->calls.clear();
+    renderer.SetComputeShader(&g_otherShader);
+    renderer.SetComputeShader(&g_shader);
+    renderer.Flush();
+    Check(inner->Count("SetComputeShader") == 2, test, "changement de shader supprimé");
+}
+
+void TestBarriersAreMerged()
+{
+    const char* test = "BarriersAreMerged";
+    auto inner = std::make_shared<RecordingRenderer>();
+    CommandBatchingRenderer renderer(inner);
+
+    renderer.SyncCompute();
+    renderer.DispatchCompute(1, 1, 1);
+    renderer.SyncCompute();
+    renderer.SyncCompute();
+    renderer.SyncCompute();
+    renderer.DispatchCompute(2, 1, 1);
+    renderer.SyncCompute();
+    renderer.Flush();
+
+    const char* expected[] = { "DispatchCompute", "SyncCompute", "DispatchCompute", "SyncCompute" };
+    bool match = inner->calls.size() == 4;
+    for (size_t i = 0; match && i < 4; ++i) {
+        match = inner->calls[i].name == expected[i];
+    }
+    Check(match, test, "barrières consécutives non fusionnées");
+
+    // Une copie est un travail : la barrière suivante est transmise
+    inner->calls.clear();
+    renderer.CopyResource(&g_resourceA, &g_resourceB);
+    renderer.SyncCompute();
+    renderer.Flush();
+    Check(inner->Count("SyncCompute") == 1, test, "barrière après une copie supprimée");
+}
+
+void TestReleaseInvalidatesBinding()
+{
+    const char* test = "ReleaseInvalidatesBinding";
+    auto inner = std::make_shared<RecordingRenderer>();
+    CommandBatchingRenderer renderer(inner);
+
+    renderer.SetComputeShaderResource(0, &g_resourceA);
+    renderer.DispatchCompute(1, 1, 1);
+    renderer.ReleaseResource(&g_resourceA);
+    Check(!inner->calls.empty() && inner->calls.back().name == "ReleaseResource", test,
+          "libération transmise avant le flux en attente");
+
+    // L'adresse peut être réutilisée par une nouvelle ressource : la liaison est retransmise
+    inner->calls.clear();
+    renderer.SetComputeShaderResource(0, &g_resourceA);
+    renderer.DispatchCompute(1, 1, 1);
+    renderer.Flush();
+    Check(inner->Count("SetComputeShaderResource") == 1, test, "liaison d'une ressource libérée supprimée");
+
+    // Idem au début d'une frame
+    inner->calls.clear();
+    renderer.CreateIntermediateResources(XISParameters());
+    renderer.SetComputeShaderResource(0, &g_resourceA);
+    renderer.Flush();
+    Check(inner->Count("SetComputeShaderResource") == 1, test, "liaison conservée d'une frame à l'autre");
+}
+
+void TestFullStreamKeepsOrder()
+{
+    const char* test = "FullStreamKeepsOrder";
+    auto inner = std::make_shared<RecordingRenderer>();
+    CommandBatchingRenderer renderer(inner);
+
+    const int dispatchCount = 1000;
+    for (int i = 0; i < dispatchCount; ++i) {
+        renderer.DispatchCompute(i, 1, 1);
+    }
+    Check(!inner->calls.empty(), test, "flux plein non rejoué");
+
+    renderer.Flush();
+    bool ordered = inner->calls.size() == static_cast<size_t>(dispatchCount);
+    for (int i = 0; ordered && i < dispatchCount; ++i) {
+        ordered = inner->calls[i].name == "DispatchCompute" && inner->calls[i].slot == i;
+    }
+    Check(ordered, test, "dispatchs perdus ou réordonnés");
+}
+
+void TestReplayedDispatchKeepsStage()
+{
+    const char* test = "ReplayedDispatchKeepsStage";
+    auto inner = std::make_shared<RecordingRenderer>();
+    CommandBatchingRenderer renderer(inner);
+    PerfMonitor perfMonitor(false);
+    inner->perfMonitor = &perfMonitor;
+    renderer.SetPerfMonitor(&perfMonitor);
+
+    PerfMonitor::StageId first = perfMonitor.RegisterStage("First");
+    PerfMonitor::StageId second = perfMonitor.RegisterStage("Second");
+
+    perfMonitor.StartFrame();
+    perfMonitor.StartStage(first);
+    renderer.DispatchCompute(1, 1, 1);
+    perfMonitor.EndStage(first);
+    perfMonitor.StartStage(second);
+    renderer.DispatchCompute(2, 1, 1);
+    renderer.Flush();
+    perfMonitor.EndStage(second);
+    renderer.DispatchCompute(3, 1, 1);
+    renderer.Flush();
+    perfMonitor.EndFrame();
+
+    Check(inner->calls.size() == 3, test, "dispatchs perdus");
+    if (inner->calls.size() == 3) {
+        Check(inner->calls[0].stage == first, test, "dispatch rejoué dans l'étape qui a vidé le flux");
+        Check(inner->calls[1].stage == second, test, "dispatch rejoué hors de son étape");
+        Check(inner->calls[2].stage == PerfMonitor::kInvalidStage, test, "dispatch hors étape rattaché à une étape");
+    }
+    Check(perfMonitor.GetCurrentStage() == PerfMonitor::kInvalidStage, test, "étape restée ouverte après le rejeu");
+
+    renderer.SetPerfMonitor(nullptr);
+}
+
+void TestStatsPublishedPerFrame()
+{
+    const char* test = "StatsPublishedPerFrame";
+    auto inner = std::make_shared<RecordingRenderer>();
+    CommandBatchingRenderer renderer(inner);
+
+    renderer.SetComputeShader(&g_shader);
+    renderer.SetComputeShader(&g_shader);
+    renderer.DispatchCompute(1, 1, 1);
+    renderer.SyncCompute();
+    renderer.SyncCompute();
+    renderer.Flush();
+
+    CommandBatchingRenderer::Stats stats;
+    renderer.CollectStats(stats);
+    Check(stats.workCalls == 0 && stats.batches == 0, test, "compteurs publiés avant la fin de la frame");
+
+    renderer.EndFrame();
+    renderer.CollectStats(stats);
+    Check(stats.workCalls == 1, test, "dispatchs");
+    Check(stats.stateCallsIn == 2 && stats.stateCallsOut == 1, test, "liaisons reçues et transmises");
+    Check(stats.barriersIn == 2 && stats.barriersOut == 1, test, "barrières reçues et transmises");
+    Check(stats.batches == 1 && stats.batchedCommands == 3, test, "flux rejoués");
+}
+
+} // namespace
+
+int main()
+{
+    return UnitTest::Run("CommandBatchingRendererTest", {
+        TestRedundantBindsAreDropped,
+        TestBarriersAreMerged,
+        TestReleaseInvalidatesBinding,
+        TestFullStreamKeepsOrder,
+        TestReplayedDispatchKeepsStage,
+        TestStatsPublishedPerFrame
+    });
+}
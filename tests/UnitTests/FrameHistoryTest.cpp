@@ -0,0 +1,220 @@
+/**
+ * @brief Tests de l'historique des frames d'entrée (FrameHistory)
+ *
+ *  - une application qui recycle sa texture d'entrée dès le retour de
+ *    ProcessFrame obtient la même frame générée qu'avec une texture par
+ *    frame, l'historique ayant copié l'entrée ;
+ *  - avec zeroCopyHistory, l'historique référence la texture de
+ *    l'application mais copie la texture intermédiaire produite par
+ *    l'upscaling, réécrite à la frame suivante ;
+ *  - FrameGenerationStage::SetHistoryLength après l'initialisation
+ *    redimensionne l'anneau en conservant les frames les plus récentes.
+ */
+
+#include "../../include/XIS/XIS.h"
+#include "../../src/Core/XISContext.h"
+#include "../../src/Pipeline/FrameGenerationStage.h"
+#include "../../src/Renderer/CPU/CPURenderer.h"
+#include "TestSupport.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace XIS;
+using UnitTest::Check;
+
+namespace {
+
+// Damier décalé de `shift` pixels vers la droite
+void FillFrame(void* texture, uint32_t width, uint32_t height, uint32_t shift)
+{
+    uint32_t pitch = 0;
+    uint8_t* pixels = CPU::MapTexture(texture, &pitch);
+    for (uint32_t y = 0; y < height; ++y) {
+        uint8_t* row = pixels + static_cast<size_t>(pitch) * y;
+        for (uint32_t x = 0; x < width; ++x) {
+            bool light = (((x + width - shift) / 8) + (y / 8)) % 2 == 0;
+            uint8_t value = light ? 220 : 30;
+            row[x * 4 + 0] = value;
+            row[x * 4 + 1] = static_cast<uint8_t>(value / 2 + x);
+            row[x * 4 + 2] = static_cast<uint8_t>(255 - value);
+            row[x * 4 + 3] = 255;
+        }
+    }
+}
+
+std::vector<uint8_t> ReadFrame(void* texture, uint32_t width, uint32_t height)
+{
+    uint32_t pitch = 0;
+    const uint8_t* pixels = CPU::MapTexture(texture, &pitch);
+    std::vector<uint8_t> frame(static_cast<size_t>(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        std::memcpy(frame.data() + static_cast<size_t>(width) * 4 * y, pixels + static_cast<size_t>(pitch) * y,
+                    static_cast<size_t>(width) * 4);
+    }
+    return frame;
+}
+
+const uint32_t kInputSize = 64;
+const uint32_t kOutputSize = 128;
+
+/**
+ * @brief Traite deux frames et renvoie la frame générée entre elles
+ *
+ * @param upscale Upscaling avant la génération ; sinon aucune étape ne précède
+ *                la génération, qui reçoit directement la texture d'entrée
+ * @param recycleInput Une seule texture d'entrée, réécrite entre les deux frames
+ */
+std::vector<uint8_t> GenerateBetweenTwoFrames(bool upscale, bool recycleInput, bool zeroCopyHistory)
+{
+    const uint32_t outputSize = upscale ? kOutputSize : kInputSize;
+
+    XISConfig config;
+    config.enableBicubicUpscaling = upscale;
+    config.upscalingParams.outputWidth = outputSize;
+    config.upscalingParams.outputHeight = outputSize;
+    if (!upscale) {
+        config.upscalingParams.mode = UpscalingMode::Bicubic;
+        config.enableAntiAliasing = false;
+    }
+    config.enableFrameGeneration = true;
+    config.frameGenParams.zeroCopyHistory = zeroCopyHistory;
+    // Petit rayon de recherche : le test porte sur l'historique, pas sur l'estimation
+    config.dynamicResolution.minSearchRadius = 4;
+    config.dynamicResolution.maxSearchRadius = 4;
+
+    XISSessionHandle session = CPU::CreateSession(config, 1);
+    void* inputs[2] = { CPU::CreateTexture(kInputSize, kInputSize), nullptr };
+    inputs[1] = recycleInput ? inputs[0] : CPU::CreateTexture(kInputSize, kInputSize);
+    void* output = CPU::CreateTexture(outputSize, outputSize);
+    void* generated = CPU::CreateTexture(outputSize, outputSize);
+
+    std::vector<uint8_t> frame;
+    if (session && inputs[0] && inputs[1] && output && generated) {
+        XISParameters params;
+        params.outputTexture = output;
+        params.generatedFrameTexture = generated;
+        params.isDX11 = false;
+
+        bool processed = true;
+        for (uint32_t i = 0; i < 2; ++i) {
+            FillFrame(inputs[i], kInputSize, kInputSize, i * 4);
+            params.inputTexture = inputs[i];
+            processed = ProcessFrame(session, params) && processed;
+        }
+        if (processed) {
+            frame = ReadFrame(generated, outputSize, outputSize);
+        }
+    }
+
+    CPU::ReleaseTexture(generated);
+    CPU::ReleaseTexture(output);
+    if (inputs[1] != inputs[0]) {
+        CPU::ReleaseTexture(inputs[1]);
+    }
+    CPU::ReleaseTexture(inputs[0]);
+    DestroySession(session);
+    return frame;
+}
+
+void TestRecycledInput()
+{
+    const char* test = "RecycledInput";
+    std::vector<uint8_t> reference = GenerateBetweenTwoFrames(true, false, false);
+    std::vector<uint8_t> recycled = GenerateBetweenTwoFrames(true, true, false);
+    Check(!reference.empty() && !recycled.empty(), test, "frames non traitées");
+    Check(recycled == reference, test, "la frame générée dépend du recyclage de l'entrée");
+
+    // Sans copie, l'historique relit l'entrée réécrite : le test doit voir la différence
+    std::vector<uint8_t> direct = GenerateBetweenTwoFrames(false, false, false);
+    std::vector<uint8_t> stale = GenerateBetweenTwoFrames(false, true, true);
+    Check(!direct.empty() && !stale.empty() && stale != direct, test,
+          "le recyclage d'une entrée importée sans copie n'est pas détecté");
+}
+
+void TestZeroCopyHistory()
+{
+    const char* test = "ZeroCopyHistory";
+
+    // Une texture par frame : la référence sans copie équivaut à la copie
+    std::vector<uint8_t> direct = GenerateBetweenTwoFrames(false, false, false);
+    std::vector<uint8_t> directZeroCopy = GenerateBetweenTwoFrames(false, false, true);
+    Check(!directZeroCopy.empty() && directZeroCopy == direct, test, "entrée de l'application référencée");
+
+    // Après l'upscaling, l'étape reçoit une texture intermédiaire réutilisée
+    // d'une frame à l'autre, qui doit être copiée malgré zeroCopyHistory
+    std::vector<uint8_t> reference = GenerateBetweenTwoFrames(true, false, false);
+    std::vector<uint8_t> upscaledZeroCopy = GenerateBetweenTwoFrames(true, false, true);
+    Check(!upscaledZeroCopy.empty() && upscaledZeroCopy == reference, test,
+          "texture intermédiaire référencée sans copie");
+}
+
+void TestHistoryResize()
+{
+    const char* test = "HistoryResize";
+    const int size = 32;
+
+    auto renderer = std::make_shared<CPURenderer>(1);
+    XISContext context(renderer, nullptr);
+    context.SetBackBuffer(size, size, 0);
+    XISContext::ScopedCurrent scopedContext(&context);
+
+    void* input = CPU::CreateTexture(size, size);
+    void* output = CPU::CreateTexture(size, size);
+    XISParameters params;
+    params.inputTexture = input;
+    params.outputTexture = output;
+    params.isDX11 = false;
+
+    {
+        FrameGenerationStage stage;
+        Check(stage.Initialize(&context), test, "initialisation");
+        stage.SetMotionSearchRadius(4);
+
+        std::vector<uint8_t> frames[5];
+        for (uint32_t i = 0; i < 3; ++i) {
+            FillFrame(input, size, size, i * 2);
+            frames[i] = ReadFrame(input, size, size);
+            Check(stage.Process(&context, input, output, params), test, "traitement");
+        }
+
+        stage.SetHistoryLength(4);
+        const FrameHistory* history = stage.GetFrameHistory();
+        Check(history && history->GetCapacity() == 4, test, "capacité non appliquée après l'initialisation");
+        Check(history && history->GetCount() == 2, test, "frames conservées perdues à l'agrandissement");
+        Check(stage.IsReady(), test, "historique insuffisant après l'agrandissement");
+
+        for (uint32_t i = 3; i < 5; ++i) {
+            FillFrame(input, size, size, i * 2);
+            frames[i] = ReadFrame(input, size, size);
+            Check(stage.Process(&context, input, output, params), test, "traitement");
+        }
+        history = stage.GetFrameHistory();
+        Check(history->GetCount() == 4, test, "l'anneau agrandi ne se remplit pas");
+
+        stage.SetHistoryLength(2);
+        history = stage.GetFrameHistory();
+        Check(history->GetCapacity() == 2 && history->GetCount() == 2, test, "réduction de l'anneau");
+        for (int age = 0; age < 2; ++age) {
+            FrameHistory::FrameRef frame = history->Get(age);
+            Check(frame && ReadFrame(frame.GetTexture(), size, size) == frames[4 - age], test,
+                  "contenu ou âge d'une frame conservée modifié");
+        }
+    }
+
+    CPU::ReleaseTexture(output);
+    CPU::ReleaseTexture(input);
+}
+
+} // namespace
+
+int main()
+{
+    return UnitTest::Run("FrameHistoryTest", {
+        TestRecycledInput,
+        TestZeroCopyHistory,
+        TestHistoryResize
+    });
+}
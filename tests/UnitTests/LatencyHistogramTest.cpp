@@ -0,0 +1,62 @@
+/**
+ * @brief Tests de l'histogramme de latences sur fenêtre glissante
+ *
+ *  - les échantillons sortis de la fenêtre ne sont plus comptés ;
+ *  - après Reset, un échantillon enregistré dans la tranche courante est
+ *    compté immédiatement.
+ */
+
+#include "../../src/Utils/LatencyHistogram.h"
+#include "TestSupport.h"
+
+using namespace XIS;
+using UnitTest::Check;
+
+namespace {
+
+// Fenêtre de 10 tranches de 1 s
+const uint64_t kSecondNs = 1000000000ull;
+
+uint64_t CountAt(const WindowedLatencyHistogram& histogram, uint64_t nowNs)
+{
+    LatencyHistogram result;
+    histogram.Collect(nowNs, result);
+    return result.GetCount();
+}
+
+void TestWindowSlides()
+{
+    const char* test = "WindowSlides";
+    WindowedLatencyHistogram histogram(10 * kSecondNs, 10);
+
+    histogram.Record(100 * kSecondNs, 1000);
+    histogram.Record(105 * kSecondNs, 1000);
+    Check(CountAt(histogram, 105 * kSecondNs) == 2, test, "échantillons de la fenêtre");
+    Check(CountAt(histogram, 112 * kSecondNs) == 1, test, "échantillon sorti de la fenêtre compté");
+    Check(CountAt(histogram, 120 * kSecondNs) == 0, test, "fenêtre vide");
+}
+
+void TestRecordAfterReset()
+{
+    const char* test = "RecordAfterReset";
+    WindowedLatencyHistogram histogram(10 * kSecondNs, 10);
+
+    histogram.Record(100 * kSecondNs, 1000);
+    histogram.Reset();
+    Check(CountAt(histogram, 100 * kSecondNs) == 0, test, "échantillon conservé par Reset");
+
+    // Même tranche que le dernier échantillon avant Reset
+    histogram.Record(100 * kSecondNs + 1, 1000);
+    Check(CountAt(histogram, 100 * kSecondNs + 1) == 1, test, "échantillon ignoré après Reset");
+    Check(CountAt(histogram, 105 * kSecondNs) == 1, test, "échantillon perdu avant la fin de la fenêtre");
+}
+
+} // namespace
+
+int main()
+{
+    return UnitTest::Run("LatencyHistogramTest", {
+        TestWindowSlides,
+        TestRecordAfterReset
+    });
+}
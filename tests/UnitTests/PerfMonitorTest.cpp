@@ -0,0 +1,158 @@
+/**
+ * @brief Tests des anneaux et du consommateur du PerfMonitor
+ *
+ *  - le thread consommateur partagé agrège les frames de tous les
+ *    moniteurs, sans appel explicite à Flush ;
+ *  - les événements d'un thread terminé sont agrégés, puis son anneau
+ *    libéré sans perte ;
+ *  - un thread qui écrit dans plus de moniteurs qu'il n'y a de sessions
+ *    typiques garde un anneau par moniteur, y compris après la
+ *    destruction de certains d'entre eux.
+ */
+
+#include "../../src/Utils/PerfMonitor.h"
+#include "TestSupport.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace XIS;
+using UnitTest::Check;
+
+namespace {
+
+// Frame d'une étape qui transfère `bytes` octets lus
+void RunFrame(PerfMonitor& perfMonitor, PerfMonitor::StageId stage, uint64_t bytes)
+{
+    perfMonitor.StartFrame();
+    perfMonitor.StartStage(stage);
+    perfMonitor.RecordBytes(bytes, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    perfMonitor.EndStage(stage);
+    perfMonitor.EndFrame();
+}
+
+uint64_t CollectBytesRead(const PerfMonitor& perfMonitor)
+{
+    PerfMonitor::BandwidthSnapshot bandwidth;
+    perfMonitor.CollectBandwidth(bandwidth);
+    return bandwidth.bytesRead;
+}
+
+void TestSharedConsumerAggregates()
+{
+    const char* test = "SharedConsumerAggregates";
+    const int monitorCount = 6;
+
+    std::vector<std::unique_ptr<PerfMonitor>> monitors;
+    for (int i = 0; i < monitorCount; ++i) {
+        monitors.push_back(std::make_unique<PerfMonitor>());
+        RunFrame(*monitors.back(), monitors.back()->RegisterStage("Stage"), 100 + i);
+    }
+
+    // L'agrégation est asynchrone : attendre quelques périodes du consommateur
+    bool aggregated = false;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!aggregated && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        aggregated = true;
+        for (int i = 0; i < monitorCount; ++i) {
+            aggregated = aggregated && CollectBytesRead(*monitors[i]) == static_cast<uint64_t>(100 + i);
+        }
+    }
+    Check(aggregated, test, "frames non agrégées par le consommateur partagé");
+
+    // Le consommateur s'arrête avec le dernier moniteur et redémarre avec le suivant
+    monitors.clear();
+    PerfMonitor restarted;
+    RunFrame(restarted, restarted.RegisterStage("Stage"), 42);
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (CollectBytesRead(restarted) != 42 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    Check(CollectBytesRead(restarted) == 42, test, "consommateur non redémarré");
+}
+
+void TestExitedThreadRingIsRetired()
+{
+    const char* test = "ExitedThreadRingIsRetired";
+    PerfMonitor perfMonitor(false);
+    PerfMonitor::StageId stage = perfMonitor.RegisterStage("Worker");
+
+    // Chaque thread écrit dans son anneau puis se termine avant l'agrégation
+    const int threadCount = 64;
+    perfMonitor.StartFrame();
+    for (int i = 0; i < threadCount; ++i) {
+        std::thread worker([&perfMonitor, stage] {
+            perfMonitor.StartStage(stage);
+            perfMonitor.RecordBytes(10, 1);
+            perfMonitor.EndStage(stage);
+        });
+        worker.join();
+    }
+    perfMonitor.EndFrame();
+
+    perfMonitor.Flush();
+    PerfMonitor::BandwidthSnapshot bandwidth;
+    perfMonitor.CollectBandwidth(bandwidth);
+    Check(bandwidth.bytesRead == 10u * threadCount, test, "événements d'un thread terminé perdus");
+    Check(bandwidth.stages.size() == 1 && bandwidth.stages[0].calls == static_cast<uint64_t>(threadCount), test,
+          "étapes d'un thread terminé non attribuées");
+
+    // Les anneaux libérés au passage suivant n'emportent pas leurs compteurs
+    perfMonitor.Flush();
+    RunFrame(perfMonitor, stage, 5);
+    perfMonitor.Flush();
+    perfMonitor.CollectBandwidth(bandwidth);
+    Check(bandwidth.bytesRead == 10u * threadCount + 5, test, "agrégation après la libération des anneaux");
+    Check(perfMonitor.GetDroppedEventCount() == 0, test, "événements perdus");
+}
+
+void TestThreadWritesToManyMonitors()
+{
+    const char* test = "ThreadWritesToManyMonitors";
+    const int monitorCount = 12;
+
+    std::vector<std::unique_ptr<PerfMonitor>> monitors;
+    std::vector<PerfMonitor::StageId> stages;
+    for (int i = 0; i < monitorCount; ++i) {
+        monitors.push_back(std::make_unique<PerfMonitor>(false));
+        stages.push_back(monitors.back()->RegisterStage("Stage"));
+    }
+
+    // Un thread de l'ordonnanceur alterne entre les sessions
+    std::thread worker([&] {
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < monitorCount; ++i) {
+                RunFrame(*monitors[i], stages[i], 1);
+            }
+        }
+
+        // Moniteurs détruits pendant la vie du thread, puis nouveaux moniteurs
+        for (int i = 0; i < monitorCount / 2; ++i) {
+            monitors[i].reset(new PerfMonitor(false));
+            stages[i] = monitors[i]->RegisterStage("Stage");
+            RunFrame(*monitors[i], stages[i], 7);
+        }
+    });
+    worker.join();
+
+    for (int i = 0; i < monitorCount; ++i) {
+        monitors[i]->Flush();
+        uint64_t expected = i < monitorCount / 2 ? 7 : 3;
+        Check(CollectBytesRead(*monitors[i]) == expected, test, "événements attribués au mauvais moniteur");
+    }
+}
+
+} // namespace
+
+int main()
+{
+    return UnitTest::Run("PerfMonitorTest", {
+        TestSharedConsumerAggregates,
+        TestExitedThreadRingIsRetired,
+        TestThreadWritesToManyMonitors
+    });
+}
@@ -0,0 +1,176 @@
+/**
+ * @brief Tests du rejeu d'une capture de frames
+ *
+ *  - une capture commencée alors qu'un plafond de qualité bas réduisait
+ *    déjà l'entrée (qualityFactor < 1, sans résolution dynamique ni mode
+ *    adaptatif) se rejoue sur une session neuve : le point de
+ *    fonctionnement imposé crée l'étape de downsampling dès la première
+ *    frame rejouée.
+ */
+
+#include "../../include/XIS/XIS.h"
+#include "../../src/Core/XISCore.h"
+#include "../../src/Renderer/CPU/CPURenderer.h"
+#include "../../src/Renderer/CPU/CPUResources.h"
+#include "../../src/Utils/FrameCapture.h"
+#include "TestSupport.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+using namespace XIS;
+using UnitTest::Check;
+
+namespace {
+
+const uint32_t kInputSize = 64;
+const uint32_t kOutputSize = 128;
+const char* const kCapturePath = "ReplayTest.xiscap";
+
+void FillFrame(void* texture, uint32_t shift)
+{
+    uint32_t pitch = 0;
+    uint8_t* pixels = CPU::MapTexture(texture, &pitch);
+    for (uint32_t y = 0; y < kInputSize; ++y) {
+        uint8_t* row = pixels + static_cast<size_t>(pitch) * y;
+        for (uint32_t x = 0; x < kInputSize; ++x) {
+            uint8_t value = ((x + shift) / 8 + y / 8) % 2 == 0 ? 220 : 30;
+            row[x * 4 + 0] = value;
+            row[x * 4 + 1] = value;
+            row[x * 4 + 2] = value;
+            row[x * 4 + 3] = 255;
+        }
+    }
+}
+
+/**
+ * @brief Enregistre `capturedFrames` frames après `warmupFrames` frames
+ *        sous le plafond de qualité `qualityFactor`
+ */
+bool RecordCapture(const XISConfig& config, float qualityFactor, uint32_t warmupFrames, uint32_t capturedFrames)
+{
+    XISSessionHandle session = CPU::CreateSession(config, 1);
+    void* input = CPU::CreateTexture(kInputSize, kInputSize);
+    void* output = CPU::CreateTexture(kOutputSize, kOutputSize);
+
+    bool recorded = session && input && output;
+    if (recorded) {
+        XISParameters params;
+        params.inputTexture = input;
+        params.outputTexture = output;
+        params.qualityFactor = qualityFactor;
+        params.isDX11 = false;
+
+        for (uint32_t i = 0; i < warmupFrames + capturedFrames && recorded; ++i) {
+            if (i == warmupFrames) {
+                recorded = StartFrameCapture(session, kCapturePath, capturedFrames);
+            }
+            FillFrame(input, i);
+            recorded = recorded && ProcessFrame(session, params);
+        }
+    }
+
+    CPU::ReleaseTexture(output);
+    CPU::ReleaseTexture(input);
+    DestroySession(session);
+    return recorded;
+}
+
+/**
+ * @brief Rejoue la capture comme ReplayCapture, sur une session neuve
+ *
+ * @param minInputScale Plus petite échelle d'entrée rencontrée
+ */
+bool ReplayCapture(uint32_t& replayedFrames, float& minInputScale)
+{
+    replayedFrames = 0;
+    minInputScale = 1.0f;
+
+    FrameCaptureReader reader;
+    if (!reader.Open(kCapturePath)) {
+        return false;
+    }
+
+    XISCore core;
+    if (!core.Initialize(std::make_shared<CPURenderer>(1), reader.GetConfig())) {
+        return false;
+    }
+    Pipeline* pipeline = core.GetPipeline();
+
+    CPUTexture* input = nullptr;
+    CPUTexture* output = nullptr;
+    bool replayed = true;
+    CapturedFrame frame;
+    bool configChanged = false;
+    while (replayed && reader.ReadNextFrame(frame, configChanged)) {
+        if (configChanged) {
+            pipeline->PublishConfig(reader.GetConfig());
+        }
+        pipeline->ForceNextOperatingPoint(frame.operatingPoint);
+        if (frame.operatingPoint.inputScale < minInputScale) {
+            minInputScale = frame.operatingPoint.inputScale;
+        }
+
+        if (!input) {
+            input = CreateCPUTexture(frame.inputWidth, frame.inputHeight, static_cast<CPUTextureFormat>(frame.inputFormat));
+            output = CreateCPUTexture(frame.outputWidth, frame.outputHeight, static_cast<CPUTextureFormat>(frame.outputFormat));
+        }
+        size_t rowBytes = input ? static_cast<size_t>(input->width) * GetCPUFormatSize(input->format) : 0;
+        if (!input || !output || frame.pixelBytes != rowBytes * static_cast<size_t>(input->height)) {
+            replayed = false;
+            break;
+        }
+        for (int y = 0; y < input->height; ++y) {
+            std::memcpy(input->GetRow(y), frame.pixels + rowBytes * static_cast<size_t>(y), rowBytes);
+        }
+
+        XISParameters params;
+        params.inputTexture = input;
+        params.outputTexture = output;
+        params.frameDeltaTime = frame.frameDeltaTime;
+        params.qualityFactor = frame.qualityFactor;
+        params.isDX11 = false;
+        replayed = core.ProcessFrame(params, static_cast<ShedLevel>(frame.shedLevel));
+        if (replayed) {
+            replayedFrames++;
+        }
+    }
+
+    ReleaseCPUResource(output);
+    ReleaseCPUResource(input);
+    return replayed && replayedFrames == reader.GetFrameCount();
+}
+
+void TestReplayWithQualityCap()
+{
+    const char* test = "ReplayWithQualityCap";
+
+    XISConfig config;
+    config.enableBicubicUpscaling = true;
+    config.upscalingParams.mode = UpscalingMode::Bicubic;
+    config.upscalingParams.outputWidth = kOutputSize;
+    config.upscalingParams.outputHeight = kOutputSize;
+    config.dynamicResolution.enabled = false;
+
+    const uint32_t capturedFrames = 3;
+    Check(RecordCapture(config, 0.1f, 2, capturedFrames), test, "enregistrement de la capture");
+
+    uint32_t replayedFrames = 0;
+    float minInputScale = 1.0f;
+    Check(ReplayCapture(replayedFrames, minInputScale), test, "rejeu interrompu");
+    Check(replayedFrames == capturedFrames, test, "frames rejouées");
+    Check(minInputScale < 1.0f, test, "la capture ne réduit pas l'entrée");
+
+    std::remove(kCapturePath);
+}
+
+} // namespace
+
+int main()
+{
+    return UnitTest::Run("ReplayTest", {
+        TestReplayWithQualityCap
+    });
+}
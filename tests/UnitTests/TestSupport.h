@@ -0,0 +1,66 @@
+#pragma once
+
+/**
+ * @brief Outils communs aux tests unitaires de tests/UnitTests
+ *
+ * Chaque exécutable regroupe des fonctions de test sans argument qui
+ * signalent leurs échecs par Check ; Run les exécute dans l'ordre et fournit
+ * le code de retour attendu par ctest : 0 si tous les tests passent, 1 sinon.
+ */
+
+#include <cstdio>
+#include <initializer_list>
+
+namespace XIS {
+namespace UnitTest {
+
+struct SuiteState {
+    const char* name = "UnitTest";
+    int failures = 0;
+};
+
+inline SuiteState& GetSuite()
+{
+    static SuiteState suite;
+    return suite;
+}
+
+/**
+ * @brief Signale un échec si condition est fausse, sans interrompre le test
+ *
+ * @param test Nom du test en cours
+ * @param what Description de la vérification en échec
+ */
+inline void Check(bool condition, const char* test, const char* what)
+{
+    if (!condition) {
+        SuiteState& suite = GetSuite();
+        std::fprintf(stderr, "[%s] %s : échec, %s\n", suite.name, test, what);
+        suite.failures++;
+    }
+}
+
+/**
+ * @brief Exécute les tests d'un exécutable et résume le résultat
+ *
+ * @param suiteName Nom de l'exécutable, préfixe des messages
+ * @return Code de retour du programme
+ */
+inline int Run(const char* suiteName, std::initializer_list<void (*)()> tests)
+{
+    SuiteState& suite = GetSuite();
+    suite.name = suiteName;
+    for (void (*test)() : tests) {
+        test();
+    }
+
+    if (suite.failures > 0) {
+        std::fprintf(stderr, "[%s] %d vérification(s) en échec\n", suite.name, suite.failures);
+        return 1;
+    }
+    std::printf("[%s] tous les tests passent\n", suite.name);
+    return 0;
+}
+
+} // namespace UnitTest
+} // namespace XIS
@@ -0,0 +1,123 @@
+/**
+ * @brief Vérification d'un fichier de configuration avant déploiement
+ *
+ * Analyse le fichier avec les règles du rechargement à chaud
+ * (ConfigManager::ParseConfig) et affiche la configuration obtenue en
+ * l'appliquant à la configuration par défaut. Avec --watch, le fichier est
+ * ensuite surveillé comme par une session : chaque version acceptée ou
+ * rejetée est signalée jusqu'à l'interruption du programme.
+ *
+ * Usage :
+ *   ConfigCheck FILE [--watch]
+ *
+ * Codes de retour : 0 si le fichier est valide, 1 s'il est invalide, 2 en
+ * cas d'erreur d'utilisation.
+ */
+
+#include "../../src/Utils/ConfigManager.h"
+#include "../../src/Utils/Logger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+using namespace XIS;
+
+namespace {
+
+const char* const kUpscalingModes[] = { "bicubic", "sharp", "adaptive" };
+const char* const kAAQualities[] = { "off", "low", "medium", "high" };
+const char* const kFrameGenModes[] = { "interp", "mc", "advanced" };
+
+const char* OnOff(bool value)
+{
+    return value ? "on" : "off";
+}
+
+void PrintConfig(const XISConfig& config)
+{
+    const UpscalingParameters& upscaling = config.upscalingParams;
+    const FrameGenParameters& frameGen = config.frameGenParams;
+    const DynamicResolutionParameters& dynamic = config.dynamicResolution;
+
+    std::printf("enableUpscaling = %s\n", OnOff(config.enableBicubicUpscaling));
+    std::printf("enableFrameGeneration = %s\n", OnOff(config.enableFrameGeneration));
+    std::printf("enableAntiAliasing = %s\n", OnOff(config.enableAntiAliasing));
+    std::printf("enableSharpness = %s\n", OnOff(config.enableSharpness));
+    std::printf("latencyWindowSeconds = %g\n", config.latencyWindowSeconds);
+    std::printf("stageReleaseDelaySeconds = %g\n", config.stageReleaseDelaySeconds);
+
+    std::printf("\n[upscaling]\n");
+    std::printf("mode = %s\n", kUpscalingModes[static_cast<int>(upscaling.mode)]);
+    std::printf("sharpnessStrength = %g\n", upscaling.sharpnessStrength);
+    std::printf("edgePreservation = %g\n", upscaling.edgePreservation);
+    std::printf("outputWidth = %u\n", upscaling.outputWidth);
+    std::printf("outputHeight = %u\n", upscaling.outputHeight);
+    std::printf("preserveFilmGrain = %s\n", OnOff(upscaling.preserveFilmGrain));
+
+    std::printf("\n[antiAliasing]\n");
+    std::printf("quality = %s\n", kAAQualities[static_cast<int>(config.aaQuality)]);
+
+    std::printf("\n[frameGeneration]\n");
+    std::printf("mode = %s\n", kFrameGenModes[static_cast<int>(frameGen.mode)]);
+    std::printf("targetFrameRate = %u\n", frameGen.targetFrameRate);
+    std::printf("motionSensitivity = %g\n", frameGen.motionSensitivity);
+    std::printf("artifactReduction = %g\n", frameGen.artifactReduction);
+    std::printf("sceneChangeDetection = %s\n", OnOff(frameGen.enableSceneChangeDetection));
+    std::printf("historyLength = %u\n", frameGen.historyLength);
+    std::printf("zeroCopyHistory = %s\n", OnOff(frameGen.zeroCopyHistory));
+
+    std::printf("\n[dynamicResolution]\n");
+    std::printf("enabled = %s\n", OnOff(dynamic.enabled));
+    std::printf("frameTimeBudgetMs = %g\n", dynamic.frameTimeBudgetMs);
+    std::printf("hysteresisPercent = %g\n", dynamic.hysteresisPercent);
+    std::printf("minInputScale = %g\n", dynamic.minInputScale);
+    std::printf("maxInputScale = %g\n", dynamic.maxInputScale);
+    std::printf("minSearchRadius = %u\n", dynamic.minSearchRadius);
+    std::printf("maxSearchRadius = %u\n", dynamic.maxSearchRadius);
+    std::printf("proportionalGain = %g\n", dynamic.proportionalGain);
+    std::printf("integralGain = %g\n", dynamic.integralGain);
+    std::printf("derivativeGain = %g\n", dynamic.derivativeGain);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3 || (argc == 3 && std::strcmp(argv[2], "--watch") != 0)) {
+        std::fprintf(stderr, "Usage: ConfigCheck FILE [--watch]\n");
+        return 2;
+    }
+    const char* path = argv[1];
+
+    ConfigPatch patch;
+    bool valid = ConfigManager::LoadConfigFile(path, patch);
+    Logger::Flush();
+    if (!valid) {
+        return 1;
+    }
+
+    XISConfig config;
+    patch.ApplyTo(config);
+    std::printf("# %s : %zu réglages, configuration résultante\n", path, patch.GetSize());
+    PrintConfig(config);
+    std::fflush(stdout);
+
+    if (argc == 3) {
+        ConfigManager::AddConfigListener([](const ConfigPatch& next) {
+            std::printf("# version %llu acceptée : %zu réglages\n",
+                        static_cast<unsigned long long>(ConfigManager::GetConfigVersion()), next.GetSize());
+            std::fflush(stdout);
+        });
+        if (!ConfigManager::WatchConfigFile(path)) {
+            Logger::Flush();
+            return 1;
+        }
+        // Les rejets sont signalés par le journal
+        for (;;) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,303 @@
+#include "Json.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace XIS {
+namespace Profiler {
+
+namespace {
+    const JsonValue kNull;
+}
+
+const JsonValue& JsonValue::operator[](const char* key) const
+{
+    for (const auto& member : m_members) {
+        if (member.first == key) {
+            return member.second;
+        }
+    }
+    return kNull;
+}
+
+const JsonValue& JsonValue::operator[](size_t index) const
+{
+    return index < m_items.size() ? m_items[index] : kNull;
+}
+
+/**
+ * Analyseur récursif descendant
+ */
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : m_text(text) {}
+
+    bool ParseDocument(JsonValue& value, std::string& error)
+    {
+        if (!ParseValue(value, 0)) {
+            error = m_error;
+            return false;
+        }
+        SkipWhitespace();
+        if (m_position != m_text.size()) {
+            error = Describe("données après la valeur racine");
+            return false;
+        }
+        return true;
+    }
+
+private:
+    static const int kMaxDepth = 64;
+
+    void SkipWhitespace()
+    {
+        while (m_position < m_text.size() && std::strchr(" \t\r\n", m_text[m_position])) {
+            m_position++;
+        }
+    }
+
+    std::string Describe(const char* message) const
+    {
+        char text[128];
+        std::snprintf(text, sizeof(text), "%s (position %zu)", message, m_position);
+        return text;
+    }
+
+    bool Fail(const char* message)
+    {
+        m_error = Describe(message);
+        return false;
+    }
+
+    bool Consume(const char* literal)
+    {
+        size_t length = std::strlen(literal);
+        if (m_text.compare(m_position, length, literal) != 0) {
+            return false;
+        }
+        m_position += length;
+        return true;
+    }
+
+    bool ParseValue(JsonValue& value, int depth)
+    {
+        if (depth > kMaxDepth) {
+            return Fail("imbrication trop profonde");
+        }
+
+        SkipWhitespace();
+        if (m_position >= m_text.size()) {
+            return Fail("fin de document inattendue");
+        }
+
+        char c = m_text[m_position];
+        if (c == '{') {
+            return ParseObject(value, depth);
+        }
+        if (c == '[') {
+            return ParseArray(value, depth);
+        }
+        if (c == '"') {
+            value.m_type = JsonValue::Type::String;
+            return ParseString(value.m_string);
+        }
+        if (Consume("true")) {
+            value.m_type = JsonValue::Type::Bool;
+            value.m_bool = true;
+            return true;
+        }
+        if (Consume("false")) {
+            value.m_type = JsonValue::Type::Bool;
+            value.m_bool = false;
+            return true;
+        }
+        if (Consume("null")) {
+            value.m_type = JsonValue::Type::Null;
+            return true;
+        }
+        return ParseNumber(value);
+    }
+
+    bool ParseNumber(JsonValue& value)
+    {
+        const char* start = m_text.c_str() + m_position;
+        char* end = nullptr;
+        double number = std::strtod(start, &end);
+        if (end == start) {
+            return Fail("valeur invalide");
+        }
+        m_position += static_cast<size_t>(end - start);
+        value.m_type = JsonValue::Type::Number;
+        value.m_number = number;
+        return true;
+    }
+
+    bool ParseString(std::string& out)
+    {
+        m_position++; // '"'
+        out.clear();
+
+        while (m_position < m_text.size()) {
+            char c = m_text[m_position++];
+            if (c == '"') {
+                return true;
+            }
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (m_position >= m_text.size()) {
+                break;
+            }
+
+            char escape = m_text[m_position++];
+            switch (escape) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                if (m_position + 4 > m_text.size()) {
+                    return Fail("séquence \\u incomplète");
+                }
+                unsigned code = static_cast<unsigned>(std::strtoul(m_text.substr(m_position, 4).c_str(), nullptr, 16));
+                m_position += 4;
+                // UTF-8 ; les paires de substitution ne sont pas recombinées
+                if (code < 0x80) {
+                    out += static_cast<char>(code);
+                } else if (code < 0x800) {
+                    out += static_cast<char>(0xC0 | (code >> 6));
+                    out += static_cast<char>(0x80 | (code & 0x3F));
+                } else {
+                    out += static_cast<char>(0xE0 | (code >> 12));
+                    out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (code & 0x3F));
+                }
+                break;
+            }
+            default:
+                return Fail("séquence d'échappement invalide");
+            }
+        }
+
+        return Fail("chaîne non terminée");
+    }
+
+    bool ParseArray(JsonValue& value, int depth)
+    {
+        m_position++; // '['
+        value.m_type = JsonValue::Type::Array;
+
+        SkipWhitespace();
+        if (m_position < m_text.size() && m_text[m_position] == ']') {
+            m_position++;
+            return true;
+        }
+
+        for (;;) {
+            value.m_items.emplace_back();
+            if (!ParseValue(value.m_items.back(), depth + 1)) {
+                return false;
+            }
+
+            SkipWhitespace();
+            if (m_position >= m_text.size()) {
+                return Fail("tableau non terminé");
+            }
+            char c = m_text[m_position++];
+            if (c == ']') {
+                return true;
+            }
+            if (c != ',') {
+                return Fail("',' ou ']' attendu");
+            }
+        }
+    }
+
+    bool ParseObject(JsonValue& value, int depth)
+    {
+        m_position++; // '{'
+        value.m_type = JsonValue::Type::Object;
+
+        SkipWhitespace();
+        if (m_position < m_text.size() && m_text[m_position] == '}') {
+            m_position++;
+            return true;
+        }
+
+        for (;;) {
+            SkipWhitespace();
+            if (m_position >= m_text.size() || m_text[m_position] != '"') {
+                return Fail("clé attendue");
+            }
+
+            value.m_members.emplace_back();
+            if (!ParseString(value.m_members.back().first)) {
+                return false;
+            }
+
+            SkipWhitespace();
+            if (m_position >= m_text.size() || m_text[m_position] != ':') {
+                return Fail("':' attendu");
+            }
+            m_position++;
+
+            if (!ParseValue(value.m_members.back().second, depth + 1)) {
+                return false;
+            }
+
+            SkipWhitespace();
+            if (m_position >= m_text.size()) {
+                return Fail("objet non terminé");
+            }
+            char c = m_text[m_position++];
+            if (c == '}') {
+                return true;
+            }
+            if (c != ',') {
+                return Fail("',' ou '}' attendu");
+            }
+        }
+    }
+
+    const std::string& m_text;
+    size_t m_position = 0;
+    std::string m_error;
+};
+
+bool JsonValue::Parse(const std::string& text, JsonValue& value, std::string& error)
+{
+    value = JsonValue();
+    JsonParser parser(text);
+    return parser.ParseDocument(value, error);
+}
+
+bool JsonValue::ParseFile(const std::string& path, JsonValue& value, std::string& error)
+{
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        error = "impossible d'ouvrir " + path;
+        return false;
+    }
+
+    std::string text;
+    char buffer[65536];
+    size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, read);
+    }
+    std::fclose(file);
+
+    if (!Parse(text, value, error)) {
+        error = path + " : " + error;
+        return false;
+    }
+    return true;
+}
+
+} // namespace Profiler
+} // namespace XIS
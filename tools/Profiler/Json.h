@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace XIS {
+namespace Profiler {
+
+/**
+ * @brief Valeur JSON en lecture seule
+ *
+ * Suffisant pour les résultats de PipelineBenchmark : objets (ordre des clés
+ * conservé), tableaux, chaînes, nombres, booléens et null.
+ */
+class JsonValue {
+public:
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    Type GetType() const { return m_type; }
+    bool IsObject() const { return m_type == Type::Object; }
+    bool IsArray() const { return m_type == Type::Array; }
+
+    bool AsBool(bool fallback = false) const { return m_type == Type::Bool ? m_bool : fallback; }
+    double AsNumber(double fallback = 0.0) const { return m_type == Type::Number ? m_number : fallback; }
+    const std::string& AsString() const { return m_string; }
+
+    /**
+     * @brief Élément d'un objet, valeur nulle si la clé est absente
+     */
+    const JsonValue& operator[](const char* key) const;
+
+    /**
+     * @brief Élément d'un tableau, valeur nulle hors limites
+     */
+    const JsonValue& operator[](size_t index) const;
+
+    size_t Size() const { return m_type == Type::Array ? m_items.size() : m_members.size(); }
+    const std::vector<JsonValue>& Items() const { return m_items; }
+    const std::vector<std::pair<std::string, JsonValue>>& Members() const { return m_members; }
+
+    /**
+     * @brief Analyse un document JSON
+     *
+     * @param text Texte du document
+     * @param value Reçoit la valeur racine
+     * @param error Reçoit la description de l'erreur en cas d'échec
+     * @return true si le document est valide
+     */
+    static bool Parse(const std::string& text, JsonValue& value, std::string& error);
+
+    /**
+     * @brief Lit et analyse un fichier JSON
+     */
+    static bool ParseFile(const std::string& path, JsonValue& value, std::string& error);
+
+private:
+    friend class JsonParser;
+
+    Type m_type = Type::Null;
+    bool m_bool = false;
+    double m_number = 0.0;
+    std::string m_string;
+    std::vector<JsonValue> m_items;
+    std::vector<std::pair<std::string, JsonValue>> m_members;
+};
+
+} // namespace Profiler
+} // namespace XIS
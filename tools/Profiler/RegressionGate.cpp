@@ -0,0 +1,384 @@
+/**
+ * @brief Contrôle de non-régression des performances
+ *
+ * Compare les résultats de PipelineBenchmark à une référence enregistrée
+ * pour la même machine. Chaque configuration (run) est comparée étape par
+ * étape sur les échantillons par répétition : une étape régresse si sa
+ * médiane augmente de plus du seuil et si le test de Mann-Whitney
+ * unilatéral conclut au niveau alpha. Le code de retour est non nul en cas
+ * de régression, ce qui permet de bloquer une livraison.
+ *
+ * Les références sont rangées par empreinte de machine (modèle de CPU,
+ * nombre de cœurs, mémoire, architecture) : une comparaison entre machines
+ * différentes n'a pas de sens.
+ *
+ * Usage :
+ *   RegressionGate fingerprint RESULTS.json
+ *   RegressionGate record RESULTS.json [--baselines DIR]
+ *   RegressionGate compare RESULTS.json [--baselines DIR | --baseline FILE]
+ *                  [--threshold PCT] [--alpha P] [--min-ms MS]
+ *
+ * Codes de retour : 0 sans régression, 1 en cas de régression, 2 en cas
+ * d'erreur (arguments, fichiers, référence absente).
+ */
+
+#include "Json.h"
+#include "Statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace XIS::Profiler;
+
+namespace {
+
+const int kExitPass = 0;
+const int kExitRegression = 1;
+const int kExitError = 2;
+
+struct Options {
+    std::string command;
+    std::string resultsPath;
+    std::string baselineDirectory = "baselines";
+    std::string baselinePath;             // Référence explicite (ignore l'empreinte)
+    double thresholdPercent = 5.0;        // Hausse de médiane tolérée
+    double alpha = 0.01;                  // Niveau du test de significativité
+    double minDeltaMs = 0.05;             // Écart absolu en dessous duquel rien n'est signalé
+};
+
+void PrintUsage()
+{
+    std::fprintf(stderr,
+        "Usage:\n"
+        "  RegressionGate fingerprint RESULTS.json\n"
+        "  RegressionGate record RESULTS.json [--baselines DIR]\n"
+        "  RegressionGate compare RESULTS.json [--baselines DIR | --baseline FILE]\n"
+        "                 [--threshold PCT] [--alpha P] [--min-ms MS]\n"
+        "\n"
+        "  --baselines DIR   Répertoire des références par machine (défaut : baselines)\n"
+        "  --baseline FILE   Référence explicite, sans contrôle d'empreinte\n"
+        "  --threshold PCT   Hausse de médiane tolérée par étape (défaut : 5)\n"
+        "  --alpha P         Niveau du test de Mann-Whitney (défaut : 0.01)\n"
+        "  --min-ms MS       Écart absolu minimal signalé (défaut : 0.05)\n");
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+    if (argc < 3) {
+        return false;
+    }
+
+    options.command = argv[1];
+    options.resultsPath = argv[2];
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Valeur manquante pour %s\n", arg.c_str());
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--baselines") options.baselineDirectory = value;
+        else if (arg == "--baseline") options.baselinePath = value;
+        else if (arg == "--threshold") options.thresholdPercent = std::atof(value.c_str());
+        else if (arg == "--alpha") options.alpha = std::atof(value.c_str());
+        else if (arg == "--min-ms") options.minDeltaMs = std::atof(value.c_str());
+        else {
+            std::fprintf(stderr, "Option inconnue : %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    return options.command == "fingerprint" || options.command == "record" || options.command == "compare";
+}
+
+// ---------------------------------------------------------------------------
+// Empreinte de machine
+// ---------------------------------------------------------------------------
+
+uint64_t Fnv1a(const std::string& text)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * Nom de fichier lisible et stable : modèle de CPU abrégé suivi du hachage
+ * des caractéristiques. La mémoire est arrondie au Gio, la valeur exacte
+ * variant avec la mémoire réservée par le noyau.
+ */
+std::string Fingerprint(const JsonValue& results)
+{
+    const JsonValue& machine = results["machine"];
+    std::string model = machine["cpuModel"].AsString();
+    uint64_t memoryGiB = static_cast<uint64_t>(std::llround(machine["memoryBytes"].AsNumber() / (1024.0 * 1024.0 * 1024.0)));
+
+    std::string key = model + "|" +
+                      std::to_string(static_cast<uint64_t>(machine["logicalCores"].AsNumber())) + "|" +
+                      std::to_string(memoryGiB) + "|" +
+                      machine["architecture"].AsString();
+
+    std::string slug;
+    for (char c : model) {
+        bool alphanumeric = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        if (alphanumeric) {
+            slug += c;
+        } else if (!slug.empty() && slug.back() != '-') {
+            slug += '-';
+        }
+        if (slug.size() >= 32) {
+            break;
+        }
+    }
+    while (!slug.empty() && slug.back() == '-') {
+        slug.pop_back();
+    }
+
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(Fnv1a(key)));
+    return (slug.empty() ? std::string("machine") : slug) + "-" + hash;
+}
+
+std::string BaselinePathFor(const Options& options, const JsonValue& results)
+{
+    if (!options.baselinePath.empty()) {
+        return options.baselinePath;
+    }
+    return (std::filesystem::path(options.baselineDirectory) / (Fingerprint(results) + ".json")).string();
+}
+
+// ---------------------------------------------------------------------------
+// Échantillons
+// ---------------------------------------------------------------------------
+
+// Échantillons par métrique ("frame" puis étapes dans l'ordre d'apparition)
+struct RunSamples {
+    bool ok = true;
+    std::vector<std::string> order;
+    std::map<std::string, std::vector<double>> metrics;
+
+    void Add(const std::string& metric, double value)
+    {
+        auto it = metrics.find(metric);
+        if (it == metrics.end()) {
+            order.push_back(metric);
+            it = metrics.emplace(metric, std::vector<double>()).first;
+        }
+        it->second.push_back(value);
+    }
+};
+
+std::map<std::string, RunSamples> CollectRuns(const JsonValue& results, std::vector<std::string>& order)
+{
+    std::map<std::string, RunSamples> runs;
+
+    for (const JsonValue& run : results["runs"].Items()) {
+        const std::string& name = run["name"].AsString();
+        RunSamples& samples = runs[name];
+        order.push_back(name);
+
+        samples.ok = run["ok"].AsBool(false);
+        for (const JsonValue& sample : run["samples"].Items()) {
+            samples.Add("frame", sample["frameMs"].AsNumber());
+            for (const auto& stage : sample["stageMs"].Members()) {
+                samples.Add(stage.first, stage.second.AsNumber());
+            }
+        }
+    }
+
+    return runs;
+}
+
+// Plus petite p-valeur unilatérale atteignable avec n et m échantillons
+double MinimumPValue(size_t n, size_t m)
+{
+    double combinations = 1.0;
+    for (size_t i = 1; i <= m; ++i) {
+        combinations = combinations * static_cast<double>(n + i) / static_cast<double>(i);
+    }
+    return 1.0 / combinations;
+}
+
+// ---------------------------------------------------------------------------
+// Commandes
+// ---------------------------------------------------------------------------
+
+int RecordBaseline(const Options& options, const JsonValue& results)
+{
+    std::string path = BaselinePathFor(options, results);
+
+    std::error_code error;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, error);
+    }
+    std::filesystem::copy_file(options.resultsPath, path, std::filesystem::copy_options::overwrite_existing, error);
+    if (error) {
+        std::fprintf(stderr, "Impossible d'écrire %s : %s\n", path.c_str(), error.message().c_str());
+        return kExitError;
+    }
+
+    std::printf("Référence enregistrée : %s\n", path.c_str());
+    return kExitPass;
+}
+
+int CompareWithBaseline(const Options& options, const JsonValue& results)
+{
+    std::string path = BaselinePathFor(options, results);
+
+    JsonValue baseline;
+    std::string error;
+    if (!JsonValue::ParseFile(path, baseline, error)) {
+        std::fprintf(stderr, "Aucune référence utilisable pour cette machine (%s) : %s\n"
+                             "Enregistrer une référence avec : RegressionGate record %s\n",
+                     Fingerprint(results).c_str(), error.c_str(), options.resultsPath.c_str());
+        return kExitError;
+    }
+
+    if (options.baselinePath.empty() || Fingerprint(baseline) == Fingerprint(results)) {
+        std::printf("Machine : %s\n", Fingerprint(results).c_str());
+    } else {
+        std::printf("Attention : référence d'une autre machine (%s, mesures sur %s)\n",
+                    Fingerprint(baseline).c_str(), Fingerprint(results).c_str());
+    }
+    std::printf("Référence : %s\nSeuil : +%.1f %% de médiane, alpha = %.3g, écart minimal %.3f ms\n\n",
+                path.c_str(), options.thresholdPercent, options.alpha, options.minDeltaMs);
+
+    std::vector<std::string> baselineOrder;
+    std::vector<std::string> currentOrder;
+    std::map<std::string, RunSamples> baselineRuns = CollectRuns(baseline, baselineOrder);
+    std::map<std::string, RunSamples> currentRuns = CollectRuns(results, currentOrder);
+
+    int regressions = 0;
+    int failedRuns = 0;
+    int untested = 0;
+
+    for (const std::string& name : currentOrder) {
+        const RunSamples& current = currentRuns[name];
+        std::printf("%s\n", name.c_str());
+
+        if (!current.ok) {
+            std::printf("  ÉCHEC : la configuration n'a pas pu être exécutée\n\n");
+            failedRuns++;
+            continue;
+        }
+
+        auto found = baselineRuns.find(name);
+        if (found == baselineRuns.end()) {
+            std::printf("  nouvelle configuration, absente de la référence\n\n");
+            continue;
+        }
+        const RunSamples& reference = found->second;
+
+        std::printf("  %-24s %10s %10s %9s %9s  %s\n", "Étape", "Réf. ms", "Actuel ms", "Écart", "p", "Verdict");
+
+        for (const std::string& metric : current.order) {
+            const std::vector<double>& now = current.metrics.at(metric);
+            auto before = reference.metrics.find(metric);
+            if (before == reference.metrics.end() || before->second.empty() || now.empty()) {
+                std::printf("  %-24s %10s %10.3f %9s %9s  nouvelle étape\n", metric.c_str(), "-", Median(now), "-", "-");
+                continue;
+            }
+
+            double baseMedian = Median(before->second);
+            double currentMedian = Median(now);
+            double deltaMs = currentMedian - baseMedian;
+            double deltaPercent = baseMedian > 0.0 ? deltaMs / baseMedian * 100.0 : 0.0;
+
+            // Sans assez de répétitions, le test ne peut pas conclure : seul
+            // le seuil s'applique, pour qu'une forte hausse ne passe pas
+            bool testable = MinimumPValue(now.size(), before->second.size()) <= options.alpha;
+            MannWhitneyResult slower = MannWhitneyGreater(now, before->second);
+            MannWhitneyResult faster = MannWhitneyGreater(before->second, now);
+
+            bool significantSlower = !testable || slower.pValue <= options.alpha;
+            bool significantFaster = !testable || faster.pValue <= options.alpha;
+            bool aboveNoise = std::fabs(deltaMs) >= options.minDeltaMs;
+
+            const char* verdict = "=";
+            if (deltaPercent > options.thresholdPercent && aboveNoise && significantSlower) {
+                verdict = testable ? "RÉGRESSION" : "RÉGRESSION (non testée)";
+                regressions++;
+            } else if (deltaPercent < -options.thresholdPercent && aboveNoise && significantFaster) {
+                verdict = testable ? "amélioration" : "amélioration (non testée)";
+            }
+            if (!testable) {
+                untested++;
+            }
+
+            double pValue = deltaMs >= 0.0 ? slower.pValue : faster.pValue;
+            std::printf("  %-24s %10.3f %10.3f %+8.1f%% %9.4f  %s\n",
+                        metric.c_str(), baseMedian, currentMedian, deltaPercent, pValue, verdict);
+        }
+
+        for (const std::string& metric : reference.order) {
+            if (current.metrics.find(metric) == current.metrics.end()) {
+                std::printf("  %-24s %10.3f %10s %9s %9s  étape disparue\n",
+                            metric.c_str(), Median(reference.metrics.at(metric)), "-", "-", "-");
+            }
+        }
+        std::printf("\n");
+    }
+
+    for (const std::string& name : baselineOrder) {
+        if (currentRuns.find(name) == currentRuns.end()) {
+            std::printf("%s : absente des mesures actuelles\n", name.c_str());
+        }
+    }
+
+    if (untested > 0) {
+        std::printf("Attention : %d comparaisons sans test de significativité faute de répétitions "
+                    "(augmenter --repetitions du benchmark)\n", untested);
+    }
+
+    if (regressions > 0 || failedRuns > 0) {
+        std::printf("Résultat : %d régression(s), %d configuration(s) en échec\n", regressions, failedRuns);
+        return kExitRegression;
+    }
+
+    std::printf("Résultat : aucune régression\n");
+    return kExitPass;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return kExitError;
+    }
+
+    JsonValue results;
+    std::string error;
+    if (!JsonValue::ParseFile(options.resultsPath, results, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return kExitError;
+    }
+    if (!results["machine"].IsObject() || !results["runs"].IsArray()) {
+        std::fprintf(stderr, "%s : résultats de PipelineBenchmark attendus\n", options.resultsPath.c_str());
+        return kExitError;
+    }
+
+    if (options.command == "fingerprint") {
+        std::printf("%s\n", Fingerprint(results).c_str());
+        return kExitPass;
+    }
+    if (options.command == "record") {
+        return RecordBaseline(options, results);
+    }
+    return CompareWithBaseline(options, results);
+}
@@ -0,0 +1,139 @@
+#include "Statistics.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace XIS {
+namespace Profiler {
+
+namespace {
+    // Au-delà, l'approximation normale est suffisante
+    const size_t kMaxExactSampleSize = 30;
+
+    /**
+     * Distribution exacte de U sous l'hypothèse nulle : counts[u] est le
+     * nombre d'arrangements de n + m valeurs distinctes donnant U = u
+     */
+    std::vector<double> ExactDistribution(size_t n, size_t m)
+    {
+        // f(i, j, u) = f(i - 1, j, u - j) + f(i, j - 1, u), calculée par
+        // couches sur i avec un tableau (j, u)
+        size_t maxU = n * m;
+        std::vector<std::vector<double>> previous(m + 1, std::vector<double>(maxU + 1, 0.0));
+        for (size_t j = 0; j <= m; ++j) {
+            previous[j][0] = 1.0;
+        }
+
+        for (size_t i = 1; i <= n; ++i) {
+            std::vector<std::vector<double>> current(m + 1, std::vector<double>(maxU + 1, 0.0));
+            current[0][0] = 1.0;
+            for (size_t j = 1; j <= m; ++j) {
+                for (size_t u = 0; u <= i * j; ++u) {
+                    double count = current[j - 1][u];
+                    if (u >= j) {
+                        count += previous[j][u - j];
+                    }
+                    current[j][u] = count;
+                }
+            }
+            previous = std::move(current);
+        }
+
+        return previous[m];
+    }
+}
+
+double Median(std::vector<double> values)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+
+    size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    double upper = values[middle];
+    if (values.size() % 2 == 1) {
+        return upper;
+    }
+
+    double lower = *std::max_element(values.begin(), values.begin() + middle);
+    return 0.5 * (lower + upper);
+}
+
+MannWhitneyResult MannWhitneyGreater(const std::vector<double>& candidate, const std::vector<double>& reference)
+{
+    MannWhitneyResult result;
+    const size_t n = candidate.size();
+    const size_t m = reference.size();
+    if (n == 0 || m == 0) {
+        return result;
+    }
+
+    // U = nombre de paires (candidat, référence) où le candidat est plus
+    // grand, les égalités comptant pour moitié
+    bool ties = false;
+    for (double x : candidate) {
+        for (double y : reference) {
+            if (x > y) {
+                result.u += 1.0;
+            } else if (x == y) {
+                result.u += 0.5;
+                ties = true;
+            }
+        }
+    }
+
+    if (!ties && n <= kMaxExactSampleSize && m <= kMaxExactSampleSize) {
+        std::vector<double> counts = ExactDistribution(n, m);
+        double total = 0.0;
+        double tail = 0.0;
+        size_t observed = static_cast<size_t>(result.u);
+        for (size_t u = 0; u < counts.size(); ++u) {
+            total += counts[u];
+            if (u >= observed) {
+                tail += counts[u];
+            }
+        }
+        result.pValue = tail / total;
+        result.exact = true;
+        return result;
+    }
+
+    // Approximation normale avec correction des ex aequo
+    std::vector<std::pair<double, int>> pooled;
+    pooled.reserve(n + m);
+    for (double x : candidate) {
+        pooled.emplace_back(x, 0);
+    }
+    for (double y : reference) {
+        pooled.emplace_back(y, 1);
+    }
+    std::sort(pooled.begin(), pooled.end());
+
+    double tieTerm = 0.0;
+    for (size_t i = 0; i < pooled.size();) {
+        size_t j = i;
+        while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+            j++;
+        }
+        double t = static_cast<double>(j - i);
+        tieTerm += t * t * t - t;
+        i = j;
+    }
+
+    const double nd = static_cast<double>(n);
+    const double md = static_cast<double>(m);
+    const double total = nd + md;
+    double mean = nd * md / 2.0;
+    double variance = nd * md / 12.0 * ((total + 1.0) - tieTerm / (total * (total - 1.0)));
+    if (variance <= 0.0) {
+        return result;
+    }
+
+    double z = (result.u - mean - 0.5) / std::sqrt(variance);
+    result.pValue = 0.5 * std::erfc(z / std::sqrt(2.0));
+    return result;
+}
+
+} // namespace Profiler
+} // namespace XIS
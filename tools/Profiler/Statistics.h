@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+namespace XIS {
+namespace Profiler {
+
+/**
+ * @brief Médiane d'un échantillon (0 s'il est vide)
+ */
+double Median(std::vector<double> values);
+
+/**
+ * @brief Résultat d'un test de Mann-Whitney
+ */
+struct MannWhitneyResult {
+    double u = 0.0;                       // Statistique U de l'échantillon candidat
+    double pValue = 1.0;                  // Probabilité unilatérale sous l'hypothèse nulle
+    bool exact = false;                   // Distribution exacte (sinon approximation normale)
+};
+
+/**
+ * @brief Test unilatéral de Mann-Whitney : candidate est-il plus grand que reference ?
+ *
+ * Sans rang ex aequo et pour de petits échantillons, la p-valeur est exacte
+ * (dénombrement des permutations) ; sinon l'approximation normale est
+ * utilisée, avec correction des ex aequo et de continuité. Le test ne
+ * suppose pas de distribution normale des temps, souvent asymétriques.
+ *
+ * Avec n échantillons de chaque côté, la plus petite p-valeur atteignable
+ * est 1 / C(2n, n) : au moins 5 répétitions sont nécessaires pour conclure
+ * au seuil de 1 %.
+ */
+MannWhitneyResult MannWhitneyGreater(const std::vector<double>& candidate, const std::vector<double>& reference);
+
+} // namespace Profiler
+} // namespace XIS
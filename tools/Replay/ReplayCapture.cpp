@@ -0,0 +1,350 @@
+/**
+ * @brief Rejeu déterministe d'une capture de frames
+ *
+ * Relit une capture produite par StartFrameCapture et fait repasser chaque
+ * frame dans Pipeline::Execute avec la même configuration (et ses
+ * changements), les mêmes paramètres, le même délestage et le même point de
+ * fonctionnement de la résolution dynamique. La capture est projetée en
+ * mémoire ; les frames sont décodées l'une après l'autre.
+ *
+ * Chaque passe utilise une session neuve : deux passes doivent produire des
+ * sorties identiques octet pour octet. Le condensat de chaque sortie peut
+ * être écrit dans un fichier (--hashes) puis comparé à un rejeu ultérieur
+ * (--verify), par exemple avant et après une modification d'un kernel.
+ *
+ * Le rejeu s'exécute sur le backend CPU ; la capture doit donc provenir du
+ * backend CPU (formats de texture CPUTextureFormat).
+ *
+ * Usage :
+ *   ReplayCapture CAPTURE [--loops N] [--threads N] [--hashes FILE] [--verify FILE]
+ *
+ * Codes de retour : 0 si le rejeu est déterministe, 1 si les sorties
+ * diffèrent entre passes ou de --verify, 2 en cas d'erreur.
+ */
+
+#include "../../src/Core/XISCore.h"
+#include "../../src/Renderer/CPU/CPURenderer.h"
+#include "../../src/Renderer/CPU/CPUResources.h"
+#include "../../src/Utils/FrameCapture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace XIS;
+
+namespace {
+
+const int kExitPass = 0;
+const int kExitMismatch = 1;
+const int kExitError = 2;
+
+struct Options {
+    std::string capturePath;
+    int loops = 2;
+    uint32_t threads = 0;                 // 0 = tous les cœurs
+    std::string hashesPath;               // Condensats de la première passe
+    std::string verifyPath;               // Condensats de référence
+};
+
+void PrintUsage()
+{
+    std::fprintf(stderr,
+        "Usage:\n"
+        "  ReplayCapture CAPTURE [--loops N] [--threads N] [--hashes FILE] [--verify FILE]\n"
+        "\n"
+        "  --loops N      Nombre de passes sur la capture (défaut : 2)\n"
+        "  --threads N    Threads de calcul du backend CPU (défaut : tous les cœurs)\n"
+        "  --hashes FILE  Écrit le condensat et le temps de chaque frame\n"
+        "  --verify FILE  Compare les condensats à ceux d'un rejeu précédent\n");
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+    if (argc < 2) {
+        return false;
+    }
+
+    options.capturePath = argv[1];
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Valeur manquante pour %s\n", arg.c_str());
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--loops") options.loops = std::max(1, std::atoi(value.c_str()));
+        else if (arg == "--threads") options.threads = static_cast<uint32_t>(std::atoi(value.c_str()));
+        else if (arg == "--hashes") options.hashesPath = value;
+        else if (arg == "--verify") options.verifyPath = value;
+        else {
+            std::fprintf(stderr, "Option inconnue : %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// FNV-1a 64 bits des lignes actives (sans le remplissage)
+uint64_t HashTexture(const CPUTexture* texture)
+{
+    uint64_t hash = 14695981039346656037ull;
+    size_t rowBytes = static_cast<size_t>(texture->width) * GetCPUFormatSize(texture->format);
+    for (int y = 0; y < texture->height; ++y) {
+        const uint8_t* row = texture->GetRow(y);
+        for (size_t x = 0; x < rowBytes; ++x) {
+            hash ^= row[x];
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+/**
+ * Textures de la session de rejeu, recréées lorsque la capture change de
+ * taille ou de format
+ */
+class ReplayTextures {
+public:
+    ~ReplayTextures() { Release(); }
+
+    bool Prepare(const CapturedFrame& frame)
+    {
+        if (!Matches(m_input, frame.inputWidth, frame.inputHeight, frame.inputFormat)) {
+            Replace(m_input, frame.inputWidth, frame.inputHeight, frame.inputFormat);
+        }
+        if (!Matches(m_output, frame.outputWidth, frame.outputHeight, frame.outputFormat)) {
+            Replace(m_output, frame.outputWidth, frame.outputHeight, frame.outputFormat);
+        }
+        if (!m_input || !m_output) {
+            return false;
+        }
+
+        size_t rowBytes = static_cast<size_t>(m_input->width) * GetCPUFormatSize(m_input->format);
+        if (frame.pixelBytes != rowBytes * static_cast<size_t>(m_input->height)) {
+            std::fprintf(stderr, "Frame %u : taille de l'entrée incohérente\n", frame.index);
+            return false;
+        }
+        for (int y = 0; y < m_input->height; ++y) {
+            std::memcpy(m_input->GetRow(y), frame.pixels + rowBytes * static_cast<size_t>(y), rowBytes);
+        }
+        return true;
+    }
+
+    void Release()
+    {
+        ReleaseCPUResource(m_input);
+        ReleaseCPUResource(m_output);
+        m_input = nullptr;
+        m_output = nullptr;
+    }
+
+    CPUTexture* GetInput() const { return m_input; }
+    CPUTexture* GetOutput() const { return m_output; }
+
+private:
+    static bool Matches(const CPUTexture* texture, int width, int height, int format)
+    {
+        return texture && texture->width == width && texture->height == height &&
+               static_cast<int>(texture->format) == format;
+    }
+
+    static void Replace(CPUTexture*& texture, int width, int height, int format)
+    {
+        ReleaseCPUResource(texture);
+        texture = CreateCPUTexture(width, height, static_cast<CPUTextureFormat>(format));
+    }
+
+    CPUTexture* m_input = nullptr;
+    CPUTexture* m_output = nullptr;
+};
+
+struct FrameResult {
+    uint64_t hash = 0;
+    double milliseconds = 0.0;
+};
+
+/**
+ * Une passe complète sur une session neuve
+ */
+bool ReplayOnce(FrameCaptureReader& reader, const Options& options, std::vector<FrameResult>& results)
+{
+    reader.Rewind();
+    results.clear();
+
+    XISCore core;
+    if (!core.Initialize(std::make_shared<CPURenderer>(options.threads), reader.GetConfig())) {
+        std::fprintf(stderr, "Échec de l'initialisation de la session de rejeu\n");
+        return false;
+    }
+    Pipeline* pipeline = core.GetPipeline();
+
+    ReplayTextures textures;
+    CapturedFrame frame;
+    bool configChanged = false;
+    while (reader.ReadNextFrame(frame, configChanged)) {
+        if (configChanged) {
+            pipeline->PublishConfig(reader.GetConfig());
+        }
+        pipeline->ForceNextOperatingPoint(frame.operatingPoint);
+
+        if (!textures.Prepare(frame)) {
+            return false;
+        }
+
+        XISParameters params;
+        params.inputTexture = textures.GetInput();
+        params.outputTexture = textures.GetOutput();
+        params.frameDeltaTime = frame.frameDeltaTime;
+        params.qualityFactor = frame.qualityFactor;
+        params.isDX11 = false;
+
+        auto start = std::chrono::steady_clock::now();
+        bool processed = core.ProcessFrame(params, static_cast<ShedLevel>(frame.shedLevel));
+        auto end = std::chrono::steady_clock::now();
+        if (!processed) {
+            std::fprintf(stderr, "Frame %u : échec du traitement\n", frame.index);
+            return false;
+        }
+
+        FrameResult result;
+        result.hash = HashTexture(textures.GetOutput());
+        result.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+        results.push_back(result);
+    }
+
+    if (results.size() != reader.GetFrameCount()) {
+        std::fprintf(stderr, "Capture illisible après %zu frames\n", results.size());
+        return false;
+    }
+    return true;
+}
+
+bool WriteHashes(const std::string& path, const std::vector<FrameResult>& results)
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        std::fprintf(stderr, "Impossible de créer %s\n", path.c_str());
+        return false;
+    }
+    for (size_t i = 0; i < results.size(); ++i) {
+        std::fprintf(file, "%zu %016" PRIx64 " %.4f\n", i, results[i].hash, results[i].milliseconds);
+    }
+    return std::fclose(file) == 0;
+}
+
+bool ReadHashes(const std::string& path, std::vector<uint64_t>& hashes)
+{
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file) {
+        std::fprintf(stderr, "Impossible d'ouvrir %s\n", path.c_str());
+        return false;
+    }
+    size_t index;
+    uint64_t hash;
+    double milliseconds;
+    while (std::fscanf(file, "%zu %" SCNx64 " %lf", &index, &hash, &milliseconds) == 3) {
+        hashes.push_back(hash);
+    }
+    std::fclose(file);
+    return true;
+}
+
+// Nombre de frames dont le condensat diffère ; la première est signalée
+size_t CountMismatches(const std::vector<FrameResult>& results, const std::vector<uint64_t>& reference, const char* label)
+{
+    size_t mismatches = 0;
+    size_t count = std::max(results.size(), reference.size());
+    for (size_t i = 0; i < count; ++i) {
+        bool same = i < results.size() && i < reference.size() && results[i].hash == reference[i];
+        if (!same && mismatches++ == 0) {
+            std::printf("  première divergence (%s) : frame %zu\n", label, i);
+        }
+    }
+    return mismatches;
+}
+
+void PrintTimings(int loop, const std::vector<FrameResult>& results)
+{
+    std::vector<double> times;
+    times.reserve(results.size());
+    double total = 0.0;
+    for (const FrameResult& result : results) {
+        times.push_back(result.milliseconds);
+        total += result.milliseconds;
+    }
+    std::sort(times.begin(), times.end());
+    if (times.empty()) {
+        return;
+    }
+
+    double median = times[times.size() / 2];
+    double p99 = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+    std::printf("Passe %d : %zu frames, %.2f ms au total, médiane %.3f ms, p99 %.3f ms, max %.3f ms\n",
+                loop + 1, times.size(), total, median, p99, times.back());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return kExitError;
+    }
+
+    FrameCaptureReader reader;
+    if (!reader.Open(options.capturePath)) {
+        std::fprintf(stderr, "%s : capture illisible\n", options.capturePath.c_str());
+        return kExitError;
+    }
+    std::printf("%s : %zu frames\n", options.capturePath.c_str(), reader.GetFrameCount());
+
+    std::vector<FrameResult> first;
+    std::vector<FrameResult> results;
+    size_t mismatches = 0;
+    for (int loop = 0; loop < options.loops; ++loop) {
+        if (!ReplayOnce(reader, options, loop == 0 ? first : results)) {
+            return kExitError;
+        }
+        PrintTimings(loop, loop == 0 ? first : results);
+
+        if (loop > 0) {
+            std::vector<uint64_t> reference;
+            for (const FrameResult& result : first) {
+                reference.push_back(result.hash);
+            }
+            mismatches += CountMismatches(results, reference, "entre passes");
+        }
+    }
+
+    if (!options.hashesPath.empty() && !WriteHashes(options.hashesPath, first)) {
+        return kExitError;
+    }
+
+    if (!options.verifyPath.empty()) {
+        std::vector<uint64_t> reference;
+        if (!ReadHashes(options.verifyPath, reference)) {
+            return kExitError;
+        }
+        mismatches += CountMismatches(first, reference, options.verifyPath.c_str());
+    }
+
+    if (mismatches > 0) {
+        std::printf("NON DÉTERMINISTE : %zu frames divergentes\n", mismatches);
+        return kExitMismatch;
+    }
+    std::printf("Rejeu déterministe\n");
+    return kExitPass;
+}